@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef EVENT_IMPL_H
+#define EVENT_IMPL_H
+
+#include <stdint.h>
+#include <cstddef>
+#include "simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup events
+ * \brief a simulation event
+ *
+ * Each subclass of this base class represents a simulation event. The
+ * EventImpl::Invoke method will be invoked by the simulation engine
+ * when the time associated to this event expires. This class is
+ * obviously (there are Ref and Unref methods) reference-counted and
+ * most subclasses are usually created by one of the many Simulator::Schedule
+ * methods.
+ *
+ * The memory of the events is managed by per-thread free lists, one for
+ * each size class (multiple of 16 bytes, up to 256 bytes). An event
+ * released by the simulation engine is kept in the free list of the
+ * releasing thread and reused by the next event of the same size class
+ * created by that thread, so that scheduling an event does not usually
+ * require a heap allocation.
+ */
+class EventImpl : public SimpleRefCount<EventImpl>
+{
+public:
+  EventImpl ();
+  virtual ~EventImpl () = 0;
+  /**
+   * Called by the simulation engine to notify the event that it has expired.
+   */
+  void Invoke (void);
+  /**
+   * Marks the event as 'canceled'. The event will not be removed from
+   * the event list but the simulation engine will check its canceled status
+   * before calling Invoke.
+   */
+  void Cancel (void);
+  /**
+   * \returns true if the event has been canceled.
+   *
+   * Invoked by the simulation engine before calling Invoke.
+   */
+  bool IsCancelled (void);
+
+  /**
+   * \brief Event allocation statistics of the calling thread.
+   */
+  struct PoolStatistics
+  {
+    uint64_t allocations;       //!< number of events allocated
+    uint64_t pooledAllocations; //!< number of allocations served by the free lists
+    uint64_t freeBlocks;        //!< number of blocks held in the free lists
+  };
+
+  /**
+   * \returns the event allocation statistics of the calling thread.
+   */
+  static struct PoolStatistics GetPoolStatistics (void);
+  /**
+   * Give the blocks held in the free lists of the calling thread back to
+   * the heap, and reset its statistics.
+   */
+  static void ReleasePool (void);
+
+  /**
+   * \param size the size of the event
+   * \returns a block from the free list of the size class, if any
+   */
+  static void *operator new (std::size_t size);
+  /**
+   * \param p the event memory
+   * \param size the size of the event, which selects its size class
+   */
+  static void operator delete (void *p, std::size_t size);
+
+protected:
+  virtual void Notify (void) = 0;
+
+private:
+  bool m_cancel;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_IMPL_H */
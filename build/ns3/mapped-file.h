@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \brief The content of a file, mapped read-only in memory.
+ *
+ * The file is mapped with mmap where the system supports it, and read
+ * in memory at once otherwise. Either way, the content is valid until
+ * the file is closed, and its first byte is page-aligned or aligned as
+ * by operator new.
+ */
+class MappedFile
+{
+public:
+  MappedFile ();
+  ~MappedFile ();
+
+  /**
+   * \param filename the name of the file
+   * \returns true if the file is mapped, false if it cannot be read or
+   *          is empty
+   */
+  bool Open (std::string const &filename);
+  /**
+   * Unmap the file.
+   */
+  void Close (void);
+
+  /**
+   * \returns the content of the file, or 0 if it is not open
+   */
+  uint8_t const *GetData (void) const;
+  /**
+   * \returns the size of the file, in bytes
+   */
+  uint64_t GetSize (void) const;
+
+private:
+  /**
+   * \brief Copy constructor, disabled: the mapping is owned by this object.
+   */
+  MappedFile (MappedFile const &);
+  /**
+   * \brief Assignment operator, disabled: the mapping is owned by this object.
+   * \returns nothing
+   */
+  MappedFile &operator= (MappedFile const &);
+
+  uint8_t const *m_data;   //!< the content of the file
+  uint64_t m_size;         //!< the size of the file
+  bool m_mapped;           //!< true if m_data is mapped, false if allocated
+};
+
+} // namespace ns3
+
+#endif /* MAPPED_FILE_H */
@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "system-thread.h"
+#include "system-mutex.h"
+#include "mpsc-queue.h"
+#include "object-factory.h"
+#include "nstime.h"
+#include "ptr.h"
+
+#include <list>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ * \brief a conservative parallel simulator, for shared-memory machines
+ *
+ * The events are partitioned by context (the node id, for network
+ * models) over Threads partitions, each with its own scheduler and run
+ * by its own thread. The simulation advances by time windows: all the
+ * partitions run their events earlier than the earliest pending event
+ * plus the Lookahead, then synchronize on a barrier. An event scheduled
+ * for another partition is pushed to the lock-free inbox of that
+ * partition, which is drained into its scheduler between its events.
+ *
+ * The Lookahead must not be larger than the smallest delay between an
+ * event and the events it schedules in other partitions, typically the
+ * minimum propagation and processing delay of the channels: a violation
+ * is a fatal error. With a single partition, the window is unbounded
+ * and the events are run as with the DefaultSimulatorImpl.
+ *
+ * The events of a partition are run in the same order for every run,
+ * and the uids of the events are allocated by partition, so that the
+ * results do not depend on the interleaving of the threads. The models
+ * must however not share unprotected state between the nodes of
+ * different partitions.
+ *
+ * Simulator::Stop (delay) stops the simulation after all the events
+ * up to the stop time, included, when called before Run or with a
+ * delay not smaller than the Lookahead. Simulator::Stop () stops the
+ * simulation once all the partitions have run the events of the
+ * current window, or after the current event with a single partition.
+ * While the simulation runs, Simulator::Remove, Cancel and IsExpired
+ * only accept the events of the calling partition. Events can be
+ * injected from foreign threads with Simulator::ScheduleWithContext:
+ * their delay is relative to the time of the target partition when
+ * they are inserted in its scheduler.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  static TypeId GetTypeId (void);
+
+  MultithreadedSimulatorImpl ();
+  ~MultithreadedSimulatorImpl ();
+
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (Time const &time);
+  virtual EventId Schedule (Time const &time, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &ev);
+  virtual void Cancel (const EventId &ev);
+  virtual bool IsExpired (const EventId &ev) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * \returns the number of windows of the last run
+   */
+  uint64_t GetWindows (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /// An event sent to another partition.
+  struct InboxEvent
+  {
+    InboxEvent *next;      //!< the next event of the inbox
+    EventImpl *event;      //!< the event
+    uint64_t ts;           //!< the timestamp, or the delay if relative
+    uint32_t context;      //!< the context of the event
+    uint32_t uid;          //!< the uid, unless relative
+    bool relative;         //!< whether the event comes from a foreign thread
+  };
+
+  /// A partition of the events, run by one thread.
+  struct Partition
+  {
+    Ptr<Scheduler> events;        //!< the events of the partition
+    MpscQueue<InboxEvent> inbox;  //!< events sent by the other threads
+    uint64_t currentTs;           //!< timestamp of the current event
+    uint32_t currentUid;          //!< uid of the current event
+    uint32_t currentContext;      //!< context of the current event
+    uint32_t uid;                 //!< next uid allocated by the partition
+    uint64_t next;                //!< timestamp of the next event, at the start of a window
+  };
+
+  /// Create the partitions, if not done yet.
+  void CreatePartitions (void);
+  /**
+   * \param context the context of an event
+   * \returns the index of the partition of the context
+   */
+  uint32_t GetPartitionIndex (uint32_t context) const;
+  /**
+   * \returns the partition of the calling thread, or the first
+   * partition if the simulation is not running
+   */
+  Partition * GetCurrentPartition (void) const;
+  /**
+   * \param partition the partition
+   * \returns a new uid of the partition
+   */
+  uint32_t AllocateUid (Partition *partition);
+  /**
+   * Insert the events of the inbox of a partition in its scheduler.
+   * \param partition the partition
+   */
+  void DrainInbox (Partition *partition);
+  /// Run the partitions of the worker threads.
+  void DoWorker (void);
+  /**
+   * Run a partition until the end of the simulation.
+   * \param index the index of the partition
+   */
+  void DoRun (uint32_t index);
+  /**
+   * Wait until all the threads reach the barrier.
+   * \param last whether the last thread must compute the next window
+   */
+  void Barrier (bool last);
+  /// Compute the next window, or the end of the simulation.
+  void NextWindow (void);
+
+  std::vector<Partition *> m_partitions;
+  ObjectFactory m_schedulerFactory;
+  uint32_t m_threads;
+  Time m_lookahead;
+
+  bool m_running;
+  volatile bool m_stop;
+  volatile uint64_t m_stopTs;
+  bool m_done;
+  uint64_t m_windowEnd;
+  uint64_t m_windows;
+  uint64_t m_endTs;
+
+  volatile uint32_t m_barrierCount;
+  volatile uint32_t m_barrierGeneration;
+  volatile uint32_t m_nextWorker;
+
+  typedef std::list<EventId> DestroyEvents;
+  DestroyEvents m_destroyEvents;
+  mutable SystemMutex m_destroyEventsMutex;
+
+  SystemThread::ThreadId m_main;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef PACKET_DATA_POOL_H
+#define PACKET_DATA_POOL_H
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup packet
+ *
+ * \brief Per-thread size-class allocator for the data blocks of packets.
+ *
+ * The data of Buffer, PacketMetadata, PacketTagList and ByteTagList is
+ * allocated from free lists, one per size class and per user. Size
+ * classes are spaced by a quarter of a power of two between 32 bytes
+ * and 8 KiB, so that blocks of varied sizes (127-byte 802.15.4 frames
+ * next to 1280-byte IPv6 packets) are all reused; larger blocks come
+ * from the heap. Each thread has its own free lists, hence no locking
+ * is needed and packets can be created and destroyed by several threads
+ * concurrently. A block released by a thread other than the one which
+ * allocated it simply joins the free lists of the releasing thread.
+ *
+ * The free lists of a thread are given back to the heap when it exits,
+ * and those of the main thread at the end of the program.
+ */
+class PacketDataPool
+{
+public:
+  /// The users of the pool, which have separate free lists and statistics.
+  enum User
+  {
+    BUFFER = 0,       //!< Buffer::Data
+    PACKET_METADATA,  //!< PacketMetadata::Data
+    PACKET_TAG_LIST,  //!< PacketTagList spilled tags
+    BYTE_TAG_LIST,    //!< ByteTagList data
+    USERS             //!< number of users
+  };
+
+  /**
+   * \brief Allocation statistics of a user, for the calling thread.
+   */
+  struct Statistics
+  {
+    uint64_t hits;          //!< allocations served by the free lists
+    uint64_t misses;        //!< allocations served by the heap
+    uint64_t bytesRetained; //!< bytes held in the free lists
+  };
+
+  /**
+   * \param user the user of the block
+   * \param size the minimum size of the block, in bytes; set to the
+   *        size of the block returned, which the user may use entirely
+   * \returns a block of at least size bytes
+   */
+  static void *Allocate (enum User user, uint32_t *size);
+  /**
+   * \param user the user of the block
+   * \param block a block returned by Allocate
+   * \param size the size of the block, as requested from or returned
+   *        by Allocate
+   */
+  static void Deallocate (enum User user, void *block, uint32_t size);
+  /**
+   * \param user the user
+   * \returns the statistics of the user for the calling thread
+   */
+  static struct Statistics GetStatistics (enum User user);
+  /**
+   * Give the blocks held in the free lists of the calling thread back
+   * to the heap, and reset its statistics.
+   */
+  static void Release (void);
+};
+
+} // namespace ns3
+
+#endif /* PACKET_DATA_POOL_H */
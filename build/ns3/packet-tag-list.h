@@ -0,0 +1,342 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef PACKET_TAG_LIST_H
+#define PACKET_TAG_LIST_H
+
+/**
+\file   packet-tag-list.h
+\brief  Defines a small array of Packet tags, including copy-on-write semantics.
+*/
+
+#include <stdint.h>
+#include <cstddef>
+#include <ostream>
+#include "ns3/type-id.h"
+#include "ns3/deprecated.h"
+
+namespace ns3 {
+
+class Tag;
+
+/**
+ * \ingroup packet
+ *
+ * \brief List of the packet tags stored in a packet.
+ *
+ * This class is mostly private to the Packet implementation and users
+ * should never have to access it directly.
+ *
+ * \internal
+ *
+ * Tags are stored in serialized form in an array of TagData, in the
+ * order in which they were added, next to an index holding the TypeId
+ * uid of each tag. #Peek, #Replace and #Remove scan the index, which
+ * for the usual one or two tags is a couple of comparisons.
+ *
+ * Up to INLINE_TAGS tags are stored inline, in the PacketTagList itself:
+ * copying the list copies them, and no memory is allocated. When more
+ * tags are added, the tags move to a Spill block allocated from the
+ * PacketDataPool, which copies of the list share, counting references:
+ *
+ *   - the copy constructor and assignment share the Spill of the
+ *     original list, incrementing its \c count.
+ *
+ *   - #Add, #Remove and #Replace first copy a Spill which is shared
+ *     with other lists (copy-on-write), then modify it in place.
+ *
+ *   - when the last tag is removed, the list goes back to inline
+ *     storage.
+ *
+ * \par <b> Memory Management: </b>
+ * \n
+ * Packet tags must serialize to a finite maximum size, see TagData
+ */
+class PacketTagList 
+{
+public:
+  /**
+   * A serialized tag.
+   *
+   * See TagData::TagData_e for a discussion of the size limit on
+   * tag serialization.
+   */
+  struct TagData
+  {
+    /**
+     * \brief Packet Tag maximum size
+     *
+     * The maximum size (in bytes) of a Tag is stored
+     * in this constant.
+     *
+     * \internal
+     * ns3:Ipv6PacketInfoTag needs 19 bytes.  The current
+     * implementation allows 20 bytes, which gives TagData
+     * a size of 22 bytes.
+     */
+    enum TagData_e
+    {
+      MAX_SIZE = 20           /**< Size of serialization buffer #data */
+  };
+
+    uint8_t data[MAX_SIZE];   /**< Serialization buffer */
+    TypeId tid;               /**< Type of the tag serialized into #data */
+  };  /* struct TagData */
+
+  /**
+   * Create a new PacketTagList.
+   */
+  inline PacketTagList ();
+  /**
+   * Copy constructor
+   *
+   * \param [in] o The PacketTagList to copy.
+   *
+   * This copies the inline tags of \pname{o}, or shares its Spill.
+   */
+  inline PacketTagList (PacketTagList const &o);
+  /**
+   * Assignment
+   *
+   * \param [in] o The PacketTagList to copy.
+   * \returns the copied object
+   *
+   * This makes a light-weight copy by #RemoveAll, then copying
+   * the inline tags of \pname{o}, or sharing its Spill.
+   */
+  inline PacketTagList &operator = (PacketTagList const &o);
+  /**
+   * Destructor
+   *
+   * #RemoveAll's the tags.
+   */
+  inline ~PacketTagList ();
+
+  /**
+   * Add a tag to the list.
+   *
+   * \param [in] tag The tag to add
+   */
+  void Add (Tag const&tag) const;
+  /**
+   * Remove (the first instance of) tag from the list.
+   *
+   * \param [in,out] tag The tag type to remove.  If found,
+   *          \pname{tag} is set to the value of the tag found.
+   * \returns True if \pname{tag} is found, false otherwise.
+   */
+  bool Remove (Tag &tag);
+  /**
+   * Replace the value of a tag.
+   *
+   * \param [in] tag The tag type to replace.  To get the old
+   *        value of the tag, use #Peek first.
+   * \returns True if \pname{tag} is found, false otherwise.
+   *        If \pname{tag} wasn't found, Add is performed instead (so
+   *        the list is guaranteed to have the new tag value either way).
+   */
+  bool Replace (Tag &tag);
+  /**
+   * Find a tag and return its value.
+   *
+   * \param [in,out] tag The tag type to find.  If found,
+   *          \pname{tag} is set to the value of the tag found.
+   * \returns True if \pname{tag} is found, false otherwise.
+   */
+  bool Peek (Tag &tag) const;
+  /**
+   * Remove all tags from this list.
+   */
+  inline void RemoveAll (void);
+  /**
+   * \returns the number of tags in the list
+   */
+  inline uint32_t GetN (void) const;
+  /**
+   * \returns the GetN tags of the list, in the order they were added
+   */
+  inline const struct PacketTagList::TagData *GetTags (void) const;
+  /**
+   * \returns the first of the GetN tags of the list, or 0 if the list
+   *          is empty.  The tags are contiguous, and no longer linked.
+   * \deprecated use GetN and GetTags
+   */
+  inline const struct PacketTagList::TagData *Head (void) const NS_DEPRECATED;
+
+private:
+  /// Number of tags stored in the PacketTagList itself
+  enum { INLINE_TAGS = 2 };
+
+  /**
+   * Tags stored out of line, shared by copies of a list.
+   *
+   * The header is followed by the index, \c capacity uids, and by
+   * \c capacity TagData.
+   */
+  struct Spill
+  {
+    uint32_t count;    //!< Number of lists sharing this Spill
+    uint32_t capacity; //!< Number of tags which fit in this Spill
+    uint32_t size;     //!< Size of the block, in bytes
+  };
+
+  /**
+   * \param [in] spill A Spill.
+   * \returns the index of \pname{spill}
+   */
+  static inline uint16_t *GetSpillIndex (const struct Spill *spill);
+  /**
+   * \param [in] spill A Spill.
+   * \returns the tags of \pname{spill}
+   */
+  static inline struct TagData *GetSpillTags (const struct Spill *spill);
+  /**
+   * \param [in] n The number of tags needed.
+   * \returns a new Spill, with room for at least \pname{n} tags
+   */
+  static struct Spill *AllocateSpill (uint32_t n);
+  /**
+   * Drop a reference to a Spill, and free it if it was the last one.
+   *
+   * \param [in] spill The Spill to release.
+   */
+  static void ReleaseSpill (struct Spill *spill);
+
+  /**
+   * \param [in] uid The TypeId uid of a tag.
+   * \returns the position of the tag in the list, or -1 if not found
+   */
+  int32_t Find (uint16_t uid) const;
+  /**
+   * Make sure the tags can be modified in place, and there is room
+   * for \pname{n} tags, by copying the tags to a new Spill if needed.
+   *
+   * \param [in] n The number of tags needed.
+   */
+  void Reserve (uint32_t n);
+
+  uint32_t m_n;                        //!< Number of tags
+  struct Spill *m_spill;               //!< Tags stored out of line, if any
+  uint16_t m_index[INLINE_TAGS];       //!< Uids of the inline tags
+  struct TagData m_tags[INLINE_TAGS];  //!< Inline tags
+};
+
+} // namespace ns3
+
+/****************************************************
+ *  Implementation of inline methods for performance
+ ****************************************************/
+
+namespace ns3 {
+
+PacketTagList::PacketTagList ()
+  : m_n (0),
+    m_spill (0)
+{
+}
+
+PacketTagList::PacketTagList (PacketTagList const &o)
+  : m_n (o.m_n),
+    m_spill (o.m_spill)
+{
+  if (m_spill != 0)
+    {
+      m_spill->count++;
+      return;
+    }
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      m_index[i] = o.m_index[i];
+      m_tags[i] = o.m_tags[i];
+    }
+}
+
+PacketTagList &
+PacketTagList::operator = (PacketTagList const &o)
+{
+  // self assignment
+  if (this == &o) 
+    {
+      return *this;
+    }
+  RemoveAll ();
+  m_n = o.m_n;
+  m_spill = o.m_spill;
+  if (m_spill != 0) 
+    {
+      m_spill->count++;
+      return *this;
+    }
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      m_index[i] = o.m_index[i];
+      m_tags[i] = o.m_tags[i];
+    }
+  return *this;
+}
+
+PacketTagList::~PacketTagList ()
+{
+  RemoveAll ();
+}
+
+void
+PacketTagList::RemoveAll (void)
+{
+  if (m_spill != 0)
+    {
+      ReleaseSpill (m_spill);
+      m_spill = 0;
+    }
+  m_n = 0;
+}
+
+uint32_t
+PacketTagList::GetN (void) const
+{
+  return m_n;
+}
+
+const struct PacketTagList::TagData *
+PacketTagList::GetTags (void) const
+{
+  return m_spill != 0 ? GetSpillTags (m_spill) : m_tags;
+}
+
+const struct PacketTagList::TagData *
+PacketTagList::Head (void) const
+{
+  return m_n != 0 ? GetTags () : 0;
+}
+
+uint16_t *
+PacketTagList::GetSpillIndex (const struct Spill *spill)
+{
+  return reinterpret_cast<uint16_t *> (const_cast<struct Spill *> (spill) + 1);
+}
+
+struct PacketTagList::TagData *
+PacketTagList::GetSpillTags (const struct Spill *spill)
+{
+  return reinterpret_cast<struct TagData *> (GetSpillIndex (spill) + spill->capacity);
+}
+
+} // namespace ns3
+
+#endif /* PACKET_TAG_LIST_H */
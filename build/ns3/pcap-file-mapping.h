@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAP_FILE_MAPPING_H
+#define PCAP_FILE_MAPPING_H
+
+#include <string>
+#include <stdint.h>
+#include "mapped-file.h"
+
+namespace ns3 {
+
+/**
+ * \brief A read-only pcap file, mapped in memory.
+ *
+ * The whole file is mapped in memory when it is opened, and its records
+ * are walked by an Iterator which points directly into the mapping:
+ * no record is copied, and no buffer is allocated per record, unlike
+ * PcapFile::Read. See MappedFile.
+ *
+ * The fields of the record headers are converted to the byte order of
+ * the host when they are accessed. A record which is truncated by the
+ * end of the file is not returned, as if the file ended before it.
+ */
+class PcapFileMapping
+{
+public:
+  /**
+   * \brief A record of the file: a packet and its header.
+   *
+   * A record is valid as long as the file is open.
+   */
+  class Record
+  {
+public:
+    /**
+     * \returns the seconds part of the timestamp of the packet
+     */
+    uint32_t GetTsSec (void) const;
+    /**
+     * \returns the microseconds part of the timestamp of the packet, or
+     *          the nanoseconds part if PcapFileMapping::IsNanoSecMode
+     */
+    uint32_t GetTsUsec (void) const;
+    /**
+     * \returns the number of bytes of the packet saved in the file
+     */
+    uint32_t GetInclLen (void) const;
+    /**
+     * \returns the original length of the packet
+     */
+    uint32_t GetOrigLen (void) const;
+    /**
+     * \returns the GetInclLen bytes of the packet saved in the file
+     */
+    uint8_t const *GetData (void) const;
+
+private:
+    friend class PcapFileMapping;
+    /**
+     * \param offset the offset of a field in the record header
+     * \returns the field, in host byte order
+     */
+    uint32_t GetField (uint32_t offset) const;
+
+    uint8_t const *m_start; //!< start of the record header
+    bool m_swapMode;        //!< true if the fields must be byte-swapped
+  };
+
+  /**
+   * \brief A forward iterator over the records of the file.
+   */
+  class Iterator
+  {
+public:
+    /**
+     * Create an iterator which points to no record.
+     */
+    Iterator ();
+    /**
+     * \returns the current record
+     */
+    Record const &operator* (void) const;
+    /**
+     * \returns the current record
+     */
+    Record const *operator-> (void) const;
+    /**
+     * Move to the next record.
+     * \returns the iterator
+     */
+    Iterator &operator++ (void);
+    /**
+     * \param o another iterator over the same file
+     * \returns true if both iterators point to the same record
+     */
+    bool operator== (Iterator const &o) const;
+    /**
+     * \param o another iterator over the same file
+     * \returns true if the iterators point to different records
+     */
+    bool operator!= (Iterator const &o) const;
+
+private:
+    friend class PcapFileMapping;
+    /**
+     * \param start the start of a record, or end
+     * \param end the end of the file
+     * \param swapMode true if the fields must be byte-swapped
+     */
+    Iterator (uint8_t const *start, uint8_t const *end, bool swapMode);
+    /// Move to the end if the current record is truncated.
+    void Check (void);
+
+    Record m_record;          //!< the current record
+    uint8_t const *m_end;     //!< the end of the file
+  };
+
+  PcapFileMapping ();
+  ~PcapFileMapping ();
+
+  /**
+   * \brief Map a pcap file in memory, and read its header.
+   *
+   * Fail returns true if the file cannot be read, or if its header is
+   * not a valid pcap header.
+   *
+   * \param filename the name of the file
+   */
+  void Open (std::string const &filename);
+  /**
+   * Unmap the file: its records must no longer be used.
+   */
+  void Close (void);
+  /**
+   * \returns true if the file could not be opened, false otherwise
+   */
+  bool Fail (void) const;
+
+  /**
+   * \returns an iterator pointing to the first record
+   */
+  Iterator Begin (void) const;
+  /**
+   * \returns an iterator pointing past the last record
+   */
+  Iterator End (void) const;
+
+  /**
+   * \returns the magic number of the file
+   */
+  uint32_t GetMagic (void) const;
+  /**
+   * \returns the major version of the file format
+   */
+  uint16_t GetVersionMajor (void) const;
+  /**
+   * \returns the minor version of the file format
+   */
+  uint16_t GetVersionMinor (void) const;
+  /**
+   * \returns the time zone offset of the file
+   */
+  int32_t GetTimeZoneOffset (void) const;
+  /**
+   * \returns the accuracy of the timestamps
+   */
+  uint32_t GetSigFigs (void) const;
+  /**
+   * \returns the maximum size of the packets saved in the file
+   */
+  uint32_t GetSnapLen (void) const;
+  /**
+   * \returns the data link type of the file
+   */
+  uint32_t GetDataLinkType (void) const;
+  /**
+   * \returns true if the file is in the opposite byte order of the host
+   */
+  bool GetSwapMode (void) const;
+  /**
+   * \returns true if the timestamps have a nanosecond resolution
+   */
+  bool IsNanoSecMode (void) const;
+
+private:
+  /**
+   * \param offset the offset of a field in the file header
+   * \returns the 32-bit field, in host byte order
+   */
+  uint32_t Read32 (uint32_t offset) const;
+  /**
+   * \param offset the offset of a field in the file header
+   * \returns the 16-bit field, in host byte order
+   */
+  uint16_t Read16 (uint32_t offset) const;
+
+  MappedFile m_file;       //!< the mapped file
+  uint8_t const *m_data;   //!< the content of the file
+  uint64_t m_size;         //!< the size of the file
+  bool m_fail;             //!< true if the file could not be opened
+  bool m_swapMode;         //!< true if the fields must be byte-swapped
+};
+
+} // namespace ns3
+
+#endif /* PCAP_FILE_MAPPING_H */
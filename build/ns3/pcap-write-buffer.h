@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAP_WRITE_BUFFER_H
+#define PCAP_WRITE_BUFFER_H
+
+#include <ostream>
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \brief A buffer of capture records, written to a stream in large blocks.
+ *
+ * Records are serialized in memory and written to the stream when the
+ * buffer is full, instead of issuing several small writes per record.
+ * Full buffers may also be handed to a background I/O thread shared by
+ * all the buffers of the program, so that the simulation does not wait
+ * for the file system; the blocks of each stream are written in order.
+ *
+ * While writes are pending, the stream is used by the I/O thread: Sync
+ * must be called before any other use of the stream. Records still in
+ * the buffer are lost if the program aborts.
+ */
+class PcapWriteBuffer
+{
+public:
+  /**
+   * \param stream the stream the records are written to
+   */
+  PcapWriteBuffer (std::ostream *stream);
+  ~PcapWriteBuffer ();
+
+  /**
+   * \param size the size of the buffer, in bytes; 0 disables buffering
+   *
+   * The records in the buffer are written before it is resized.
+   */
+  void SetSize (uint32_t size);
+  /**
+   * \returns the size of the buffer, in bytes
+   */
+  uint32_t GetSize (void) const;
+  /**
+   * \returns true if records are buffered
+   */
+  bool IsEnabled (void) const;
+  /**
+   * \param async true to write full buffers from the background I/O
+   *        thread; ignored if threads are not supported
+   */
+  void SetAsync (bool async);
+
+  /**
+   * \param size the number of bytes to append to the buffer
+   * \returns a pointer to the bytes appended, valid until the next
+   *          call to a method of this buffer
+   */
+  uint8_t *Reserve (uint32_t size);
+  /**
+   * Mark the end of a record: the buffer is written if it is full.
+   */
+  void Commit (void);
+  /**
+   * Write the records in the buffer, and wait until they are written.
+   */
+  void Flush (void);
+  /**
+   * Wait until the records handed to the I/O thread are written.
+   */
+  void Sync (void) const;
+
+private:
+  /// Write the buffer to the stream, or hand it to the I/O thread.
+  void Write (void);
+
+  std::ostream *m_stream; //!< stream the records are written to
+  uint8_t *m_data;        //!< the buffer
+  uint32_t m_used;        //!< bytes used in the buffer
+  uint32_t m_capacity;    //!< bytes allocated for the buffer
+  uint32_t m_size;        //!< size at which the buffer is written
+  bool m_async;           //!< true if the buffer is written by the I/O thread
+  uint32_t m_pending;     //!< blocks handed to the I/O thread, not yet written
+};
+
+} // namespace ns3
+
+#endif /* PCAP_WRITE_BUFFER_H */
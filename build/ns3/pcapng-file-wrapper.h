@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAPNG_FILE_WRAPPER_H
+#define PCAPNG_FILE_WRAPPER_H
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <stdint.h>
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "file-write-buffer.h"
+#include "buffered-file-writer.h"
+
+namespace ns3 {
+
+class Packet;
+
+/**
+ * \brief A pcapng file, where the packets of several interfaces are
+ * captured.
+ *
+ * Instead of a pcap file per device, the packets of many devices can
+ * be written to a single file: each device is described by an
+ * interface description block, and each packet by an enhanced packet
+ * block which refers to its interface. Timestamps have a nanosecond
+ * resolution. Blocks are written in the byte order of the host, which
+ * is recorded in the section header block.
+ *
+ * Records are buffered as described in BufferedFileWriter.
+ *
+ * See https://github.com/pcapng/pcapng
+ */
+class PcapngFileWrapper : public BufferedFileWriter
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  PcapngFileWrapper ();
+  ~PcapngFileWrapper ();
+
+  /**
+   * \return true if the 'fail' bit is set in the underlying stream, false otherwise.
+   */
+  bool Fail (void) const;
+  /**
+   * Create a new pcapng file, and write its section header block.
+   *
+   * \param filename the name of the file
+   */
+  void Open (std::string const &filename);
+  /**
+   * Close the underlying file, writing the buffered records.
+   */
+  void Close (void);
+  /**
+   * Write the buffered records to the underlying file.
+   */
+  void Flush (void);
+
+  /**
+   * \brief Describe a new interface.
+   *
+   * \param dataLinkType the data link type of the packets of the
+   *        interface, as in PcapFile::Init
+   * \param name the name of the interface
+   * \param snapLen the maximum size of the packets written; 0 to use
+   *        the CaptureSize attribute
+   * \returns the id of the interface, to be used with Write
+   */
+  uint32_t AddInterface (uint32_t dataLinkType, std::string const &name, uint32_t snapLen = 0);
+  /**
+   * \returns the number of interfaces described
+   */
+  uint32_t GetNInterfaces (void) const;
+
+  /**
+   * \brief Write a packet captured on an interface.
+   *
+   * \param interface the id of the interface, as returned by AddInterface
+   * \param t the timestamp of the packet
+   * \param p the packet
+   */
+  void Write (uint32_t interface, Time t, Ptr<const Packet> p);
+
+private:
+  // inherited from BufferedFileWriter
+  virtual void DoSetBufferSize (uint32_t size);
+  virtual void DoSetAsyncFlush (bool async);
+
+  /**
+   * \param value the value to append to the buffer
+   * \param buffer the buffer
+   * \returns the buffer, after the value
+   */
+  static uint8_t *Append32 (uint32_t value, uint8_t *buffer);
+
+  std::ofstream m_file;               //!< file stream
+  FileWriteBuffer m_buffer;           //!< buffer of the records written
+  std::vector<uint32_t> m_snapLens;   //!< snap length of each interface
+  uint32_t m_snapLen;                 //!< default snap length
+};
+
+} // namespace ns3
+
+#endif /* PCAPNG_FILE_WRAPPER_H */
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RECORDING_SCHEDULER_H
+#define RECORDING_SCHEDULER_H
+
+#include "scheduler.h"
+#include "type-id.h"
+#include "ptr.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a scheduler which records the operations of another scheduler
+ *
+ * All the operations are forwarded to a scheduler of type
+ * SchedulerType, and the Insert, Remove and RemoveNext operations are
+ * written to the binary file FileName, so that the event stream of a
+ * real simulation can be replayed against every scheduler, as done by
+ * utils/bench-scheduler. For example:
+ * \code
+ *   ./waf --run "lr-wpan-tsch --SchedulerType=ns3::RecordingScheduler
+ *                --ns3::RecordingScheduler::FileName=tsch.sched"
+ * \endcode
+ *
+ * Cancelled events are still removed from the scheduler by RemoveNext,
+ * so they appear in the record as any other event.
+ *
+ * The file starts with the 8 bytes "ns3sched", followed by one record
+ * per operation: an operation byte, then the timestamp of the event
+ * relative to the last event returned by RemoveNext and, for Insert and
+ * Remove only, the uid of the event relative to the last inserted event
+ * (forward for Insert, backward for Remove) and the context of the
+ * event, each encoded as an unsigned LEB128 integer.
+ */
+class RecordingScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  /// The operations of a record.
+  enum Operation
+  {
+    INSERT = 1,
+    REMOVE = 2,
+    REMOVE_NEXT = 3
+  };
+  /// A decoded record.
+  struct Record
+  {
+    Operation op;        //!< the operation
+    EventKey key;        //!< the event key, only the timestamp for REMOVE_NEXT
+  };
+
+  RecordingScheduler ();
+  virtual ~RecordingScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+  /**
+   * Decode a file written by a RecordingScheduler.
+   *
+   * \param filename the file name
+   * \param records the decoded records, with absolute event keys
+   * \returns false if the file cannot be read or is not a record
+   */
+  static bool Read (std::string filename, std::vector<Record> &records);
+
+private:
+  /**
+   * \param type the type of the recorded scheduler
+   */
+  void SetSchedulerType (TypeId type);
+  /**
+   * \returns the type of the recorded scheduler
+   */
+  TypeId GetSchedulerType (void) const;
+  /**
+   * \param op the operation
+   * \param key the event key
+   */
+  void Write (Operation op, const EventKey &key);
+  /**
+   * \param value the integer to write, in LEB128
+   */
+  void WriteInteger (uint64_t value);
+
+  Ptr<Scheduler> m_scheduler;     //!< the recorded scheduler
+  TypeId m_schedulerType;         //!< type of m_scheduler
+  std::string m_filename;         //!< the record file name
+  std::ofstream m_file;           //!< the record file, opened on first use
+  uint64_t m_now;                 //!< timestamp of the last removed event
+  uint32_t m_lastUid;             //!< uid of the last inserted event
+};
+
+} // namespace ns3
+
+#endif /* RECORDING_SCHEDULER_H */
@@ -0,0 +1,832 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Universita' di Firenze, Italy
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Tommaso Pecorella <tommaso.pecorella@unifi.it>
+ *         Michele Muccio <michelemuccio@virgilio.it>
+ */
+
+#ifndef SIXLOWPAN_NET_DEVICE_H
+#define SIXLOWPAN_NET_DEVICE_H
+
+#include <stdint.h>
+#include <string>
+#include <map>
+#include <list>
+#include <vector>
+#include "ns3/sgi-hashmap.h"
+#include "ns3/traced-callback.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/net-device.h"
+#include "ns3/packet.h"
+#include "sixlowpan-header.h"
+#include "ns3/random-variable-stream.h"
+
+namespace ns3 {
+
+class Node;
+
+/**
+ * \defgroup sixlowpan 6LoWPAN
+ * \brief Performs 6LoWPAN compression of IPv6 packets as specified by RFC 4944 and RFC 6282
+ *
+ * This module acts as a shim between IPv6 and a generic NetDevice.
+ *
+ * The module implements RFCs 4944 and 6282, with the following exceptions:
+ * <ul>
+ * <li> MESH and LOWPAN_BC0 dispatch types are not supported </li>
+ * <li> HC2 encoding is not supported </li>
+ * <li> IPHC's DAC is not supported for multicast addresses </li>
+ *</ul>
+ */
+
+/**
+ * \ingroup sixlowpan
+ *
+ * \brief Shim performing 6LoWPAN compression, decompression and fragmentation.
+ *
+ * This class implements the shim between IPv6 and a generic NetDevice,
+ * performing packet compression, decompression and fragmentation in a transparent way.
+ * To this end, the class pretend to be a normal NetDevice, masquerading some functions
+ * of the underlying NetDevice.
+ */
+class SixLowPanNetDevice : public NetDevice
+{
+public:
+  /**
+   * Enumeration of the dropping reasons in SixLoWPAN.
+   */
+  enum DropReason
+  {
+    DROP_FRAGMENT_TIMEOUT = 1, /**< Fragment timeout exceeded */
+    DROP_FRAGMENT_BUFFER_FULL, /**< Fragment buffer size exceeded */
+    DROP_UNKNOWN_EXTENSION /**< Unsupported compression kind */
+  };
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Constructor for the SixLowPanNetDevice.
+   */
+  SixLowPanNetDevice ();
+
+  // inherited from NetDevice base class
+  virtual void SetIfIndex (const uint32_t index);
+  virtual uint32_t GetIfIndex (void) const;
+  virtual Ptr<Channel> GetChannel (void) const;
+  virtual void SetAddress (Address address);
+  virtual Address GetAddress (void) const;
+  virtual bool SetMtu (const uint16_t mtu);
+
+  /**
+   * \brief Returns the link-layer MTU for this interface.
+   * If the link-layer MTU is smaller than IPv6's minimum MTU (RFC 4944),
+   * 1280 will be returned.
+   *
+   * \return the link-level MTU in bytes for this interface.
+   */
+  virtual uint16_t GetMtu (void) const;
+  virtual bool IsLinkUp (void) const;
+  virtual void AddLinkChangeCallback (Callback<void> callback);
+  virtual bool IsBroadcast (void) const;
+  virtual Address GetBroadcast (void) const;
+  virtual bool IsMulticast (void) const;
+  virtual Address GetMulticast (Ipv4Address multicastGroup) const;
+  virtual bool IsPointToPoint (void) const;
+  virtual bool IsBridge (void) const;
+  virtual bool Send (Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber);
+  virtual bool SendFrom (Ptr<Packet> packet, const Address& source, const Address& dest, uint16_t protocolNumber);
+  virtual Ptr<Node> GetNode (void) const;
+  virtual void SetNode (Ptr<Node> node);
+  virtual bool NeedsArp (void) const;
+  virtual void SetReceiveCallback (NetDevice::ReceiveCallback cb);
+  virtual void SetPromiscReceiveCallback (NetDevice::PromiscReceiveCallback cb);
+  virtual bool SupportsSendFrom () const;
+  virtual Address GetMulticast (Ipv6Address addr) const;
+
+  /**
+   * \brief Returns a smart pointer to the underlying NetDevice.
+   *
+   * \return a smart pointer to the underlying NetDevice.
+   */
+  Ptr<NetDevice> GetNetDevice () const;
+
+  /**
+   * \brief Setup SixLowPan to be a proxy for the specified NetDevice.
+   * All the packets incoming and outgoing from the NetDevice will be
+   * processed by SixLowPanNetDevice.
+   *
+   * \param device a smart pointer to the NetDevice to be proxied.
+   */
+  void SetNetDevice (Ptr<NetDevice> device);
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model.  Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
+
+  /**
+   * \brief Get the number of datagrams successfully reassembled.
+   * \return the number of reassembled datagrams
+   */
+  uint32_t GetReassembledDatagrams (void) const;
+
+  /**
+   * \brief Get the number of fragment sets evicted because the
+   * reassembly buffer was full.
+   * \return the number of evicted fragment sets
+   */
+  uint32_t GetEvictedDatagrams (void) const;
+
+  /**
+   * \brief Get the average time elapsed between the reception of the
+   * first fragment of a datagram and its reassembly.
+   * \return the average reassembly latency
+   */
+  Time GetAverageReassemblyLatency (void) const;
+
+  /**
+   * \brief Get the number of bytes currently held in the reassembly buffer.
+   * \return the stored bytes
+   */
+  uint32_t GetReassemblyBufferSize (void) const;
+
+  /**
+   * \brief Get the number of fragments forwarded without reassembly.
+   * \return the number of forwarded fragments
+   */
+  uint32_t GetForwardedFragments (void) const;
+
+  /**
+   * \brief Add, or update, a compression context (RFC 6282).
+   *
+   * Only the first 64 bits of the context are used, i.e., contexts are
+   * expected to be IPv6 network prefixes.
+   *
+   * \param contextId context ID (0 to 15)
+   * \param contextPrefix the context prefix
+   * \param prefixLength the context prefix length (up to 64 bits)
+   * \param compressionAllowed use the context for compression (decompression is always allowed)
+   */
+  void AddContext (uint8_t contextId, Ipv6Address contextPrefix, Ipv6Prefix prefixLength, bool compressionAllowed);
+
+  /**
+   * \brief Get a compression context.
+   * \param [in] contextId context ID
+   * \param [out] contextPrefix the context prefix
+   * \param [out] prefixLength the context prefix length
+   * \param [out] compressionAllowed the context is used for compression
+   * \return true if the context exists
+   */
+  bool GetContext (uint8_t contextId, Ipv6Address &contextPrefix, Ipv6Prefix &prefixLength, bool &compressionAllowed) const;
+
+  /**
+   * \brief Remove a compression context.
+   * \param contextId context ID
+   */
+  void RemoveContext (uint8_t contextId);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  SixLowPanNetDevice (SixLowPanNetDevice const &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  SixLowPanNetDevice& operator= (SixLowPanNetDevice const &);
+  /**
+   * \brief receives all the packets from a NetDevice for further processing.
+   * \param device the NetDevice the packet ws received from
+   * \param packet the received packet
+   * \param protocol the protocol (if known)
+   * \param source the source address
+   * \param destination the destination address
+   * \param packetType the packet kind (e.g., HOST, BROADCAST, etc.)
+   * \return the IPv6 link-local address
+   */
+  void ReceiveFromDevice (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                          Address const &source, Address const &destination, PacketType packetType);
+
+
+  /**
+   * \param packet packet sent from above down to Network Device
+   * \param source source mac address (so called "MAC spoofing")
+   * \param dest mac address of the destination (already resolved)
+   * \param protocolNumber identifies the type of payload contained in
+   *        this packet. Used to call the right L3Protocol when the packet
+   *        is received.
+   * \param doSendFrom perform a SendFrom instead of a Send
+   *
+   *  Called from higher layer to send packet into Network Device
+   *  with the specified source and destination Addresses.
+   *
+   * \return whether the Send operation succeeded
+   */
+  bool DoSend (Ptr<Packet> packet, const Address& source, const Address& dest, uint16_t protocolNumber, bool doSendFrom);
+
+  /**
+   * The callback used to notify higher layers that a packet has been received.
+   */
+  NetDevice::ReceiveCallback m_rxCallback;
+
+  /**
+   * The callback used to notify higher layers that a packet has been received in promiscuous mode.
+   */
+  NetDevice::PromiscReceiveCallback m_promiscRxCallback;
+
+  /**
+   * \brief Callback to trace TX (transmission) packets.
+   *
+   * Data passed:
+   * \li Packet received (including 6LoWPAN header)
+   * \li Ptr to SixLowPanNetDevice
+   * \li interface index
+   */
+  TracedCallback<Ptr<const Packet>, Ptr<SixLowPanNetDevice>, uint32_t> m_txTrace;
+
+  /**
+   * \brief Callback to trace RX (reception) packets.
+   *
+   * Data passed:
+   * \li Packet received (including 6LoWPAN header)
+   * \li Ptr to SixLowPanNetDevice
+   * \li interface index
+   */
+  TracedCallback<Ptr<const Packet>, Ptr<SixLowPanNetDevice>, uint32_t> m_rxTrace;
+
+  /**
+   * \brief Callback to trace drop packets.
+   *
+   * Data passed:
+   * \li DropReason
+   * \li Packet dropped (including 6LoWPAN header)
+   * \li Ptr to SixLowPanNetDevice
+   * \li interface index
+   */
+  TracedCallback<DropReason, Ptr<const Packet>, Ptr<SixLowPanNetDevice>, uint32_t> m_dropTrace;
+
+  /**
+   * \brief make a link-local address from a MAC address.
+   * \param addr the MAC address
+   * \return the IPv6 link-local address
+   */
+  Ipv6Address MakeLinkLocalAddressFromMac (Address const &addr);
+
+  /**
+   * \brief make a global address from a MAC address.
+   * \param addr the MAC address
+   * \param prefix the address prefix
+   * \return the IPv6 address
+   */
+  Ipv6Address MakeGlobalAddressFromMac (Address const &addr, Ipv6Address prefix);
+
+  /**
+   * \brief Compress the headers according to HC1 compression.
+   * \param packet the packet to be compressed
+   * \param src the MAC source address
+   * \param dst the MAC destination address
+   * \return the size of the removed headers
+   */
+  uint32_t CompressLowPanHc1 (Ptr<Packet> packet, Address const &src, Address const &dst);
+
+  /**
+   * \brief Decompress the headers according to HC1 compression.
+   * \param packet the packet to be compressed
+   * \param src the MAC source address
+   * \param dst the MAC destination address
+   */
+  void DecompressLowPanHc1 (Ptr<Packet> packet, Address const &src, Address const &dst);
+
+  /**
+   * \brief Compress the headers according to IPHC compression.
+   * \param packet the packet to be compressed
+   * \param src the MAC source address
+   * \param dst the MAC destination address
+   * \return the size of the removed headers
+   */
+  uint32_t CompressLowPanIphc (Ptr<Packet> packet, Address const &src, Address const &dst);
+
+  /**
+   * \brief Set the IPHC HLIM field and the inline Hop Limit, if needed.
+   * \param iphcHeader the IPHC header
+   * \param hopLimit the IPv6 Hop Limit
+   */
+  void SetIphcHopLimit (SixLowPanIphc &iphcHeader, uint8_t hopLimit);
+
+  /**
+   * \brief Set the IPHC address fields, eliding what can be derived from the link-layer addresses.
+   * \param iphcHeader the IPHC header
+   * \param srcAddr the IPv6 source address
+   * \param dstAddr the IPv6 destination address
+   * \param src the MAC source address
+   * \param dst the MAC destination address
+   */
+  void SetIphcAddresses (SixLowPanIphc &iphcHeader, Ipv6Address srcAddr, Ipv6Address dstAddr,
+                         Address const &src, Address const &dst);
+
+  /**
+   * \class IphcCacheEntry
+   * \brief IPHC address encoding computed for a given address pair.
+   */
+  class IphcCacheEntry
+  {
+public:
+    IphcCacheEntry ()
+      : m_valid (false)
+    {
+    }
+
+    bool m_valid;            //!< The entry holds a computed encoding
+    Ipv6Address m_srcAddr;   //!< IPv6 source address
+    Ipv6Address m_dstAddr;   //!< IPv6 destination address
+    Address m_src;           //!< MAC source address
+    Address m_dst;           //!< MAC destination address
+    bool m_sac;              //!< SAC field
+    SixLowPanIphc::HeaderCompression_e m_sam; //!< SAM field
+    bool m_m;                //!< M field
+    bool m_dac;              //!< DAC field
+    SixLowPanIphc::HeaderCompression_e m_dam; //!< DAM field
+    uint8_t m_srcContextId;  //!< Source context ID
+    uint8_t m_dstContextId;  //!< Destination context ID
+  };
+
+  /**
+   * \brief Compute the IPHC address encoding of an address pair.
+   * \param encoding the computed encoding
+   * \param srcAddr the IPv6 source address
+   * \param dstAddr the IPv6 destination address
+   * \param src the MAC source address
+   * \param dst the MAC destination address
+   */
+  void ComputeIphcAddressModes (IphcCacheEntry &encoding, Ipv6Address srcAddr, Ipv6Address dstAddr,
+                                Address const &src, Address const &dst);
+
+  /**
+   * \brief Find a context usable to compress an address.
+   * \param addr the IPv6 address
+   * \param contextId the context ID found
+   * \return true if a context has been found
+   */
+  bool LookupCompressionContext (Ipv6Address addr, uint8_t &contextId);
+
+  /**
+   * \brief Build an address from a context prefix and an interface identifier.
+   * \param contextId the context ID
+   * \param iid an address holding the interface identifier in its last 64 bits
+   * \return the IPv6 address
+   */
+  Ipv6Address MakeContextAddress (uint8_t contextId, Ipv6Address iid);
+
+  /**
+   * \brief Rebuild the source address of an IPHC header.
+   * \param encoding the IPHC header
+   * \param src the MAC source address
+   * \return the IPv6 source address
+   */
+  Ipv6Address DecompressIphcSrcAddress (SixLowPanIphc const &encoding, Address const &src);
+
+  /**
+   * \brief Rebuild the destination address of an IPHC header.
+   * \param encoding the IPHC header
+   * \param dst the MAC destination address
+   * \return the IPv6 destination address
+   */
+  Ipv6Address DecompressIphcDstAddress (SixLowPanIphc const &encoding, Address const &dst);
+
+  /**
+   * \class ContextEntry
+   * \brief A RFC 6282 compression context.
+   */
+  class ContextEntry
+  {
+public:
+    Ipv6Address m_prefix;        //!< Context prefix
+    Ipv6Prefix m_prefixLength;   //!< Context prefix length
+    bool m_compressionAllowed;   //!< Context usable for compression (or only for decompression)
+  };
+
+  /**
+   * Container for context ID -> context
+   */
+  typedef std::map<uint8_t, ContextEntry> ContextTable_t;
+
+  ContextTable_t m_contextTable;            //!< Compression contexts
+  std::vector<IphcCacheEntry> m_iphcCache;  //!< Direct-mapped cache of IPHC address encodings
+  uint32_t m_iphcCacheSize;                 //!< Number of entries in the IPHC encoding cache
+
+  /**
+   * \brief Checks if the next header can be compressed using NHC.
+   * \param headerType the header kind to be compressed
+   * \return true if the header can be compressed
+   */
+  bool CanCompressLowPanNhc (uint8_t headerType);
+
+  /**
+   * \brief Decompress the headers according to IPHC compression.
+   * \param packet the packet to be compressed
+   * \param src the MAC source address
+   * \param dst the MAC destination address
+   */
+  void DecompressLowPanIphc (Ptr<Packet> packet, Address const &src, Address const &dst);
+
+  /**
+   * \brief Compress the headers according to NHC compression.
+   * \param packet the packet to be compressed
+   * \param headerType the header type
+   * \param src the MAC source address
+   * \param dst the MAC destination address
+   * \return the size of the removed headers
+   */
+  uint32_t CompressLowPanNhc (Ptr<Packet> packet, uint8_t headerType, Address const &src, Address const &dst);
+
+  /**
+   * \brief Decompress the headers according to NHC compression.
+   * \param packet the packet to be compressed
+   * \param src the MAC source address
+   * \param dst the MAC destination address
+   * \param srcAddress the IPv6 source address
+   * \param dstAddress the IPv6 destination address
+   * \return the decompressed header type
+   */
+  uint8_t DecompressLowPanNhc (Ptr<Packet> packet, Address const &src, Address const &dst, Ipv6Address srcAddress, Ipv6Address dstAddress);
+
+  /**
+   * \brief Compress the headers according to NHC compression.
+   * \param packet the packet to be compressed
+   * \param omitChecksum omit UDP checksum (if true)
+   * \return the size of the removed headers
+   */
+  uint32_t CompressLowPanUdpNhc (Ptr<Packet> packet, bool omitChecksum);
+
+  /**
+   * \brief Decompress the headers according to NHC compression.
+   * \param packet the packet to be compressed
+   * \param saddr the IPv6 source address
+   * \param daddr the IPv6 destination address
+   */
+  void DecompressLowPanUdpNhc (Ptr<Packet> packet, Ipv6Address saddr, Ipv6Address daddr);
+
+  /**
+   * \brief Fragment identifier: src/dst MAC address, datagram size and tag.
+   */
+  class FragmentKey
+  {
+public:
+    FragmentKey ();
+
+    /**
+     * \brief Constructor.
+     * \param src the source MAC address
+     * \param dst the destination MAC address
+     * \param size the datagram size
+     * \param tag the datagram tag
+     */
+    FragmentKey (Address const &src, Address const &dst, uint16_t size, uint16_t tag);
+
+    Address m_src;   //!< Source MAC address
+    Address m_dst;   //!< Destination MAC address
+    uint16_t m_size; //!< Datagram size
+    uint16_t m_tag;  //!< Datagram tag
+
+    /**
+     * \brief Equality operator.
+     * \param other the key to compare with
+     * \returns true if the keys are equal
+     */
+    bool operator == (FragmentKey const &other) const;
+  };
+
+  /**
+   * \class FragmentKeyHash
+   * \brief Hash function class for fragment keys.
+   */
+  class FragmentKeyHash : public std::unary_function<FragmentKey, size_t>
+  {
+public:
+    /**
+     * \brief Unary operator to hash a fragment key.
+     * \param key the key to hash
+     * \returns the hash of the key
+     */
+    size_t operator () (FragmentKey const &key) const;
+  };
+
+  /**
+   * Container for the fragment sets, least recently used first.
+   */
+  typedef std::list<FragmentKey> FragmentsLru_t;
+
+  /**
+   * \class Fragments
+   * \brief A Set of Fragment
+   *
+   * The fragments are kept sorted by offset in a contiguous vector, and the
+   * covered part of the datagram is tracked by a bitmap of 8-byte units
+   * (the FRAGN offset granularity), so that checking whether the datagram
+   * is complete does not require walking the fragments.
+   */
+  class Fragments : public SimpleRefCount<Fragments>
+  {
+public:
+    /**
+     * \brief Constructor.
+     */
+    Fragments ();
+
+    /**
+     * \brief Destructor.
+     */
+    ~Fragments ();
+
+    /**
+     * \brief Add a fragment to the pool.
+     * \param fragment the fragment
+     * \param fragmentOffset the offset of the fragment
+     * \return the number of bytes added to the pool (zero for duplicates)
+     */
+    uint32_t AddFragment (Ptr<Packet> fragment, uint16_t fragmentOffset);
+
+    /**
+     * \brief Add the first packet fragment. The first fragment is needed to
+     * allow the post-defragmentation decompression.
+     * \param fragment the fragment
+     * \return the number of bytes added to the pool
+     */
+    uint32_t AddFirstFragment (Ptr<Packet> fragment);
+
+    /**
+     * \brief If all fragments have been added.
+     * \returns true if the packet is entire
+     */
+    bool IsEntire () const;
+
+    /**
+     * \brief Get the entire packet.
+     * \return the entire packet
+     */
+    Ptr<Packet> GetPacket () const;
+
+    /**
+     * \brief Set the packet-to-be-defragmented size.
+     * \param packetSize the packet size (bytes)
+     */
+    void SetPacketSize (uint32_t packetSize);
+
+    /**
+     * \brief Get a list of the current stored fragments.
+     */
+    std::list< Ptr<Packet> > GetFraments () const;
+
+    /**
+     * \brief Get the number of bytes held by this fragment set.
+     * \return the stored bytes
+     */
+    uint32_t GetStoredBytes () const;
+
+    /**
+     * \brief Get the time the first fragment of the set has been received.
+     * \return the arrival time
+     */
+    Time GetArrivalTime () const;
+
+    /**
+     * \brief Set the timeout event of the fragment set.
+     * \param event the timeout event
+     */
+    void SetTimeoutEvent (EventId event);
+
+    /**
+     * \brief Get the timeout event of the fragment set.
+     * \return the timeout event
+     */
+    EventId GetTimeoutEvent () const;
+
+    /**
+     * \brief Set the position of the fragment set in the LRU list.
+     * \param iter the LRU list iterator
+     */
+    void SetLruIterator (FragmentsLru_t::iterator iter);
+
+    /**
+     * \brief Get the position of the fragment set in the LRU list.
+     * \return the LRU list iterator
+     */
+    FragmentsLru_t::iterator GetLruIterator () const;
+
+private:
+    /**
+     * \brief Mark the 8-byte units fully covered by [start, end) as received.
+     * \param start the first byte
+     * \param end one past the last byte
+     */
+    void MarkCovered (uint32_t start, uint32_t end);
+
+    /**
+     * \brief The size of the reconstructed packet (bytes).
+     */
+    uint32_t m_packetSize;
+
+    /**
+     * \brief The current fragments, sorted by offset.
+     */
+    std::vector<std::pair<uint16_t, Ptr<Packet> > > m_fragments;
+
+    /**
+     * \brief The very first fragment
+     */
+    Ptr<Packet> m_firstFragment;
+
+    std::vector<uint32_t> m_coverage; //!< Bitmap of the received 8-byte units
+    uint32_t m_coveredUnits;          //!< Number of bits set in m_coverage
+    uint32_t m_totalUnits;            //!< Number of 8-byte units in the packet
+    uint32_t m_storedBytes;           //!< Bytes held by the stored fragments
+    Time m_arrivalTime;               //!< Arrival time of the first fragment
+    EventId m_timeoutEvent;           //!< Expiration event
+    FragmentsLru_t::iterator m_lruIterator; //!< Position in the LRU list
+  };
+
+  /**
+   * \brief Return the instance type identifier.
+   * \param packet the packet to be fragmented (with headers already compressed with 6LoWPAN)
+   * \param origPacketSize the size of the IP packet before the 6LoWPAN header compression, including the IP/L4 headers
+   * \param origHdrSize the size of the IP header before the 6LoWPAN header compression
+   * \param listFragments a reference to the list of the resulting packets, all with the proper headers in place
+   */
+  void DoFragmentation (Ptr<Packet> packet, uint32_t origPacketSize, uint32_t origHdrSize,
+                        std::list<Ptr<Packet> >& listFragments);
+
+  /**
+   * \brief Process a packet fragment
+   * \param packet the packet
+   * \param src the source MAC address
+   * \param dst the destination MAC address
+   * \param isFirst true if it is the first fragment, false otherwise
+   * \return true is the fragment completed the packet
+   */
+  bool ProcessFragment (Ptr<Packet>& packet, Address const &src, Address const &dst, bool isFirst);
+
+  /**
+   * \brief Process the timeout for packet fragments
+   * \param key representing the packet fragments
+   * \param iif Input Interface
+   */
+  void HandleFragmentsTimeout ( FragmentKey key, uint32_t iif);
+
+  /**
+   * \brief Drops the least recently used fragment set
+   */
+  void DropOldestFragmentSet ();
+
+  /**
+   * \brief Remove a fragment set from the reassembly buffer.
+   * \param key the fragment set key
+   */
+  void RemoveFragmentSet (FragmentKey const &key);
+
+  /**
+   * \brief Try to forward a fragment toward the next hop without reassembling the packet.
+   *
+   * The first fragment is forwarded only if the IPv6 destination is not local, its route
+   * uses this interface and the next hop link-layer address is known. In that case
+   * a forwarding entry is created, and the following fragments are switched through it.
+   *
+   * \param packet the fragment (including the 6LoWPAN fragmentation header)
+   * \param src the source MAC address
+   * \param dst the destination MAC address
+   * \param protocol the L2 protocol number
+   * \param isFirst true if it is the first fragment, false otherwise
+   * \return true if the fragment has been forwarded
+   */
+  bool ForwardFragment (Ptr<Packet> packet, Address const &src, Address const &dst, uint16_t protocol, bool isFirst);
+
+  /**
+   * \brief Find the link-layer address of the next hop toward an IPv6 destination.
+   * \param srcAddr the IPv6 source address
+   * \param dstAddr the IPv6 destination address
+   * \param nextHop the next hop MAC address
+   * \return true if the next hop is reachable through this interface
+   */
+  bool LookupFragmentNextHop (Ipv6Address srcAddr, Ipv6Address dstAddr, Address &nextHop);
+
+  /**
+   * \brief Process the timeout for a fragment forwarding entry
+   * \param key representing the incoming packet fragments
+   */
+  void HandleForwardingTimeout (FragmentKey key);
+
+  /**
+   * \class ForwardingEntry
+   * \brief Per-hop switching state of a forwarded packet.
+   */
+  class ForwardingEntry
+  {
+public:
+    Address m_nextHop;  //!< Next hop MAC address
+    uint16_t m_tag;     //!< Outgoing datagram tag
+    EventId m_timeout;  //!< Expiration event
+  };
+
+  /**
+   * Container for incoming fragment key -> forwarding entry
+   */
+  typedef sgi::hash_map< FragmentKey, ForwardingEntry, FragmentKeyHash > MapForwarding_t;
+
+  MapForwarding_t m_forwarding; /**< Fragment forwarding entries */
+  bool m_fragmentForwarding;    /**< Forward fragments without reassembling them */
+  uint32_t m_forwardedFragments; /**< Number of fragments forwarded */
+
+  /**
+   * Container for fragment key -> fragments
+   */
+  typedef sgi::hash_map< FragmentKey, Ptr<Fragments>, FragmentKeyHash > MapFragments_t;
+  /**
+   * Container Iterator for fragment key -> fragments
+   */
+  typedef sgi::hash_map< FragmentKey, Ptr<Fragments>, FragmentKeyHash >::iterator MapFragmentsI_t;
+
+  MapFragments_t       m_fragments; /**< Fragments hold to be rebuilt */
+  FragmentsLru_t       m_fragmentsLru; /**< Fragment sets, least recently used first */
+  Time                 m_fragmentExpirationTimeout; /**< Time limit for fragment rebuilding */
+
+  /**
+   * \brief How many packets can be rebuilt at the same time.
+   * Some real implementation do limit this. Zero means no limit.
+   */
+  uint16_t             m_fragmentReassemblyListSize;
+
+  /**
+   * \brief How many bytes can be held in the reassembly buffer.
+   * Zero means no limit.
+   */
+  uint32_t             m_fragmentReassemblyMemory;
+  uint32_t             m_fragmentStoredBytes; /**< Bytes currently held in the reassembly buffer */
+
+  uint32_t m_reassembledDatagrams; /**< Number of successfully reassembled datagrams */
+  uint32_t m_evictedDatagrams;     /**< Number of fragment sets evicted because the buffer was full */
+  Time     m_reassemblyLatency;    /**< Cumulative reassembly latency */
+
+  /**
+   * \brief Callback to trace the reassembly latency of each rebuilt datagram.
+   *
+   * Data passed:
+   * \li time elapsed since the first received fragment
+   * \li Ptr to SixLowPanNetDevice
+   * \li interface index
+   */
+  TracedCallback<Time, Ptr<SixLowPanNetDevice>, uint32_t> m_reassemblyTrace;
+
+  bool m_useIphc; /**< Use IPHC or HC1 */
+
+  Ptr<Node> m_node; /**< Smart pointer to the Node */
+  Ptr<NetDevice> m_netDevice; /**< Smart pointer to the underlying NetDevice */
+  uint32_t m_ifIndex; /**< Interface index */
+
+  /**
+   * \brief Force the EtherType number.
+   * Also implying that the underlying NetDevice is using 48-bit Addresses, e.g., Ethernet, WiFi, etc.
+   */
+  bool m_forceEtherType;
+
+  uint16_t m_etherType; /**< EtherType number (used only if m_forceEtherType is true) */
+  bool m_omitUdpChecksum; /**< Omit UDP checksum in NC1 encoding */
+
+  uint32_t m_compressionThreshold; /**< Minimum L2 payload size */
+
+  Ptr<UniformRandomVariable> m_rng; //!< Rng for the fragments tag.
+};
+
+} // namespace ns3
+
+#endif /* SIXLOWPAN_NET_DEVICE_H */
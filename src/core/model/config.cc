@@ -27,6 +27,8 @@
 #include "log.h"
 
 #include <sstream>
+#include <map>
+#include <utility>
 
 namespace ns3 {
 
@@ -150,23 +152,38 @@ public:
 private:
   bool StringToUint32 (std::string str, uint32_t *value) const;
   std::string m_element;
+  bool m_any;          //!< whether the element is "*"
+  bool m_isIndex;      //!< whether the element is a single index
+  uint32_t m_index;    //!< the index, if m_isIndex
 };
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
+  : m_element (element),
+    m_any (element == "*"),
+    m_isIndex (false),
+    m_index (0)
 {
   NS_LOG_FUNCTION (this << element);
+  if (!element.empty () &&
+      element.find_first_not_of ("0123456789") == std::string::npos)
+    {
+      m_isIndex = StringToUint32 (element, &m_index);
+    }
 }
 bool
 ArrayMatcher::Matches (uint32_t i) const
 {
   NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  if (m_any)
     {
       NS_LOG_DEBUG ("Array "<<i<<" matches *");
       return true;
     }
+  if (m_isIndex)
+    {
+      return i == m_index;
+    }
   std::string::size_type tmp;
   tmp = m_element.find ("|");
   if (tmp != std::string::npos)
@@ -198,7 +215,7 @@ ArrayMatcher::Matches (uint32_t i) const
       std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
-      if (StringToUint32 (lowerBound, &min) && 
+      if (StringToUint32 (lowerBound, &min) &&
           StringToUint32 (upperBound, &max) &&
           i >= min && i <= max)
         {
@@ -233,60 +250,262 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
 }
 
 
-class Resolver
+/**
+ * A segment of a path. The segments are interned by the TokenTable, so
+ * that the work which only depends on the text of a segment is done
+ * once for all the paths, and all the calls, which contain it.
+ */
+struct PathToken
+{
+  PathToken (std::string item);
+
+  std::string name;       //!< the text of the segment
+  bool isNames;           //!< whether the segment enters the "/Names" namespace
+  bool isGetObject;       //!< whether the segment is a "$TypeId"
+  bool tidResolved;       //!< whether tid was looked up
+  TypeId tid;             //!< the TypeId of a "$TypeId" segment
+  ArrayMatcher matcher;   //!< the matcher of an array segment
+};
+
+PathToken::PathToken (std::string item)
+  : name (item),
+    isNames (item.compare (0, 5, "Names") == 0),
+    isGetObject (item.find ("$") == 0),
+    tidResolved (false),
+    matcher (item)
+{
+}
+
+/**
+ * \brief the interned segments of the paths, and the attributes they
+ *        match on each TypeId.
+ *
+ * The attributes which match a segment on an object are those of its
+ * TypeId and of its parents: they are computed once for each
+ * (TypeId, segment) pair, instead of comparing the segment with the name
+ * of every attribute of the hierarchy of each object of the path.
+ */
+class TokenTable
 {
 public:
-  Resolver (std::string path);
-  virtual ~Resolver ();
+  /// A compiled path: its interned segments.
+  typedef std::vector<PathToken *> Path;
+
+  /// An attribute which matches a segment.
+  struct Step
+  {
+    std::string name;                           //!< the name of the attribute
+    Ptr<const AttributeAccessor> accessor;      //!< its accessor
+    bool isContainer;                           //!< an object container, or a pointer
+  };
+  typedef std::vector<Step> Steps;
+
+  TokenTable ();
+  ~TokenTable ();
+
+  /**
+   * \param path a path, with or without leading and trailing '/'
+   * \returns the compiled path
+   */
+  Path Compile (std::string path);
+  /**
+   * \param token a "$TypeId" segment
+   * \returns the TypeId it names
+   */
+  TypeId GetTypeId (PathToken *token);
+  /**
+   * \param tid the TypeId of an object
+   * \param token a segment
+   * \returns the pointer and container attributes of the object
+   *          which match the segment, in the order of the hierarchy.
+   */
+  const Steps & LookupSteps (TypeId tid, const PathToken *token);
 
-  void Resolve (Ptr<Object> root);
 private:
-  void Canonicalize (void);
-  void DoResolve (std::string path, Ptr<Object> root);
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
-  void DoResolveOne (Ptr<Object> object);
-  std::string GetResolvedPath (void) const;
-  virtual void DoOne (Ptr<Object> object, std::string path) = 0;
-  std::vector<std::string> m_workStack;
-  std::string m_path;
+  PathToken * Intern (std::string item);
+
+  typedef std::map<std::string, PathToken *> Tokens;
+  Tokens m_tokens;
+  typedef std::map<std::pair<uint16_t, const PathToken *>, Steps> StepsCache;
+  StepsCache m_steps;
 };
 
-Resolver::Resolver (std::string path)
-  : m_path (path)
+TokenTable::TokenTable ()
 {
-  NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
+  NS_LOG_FUNCTION (this);
 }
-Resolver::~Resolver ()
+TokenTable::~TokenTable ()
 {
   NS_LOG_FUNCTION (this);
+  for (Tokens::iterator i = m_tokens.begin (); i != m_tokens.end (); ++i)
+    {
+      delete i->second;
+    }
+  m_tokens.clear ();
 }
-void
-Resolver::Canonicalize (void)
+
+PathToken *
+TokenTable::Intern (std::string item)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << item);
+  Tokens::iterator i = m_tokens.find (item);
+  if (i != m_tokens.end ())
+    {
+      return i->second;
+    }
+  PathToken *token = new PathToken (item);
+  m_tokens.insert (std::make_pair (item, token));
+  return token;
+}
 
-  // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
-  if (tmp != 0)
+TokenTable::Path
+TokenTable::Compile (std::string path)
+{
+  NS_LOG_FUNCTION (this << path);
+  // every segment is between two '/': the leading and trailing ones
+  // are optional.
+  Path compiled;
+  std::string::size_type start = path.find ("/") == 0 ? 1 : 0;
+  while (start < path.size ())
     {
-      // no slash at start
-      m_path = "/" + m_path;
+      std::string::size_type next = path.find ("/", start);
+      if (next == std::string::npos)
+        {
+          next = path.size ();
+        }
+      compiled.push_back (Intern (path.substr (start, next - start)));
+      start = next + 1;
     }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
+  return compiled;
+}
+
+TypeId
+TokenTable::GetTypeId (PathToken *token)
+{
+  NS_LOG_FUNCTION (this << token);
+  NS_ASSERT (token->isGetObject);
+  if (!token->tidResolved)
     {
-      // no slash at end
-      m_path = m_path + "/";
+      token->tid = TypeId::LookupByName (token->name.substr (1, token->name.size () - 1));
+      token->tidResolved = true;
     }
+  return token->tid;
 }
 
-void 
+const TokenTable::Steps &
+TokenTable::LookupSteps (TypeId tid, const PathToken *token)
+{
+  NS_LOG_FUNCTION (this << tid << token);
+  std::pair<uint16_t, const PathToken *> key = std::make_pair (tid.GetUid (), token);
+  StepsCache::const_iterator cached = m_steps.find (key);
+  if (cached != m_steps.end ())
+    {
+      return cached->second;
+    }
+
+  Steps steps;
+  TypeId tmp;
+  TypeId nextTid = tid;
+  do
+    {
+      tmp = nextTid;
+      for (uint32_t i = 0; i < tmp.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info = tmp.GetAttribute (i);
+          if (info.name != token->name && token->name != "*")
+            {
+              continue;
+            }
+          Step step;
+          if (dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              step.isContainer = false;
+            }
+          else if (dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              step.isContainer = true;
+            }
+          else
+            {
+              // this could be anything else and we don't know what to do with it.
+              // So, we just ignore it.
+              continue;
+            }
+          // the object is accessed by name: use the accessor of the
+          // attribute of this name closest to its TypeId.
+          struct TypeId::AttributeInformation closest;
+          bool found = tid.LookupAttributeByName (info.name, &closest);
+          NS_ASSERT (found);
+          if (!(closest.flags & TypeId::ATTR_GET) || !closest.accessor->HasGetter ())
+            {
+              NS_FATAL_ERROR ("Attribute name="<<info.name<<" is not gettable for this object: tid="<<tid.GetName ());
+            }
+          step.name = info.name;
+          step.accessor = closest.accessor;
+          steps.push_back (step);
+        }
+      nextTid = tmp.GetParent ();
+    } while (nextTid != tmp);
+
+  return m_steps.insert (std::make_pair (key, steps)).first->second;
+}
+
+
+/**
+ * \brief resolve a batch of paths against the object graph
+ *
+ * The paths are resolved together: at each object, the paths which
+ * continue with the same segment are grouped, so that a prefix shared
+ * by several paths is walked, and its object containers copied, only
+ * once. The matches of each path are found in the same order as if it
+ * were resolved alone.
+ */
+class Resolver
+{
+public:
+  Resolver (TokenTable *tokens, const std::vector<TokenTable::Path> &paths);
+  virtual ~Resolver ();
+
+  void Resolve (Ptr<Object> root);
+private:
+  /// The indexes of the paths being resolved together.
+  typedef std::vector<uint32_t> Cursors;
+  /// The paths grouped by their next segment.
+  typedef std::map<PathToken *, Cursors> Groups;
+
+  void Split (const Cursors &cursors, uint32_t depth, Cursors *done, Groups *groups) const;
+  void DoResolve (const Cursors &cursors, uint32_t depth, Ptr<Object> root);
+  void DoResolveToken (PathToken *token, const Cursors &cursors, uint32_t depth, Ptr<Object> root);
+  void DoArrayResolve (const Cursors &cursors, uint32_t depth, const ObjectPtrContainerValue &vector);
+  std::string GetResolvedPath (void) const;
+  virtual void DoOne (uint32_t index, Ptr<Object> object, std::string path) = 0;
+  std::vector<std::string> m_workStack;
+  TokenTable *m_tokens;
+  std::vector<TokenTable::Path> m_paths;
+  Cursors m_all;
+};
+
+Resolver::Resolver (TokenTable *tokens, const std::vector<TokenTable::Path> &paths)
+  : m_tokens (tokens),
+    m_paths (paths)
+{
+  NS_LOG_FUNCTION (this << tokens << paths.size ());
+  for (uint32_t i = 0; i < m_paths.size (); i++)
+    {
+      m_all.push_back (i);
+    }
+}
+Resolver::~Resolver ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
 Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  DoResolve (m_all, 0, root);
 }
 
 std::string
@@ -302,58 +521,75 @@ Resolver::GetResolvedPath (void) const
   return fullPath;
 }
 
-void 
-Resolver::DoResolveOne (Ptr<Object> object)
+void
+Resolver::Split (const Cursors &cursors, uint32_t depth, Cursors *done, Groups *groups) const
 {
-  NS_LOG_FUNCTION (this << object);
-
-  NS_LOG_DEBUG ("resolved="<<GetResolvedPath ());
-  DoOne (object, GetResolvedPath ());
+  NS_LOG_FUNCTION (this << &cursors << depth << done << groups);
+  for (Cursors::const_iterator i = cursors.begin (); i != cursors.end (); ++i)
+    {
+      const TokenTable::Path &path = m_paths[*i];
+      if (depth == path.size ())
+        {
+          done->push_back (*i);
+        }
+      else
+        {
+          (*groups)[path[depth]].push_back (*i);
+        }
+    }
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
-{
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-
-  if (next == std::string::npos)
-    {
-      //
-      // If root is zero, we're beginning to see if we can use the object name 
-      // service to resolve this path.  It is impossible to have a object name 
-      // associated with the root of the object name service since that root
-      // is not an object.  This path must be referring to something in another
-      // namespace and it will have been found already since the name service
-      // is always consulted last.
-      // 
-      if (root)
+Resolver::DoResolve (const Cursors &cursors, uint32_t depth, Ptr<Object> root)
+{
+  NS_LOG_FUNCTION (this << &cursors << depth << root);
+
+  Cursors done;
+  Groups groups;
+  Split (cursors, depth, &done, &groups);
+
+  //
+  // If root is zero, we're beginning to see if we can use the object name
+  // service to resolve this path.  It is impossible to have a object name
+  // associated with the root of the object name service since that root
+  // is not an object.  This path must be referring to something in another
+  // namespace and it will have been found already since the name service
+  // is always consulted last.
+  //
+  if (root && !done.empty ())
+    {
+      std::string resolved = GetResolvedPath ();
+      NS_LOG_DEBUG ("resolved="<<resolved);
+      for (Cursors::const_iterator i = done.begin (); i != done.end (); ++i)
         {
-          DoResolveOne (root);
+          DoOne (*i, root, resolved);
         }
-      return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  for (Groups::const_iterator i = groups.begin (); i != groups.end (); ++i)
+    {
+      DoResolveToken (i->first, i->second, depth, root);
+    }
+}
+
+void
+Resolver::DoResolveToken (PathToken *token, const Cursors &cursors, uint32_t depth, Ptr<Object> root)
+{
+  NS_LOG_FUNCTION (this << token->name << &cursors << depth << root);
+  const std::string &item = token->name;
 
   //
-  // If root is zero, we're beginning to see if we can use the object name 
-  // service to resolve this path.  In this case, we must see the name space 
-  // "/Names" on the front of this path.  There is no object associated with 
-  // the root of the "/Names" namespace, so we just ignore it and move on to 
+  // If root is zero, we're beginning to see if we can use the object name
+  // service to resolve this path.  In this case, we must see the name space
+  // "/Names" on the front of this path.  There is no object associated with
+  // the root of the "/Names" namespace, so we just ignore it and move on to
   // the next segment.
   //
-  if (root == 0)
+  if (root == 0 && token->isNames)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
-        {
-          m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
-          m_workStack.pop_back ();
-          return;
-        }
+      m_workStack.push_back (item);
+      DoResolve (cursors, depth + 1, root);
+      m_workStack.pop_back ();
+      return;
     }
 
   //
@@ -367,7 +603,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (cursors, depth + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -383,115 +619,85 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       return;
     }
-  std::string::size_type dollarPos = item.find ("$");
-  if (dollarPos == 0)
+  if (token->isGetObject)
     {
       // This is a call to GetObject
-      std::string tidString = item.substr (1, item.size () - 1);
-      NS_LOG_DEBUG ("GetObject="<<tidString<<" on path="<<GetResolvedPath ());
-      TypeId tid = TypeId::LookupByName (tidString);
-      Ptr<Object> object = root->GetObject<Object> (tid);
+      NS_LOG_DEBUG ("GetObject="<<item<<" on path="<<GetResolvedPath ());
+      Ptr<Object> object = root->GetObject<Object> (m_tokens->GetTypeId (token));
       if (object == 0)
         {
-          NS_LOG_DEBUG ("GetObject ("<<tidString<<") failed on path="<<GetResolvedPath ());
+          NS_LOG_DEBUG ("GetObject ("<<item<<") failed on path="<<GetResolvedPath ());
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (cursors, depth + 1, object);
       m_workStack.pop_back ();
+      return;
     }
-  else 
+
+  // this is a normal attribute.
+  const TokenTable::Steps &steps = m_tokens->LookupSteps (root->GetInstanceTypeId (), token);
+  for (TokenTable::Steps::const_iterator i = steps.begin (); i != steps.end (); ++i)
     {
-      // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
-      bool foundMatch = false;
-      
-      do
+      if (!i->isContainer)
         {
-          tid = nextTid;
-          
-          for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+          NS_LOG_DEBUG ("GetAttribute(ptr)="<<i->name<<" on path="<<GetResolvedPath ());
+          PointerValue ptr;
+          bool ok = i->accessor->Get (PeekPointer (root), ptr);
+          NS_ASSERT (ok);
+          Ptr<Object> object = ptr.Get<Object> ();
+          if (object == 0)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute(i);
-              if (info.name != item && item != "*")
-                {
-                  continue;
-                }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *ptr = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (ptr != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)="<<info.name<<" on path="<<GetResolvedPath ());
-                  PointerValue ptr;
-                  root->GetAttribute (info.name, ptr);
-                  Ptr<Object> object = ptr.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\""<<item<<
-                                    "\" exists on path=\""<<GetResolvedPath ()<<"\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
-                }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker = 
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(vector)="<<info.name<<" on path="<<GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
-                }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              NS_LOG_ERROR ("Requested object name=\""<<item<<
+                            "\" exists on path=\""<<GetResolvedPath ()<<"\""
+                            " but is null.");
+              continue;
             }
-
-          nextTid = tid.GetParent ();
-        } while (nextTid != tid);
-      
-      if (!foundMatch)
+          m_workStack.push_back (i->name);
+          DoResolve (cursors, depth + 1, object);
+          m_workStack.pop_back ();
+        }
+      else
         {
-          NS_LOG_DEBUG ("Requested item="<<item<<" does not exist on path="<<GetResolvedPath ());
-          return;
+          NS_LOG_DEBUG ("GetAttribute(vector)="<<i->name<<" on path="<<GetResolvedPath ());
+          ObjectPtrContainerValue vector;
+          bool ok = i->accessor->Get (PeekPointer (root), vector);
+          NS_ASSERT (ok);
+          m_workStack.push_back (i->name);
+          DoArrayResolve (cursors, depth + 1, vector);
+          m_workStack.pop_back ();
         }
     }
+  if (steps.empty ())
+    {
+      NS_LOG_DEBUG ("Requested item="<<item<<" does not exist on path="<<GetResolvedPath ());
+    }
 }
 
-void 
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+void
+Resolver::DoArrayResolve (const Cursors &cursors, uint32_t depth, const ObjectPtrContainerValue &container)
 {
-  NS_LOG_FUNCTION(this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
-    {
-      return;
-    }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  NS_LOG_FUNCTION (this << &cursors << depth << &container);
+
+  // the paths which end with the container match nothing.
+  Cursors done;
+  Groups groups;
+  Split (cursors, depth, &done, &groups);
 
-  ArrayMatcher matcher = ArrayMatcher (item);
-  ObjectPtrContainerValue::Iterator it;
-  for (it = container.Begin (); it != container.End (); ++it)
+  for (Groups::const_iterator i = groups.begin (); i != groups.end (); ++i)
     {
-      if (matcher.Matches ((*it).first))
+      const ArrayMatcher &matcher = i->first->matcher;
+      ObjectPtrContainerValue::Iterator it;
+      for (it = container.Begin (); it != container.End (); ++it)
         {
-          std::ostringstream oss;
-          oss << (*it).first;
-          m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
-          m_workStack.pop_back ();
+          if (matcher.Matches ((*it).first))
+            {
+              std::ostringstream oss;
+              oss << (*it).first;
+              m_workStack.push_back (oss.str ());
+              DoResolve (i->second, depth + 1, (*it).second);
+              m_workStack.pop_back ();
+            }
         }
     }
 }
@@ -506,6 +712,7 @@ public:
   void DisconnectWithoutContext (std::string path, const CallbackBase &cb);
   void Disconnect (std::string path, const CallbackBase &cb);
   Config::MatchContainer LookupMatches (std::string path);
+  std::vector<Config::MatchContainer> LookupMatches (const std::vector<std::string> &paths);
 
   void RegisterRootNamespaceObject (Ptr<Object> obj);
   void UnregisterRootNamespaceObject (Ptr<Object> obj);
@@ -517,6 +724,7 @@ private:
   void ParsePath (std::string path, std::string *root, std::string *leaf) const;
   typedef std::vector<Ptr<Object> > Roots;
   Roots m_roots;
+  TokenTable m_tokens;
 };
 
 void 
@@ -584,19 +792,35 @@ Config::MatchContainer
 ConfigImpl::LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
+  return LookupMatches (std::vector<std::string> (1, path))[0];
+}
+
+std::vector<Config::MatchContainer>
+ConfigImpl::LookupMatches (const std::vector<std::string> &paths)
+{
+  NS_LOG_FUNCTION (this << paths.size ());
   class LookupMatchesResolver : public Resolver 
   {
   public:
-    LookupMatchesResolver (std::string path)
-      : Resolver (path)
+    LookupMatchesResolver (TokenTable *tokens, const std::vector<TokenTable::Path> &paths)
+      : Resolver (tokens, paths),
+        m_objects (paths.size ()),
+        m_contexts (paths.size ())
     {}
-    virtual void DoOne (Ptr<Object> object, std::string path) {
-      m_objects.push_back (object);
-      m_contexts.push_back (path);
+    virtual void DoOne (uint32_t index, Ptr<Object> object, std::string path) {
+      m_objects[index].push_back (object);
+      m_contexts[index].push_back (path);
+    }
+    std::vector<std::vector<Ptr<Object> > > m_objects;
+    std::vector<std::vector<std::string> > m_contexts;
+  };
+
+  std::vector<TokenTable::Path> compiled;
+  for (std::vector<std::string>::const_iterator i = paths.begin (); i != paths.end (); ++i)
+    {
+      compiled.push_back (m_tokens.Compile (*i));
     }
-    std::vector<Ptr<Object> > m_objects;
-    std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+  LookupMatchesResolver resolver (&m_tokens, compiled);
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -609,7 +833,12 @@ ConfigImpl::LookupMatches (std::string path)
   //
   resolver.Resolve (0);
 
-  return Config::MatchContainer (resolver.m_objects, resolver.m_contexts, path);
+  std::vector<Config::MatchContainer> containers;
+  for (uint32_t i = 0; i < paths.size (); i++)
+    {
+      containers.push_back (Config::MatchContainer (resolver.m_objects[i], resolver.m_contexts[i], paths[i]));
+    }
+  return containers;
 }
 
 void 
@@ -751,6 +980,11 @@ Config::MatchContainer LookupMatches (std::string path)
   NS_LOG_FUNCTION (path);
   return Singleton<ConfigImpl>::Get ()->LookupMatches (path);
 }
+std::vector<Config::MatchContainer> LookupMatches (const std::vector<std::string> &paths)
+{
+  NS_LOG_FUNCTION (paths.size ());
+  return Singleton<ConfigImpl>::Get ()->LookupMatches (paths);
+}
 
 void RegisterRootNamespaceObject (Ptr<Object> obj)
 {
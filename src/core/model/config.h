@@ -221,6 +221,18 @@ private:
  *          path.
  */
 MatchContainer LookupMatches (std::string path);
+/**
+ * \param paths the paths to perform a match against
+ * \returns a container for each input path, with the objects which
+ *          match it.
+ *
+ * The paths are resolved together, walking the object graph once:
+ * the segments shared by several paths, such as the node and device
+ * lists, are resolved only once. To connect many trace sources of the
+ * same objects, look up their parent paths with this function and use
+ * MatchContainer::Connect on the results.
+ */
+std::vector<MatchContainer> LookupMatches (const std::vector<std::string> &paths);
 
 /**
  * \param obj a new root object
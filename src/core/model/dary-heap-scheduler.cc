@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "dary-heap-scheduler.h"
+#include "event-impl.h"
+#include "uinteger.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+
+namespace ns3 {
+
+// Note:  Logging in this file is limited to the public methods, as
+// the heap operations are invoked for every event.
+NS_LOG_COMPONENT_DEFINE ("DaryHeapScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (DaryHeapScheduler);
+
+TypeId
+DaryHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::DaryHeapScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<DaryHeapScheduler> ()
+    .AddAttribute ("Arity",
+                   "The number of children of each node of the heap.",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&DaryHeapScheduler::SetArity,
+                                         &DaryHeapScheduler::GetArity),
+                   MakeUintegerChecker<uint32_t> (2, 16))
+  ;
+  return tid;
+}
+
+DaryHeapScheduler::DaryHeapScheduler ()
+  : m_arity (4)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+DaryHeapScheduler::~DaryHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+DaryHeapScheduler::SetArity (uint32_t arity)
+{
+  NS_LOG_FUNCTION (this << arity);
+  NS_ASSERT_MSG (m_heap.empty (), "The arity cannot be changed while events are scheduled");
+  m_arity = arity;
+}
+
+uint32_t
+DaryHeapScheduler::GetArity (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_arity;
+}
+
+void
+DaryHeapScheduler::SiftUp (uint32_t index)
+{
+  Event ev = m_heap[index];
+  while (index > 0)
+    {
+      uint32_t parent = (index - 1) / m_arity;
+      if (!(ev.key < m_heap[parent].key))
+        {
+          break;
+        }
+      m_heap[index] = m_heap[parent];
+      index = parent;
+    }
+  m_heap[index] = ev;
+}
+
+void
+DaryHeapScheduler::SiftDown (uint32_t index)
+{
+  uint32_t size = m_heap.size ();
+  Event ev = m_heap[index];
+  while (true)
+    {
+      uint32_t first = index * m_arity + 1;
+      if (first >= size)
+        {
+          break;
+        }
+      uint32_t last = std::min (first + m_arity, size);
+      uint32_t smallest = first;
+      for (uint32_t child = first + 1; child < last; child++)
+        {
+          if (m_heap[child].key < m_heap[smallest].key)
+            {
+              smallest = child;
+            }
+        }
+      if (!(m_heap[smallest].key < ev.key))
+        {
+          break;
+        }
+      m_heap[index] = m_heap[smallest];
+      index = smallest;
+    }
+  m_heap[index] = ev;
+}
+
+void
+DaryHeapScheduler::PopRoot (void)
+{
+  m_heap[0] = m_heap.back ();
+  m_heap.pop_back ();
+  if (!m_heap.empty ())
+    {
+      SiftDown (0);
+    }
+}
+
+bool
+DaryHeapScheduler::EraseRemoved (uint32_t uid)
+{
+  RemovedUids::iterator it = std::lower_bound (m_removed.begin (), m_removed.end (), uid);
+  if (it == m_removed.end () || *it != uid)
+    {
+      return false;
+    }
+  m_removed.erase (it);
+  return true;
+}
+
+void
+DaryHeapScheduler::SkipRemoved (void)
+{
+  while (!m_removed.empty () && !m_heap.empty ())
+    {
+      if (!EraseRemoved (m_heap[0].key.m_uid))
+        {
+          return;
+        }
+      PopRoot ();
+    }
+}
+
+void
+DaryHeapScheduler::Compact (void)
+{
+  NS_LOG_FUNCTION (this << m_heap.size () << m_removed.size ());
+  uint32_t live = 0;
+  for (uint32_t i = 0; i < m_heap.size (); i++)
+    {
+      if (std::binary_search (m_removed.begin (), m_removed.end (), m_heap[i].key.m_uid))
+        {
+          continue;
+        }
+      m_heap[live++] = m_heap[i];
+    }
+  NS_ASSERT (m_heap.size () - live == m_removed.size ());
+  m_removed.clear ();
+  m_heap.resize (live);
+  if (live > 1)
+    {
+      for (uint32_t i = (live - 2) / m_arity + 1; i > 0; i--)
+        {
+          SiftDown (i - 1);
+        }
+    }
+}
+
+void
+DaryHeapScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  m_heap.push_back (ev);
+  SiftUp (m_heap.size () - 1);
+}
+
+bool
+DaryHeapScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_heap.empty ();
+}
+
+Scheduler::Event
+DaryHeapScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_heap.empty ());
+  return m_heap[0];
+}
+
+Scheduler::Event
+DaryHeapScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_heap.empty ());
+  Event next = m_heap[0];
+  PopRoot ();
+  SkipRemoved ();
+  return next;
+}
+
+void
+DaryHeapScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!m_heap.empty ());
+  if (m_heap[0].key.m_uid == ev.key.m_uid)
+    {
+      NS_ASSERT (m_heap[0].impl == ev.impl);
+      PopRoot ();
+      SkipRemoved ();
+      return;
+    }
+  // the events removed are usually the latest scheduled ones, whose
+  // uids are the largest.
+  m_removed.insert (std::upper_bound (m_removed.begin (), m_removed.end (), ev.key.m_uid),
+                    ev.key.m_uid);
+  if (m_removed.size () * 2 > m_heap.size ())
+    {
+      Compact ();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DARY_HEAP_SCHEDULER_H
+#define DARY_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a d-ary heap event scheduler
+ *
+ * The events, including their keys, are stored by value in a single
+ * contiguous array, the root being at index 0 and the children of the
+ * node at index i being at indexes d*i+1 to d*i+d. With the default
+ * arity of 4 the children of a node are adjacent in memory, and the
+ * heap is half as deep as a binary heap, which reduces the number of
+ * cache misses of RemoveNext.
+ *
+ * Removed events are not searched for: their uid is recorded, in a
+ * sorted array rather than a tree, and they are discarded when they
+ * reach the root. The heap is compacted when
+ * more than half of its entries are removed events. The root of the
+ * heap is never a removed event.
+ */
+class DaryHeapScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  DaryHeapScheduler ();
+  virtual ~DaryHeapScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+private:
+  typedef std::vector<Event> Heap;
+  typedef std::vector<uint32_t> RemovedUids;
+
+  /**
+   * \param arity the number of children of each node of the heap
+   *
+   * Can be changed only while the scheduler is empty.
+   */
+  void SetArity (uint32_t arity);
+  /**
+   * \returns the number of children of each node of the heap
+   */
+  uint32_t GetArity (void) const;
+
+  /**
+   * Move the entry at the given index up to its position.
+   * \param index the entry index
+   */
+  void SiftUp (uint32_t index);
+  /**
+   * Move the entry at the given index down to its position.
+   * \param index the entry index
+   */
+  void SiftDown (uint32_t index);
+  /// Remove the root of the heap
+  void PopRoot (void);
+  /**
+   * Forget the given uid if it is one of a removed event.
+   * \param uid the event uid
+   * \returns true if the event was removed
+   */
+  bool EraseRemoved (uint32_t uid);
+  /// Pop the removed events from the root of the heap
+  void SkipRemoved (void);
+  /// Drop all the removed events and rebuild the heap
+  void Compact (void);
+
+  Heap m_heap;
+  RemovedUids m_removed; //!< sorted uids of the removed events
+  uint32_t m_arity;
+};
+
+} // namespace ns3
+
+#endif /* DARY_HEAP_SCHEDULER_H */
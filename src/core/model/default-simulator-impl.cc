@@ -25,6 +25,7 @@
 
 #include "ptr.h"
 #include "pointer.h"
+#include "uinteger.h"
 #include "assert.h"
 #include "log.h"
 
@@ -46,6 +47,26 @@ DefaultSimulatorImpl::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::DefaultSimulatorImpl")
     .SetParent<SimulatorImpl> ()
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("EventAllocations",
+                   "The number of events allocated by the simulation thread.",
+                   TypeId::ATTR_GET,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&DefaultSimulatorImpl::GetEventAllocations),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("PooledEventAllocations",
+                   "The number of event allocations of the simulation thread "
+                   "served by the event free lists.",
+                   TypeId::ATTR_GET,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&DefaultSimulatorImpl::GetPooledEventAllocations),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("PooledEventBlocks",
+                   "The number of blocks held by the event free lists "
+                   "of the simulation thread.",
+                   TypeId::ATTR_GET,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&DefaultSimulatorImpl::GetPooledEventBlocks),
+                   MakeUintegerChecker<uint64_t> ())
   ;
   return tid;
 }
@@ -64,7 +85,6 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
-  m_eventsWithContextEmpty = true;
   m_main = SystemThread::Self();
 }
 
@@ -83,8 +103,38 @@ DefaultSimulatorImpl::DoDispose (void)
       next.impl->Unref ();
     }
   m_events = 0;
+  for (EventWithContext *ev = m_eventsWithContext.PopAll (); ev != 0; )
+    {
+      EventWithContext *next = ev->next;
+      ev->event->Unref ();
+      delete ev;
+      ev = next;
+    }
+  // events still referenced by an EventId go back to a new free list
+  EventImpl::ReleasePool ();
   SimulatorImpl::DoDispose ();
 }
+uint64_t
+DefaultSimulatorImpl::GetEventAllocations (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return EventImpl::GetPoolStatistics ().allocations;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetPooledEventAllocations (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return EventImpl::GetPoolStatistics ().pooledAllocations;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetPooledEventBlocks (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return EventImpl::GetPoolStatistics ().freeBlocks;
+}
+
 void
 DefaultSimulatorImpl::Destroy ()
 {
@@ -152,30 +202,21 @@ DefaultSimulatorImpl::IsFinished (void) const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext (void)
 {
-  if (m_eventsWithContextEmpty)
-    {
-      return;
-    }
-
-  // swap queues
-  EventsWithContext eventsWithContext;
-  {
-    CriticalSection cs (m_eventsWithContextMutex);
-    m_eventsWithContext.swap(eventsWithContext);
-    m_eventsWithContextEmpty = true;
-  }
-  while (!eventsWithContext.empty ())
+  // take all the pending events at once, in the order they were scheduled
+  EventWithContext *event = m_eventsWithContext.PopAll ();
+  while (event != 0)
     {
-       EventWithContext event = eventsWithContext.front ();
-       eventsWithContext.pop_front ();
-       Scheduler::Event ev;
-       ev.impl = event.event;
-       ev.key.m_ts = m_currentTs + event.timestamp;
-       ev.key.m_context = event.context;
-       ev.key.m_uid = m_uid;
-       m_uid++;
-       m_unscheduledEvents++;
-       m_events->Insert (ev);
+      Scheduler::Event ev;
+      ev.impl = event->event;
+      ev.key.m_ts = m_currentTs + event->timestamp;
+      ev.key.m_context = event->context;
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_unscheduledEvents++;
+      m_events->Insert (ev);
+      EventWithContext *next = event->next;
+      delete event;
+      event = next;
     }
 }
 
@@ -255,15 +296,11 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time, E
     }
   else
     {
-      EventWithContext ev;
-      ev.context = context;
-      ev.timestamp = time.GetTimeStep ();
-      ev.event = event;
-      {
-        CriticalSection cs (m_eventsWithContextMutex);
-        m_eventsWithContext.push_back(ev);
-        m_eventsWithContextEmpty = false;
-      }
+      EventWithContext *ev = new EventWithContext;
+      ev->context = context;
+      ev->timestamp = time.GetTimeStep ();
+      ev->event = event;
+      m_eventsWithContext.Push (ev);
     }
 }
 
@@ -25,7 +25,7 @@
 #include "scheduler.h"
 #include "event-impl.h"
 #include "system-thread.h"
-#include "ns3/system-mutex.h"
+#include "mpsc-queue.h"
 
 #include "ptr.h"
 
@@ -63,20 +63,35 @@ public:
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
 
+  /**
+   * \returns the number of events allocated by the simulation thread.
+   */
+  uint64_t GetEventAllocations (void) const;
+  /**
+   * \returns the number of event allocations of the simulation thread
+   * served by the EventImpl free lists.
+   */
+  uint64_t GetPooledEventAllocations (void) const;
+  /**
+   * \returns the number of blocks held by the EventImpl free lists of the
+   * simulation thread.
+   */
+  uint64_t GetPooledEventBlocks (void) const;
+
 private:
   virtual void DoDispose (void);
   void ProcessOneEvent (void);
   void ProcessEventsWithContext (void);
  
+  /// An event scheduled by another thread than the simulation thread.
   struct EventWithContext {
-    uint32_t context;
-    uint64_t timestamp;
-    EventImpl *event;
+    EventWithContext *next;   //!< the next event of the queue
+    uint32_t context;         //!< the context of the event
+    uint64_t timestamp;       //!< the delay of the event
+    EventImpl *event;         //!< the event
   };
-  typedef std::list<struct EventWithContext> EventsWithContext;
-  EventsWithContext m_eventsWithContext;
-  bool m_eventsWithContextEmpty;
-  SystemMutex m_eventsWithContextMutex;
+  /// Events scheduled by other threads, inserted by the simulation thread.
+  MpscQueue<EventWithContext> m_eventsWithContext;
 
   typedef std::list<EventId> DestroyEvents;
   DestroyEvents m_destroyEvents;
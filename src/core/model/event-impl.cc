@@ -21,10 +21,123 @@
 #include "event-impl.h"
 #include "log.h"
 
+#include <new>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+namespace {
+
+/// Granularity of the size classes, in bytes
+const std::size_t EVENT_POOL_GRANULARITY = 16;
+/// Number of size classes; larger events are allocated from the heap
+const uint32_t EVENT_POOL_CLASSES = 16;
+/// Maximum number of blocks kept in each free list
+const uint32_t EVENT_POOL_MAX_FREE = 8192;
+
+struct EventPoolBlock
+{
+  EventPoolBlock *next;
+};
+
+/// Per-thread event pool. Must be a POD to be thread-local.
+struct EventPool
+{
+  EventPoolBlock *free[EVENT_POOL_CLASSES];
+  uint32_t length[EVENT_POOL_CLASSES];
+  uint64_t allocations;
+  uint64_t pooledAllocations;
+};
+
+/*
+ * Events are scheduled from the simulation thread, and from other threads
+ * with the realtime and distributed implementations, hence each thread
+ * has its own free lists and no locking is needed.
+ */
+__thread EventPool g_eventPool;
+
+inline uint32_t
+EventPoolClass (std::size_t size)
+{
+  return (size - 1) / EVENT_POOL_GRANULARITY;
+}
+
+} // anonymous namespace
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  EventPool &pool = g_eventPool;
+  pool.allocations++;
+  uint32_t sizeClass = EventPoolClass (size);
+  if (sizeClass >= EVENT_POOL_CLASSES)
+    {
+      return ::operator new (size);
+    }
+  EventPoolBlock *block = pool.free[sizeClass];
+  if (block != 0)
+    {
+      pool.free[sizeClass] = block->next;
+      pool.length[sizeClass]--;
+      pool.pooledAllocations++;
+      return block;
+    }
+  return ::operator new ((sizeClass + 1) * EVENT_POOL_GRANULARITY);
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  EventPool &pool = g_eventPool;
+  uint32_t sizeClass = EventPoolClass (size);
+  if (sizeClass >= EVENT_POOL_CLASSES
+      || pool.length[sizeClass] >= EVENT_POOL_MAX_FREE)
+    {
+      ::operator delete (p);
+      return;
+    }
+  EventPoolBlock *block = static_cast<EventPoolBlock *> (p);
+  block->next = pool.free[sizeClass];
+  pool.free[sizeClass] = block;
+  pool.length[sizeClass]++;
+}
+
+struct EventImpl::PoolStatistics
+EventImpl::GetPoolStatistics (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  EventPool &pool = g_eventPool;
+  struct PoolStatistics stats;
+  stats.allocations = pool.allocations;
+  stats.pooledAllocations = pool.pooledAllocations;
+  stats.freeBlocks = 0;
+  for (uint32_t i = 0; i < EVENT_POOL_CLASSES; i++)
+    {
+      stats.freeBlocks += pool.length[i];
+    }
+  return stats;
+}
+
+void
+EventImpl::ReleasePool (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  EventPool &pool = g_eventPool;
+  for (uint32_t i = 0; i < EVENT_POOL_CLASSES; i++)
+    {
+      while (pool.free[i] != 0)
+        {
+          EventPoolBlock *block = pool.free[i];
+          pool.free[i] = block->next;
+          ::operator delete (block);
+        }
+      pool.length[i] = 0;
+    }
+  pool.allocations = 0;
+  pool.pooledAllocations = 0;
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
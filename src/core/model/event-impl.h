@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 namespace ns3 {
@@ -35,6 +36,13 @@ namespace ns3 {
  * obviously (there are Ref and Unref methods) reference-counted and
  * most subclasses are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The memory of the events is managed by per-thread free lists, one for
+ * each size class (multiple of 16 bytes, up to 256 bytes). An event
+ * released by the simulation engine is kept in the free list of the
+ * releasing thread and reused by the next event of the same size class
+ * created by that thread, so that scheduling an event does not usually
+ * require a heap allocation.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -58,6 +66,37 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * \brief Event allocation statistics of the calling thread.
+   */
+  struct PoolStatistics
+  {
+    uint64_t allocations;       //!< number of events allocated
+    uint64_t pooledAllocations; //!< number of allocations served by the free lists
+    uint64_t freeBlocks;        //!< number of blocks held in the free lists
+  };
+
+  /**
+   * \returns the event allocation statistics of the calling thread.
+   */
+  static struct PoolStatistics GetPoolStatistics (void);
+  /**
+   * Give the blocks held in the free lists of the calling thread back to
+   * the heap, and reset its statistics.
+   */
+  static void ReleasePool (void);
+
+  /**
+   * \param size the size of the event
+   * \returns a block from the free list of the size class, if any
+   */
+  static void *operator new (std::size_t size);
+  /**
+   * \param p the event memory
+   * \param size the size of the event, which selects its size class
+   */
+  static void operator delete (void *p, std::size_t size);
+
 protected:
   virtual void Notify (void) = 0;
 
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ * \brief a lock-free multiple producer, single consumer intrusive queue
+ *
+ * Any thread can Push an item, and a single consumer thread takes all
+ * the pushed items at once with PopAll, in the order they were pushed.
+ * The items are linked through their \c next member, of type T*: the
+ * queue never allocates memory, and it does not own its items.
+ *
+ * Push is a single compare-and-swap on the head of the queue, and PopAll
+ * a single exchange, so that the consumer drains the items in batches
+ * without ever blocking the producers. As a single consumer only ever
+ * removes the whole queue, the ABA problem of lock-free stacks does not
+ * occur.
+ */
+template <typename T>
+class MpscQueue
+{
+public:
+  MpscQueue ()
+    : m_head (0)
+  {}
+
+  /**
+   * Push an item, from any thread.
+   * \param item the item, which must not be in a queue
+   * \returns true if the queue was empty
+   */
+  bool Push (T *item)
+  {
+    T *head;
+    do
+      {
+        head = m_head;
+        item->next = head;
+      }
+    while (!__sync_bool_compare_and_swap (&m_head, head, item));
+    return head == 0;
+  }
+
+  /**
+   * \returns true if no item is pushed. When called by another thread
+   * than the producers, the result may be immediately outdated.
+   */
+  bool IsEmpty (void) const
+  {
+    return m_head == 0;
+  }
+
+  /**
+   * Take all the pushed items. This method must only be called by the
+   * consumer thread.
+   * \returns the first pushed item, linked to the next ones, or zero
+   */
+  T * PopAll (void)
+  {
+    if (m_head == 0)
+      {
+        return 0;
+      }
+    // an acquire barrier, paired with the full barrier of Push
+    T *items = __sync_lock_test_and_set (&m_head, (T *) 0);
+    // the items were pushed on a stack: reverse them
+    T *fifo = 0;
+    while (items != 0)
+      {
+        T *next = items->next;
+        items->next = fifo;
+        fifo = items;
+        items = next;
+      }
+    return fifo;
+  }
+
+private:
+  MpscQueue (const MpscQueue &);
+  MpscQueue & operator = (const MpscQueue &);
+
+  T * volatile m_head;  //!< the last pushed item
+};
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
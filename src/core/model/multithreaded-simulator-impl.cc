@@ -0,0 +1,686 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+#include "simulator.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "uinteger.h"
+#include "assert.h"
+#include "fatal-error.h"
+#include "log.h"
+
+#include <algorithm>
+#include <sched.h>
+#include <unistd.h>
+
+namespace ns3 {
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+namespace {
+
+/// The partition run by the calling thread, plus one; zero for other threads.
+__thread uint32_t g_partition = 0;
+
+/// A timestamp later than any event.
+const uint64_t g_never = ~(uint64_t) 0;
+
+} // anonymous namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("Threads",
+                   "The number of partitions, each run by its own thread. "
+                   "Zero means one partition per processor.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_threads),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Lookahead",
+                   "The smallest delay of an event scheduled for another partition, "
+                   "such as the minimum propagation delay of the channels.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&MultithreadedSimulatorImpl::m_lookahead),
+                   MakeTimeChecker ())
+    .AddAttribute ("Windows",
+                   "The number of time windows of the last run.",
+                   TypeId::ATTR_GET,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::GetWindows),
+                   MakeUintegerChecker<uint64_t> ())
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_threads (0),
+    m_running (false),
+    m_stop (false),
+    m_stopTs (g_never),
+    m_done (false),
+    m_windowEnd (0),
+    m_windows (0),
+    m_endTs (0),
+    m_barrierCount (0),
+    m_barrierGeneration (0),
+    m_nextWorker (0)
+{
+  NS_LOG_FUNCTION (this);
+  m_main = SystemThread::Self ();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t i = 0; i < m_partitions.size (); i++)
+    {
+      Partition *partition = m_partitions[i];
+      InboxEvent *inbox = partition->inbox.PopAll ();
+      while (inbox != 0)
+        {
+          InboxEvent *next = inbox->next;
+          inbox->event->Unref ();
+          delete inbox;
+          inbox = next;
+        }
+      while (!partition->events->IsEmpty ())
+        {
+          Scheduler::Event next = partition->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      delete partition;
+    }
+  m_partitions.clear ();
+  EventImpl::ReleasePool ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (true)
+    {
+      Ptr<EventImpl> ev;
+      {
+        CriticalSection cs (m_destroyEventsMutex);
+        if (m_destroyEvents.empty ())
+          {
+            break;
+          }
+        ev = m_destroyEvents.front ().PeekEventImpl ();
+        m_destroyEvents.pop_front ();
+      }
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::CreatePartitions (void)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t n = m_threads;
+  if (n == 0)
+    {
+      long processors = sysconf (_SC_NPROCESSORS_ONLN);
+      n = processors > 0 ? processors : 1;
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Partition *partition = new Partition ();
+      partition->events = m_schedulerFactory.Create<Scheduler> ();
+      partition->currentTs = 0;
+      // before ::Run is entered, the currentUid will be zero
+      partition->currentUid = 0;
+      partition->currentContext = 0xffffffff;
+      // uids are allocated from 4, and interleaved between the partitions.
+      // uid 0 is "invalid" events
+      // uid 1 is "now" events
+      // uid 2 is "destroy" events
+      partition->uid = 4 + i;
+      partition->next = g_never;
+      m_partitions.push_back (partition);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  NS_ASSERT_MSG (!m_running, "The scheduler cannot be changed while running");
+  m_schedulerFactory = schedulerFactory;
+  if (m_partitions.empty ())
+    {
+      CreatePartitions ();
+      return;
+    }
+  for (uint32_t i = 0; i < m_partitions.size (); i++)
+    {
+      Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+      Ptr<Scheduler> events = m_partitions[i]->events;
+      while (!events->IsEmpty ())
+        {
+          scheduler->Insert (events->RemoveNext ());
+        }
+      m_partitions[i]->events = scheduler;
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionIndex (uint32_t context) const
+{
+  if (context == 0xffffffff)
+    {
+      return 0;
+    }
+  return context % m_partitions.size ();
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetCurrentPartition (void) const
+{
+  if (g_partition != 0)
+    {
+      return m_partitions[g_partition - 1];
+    }
+  if (!m_running && SystemThread::Equals (m_main))
+    {
+      return m_partitions[0];
+    }
+  return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::AllocateUid (Partition *partition)
+{
+  uint32_t uid = partition->uid;
+  partition->uid += m_partitions.size ();
+  return uid;
+}
+
+void
+MultithreadedSimulatorImpl::DrainInbox (Partition *partition)
+{
+  InboxEvent *events = partition->inbox.PopAll ();
+  while (events != 0)
+    {
+      InboxEvent *next = events->next;
+      Scheduler::Event ev;
+      ev.impl = events->event;
+      ev.key.m_context = events->context;
+      if (events->relative)
+        {
+          ev.key.m_ts = partition->currentTs + events->ts;
+          ev.key.m_uid = AllocateUid (partition);
+        }
+      else
+        {
+          ev.key.m_ts = events->ts;
+          ev.key.m_uid = events->uid;
+        }
+      partition->events->Insert (ev);
+      delete events;
+      events = next;
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  for (uint32_t i = 0; i < m_partitions.size (); i++)
+    {
+      if (!m_partitions[i]->events->IsEmpty () || !m_partitions[i]->inbox.IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::Barrier (bool last)
+{
+  uint32_t generation = m_barrierGeneration;
+  if (__sync_add_and_fetch (&m_barrierCount, 1) == m_partitions.size ())
+    {
+      if (last)
+        {
+          NextWindow ();
+        }
+      m_barrierCount = 0;
+      __sync_add_and_fetch (&m_barrierGeneration, 1);
+      return;
+    }
+  while (m_barrierGeneration == generation)
+    {
+      sched_yield ();
+    }
+  __sync_synchronize ();
+}
+
+void
+MultithreadedSimulatorImpl::NextWindow (void)
+{
+  uint64_t next = g_never;
+  for (uint32_t i = 0; i < m_partitions.size (); i++)
+    {
+      next = std::min (next, m_partitions[i]->next);
+    }
+  if (m_stopTs != g_never && (next == g_never || next > m_stopTs))
+    {
+      // as with a stop event, the time advances to the stop time
+      m_endTs = m_stopTs;
+      m_stopTs = g_never;
+      m_done = true;
+      return;
+    }
+  if (m_stop || next == g_never)
+    {
+      m_done = true;
+      return;
+    }
+  m_windows++;
+  uint64_t lookahead = m_lookahead.GetTimeStep ();
+  if (m_partitions.size () == 1 || next > g_never - lookahead)
+    {
+      m_windowEnd = g_never;
+    }
+  else
+    {
+      m_windowEnd = next + lookahead;
+    }
+  if (m_stopTs != g_never)
+    {
+      m_windowEnd = std::min (m_windowEnd, m_stopTs + 1);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::DoRun (uint32_t index)
+{
+  Partition *partition = m_partitions[index];
+  g_partition = index + 1;
+  while (true)
+    {
+      DrainInbox (partition);
+      partition->next = partition->events->IsEmpty () ?
+        g_never : partition->events->PeekNext ().key.m_ts;
+      Barrier (true);
+      if (m_done)
+        {
+          break;
+        }
+      while (!partition->events->IsEmpty ()
+             && partition->events->PeekNext ().key.m_ts < m_windowEnd)
+        {
+          Scheduler::Event next = partition->events->RemoveNext ();
+          NS_ASSERT (next.key.m_ts >= partition->currentTs);
+          partition->currentTs = next.key.m_ts;
+          partition->currentContext = next.key.m_context;
+          partition->currentUid = next.key.m_uid;
+          next.impl->Invoke ();
+          next.impl->Unref ();
+          if (m_stop && m_partitions.size () == 1)
+            {
+              // the window of a single partition is unbounded; with
+              // several, all the partitions end the window, for the
+              // results not to depend on the interleaving of the threads
+              break;
+            }
+          // the events of the other partitions are not in this window, but
+          // the events of foreign threads are run as soon as possible
+          DrainInbox (partition);
+        }
+      Barrier (false);
+    }
+  g_partition = 0;
+}
+
+void
+MultithreadedSimulatorImpl::DoWorker (void)
+{
+  DoRun (__sync_add_and_fetch (&m_nextWorker, 1));
+  // the free lists of this thread are lost when it exits
+  EventImpl::ReleasePool ();
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_partitions.size () > 1 && !m_lookahead.IsStrictlyPositive ())
+    {
+      NS_FATAL_ERROR ("MultithreadedSimulatorImpl::Lookahead must be set with several partitions");
+    }
+  m_stop = false;
+  m_done = false;
+  m_windows = 0;
+  m_endTs = 0;
+  m_nextWorker = 0;
+  // Set the current threadId as the main threadId
+  m_main = SystemThread::Self ();
+  m_running = true;
+  __sync_synchronize ();
+
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 1; i < m_partitions.size (); i++)
+    {
+      Ptr<SystemThread> thread =
+        Create<SystemThread> (MakeCallback (&MultithreadedSimulatorImpl::DoWorker, this));
+      thread->Start ();
+      threads.push_back (thread);
+    }
+  DoRun (0);
+  for (uint32_t i = 0; i < threads.size (); i++)
+    {
+      threads[i]->Join ();
+    }
+  m_running = false;
+
+  // Now () is the time of the partition of the main thread, which must
+  // be the end of the simulation
+  Partition *main = m_partitions[0];
+  for (uint32_t i = 1; i < m_partitions.size (); i++)
+    {
+      if (m_partitions[i]->currentTs > main->currentTs)
+        {
+          main->currentTs = m_partitions[i]->currentTs;
+          main->currentContext = m_partitions[i]->currentContext;
+          main->currentUid = m_partitions[i]->currentUid;
+        }
+    }
+  if (m_endTs > main->currentTs)
+    {
+      main->currentTs = m_endTs;
+    }
+  NS_LOG_LOGIC ("run in " << m_windows << " windows");
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &time)
+{
+  NS_LOG_FUNCTION (this << time.GetTimeStep ());
+  uint64_t ts = Now ().GetTimeStep () + time.GetTimeStep ();
+  uint64_t current;
+  do
+    {
+      current = m_stopTs;
+      if (current <= ts)
+        {
+          return;
+        }
+    }
+  while (!__sync_bool_compare_and_swap (&m_stopTs, current, ts));
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &time, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << time.GetTimeStep () << event);
+  Partition *partition = GetCurrentPartition ();
+  NS_ASSERT_MSG (partition != 0, "Simulator::Schedule Thread-unsafe invocation!");
+
+  Time tAbsolute = time + TimeStep (partition->currentTs);
+  NS_ASSERT (tAbsolute.IsPositive ());
+  NS_ASSERT (tAbsolute >= TimeStep (partition->currentTs));
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
+  ev.key.m_context = partition->currentContext;
+  ev.key.m_uid = AllocateUid (partition);
+  partition->events->Insert (ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << time.GetTimeStep () << event);
+  Partition *partition = GetCurrentPartition ();
+  Partition *target = m_partitions[GetPartitionIndex (context)];
+  if (partition == 0)
+    {
+      // a foreign thread: the delay is relative to the target partition
+      InboxEvent *ev = new InboxEvent;
+      ev->event = event;
+      ev->ts = time.GetTimeStep ();
+      ev->context = context;
+      ev->uid = 0;
+      ev->relative = true;
+      target->inbox.Push (ev);
+      return;
+    }
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = partition->currentTs + time.GetTimeStep ();
+  ev.key.m_context = context;
+  ev.key.m_uid = AllocateUid (partition);
+  if (target == partition || !m_running)
+    {
+      target->events->Insert (ev);
+      return;
+    }
+  if (ev.key.m_ts < m_windowEnd)
+    {
+      NS_FATAL_ERROR ("Event for context " << context << " scheduled " << time.GetTimeStep ()
+                      << " after context " << partition->currentContext
+                      << ", less than MultithreadedSimulatorImpl::Lookahead");
+    }
+  InboxEvent *inbox = new InboxEvent;
+  inbox->event = event;
+  inbox->ts = ev.key.m_ts;
+  inbox->context = context;
+  inbox->uid = ev.key.m_uid;
+  inbox->relative = false;
+  target->inbox.Push (inbox);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  Partition *partition = GetCurrentPartition ();
+  NS_ASSERT_MSG (partition != 0, "Simulator::ScheduleNow Thread-unsafe invocation!");
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = partition->currentTs;
+  ev.key.m_context = partition->currentContext;
+  ev.key.m_uid = AllocateUid (partition);
+  partition->events->Insert (ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  EventId id (Ptr<EventImpl> (event, false), Now ().GetTimeStep (), 0xffffffff, 2);
+  CriticalSection cs (m_destroyEventsMutex);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  Partition *partition = GetCurrentPartition ();
+  if (partition == 0)
+    {
+      // a foreign thread sees the time of the main thread
+      partition = m_partitions[0];
+    }
+  return TimeStep (partition->currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - Now ().GetTimeStep ());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      CriticalSection cs (m_destroyEventsMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition *partition = m_partitions[GetPartitionIndex (id.GetContext ())];
+  NS_ASSERT_MSG (!m_running || partition == GetCurrentPartition (),
+                 "Simulator::Remove of an event of another partition");
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  partition->events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &ev) const
+{
+  if (ev.GetUid () == 2)
+    {
+      if (ev.PeekEventImpl () == 0 ||
+          ev.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      CriticalSection cs (m_destroyEventsMutex);
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == ev)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  // the events run in the order of their keys in their partition, whose
+  // current event is only known to its own thread
+  const Partition *partition = m_partitions[GetPartitionIndex (ev.GetContext ())];
+  NS_ASSERT_MSG (!m_running || partition == GetCurrentPartition (),
+                 "Simulator::IsExpired of an event of another partition");
+  if (ev.PeekEventImpl () == 0 ||
+      ev.GetTs () < partition->currentTs ||
+      (ev.GetTs () == partition->currentTs &&
+       ev.GetUid () <= partition->currentUid) ||
+      ev.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  Partition *partition = GetCurrentPartition ();
+  if (partition == 0)
+    {
+      return 0xffffffff;
+    }
+  return partition->currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetWindows (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_windows;
+}
+
+} // namespace ns3
@@ -34,6 +34,7 @@
 
 
 #include <cmath>
+#include <algorithm>
 
 
 namespace ns3 {
@@ -106,6 +107,13 @@ RealtimeSimulatorImpl::DoDispose (void)
       next.impl->Unref ();
     }
   m_events = 0;
+  for (EventWithContext *ev = m_eventsWithContext.PopAll (); ev != 0; )
+    {
+      EventWithContext *next = ev->next;
+      ev->event->Unref ();
+      delete ev;
+      ev = next;
+    }
   m_synchronizer = 0;
   SimulatorImpl::DoDispose ();
 }
@@ -214,6 +222,16 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
         NS_ASSERT_MSG (m_synchronizer->Realtime (), 
                        "RealtimeSimulatorImpl::ProcessOneEvent (): Synchronizer reports not Realtime ()");
 
+        //
+        // This resets the synchronizer so that any future event will cause
+        // it to interrupt (see below).  The events of other threads are pushed
+        // without the critical section, so the condition must be reset before
+        // the pushed events are taken: an event pushed after that will signal
+        // the synchronizer.
+        //
+        m_synchronizer->SetCondition (false);
+        ProcessEventsWithContext ();
+
         //
         // tsNow is set to the normalized current real time.  When the simulation was
         // started, the current real time was effectively set to zero; so tsNow is
@@ -246,10 +264,9 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
         // We've figured out how long we need to delay in order to pace the 
         // simulation time with the real time.  We're going to sleep, but need
         // to work with the synchronizer to make sure we're awakened if something 
-        // external happens (like a packet is received).  This next line resets
-        // the synchronizer so that any future event will cause it to interrupt.
+        // external happens (like a packet is received).  This is why the
+        // condition of the synchronizer was reset above.
         //
-        m_synchronizer->SetCondition (false);
       }
 
       //
@@ -317,8 +334,10 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
     // We do know we're waiting for an event, so there had better be an event on the 
     // event queue.  Let's pull it off.  When we release the critical section, the
     // event we're working on won't be on the list and so subsequent operations won't
-    // mess with us.
+    // mess with us.  Events pushed by other threads while we were waiting
+    // may be due before it.
     //
+    ProcessEventsWithContext ();
     NS_ASSERT_MSG (m_events->IsEmpty () == false, 
                    "RealtimeSimulatorImpl::ProcessOneEvent(): event queue is empty");
     next = m_events->RemoveNext ();
@@ -392,7 +411,7 @@ RealtimeSimulatorImpl::IsFinished (void) const
   bool rc;
   {
     CriticalSection cs (m_mutex);
-    rc = m_events->IsEmpty () || m_stop;
+    rc = (m_events->IsEmpty () && m_eventsWithContext.IsEmpty ()) || m_stop;
   }
 
   return rc;
@@ -401,6 +420,31 @@ RealtimeSimulatorImpl::IsFinished (void) const
 //
 // Peeks into event list.  Should be called with critical section locked.
 //
+void
+RealtimeSimulatorImpl::ProcessEventsWithContext (void)
+{
+  // take all the pending events at once, in the order they were scheduled
+  EventWithContext *event = m_eventsWithContext.PopAll ();
+  while (event != 0)
+    {
+      Scheduler::Event ev;
+      ev.impl = event->event;
+      //
+      // The event was due at its realtime timestamp, but the simulation may
+      // have executed later events since: run it as soon as possible.
+      //
+      ev.key.m_ts = std::max (event->timestamp, m_currentTs);
+      ev.key.m_context = event->context;
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_unscheduledEvents++;
+      m_events->Insert (ev);
+      EventWithContext *next = event->next;
+      delete event;
+      event = next;
+    }
+}
+
 uint64_t
 RealtimeSimulatorImpl::NextTs (void) const
 {
@@ -435,6 +479,7 @@ RealtimeSimulatorImpl::Run (void)
       {
         CriticalSection cs (m_mutex);
 
+        ProcessEventsWithContext ();
         if (!m_events->IsEmpty ())
           {
             process = true;
@@ -536,35 +581,41 @@ RealtimeSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time,
 {
   NS_LOG_FUNCTION (this << context << time << impl);
 
-  {
-    CriticalSection cs (m_mutex);
-    uint64_t ts;
-
-    if (SystemThread::Equals (m_main))
-      {
-        ts = m_currentTs + time.GetTimeStep ();
-      }
-    else
-      {
-        //
-        // If the simulator is running, we're pacing and have a meaningful 
-        // realtime clock.  If we're not, then m_currentTs is where we stopped.
-        // 
-        ts = m_running ? m_synchronizer->GetCurrentRealtime () : m_currentTs;
-        ts += time.GetTimeStep ();
-      }
+  if (SystemThread::Equals (m_main))
+    {
+      CriticalSection cs (m_mutex);
+      uint64_t ts = m_currentTs + time.GetTimeStep ();
+      Scheduler::Event ev;
+      ev.impl = impl;
+      ev.key.m_ts = ts;
+      ev.key.m_context = context;
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_unscheduledEvents++;
+      m_events->Insert (ev);
+      m_synchronizer->Signal ();
+      return;
+    }
 
-    NS_ASSERT_MSG (ts >= m_currentTs, "RealtimeSimulatorImpl::ScheduleRealtime(): schedule for time < m_currentTs");
-    Scheduler::Event ev;
-    ev.impl = impl;
-    ev.key.m_ts = ts;
-    ev.key.m_context = context;
-    ev.key.m_uid = m_uid;
-    m_uid++;
-    m_unscheduledEvents++;
-    m_events->Insert (ev);
-    m_synchronizer->Signal ();
-  }
+  //
+  // Other threads push their events without taking the critical section,
+  // and the simulation thread inserts them in the scheduler.  If the
+  // simulator is running, we're pacing and have a meaningful realtime
+  // clock.  If we're not, then m_currentTs is where we stopped.
+  //
+  EventWithContext *ev = new EventWithContext;
+  ev->context = context;
+  ev->timestamp = (m_running ? m_synchronizer->GetCurrentRealtime () : m_currentTs)
+    + time.GetTimeStep ();
+  ev->event = impl;
+  //
+  // Only the first event pushed since the queue was last emptied needs to
+  // interrupt the synchronizer: the next ones are taken with it.
+  //
+  if (m_eventsWithContext.Push (ev))
+    {
+      m_synchronizer->Signal ();
+    }
 }
 
 EventId
@@ -30,6 +30,7 @@
 #include "assert.h"
 #include "log.h"
 #include "system-mutex.h"
+#include "mpsc-queue.h"
 
 #include <list>
 
@@ -91,8 +92,26 @@ private:
   bool Realtime (void) const;
   uint64_t NextTs (void) const;
   void ProcessOneEvent (void);
+  /**
+   * Insert the events scheduled by other threads than the simulation
+   * thread. Should be called with the critical section locked.
+   */
+  void ProcessEventsWithContext (void);
   virtual void DoDispose (void);
 
+  /// An event scheduled by another thread than the simulation thread.
+  struct EventWithContext {
+    EventWithContext *next;   //!< the next event of the queue
+    uint32_t context;         //!< the context of the event
+    uint64_t timestamp;       //!< the realtime timestamp of the event
+    EventImpl *event;         //!< the event
+  };
+  /**
+   * Events scheduled by other threads: they are pushed without taking
+   * m_mutex, and inserted by the simulation thread.
+   */
+  MpscQueue<EventWithContext> m_eventsWithContext;
+
   typedef std::list<EventId> DestroyEvents;
   DestroyEvents m_destroyEvents;
   bool m_stop;
@@ -0,0 +1,260 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "recording-scheduler.h"
+#include "map-scheduler.h"
+#include "object-factory.h"
+#include "string.h"
+#include "assert.h"
+#include "fatal-error.h"
+#include "log.h"
+
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RecordingScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (RecordingScheduler);
+
+namespace {
+
+/// The first bytes of a record file.
+const char g_magic[8] = { 'n', 's', '3', 's', 'c', 'h', 'e', 'd' };
+
+/**
+ * \param is the stream
+ * \param value the decoded integer
+ * \returns false at the end of the stream
+ */
+bool
+ReadInteger (std::istream &is, uint64_t &value)
+{
+  value = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+      int c = is.get ();
+      if (c == EOF)
+        {
+          return false;
+        }
+      value |= static_cast<uint64_t> (c & 0x7f) << shift;
+      if ((c & 0x80) == 0)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+} // anonymous namespace
+
+TypeId
+RecordingScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::RecordingScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<RecordingScheduler> ()
+    .AddAttribute ("SchedulerType",
+                   "The type of the recorded scheduler.",
+                   TypeIdValue (MapScheduler::GetTypeId ()),
+                   MakeTypeIdAccessor (&RecordingScheduler::SetSchedulerType,
+                                       &RecordingScheduler::GetSchedulerType),
+                   MakeTypeIdChecker ())
+    .AddAttribute ("FileName",
+                   "The name of the record file.",
+                   StringValue ("scheduler.rec"),
+                   MakeStringAccessor (&RecordingScheduler::m_filename),
+                   MakeStringChecker ())
+  ;
+  return tid;
+}
+
+RecordingScheduler::RecordingScheduler ()
+  : m_now (0),
+    m_lastUid (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+RecordingScheduler::~RecordingScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_file.is_open ())
+    {
+      m_file.close ();
+    }
+}
+
+void
+RecordingScheduler::SetSchedulerType (TypeId type)
+{
+  NS_LOG_FUNCTION (this << type.GetName ());
+  NS_ASSERT_MSG (m_scheduler == 0 || m_scheduler->IsEmpty (),
+                 "The scheduler cannot be changed while events are scheduled");
+  ObjectFactory factory;
+  factory.SetTypeId (type);
+  m_scheduler = factory.Create<Scheduler> ();
+  m_schedulerType = type;
+}
+
+TypeId
+RecordingScheduler::GetSchedulerType (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_schedulerType;
+}
+
+void
+RecordingScheduler::WriteInteger (uint64_t value)
+{
+  while (value >= 0x80)
+    {
+      m_file.put (static_cast<char> ((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+  m_file.put (static_cast<char> (value));
+}
+
+void
+RecordingScheduler::Write (Operation op, const EventKey &key)
+{
+  if (!m_file.is_open ())
+    {
+      m_file.open (m_filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!m_file.is_open ())
+        {
+          NS_FATAL_ERROR ("Cannot open record file " << m_filename);
+        }
+      m_file.write (g_magic, sizeof (g_magic));
+    }
+  m_file.put (static_cast<char> (op));
+  NS_ASSERT (key.m_ts >= m_now);
+  WriteInteger (key.m_ts - m_now);
+  if (op == REMOVE_NEXT)
+    {
+      m_now = key.m_ts;
+      return;
+    }
+  if (op == INSERT)
+    {
+      WriteInteger (key.m_uid - m_lastUid);
+      m_lastUid = key.m_uid;
+    }
+  else
+    {
+      WriteInteger (m_lastUid - key.m_uid);
+    }
+  WriteInteger (key.m_context);
+}
+
+void
+RecordingScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  Write (INSERT, ev.key);
+  m_scheduler->Insert (ev);
+}
+
+bool
+RecordingScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_scheduler->IsEmpty ();
+}
+
+Scheduler::Event
+RecordingScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_scheduler->PeekNext ();
+}
+
+Scheduler::Event
+RecordingScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  Event next = m_scheduler->RemoveNext ();
+  Write (REMOVE_NEXT, next.key);
+  return next;
+}
+
+void
+RecordingScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  Write (REMOVE, ev.key);
+  m_scheduler->Remove (ev);
+}
+
+bool
+RecordingScheduler::Read (std::string filename, std::vector<Record> &records)
+{
+  NS_LOG_FUNCTION (filename);
+  std::ifstream file (filename.c_str (), std::ios::in | std::ios::binary);
+  char magic[sizeof (g_magic)];
+  if (!file.read (magic, sizeof (magic))
+      || std::memcmp (magic, g_magic, sizeof (magic)) != 0)
+    {
+      return false;
+    }
+
+  uint64_t now = 0;
+  uint32_t lastUid = 0;
+  int c;
+  while ((c = file.get ()) != EOF)
+    {
+      Record record;
+      record.op = static_cast<Operation> (c);
+      record.key.m_uid = 0;
+      record.key.m_context = 0;
+      uint64_t delay;
+      if (record.op != INSERT && record.op != REMOVE && record.op != REMOVE_NEXT)
+        {
+          return false;
+        }
+      if (!ReadInteger (file, delay))
+        {
+          return false;
+        }
+      record.key.m_ts = now + delay;
+      if (record.op == REMOVE_NEXT)
+        {
+          now = record.key.m_ts;
+          records.push_back (record);
+          continue;
+        }
+      uint64_t uid, context;
+      if (!ReadInteger (file, uid) || !ReadInteger (file, context))
+        {
+          return false;
+        }
+      if (record.op == INSERT)
+        {
+          lastUid += uid;
+          record.key.m_uid = lastUid;
+        }
+      else
+        {
+          record.key.m_uid = lastUid - uid;
+        }
+      record.key.m_context = context;
+      records.push_back (record);
+    }
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "timing-wheel-scheduler.h"
+#include "event-impl.h"
+#include "uinteger.h"
+#include "assert.h"
+#include "unused.h"
+#include "log.h"
+
+#include <algorithm>
+
+namespace ns3 {
+
+// Note:  Logging in this file is limited to the public methods, as
+// the wheel operations are invoked for every event.
+NS_LOG_COMPONENT_DEFINE ("TimingWheelScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (TimingWheelScheduler);
+
+namespace {
+
+/// Order of the bottom: the next event is the last one.
+bool
+IsLater (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return b.key < a.key;
+}
+
+} // anonymous namespace
+
+TypeId
+TimingWheelScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TimingWheelScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<TimingWheelScheduler> ()
+    .AddAttribute ("BucketWidth",
+                   "The simulation time covered by each bucket of the wheel.",
+                   TimeValue (MicroSeconds (100)),
+                   MakeTimeAccessor (&TimingWheelScheduler::SetBucketWidth,
+                                     &TimingWheelScheduler::GetBucketWidth),
+                   MakeTimeChecker ())
+    .AddAttribute ("Buckets",
+                   "The number of buckets of the wheel. Events scheduled "
+                   "beyond Buckets * BucketWidth are kept in a sorted overflow.",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&TimingWheelScheduler::SetBuckets,
+                                         &TimingWheelScheduler::GetBuckets),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+TimingWheelScheduler::TimingWheelScheduler ()
+  : m_current (0),
+    m_bottomEnd (0),
+    m_wheelCount (0),
+    m_width (0),
+    m_bucketWidth (MicroSeconds (100)),
+    m_buckets (4096)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TimingWheelScheduler::~TimingWheelScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TimingWheelScheduler::SetBucketWidth (Time width)
+{
+  NS_LOG_FUNCTION (this << width);
+  NS_ASSERT_MSG (IsEmpty (), "The bucket width cannot be changed while events are scheduled");
+  NS_ASSERT (width.IsStrictlyPositive ());
+  m_bucketWidth = width;
+  m_width = 0;
+}
+
+Time
+TimingWheelScheduler::GetBucketWidth (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_bucketWidth;
+}
+
+void
+TimingWheelScheduler::SetBuckets (uint32_t buckets)
+{
+  NS_LOG_FUNCTION (this << buckets);
+  NS_ASSERT_MSG (IsEmpty (), "The number of buckets cannot be changed while events are scheduled");
+  m_buckets = buckets;
+  m_wheel.clear ();
+  m_current = 0;
+}
+
+uint32_t
+TimingWheelScheduler::GetBuckets (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_buckets;
+}
+
+uint64_t
+TimingWheelScheduler::GetHorizon (void) const
+{
+  return m_bottomEnd + m_width * m_buckets;
+}
+
+void
+TimingWheelScheduler::InsertBottom (const Event &ev)
+{
+  Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater);
+  m_bottom.insert (i, ev);
+}
+
+void
+TimingWheelScheduler::InsertWheel (const Event &ev)
+{
+  uint64_t offset = (ev.key.m_ts - m_bottomEnd) / m_width;
+  m_wheel[(m_current + offset) % m_buckets].push_back (ev);
+  m_wheelCount++;
+}
+
+void
+TimingWheelScheduler::Migrate (void)
+{
+  uint64_t horizon = GetHorizon ();
+  while (!m_overflow.empty () && m_overflow.begin ()->first.m_ts < horizon)
+    {
+      Event ev;
+      ev.key = m_overflow.begin ()->first;
+      ev.impl = m_overflow.begin ()->second;
+      m_overflow.erase (m_overflow.begin ());
+      InsertWheel (ev);
+    }
+}
+
+void
+TimingWheelScheduler::Settle (void)
+{
+  while (m_bottom.empty ())
+    {
+      if (m_wheelCount == 0)
+        {
+          if (m_overflow.empty ())
+            {
+              return;
+            }
+          // the wheel is empty: move it to the earliest overflow event
+          uint64_t ts = m_overflow.begin ()->first.m_ts;
+          m_bottomEnd = ts - ts % m_width;
+          Migrate ();
+          continue;
+        }
+      // the current bucket becomes the bottom, and the wheel advances
+      m_bottom.swap (m_wheel[m_current]);
+      m_wheelCount -= m_bottom.size ();
+      m_bottomEnd += m_width;
+      m_current = (m_current + 1) % m_buckets;
+      if (m_bottom.size () > 1)
+        {
+          std::sort (m_bottom.begin (), m_bottom.end (), IsLater);
+        }
+      Migrate ();
+    }
+}
+
+void
+TimingWheelScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  if (m_width == 0)
+    {
+      m_width = std::max<int64_t> (m_bucketWidth.GetTimeStep (), 1);
+    }
+  if (m_wheel.empty ())
+    {
+      m_wheel.resize (m_buckets);
+    }
+
+  if (ev.key.m_ts < m_bottomEnd)
+    {
+      InsertBottom (ev);
+    }
+  else if (ev.key.m_ts < GetHorizon ())
+    {
+      InsertWheel (ev);
+    }
+  else
+    {
+      m_overflow.insert (std::make_pair (ev.key, ev.impl));
+    }
+  Settle ();
+}
+
+bool
+TimingWheelScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  // the bottom is refilled as soon as it is empty
+  return m_bottom.empty ();
+}
+
+Scheduler::Event
+TimingWheelScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_bottom.empty ());
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+TimingWheelScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_bottom.empty ());
+  Event next = m_bottom.back ();
+  m_bottom.pop_back ();
+  Settle ();
+  return next;
+}
+
+void
+TimingWheelScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  if (ev.key.m_ts < m_bottomEnd)
+    {
+      Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater);
+      NS_ASSERT (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid);
+      m_bottom.erase (i);
+    }
+  else if (ev.key.m_ts < GetHorizon ())
+    {
+      uint64_t offset = (ev.key.m_ts - m_bottomEnd) / m_width;
+      Bucket &bucket = m_wheel[(m_current + offset) % m_buckets];
+      Bucket::iterator i;
+      for (i = bucket.begin (); i != bucket.end (); i++)
+        {
+          if (i->key.m_uid == ev.key.m_uid)
+            {
+              break;
+            }
+        }
+      NS_ASSERT (i != bucket.end ());
+      *i = bucket.back ();
+      bucket.pop_back ();
+      m_wheelCount--;
+    }
+  else
+    {
+      Overflow::size_type erased = m_overflow.erase (ev.key);
+      NS_ASSERT (erased == 1);
+      NS_UNUSED (erased);
+    }
+  Settle ();
+}
+
+} // namespace ns3
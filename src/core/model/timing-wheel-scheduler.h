@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TIMING_WHEEL_SCHEDULER_H
+#define TIMING_WHEEL_SCHEDULER_H
+
+#include "scheduler.h"
+#include "nstime.h"
+#include <stdint.h>
+#include <vector>
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a timing wheel event scheduler, for many near-future events
+ *
+ * The events are spread over three tiers, ordered in time:
+ *  - the bottom: a small array, sorted, of the events earlier than the
+ *    end of the current bucket. The next event is always at its end.
+ *  - the wheel: a circular array of Buckets unsorted buckets, each
+ *    covering BucketWidth of simulation time, after the bottom.
+ *  - the overflow: a std::map of the events later than the wheel horizon.
+ *
+ * Inserting an event in the wheel only appends it to its bucket. When
+ * the bottom is empty, the next non-empty bucket is sorted and becomes
+ * the bottom, and the wheel advances, taking the events of the overflow
+ * which fall within its new horizon. Each event is thus sorted only
+ * within its bucket, which makes insertion and removal O(1) amortized
+ * when most events are scheduled less than Buckets * BucketWidth in the
+ * future, with clustered timestamps, as for slotted MAC protocols.
+ *
+ * Events scheduled before the end of the current bucket, including
+ * events scheduled in the past of the wheel by a realtime simulator,
+ * are inserted directly in the sorted bottom.
+ */
+class TimingWheelScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  TimingWheelScheduler ();
+  virtual ~TimingWheelScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+
+private:
+  typedef std::vector<Event> Bucket;
+  typedef std::map<EventKey, EventImpl *> Overflow;
+
+  /**
+   * \param width the time covered by each bucket
+   *
+   * Can be changed only while the scheduler is empty.
+   */
+  void SetBucketWidth (Time width);
+  /**
+   * \returns the time covered by each bucket
+   */
+  Time GetBucketWidth (void) const;
+  /**
+   * \param buckets the number of buckets of the wheel
+   *
+   * Can be changed only while the scheduler is empty.
+   */
+  void SetBuckets (uint32_t buckets);
+  /**
+   * \returns the number of buckets of the wheel
+   */
+  uint32_t GetBuckets (void) const;
+
+  /// \returns the end of the wheel horizon, in time steps
+  uint64_t GetHorizon (void) const;
+  /**
+   * Insert an event in the sorted bottom.
+   * \param ev the event
+   */
+  void InsertBottom (const Event &ev);
+  /**
+   * Insert an event in the wheel.
+   * \param ev the event, within the wheel horizon
+   */
+  void InsertWheel (const Event &ev);
+  /// Move the overflow events within the wheel horizon to the wheel
+  void Migrate (void);
+  /// Refill the bottom from the wheel if it is empty
+  void Settle (void);
+
+  Bucket m_bottom;               //!< sorted by decreasing key
+  std::vector<Bucket> m_wheel;   //!< the buckets
+  Overflow m_overflow;           //!< events beyond the wheel horizon
+  uint32_t m_current;            //!< index of the bucket following the bottom
+  uint64_t m_bottomEnd;          //!< end of the bottom, in time steps
+  uint32_t m_wheelCount;         //!< number of events in the wheel
+  uint64_t m_width;              //!< bucket width, in time steps
+  Time m_bucketWidth;            //!< bucket width
+  uint32_t m_buckets;            //!< number of buckets
+};
+
+} // namespace ns3
+
+#endif /* TIMING_WHEEL_SCHEDULER_H */
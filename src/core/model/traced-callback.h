@@ -21,8 +21,10 @@
 #ifndef TRACED_CALLBACK_H
 #define TRACED_CALLBACK_H
 
-#include <list>
+#include <vector>
 #include "callback.h"
+#include "simple-ref-count.h"
+#include "ptr.h"
 
 namespace ns3 {
 
@@ -35,6 +37,19 @@ namespace ns3 {
  * it forwards calls to a chain of ns3::Callback. TracedCallback::Connect adds a ns3::Callback
  * at the end of the chain of callbacks. TracedCallback::Disconnect removes a ns3::Callback from
  * the chain of callbacks.
+ *
+ * The callbacks are stored in a single array, shared by the copies of
+ * the TracedCallback and replaced when a callback is connected or
+ * disconnected during a call, so that the callbacks are free to
+ * connect and disconnect. A TracedCallback without callbacks holds no
+ * array: calling it is a single test, and IsEmpty allows the trace
+ * sources to avoid building their arguments when nobody listens:
+ * \code
+ *   if (!m_rxTrace.IsEmpty ())
+ *     {
+ *       m_rxTrace (packet->Copy ());
+ *     }
+ * \endcode
  */
 template<typename T1 = empty, typename T2 = empty, 
          typename T3 = empty, typename T4 = empty,
@@ -78,6 +93,20 @@ public:
    * of the TracedCallback::Connect method.
    */
   void Disconnect (const CallbackBase & callback, std::string path);
+  /**
+   * \returns true if no callback is connected
+   */
+  bool IsEmpty (void) const
+  {
+    return m_callbacks == 0;
+  }
+  /**
+   * \returns the number of connected callbacks
+   */
+  uint32_t GetN (void) const
+  {
+    return m_callbacks == 0 ? 0 : m_callbacks->list.size ();
+  }
   void operator() (void) const;
   void operator() (T1 a1) const;
   void operator() (T1 a1, T2 a2) const;
@@ -89,8 +118,19 @@ public:
   void operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8) const;
 
 private:
-  typedef std::list<Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> > CallbackList;
-  CallbackList m_callbackList;
+  typedef std::vector<Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> > CallbackList;
+  /// The connected callbacks, shared by reference counting.
+  struct Callbacks : public SimpleRefCount<Callbacks>
+  {
+    CallbackList list;  //!< the callbacks, in the order of connection
+  };
+  /**
+   * \returns the callbacks, ready to be modified: they are copied if
+   * shared with a copy of the TracedCallback or with a running call
+   */
+  Callbacks * GetUnshared (void);
+  /// The callbacks, or zero if none is connected.
+  Ptr<Callbacks> m_callbacks;
 };
 
 } // namespace ns3
@@ -104,8 +144,27 @@ template<typename T1, typename T2,
          typename T5, typename T6,
          typename T7, typename T8>
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::TracedCallback ()
-  : m_callbackList () 
+  : m_callbacks () 
+{
+}
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+typename TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::Callbacks *
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::GetUnshared (void)
 {
+  if (m_callbacks == 0)
+    {
+      m_callbacks = Create<Callbacks> ();
+    }
+  else if (m_callbacks->GetReferenceCount () > 1)
+    {
+      Ptr<Callbacks> callbacks = Create<Callbacks> ();
+      callbacks->list = m_callbacks->list;
+      m_callbacks = callbacks;
+    }
+  return PeekPointer (m_callbacks);
 }
 template<typename T1, typename T2,
          typename T3, typename T4,
@@ -116,7 +175,7 @@ TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::ConnectWithoutContext (const CallbackBa
 {
   Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> cb;
   cb.Assign (callback);
-  m_callbackList.push_back (cb);
+  GetUnshared ()->list.push_back (cb);
 }
 template<typename T1, typename T2,
          typename T3, typename T4,
@@ -128,7 +187,7 @@ TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::Connect (const CallbackBase & callback,
   Callback<void,std::string,T1,T2,T3,T4,T5,T6,T7,T8> cb;
   cb.Assign (callback);
   Callback<void,T1,T2,T3,T4,T5,T6,T7,T8> realCb = cb.Bind (path);
-  m_callbackList.push_back (realCb);
+  GetUnshared ()->list.push_back (realCb);
 }
 template<typename T1, typename T2, 
          typename T3, typename T4,
@@ -137,18 +196,27 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::DisconnectWithoutContext (const CallbackBase & callback)
 {
-  for (typename CallbackList::iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); /* empty */)
+  if (m_callbacks == 0)
+    {
+      return;
+    }
+  CallbackList &list = GetUnshared ()->list;
+  for (typename CallbackList::iterator i = list.begin ();
+       i != list.end (); /* empty */)
     {
       if ((*i).IsEqual (callback))
         {
-          i = m_callbackList.erase (i);
+          i = list.erase (i);
         }
       else
         {
           i++;
         }
     }
+  if (list.empty ())
+    {
+      m_callbacks = 0;
+    }
 }
 template<typename T1, typename T2, 
          typename T3, typename T4,
@@ -169,8 +237,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (void) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (m_callbacks == 0)
+    {
+      return;
+    }
+  // keep the callbacks alive, should they be disconnected by a callback
+  Ptr<Callbacks> callbacks = m_callbacks;
+  for (typename CallbackList::const_iterator i = callbacks->list.begin ();
+       i != callbacks->list.end (); i++)
     {
       (*i)();
     }
@@ -182,8 +256,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (m_callbacks == 0)
+    {
+      return;
+    }
+  // keep the callbacks alive, should they be disconnected by a callback
+  Ptr<Callbacks> callbacks = m_callbacks;
+  for (typename CallbackList::const_iterator i = callbacks->list.begin ();
+       i != callbacks->list.end (); i++)
     {
       (*i)(a1);
     }
@@ -195,8 +275,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (m_callbacks == 0)
+    {
+      return;
+    }
+  // keep the callbacks alive, should they be disconnected by a callback
+  Ptr<Callbacks> callbacks = m_callbacks;
+  for (typename CallbackList::const_iterator i = callbacks->list.begin ();
+       i != callbacks->list.end (); i++)
     {
       (*i)(a1, a2);
     }
@@ -208,8 +294,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (m_callbacks == 0)
+    {
+      return;
+    }
+  // keep the callbacks alive, should they be disconnected by a callback
+  Ptr<Callbacks> callbacks = m_callbacks;
+  for (typename CallbackList::const_iterator i = callbacks->list.begin ();
+       i != callbacks->list.end (); i++)
     {
       (*i)(a1, a2, a3);
     }
@@ -221,8 +313,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (m_callbacks == 0)
+    {
+      return;
+    }
+  // keep the callbacks alive, should they be disconnected by a callback
+  Ptr<Callbacks> callbacks = m_callbacks;
+  for (typename CallbackList::const_iterator i = callbacks->list.begin ();
+       i != callbacks->list.end (); i++)
     {
       (*i)(a1, a2, a3, a4);
     }
@@ -234,8 +332,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (m_callbacks == 0)
+    {
+      return;
+    }
+  // keep the callbacks alive, should they be disconnected by a callback
+  Ptr<Callbacks> callbacks = m_callbacks;
+  for (typename CallbackList::const_iterator i = callbacks->list.begin ();
+       i != callbacks->list.end (); i++)
     {
       (*i)(a1, a2, a3, a4, a5);
     }
@@ -247,8 +351,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (m_callbacks == 0)
+    {
+      return;
+    }
+  // keep the callbacks alive, should they be disconnected by a callback
+  Ptr<Callbacks> callbacks = m_callbacks;
+  for (typename CallbackList::const_iterator i = callbacks->list.begin ();
+       i != callbacks->list.end (); i++)
     {
       (*i)(a1, a2, a3, a4, a5, a6);
     }
@@ -260,8 +370,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (m_callbacks == 0)
+    {
+      return;
+    }
+  // keep the callbacks alive, should they be disconnected by a callback
+  Ptr<Callbacks> callbacks = m_callbacks;
+  for (typename CallbackList::const_iterator i = callbacks->list.begin ();
+       i != callbacks->list.end (); i++)
     {
       (*i)(a1, a2, a3, a4, a5, a6, a7);
     }
@@ -273,8 +389,14 @@ template<typename T1, typename T2,
 void 
 TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  if (m_callbacks == 0)
+    {
+      return;
+    }
+  // keep the callbacks alive, should they be disconnected by a callback
+  Ptr<Callbacks> callbacks = m_callbacks;
+  for (typename CallbackList::const_iterator i = callbacks->list.begin ();
+       i != callbacks->list.end (); i++)
     {
       (*i)(a1, a2, a3, a4, a5, a6, a7, a8);
     }
@@ -25,6 +25,7 @@
 
 #include <map>
 #include <vector>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 
@@ -45,6 +46,15 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
  * Information records are stored in a vector.  Name and hash lookup
  * are performed by maps to the vector index.
  *
+ * The names of the types, and the names of the attributes and trace
+ * sources of each type, are also indexed by a hash of the name: a
+ * lookup by name is a binary search of the hash in a sorted vector,
+ * followed by the comparison of the few names with this hash.  The
+ * index of the attributes and trace sources of a type includes those
+ * of its parents, the closest first, so that a lookup does not walk the
+ * inheritance tree.  The indexes are updated when a type is registered,
+ * so that the lookups never modify the IidManager.
+ *
  * \internal
  * <b>Hash Chaining</b>
  *
@@ -108,12 +118,50 @@ public:
   uint32_t GetTraceSourceN (uint16_t uid) const;
   struct TypeId::TraceSourceInformation GetTraceSource(uint16_t uid, uint32_t i) const;
   bool MustHideFromDocumentation (uint16_t uid) const;
+  const struct TypeId::AttributeInformation * LookupAttribute (uint16_t uid, const std::string &name) const;
+  const struct TypeId::TraceSourceInformation * LookupTraceSource (uint16_t uid, const std::string &name) const;
 
 private:
   bool HasTraceSource (uint16_t uid, std::string name);
   bool HasAttribute (uint16_t uid, std::string name);
   static TypeId::hash_t Hasher (const std::string name);
 
+  /// An entry of a name index.
+  struct IndexEntry {
+    uint32_t hash;        //!< the hash of the name
+    uint16_t uid;         //!< the type which registered the name
+    uint32_t i;           //!< the index of the name in this type
+    /// Order the entries by hash.
+    bool operator < (const struct IndexEntry &o) const { return hash < o.hash; }
+  };
+  /// A name index, sorted by hash.
+  typedef std::vector<struct IndexEntry> Index;
+  /**
+   * \param name a name
+   * \returns the hash of the name in the indexes
+   *
+   * This is not the TypeId hash: it is computed without any state, so
+   * that concurrent lookups are safe.
+   */
+  static uint32_t IndexHash (const std::string &name);
+  /**
+   * \param index an index
+   * \param hash a hash
+   * \returns the first entry of the index with this hash, or the end
+   */
+  static Index::const_iterator FindFirst (const Index &index, uint32_t hash);
+  /**
+   * Rebuild the attribute and trace source indexes of a type, and
+   * of all its registered descendants.
+   * \param uid the type
+   */
+  void UpdateIndexes (uint16_t uid);
+  /**
+   * Rebuild the attribute and trace source indexes of a type.
+   * \param uid the type
+   */
+  void BuildIndexes (uint16_t uid);
+
   struct IidInformation {
     std::string name;
     TypeId::hash_t hash;
@@ -125,6 +173,9 @@ private:
     bool mustHideFromDocumentation;
     std::vector<struct TypeId::AttributeInformation> attributes;
     std::vector<struct TypeId::TraceSourceInformation> traceSources;
+    bool hasChildren;
+    Index attributeIndex;
+    Index traceSourceIndex;
   };
   typedef std::vector<struct IidInformation>::const_iterator Iterator;
 
@@ -132,8 +183,7 @@ private:
 
   std::vector<struct IidInformation> m_information;
 
-  typedef std::map<std::string, uint16_t> namemap_t;
-  namemap_t m_namemap;
+  Index m_nameIndex;
 
   typedef std::map<TypeId::hash_t, uint16_t> hashmap_t;
   hashmap_t m_hashmap;
@@ -162,7 +212,7 @@ IidManager::AllocateUid (std::string name)
 {
   NS_LOG_FUNCTION (this << name);
   // Type names are definitive: equal names are equal types
-  NS_ASSERT_MSG (m_namemap.count (name) == 0,
+  NS_ASSERT_MSG (GetUid (name) == 0,
                  "Trying to allocate twice the same uid: " << name);
   
   TypeId::hash_t hash = Hasher (name) & (~HashChainFlag);
@@ -218,12 +268,17 @@ IidManager::AllocateUid (std::string name)
   information.size = (std::size_t)(-1);
   information.hasConstructor = false;
   information.mustHideFromDocumentation = false;
+  information.hasChildren = false;
   m_information.push_back (information);
   uint32_t uid = m_information.size ();
   NS_ASSERT (uid <= 0xffff);
 
   // Add to both maps:
-  m_namemap.insert (std::make_pair (name, uid));
+  struct IndexEntry entry;
+  entry.hash = IndexHash (name);
+  entry.uid = uid;
+  entry.i = 0;
+  m_nameIndex.insert (std::upper_bound (m_nameIndex.begin (), m_nameIndex.end (), entry), entry);
   m_hashmap.insert (std::make_pair (hash, uid));
   return uid;
 }
@@ -243,6 +298,11 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  if (parent != 0 && parent != uid)
+    {
+      LookupInformation (parent)->hasChildren = true;
+    }
+  UpdateIndexes (uid);
 }
 void 
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -279,19 +339,41 @@ IidManager::AddConstructor (uint16_t uid, Callback<ObjectBase *> callback)
   information->constructor = callback;
 }
 
+uint32_t
+IidManager::IndexHash (const std::string &name)
+{
+  // 32-bit FNV-1a
+  uint32_t hash = 2166136261U;
+  for (std::string::const_iterator i = name.begin (); i != name.end (); ++i)
+    {
+      hash ^= static_cast<uint8_t> (*i);
+      hash *= 16777619U;
+    }
+  return hash;
+}
+
+IidManager::Index::const_iterator
+IidManager::FindFirst (const Index &index, uint32_t hash)
+{
+  struct IndexEntry entry;
+  entry.hash = hash;
+  return std::lower_bound (index.begin (), index.end (), entry);
+}
+
 uint16_t 
 IidManager::GetUid (std::string name) const
 {
   NS_LOG_FUNCTION (this << name);
-  namemap_t::const_iterator it = m_namemap.find (name);
-  if (it != m_namemap.end ())
-    {
-      return it->second;
-    }
-  else
+  uint32_t hash = IndexHash (name);
+  for (Index::const_iterator i = FindFirst (m_nameIndex, hash);
+       i != m_nameIndex.end () && i->hash == hash; ++i)
     {
-      return 0;
+      if (m_information[i->uid - 1].name == name)
+        {
+          return i->uid;
+        }
     }
+  return 0;
 }
 uint16_t 
 IidManager::GetUid (TypeId::hash_t hash) const
@@ -380,27 +462,7 @@ IidManager::HasAttribute (uint16_t uid,
                           std::string name)
 {
   NS_LOG_FUNCTION (this << uid << name);
-  struct IidInformation *information  = LookupInformation (uid);
-  while (true)
-    {
-      for (std::vector<struct TypeId::AttributeInformation>::const_iterator i = information->attributes.begin ();
-           i != information->attributes.end (); ++i)
-        {
-          if (i->name == name)
-            {
-              return true;
-            }
-        }
-      struct IidInformation *parent = LookupInformation (information->parent);
-      if (parent == information)
-        {
-          // top of inheritance tree
-          return false;
-        }
-      // check parent
-      information = parent;
-    }
-  return false;
+  return LookupAttribute (uid, name) != 0;
 }
 
 void 
@@ -428,6 +490,7 @@ IidManager::AddAttribute (uint16_t uid,
   info.accessor = accessor;
   info.checker = checker;
   information->attributes.push_back (info);
+  UpdateIndexes (uid);
 }
 void 
 IidManager::SetAttributeInitialValue(uint16_t uid,
@@ -463,27 +526,7 @@ IidManager::HasTraceSource (uint16_t uid,
                             std::string name)
 {
   NS_LOG_FUNCTION (this << uid << name);
-  struct IidInformation *information  = LookupInformation (uid);
-  while (true)
-    {
-      for (std::vector<struct TypeId::TraceSourceInformation>::const_iterator i = information->traceSources.begin ();
-           i != information->traceSources.end (); ++i)
-        {
-          if (i->name == name)
-            {
-              return true;
-            }
-        }
-      struct IidInformation *parent = LookupInformation (information->parent);
-      if (parent == information)
-        {
-          // top of inheritance tree
-          return false;
-        }
-      // check parent
-      information = parent;
-    }
-  return false;
+  return LookupTraceSource (uid, name) != 0;
 }
 
 void 
@@ -506,6 +549,7 @@ IidManager::AddTraceSource (uint16_t uid,
   source.accessor = accessor;
   source.callback = callback;
   information->traceSources.push_back (source);
+  UpdateIndexes (uid);
 }
 uint32_t 
 IidManager::GetTraceSourceN (uint16_t uid) const
@@ -530,6 +574,106 @@ IidManager::MustHideFromDocumentation (uint16_t uid) const
   return information->mustHideFromDocumentation;
 }
 
+const struct TypeId::AttributeInformation *
+IidManager::LookupAttribute (uint16_t uid, const std::string &name) const
+{
+  NS_LOG_FUNCTION (this << uid << name);
+  const Index &index = LookupInformation (uid)->attributeIndex;
+  uint32_t hash = IndexHash (name);
+  for (Index::const_iterator i = FindFirst (index, hash);
+       i != index.end () && i->hash == hash; ++i)
+    {
+      const struct TypeId::AttributeInformation *info = &m_information[i->uid - 1].attributes[i->i];
+      if (info->name == name)
+        {
+          return info;
+        }
+    }
+  return 0;
+}
+
+const struct TypeId::TraceSourceInformation *
+IidManager::LookupTraceSource (uint16_t uid, const std::string &name) const
+{
+  NS_LOG_FUNCTION (this << uid << name);
+  const Index &index = LookupInformation (uid)->traceSourceIndex;
+  uint32_t hash = IndexHash (name);
+  for (Index::const_iterator i = FindFirst (index, hash);
+       i != index.end () && i->hash == hash; ++i)
+    {
+      const struct TypeId::TraceSourceInformation *info = &m_information[i->uid - 1].traceSources[i->i];
+      if (info->name == name)
+        {
+          return info;
+        }
+    }
+  return 0;
+}
+
+void
+IidManager::UpdateIndexes (uint16_t uid)
+{
+  NS_LOG_FUNCTION (this << uid);
+  BuildIndexes (uid);
+  if (!LookupInformation (uid)->hasChildren)
+    {
+      return;
+    }
+  // the types are usually registered before their children, which
+  // makes this loop rare.
+  for (uint16_t other = 1; other <= m_information.size (); other++)
+    {
+      uint16_t ancestor = other;
+      uint16_t parent = m_information[ancestor - 1].parent;
+      while (parent != 0 && parent != ancestor && parent != uid)
+        {
+          ancestor = parent;
+          parent = m_information[ancestor - 1].parent;
+        }
+      if (parent == uid && other != uid)
+        {
+          BuildIndexes (other);
+        }
+    }
+}
+
+void
+IidManager::BuildIndexes (uint16_t uid)
+{
+  NS_LOG_FUNCTION (this << uid);
+  struct IidInformation *information = LookupInformation (uid);
+  information->attributeIndex.clear ();
+  information->traceSourceIndex.clear ();
+  // the type first, then its parents: the stable sort keeps the closest
+  // name first among those with the same hash.
+  uint16_t current = uid;
+  while (true)
+    {
+      const struct IidInformation *level = LookupInformation (current);
+      struct IndexEntry entry;
+      entry.uid = current;
+      for (uint32_t i = 0; i < level->attributes.size (); i++)
+        {
+          entry.hash = IndexHash (level->attributes[i].name);
+          entry.i = i;
+          information->attributeIndex.push_back (entry);
+        }
+      for (uint32_t i = 0; i < level->traceSources.size (); i++)
+        {
+          entry.hash = IndexHash (level->traceSources[i].name);
+          entry.i = i;
+          information->traceSourceIndex.push_back (entry);
+        }
+      if (level->parent == 0 || level->parent == current)
+        {
+          break;
+        }
+      current = level->parent;
+    }
+  std::stable_sort (information->attributeIndex.begin (), information->attributeIndex.end ());
+  std::stable_sort (information->traceSourceIndex.begin (), information->traceSourceIndex.end ());
+}
+
 } // namespace ns3
 
 namespace ns3 {
@@ -609,22 +753,14 @@ bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
 {
   NS_LOG_FUNCTION (this << name << info);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do {
-      tid = nextTid;
-      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
-        {
-          struct TypeId::AttributeInformation tmp = tid.GetAttribute(i);
-          if (tmp.name == name)
-            {
-              *info = tmp;
-              return true;
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return false;
+  const struct TypeId::AttributeInformation *found =
+    Singleton<IidManager>::Get ()->LookupAttribute (m_tid, name);
+  if (found == 0)
+    {
+      return false;
+    }
+  *info = *found;
+  return true;
 }
 
 TypeId 
@@ -827,21 +963,13 @@ Ptr<const TraceSourceAccessor>
 TypeId::LookupTraceSourceByName (std::string name) const
 {
   NS_LOG_FUNCTION (this << name);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do {
-      tid = nextTid;
-      for (uint32_t i = 0; i < tid.GetTraceSourceN (); i++)
-        {
-          struct TypeId::TraceSourceInformation info = tid.GetTraceSource (i);
-          if (info.name == name)
-            {
-              return info.accessor;
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return 0;
+  const struct TypeId::TraceSourceInformation *found =
+    Singleton<IidManager>::Get ()->LookupTraceSource (m_tid, name);
+  if (found == 0)
+    {
+      return 0;
+    }
+  return found->accessor;
 }
 
 uint16_t 
@@ -18,6 +18,8 @@
 
 #include "ns3/test.h"
 #include "ns3/callback.h"
+#include "ns3/simple-ref-count.h"
+#include <string>
 #include <stdint.h>
 
 using namespace ns3;
@@ -688,6 +690,87 @@ MakeCallbackTemplatesTestCase::DoRun (void)
   that.CheckParentalRights ();
 }
 
+// ===========================================================================
+// Test the storage of the callbacks, inline or on the heap
+// ===========================================================================
+class CallbackStorageTestCase : public TestCase
+{
+public:
+  CallbackStorageTestCase ();
+  virtual ~CallbackStorageTestCase () {}
+
+  /// An object counting its live instances.
+  class Counted : public SimpleRefCount<Counted>
+  {
+  public:
+    Counted () { m_live++; }
+    ~Counted () { m_live--; }
+    static int m_live;
+  };
+
+private:
+  virtual void DoRun (void);
+};
+
+int CallbackStorageTestCase::Counted::m_live = 0;
+
+static int gCallbackStorageTest;
+int CallbackStorageTarget1 (Ptr<CallbackStorageTestCase::Counted> counted, int a)
+{
+  gCallbackStorageTest = a;
+  return counted->GetReferenceCount ();
+}
+int CallbackStorageTarget2 (std::string a, std::string b, std::string c, int d)
+{
+  gCallbackStorageTest = a.size () + b.size () + c.size () + d;
+  return d;
+}
+
+CallbackStorageTestCase::CallbackStorageTestCase ()
+  : TestCase ("Check the copies and the lifetime of inline and heap callbacks")
+{
+}
+
+void
+CallbackStorageTestCase::DoRun (void)
+{
+  {
+    Ptr<Counted> counted = Create<Counted> ();
+    Callback<int,int> a = MakeBoundCallback (&CallbackStorageTarget1, counted);
+    NS_TEST_ASSERT_MSG_EQ (counted->GetReferenceCount (), 2, "Bound argument not held");
+    Callback<int,int> b = a;
+    NS_TEST_ASSERT_MSG_EQ (counted->GetReferenceCount (), 3, "Bound argument not copied");
+    NS_TEST_ASSERT_MSG_EQ (a.IsEqual (b), true, "Copies are not equal");
+    NS_TEST_ASSERT_MSG_EQ (b (5), 4, "Copy did not fire");
+    NS_TEST_ASSERT_MSG_EQ (gCallbackStorageTest, 5, "Copy did not fire");
+    b = b;
+    b.Assign (a);
+    NS_TEST_ASSERT_MSG_EQ (counted->GetReferenceCount (), 3, "Assignment leaked");
+    a.Nullify ();
+    NS_TEST_ASSERT_MSG_EQ (counted->GetReferenceCount (), 2, "Nullify did not release");
+    NS_TEST_ASSERT_MSG_EQ (b.IsNull (), false, "Copy nullified");
+
+    CallbackValue value (b);
+    Callback<int,int> c;
+    NS_TEST_ASSERT_MSG_EQ (value.GetAccessor (c), true, "CallbackValue type check failed");
+    NS_TEST_ASSERT_MSG_EQ (c.IsEqual (b), true, "CallbackValue copy is not equal");
+    NS_TEST_ASSERT_MSG_EQ (c (7), 5, "CallbackValue copy did not fire");
+    NS_TEST_ASSERT_MSG_EQ (gCallbackStorageTest, 7, "CallbackValue copy did not fire");
+    Callback<void> d;
+    NS_TEST_ASSERT_MSG_EQ (value.GetAccessor (d), false, "CallbackValue type check passed");
+  }
+  NS_TEST_ASSERT_MSG_EQ (Counted::m_live, 0, "Bound argument leaked");
+
+  // three strings do not fit in a callback
+  Callback<int,int> large =
+    MakeBoundCallback (&CallbackStorageTarget2, std::string ("a"), std::string ("bc"), std::string ("def"));
+  Callback<int,int> copy = large;
+  large.Nullify ();
+  NS_TEST_ASSERT_MSG_EQ (copy (4), 4, "Heap callback did not fire");
+  NS_TEST_ASSERT_MSG_EQ (gCallbackStorageTest, 10, "Heap callback did not fire");
+  NS_TEST_ASSERT_MSG_EQ (PeekPointer (copy.GetImpl ()), copy.PeekImpl (), "Heap callback not shared");
+}
+
 // ===========================================================================
 // The Test Suite that glues all of the Test Cases together.
 // ===========================================================================
@@ -705,6 +788,7 @@ CallbackTestSuite::CallbackTestSuite ()
   AddTestCase (new MakeBoundCallbackTestCase, TestCase::QUICK);
   AddTestCase (new NullifyCallbackTestCase, TestCase::QUICK);
   AddTestCase (new MakeCallbackTemplatesTestCase, TestCase::QUICK);
+  AddTestCase (new CallbackStorageTestCase, TestCase::QUICK);
 }
 
 static CallbackTestSuite CallbackTestSuite;
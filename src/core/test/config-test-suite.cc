@@ -721,6 +721,83 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+// ===========================================================================
+// Test that paths looked up together match the same objects as when they
+// are looked up one by one.
+// ===========================================================================
+class BatchLookupMatchesConfigTestCase : public TestCase
+{
+public:
+  BatchLookupMatchesConfigTestCase ();
+  virtual ~BatchLookupMatchesConfigTestCase () {}
+
+private:
+  virtual void DoRun (void);
+};
+
+BatchLookupMatchesConfigTestCase::BatchLookupMatchesConfigTestCase ()
+  : TestCase ("Check that a batch of paths is resolved like each of its paths")
+{
+}
+
+void
+BatchLookupMatchesConfigTestCase::DoRun (void)
+{
+  //
+  // /Names/BatchRoot/NodesA/i/NodeB and /Names/BatchRoot/NodesA/i/NodesB/j
+  // for i in [0,3[ and j in [0,2[.
+  //
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Names::Add ("BatchRoot", root);
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+      root->AddNodeA (a);
+      a->SetNodeB (CreateObject<DerivedConfigTestObject> ());
+      a->AddNodeB (CreateObject<ConfigTestObject> ());
+      a->AddNodeB (CreateObject<ConfigTestObject> ());
+    }
+
+  std::vector<std::string> paths;
+  paths.push_back ("/Names/BatchRoot/NodesA/*/NodeB");
+  paths.push_back ("/Names/BatchRoot/NodesA/1/NodeB/");
+  paths.push_back ("/Names/BatchRoot/NodesA/*/NodesB/*");
+  paths.push_back ("/Names/BatchRoot/NodesA/*/NodeB");
+  paths.push_back ("Names/BatchRoot/NodesA/[1-2]/*/*");
+  paths.push_back ("/Names/BatchRoot/NodesA/*/NodeB/$DerivedConfigTestObject");
+  paths.push_back ("/Names/BatchRoot/NodesA/*/Missing");
+  paths.push_back ("/Names/BatchRoot/NodesA");
+
+  uint32_t expected[] = { 3, 1, 6, 3, 4, 3, 0, 0 };
+  std::vector<Config::MatchContainer> batch = Config::LookupMatches (paths);
+  NS_TEST_ASSERT_MSG_EQ (batch.size (), paths.size (), "One container per path");
+  for (uint32_t i = 0; i < paths.size (); i++)
+    {
+      Config::MatchContainer alone = Config::LookupMatches (paths[i]);
+      NS_TEST_ASSERT_MSG_EQ (batch[i].GetPath (), paths[i], "Wrong path");
+      NS_TEST_ASSERT_MSG_EQ (batch[i].GetN (), expected[i], "Wrong number of matches of " << paths[i]);
+      NS_TEST_ASSERT_MSG_EQ (alone.GetN (), expected[i], "Wrong number of matches of " << paths[i]);
+      for (uint32_t j = 0; j < alone.GetN (); j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (batch[i].Get (j), alone.Get (j), "Different match of " << paths[i]);
+          NS_TEST_ASSERT_MSG_EQ (batch[i].GetMatchedPath (j), alone.GetMatchedPath (j), "Different match of " << paths[i]);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (batch[1].GetMatchedPath (0), "/Names/BatchRoot/NodesA/1/NodeB/", "Wrong matched path");
+  NS_TEST_ASSERT_MSG_EQ (batch[4].GetMatchedPath (0), "/Names/BatchRoot/NodesA/1/NodesB/0/", "Wrong matched path");
+
+  //
+  // The matches of a batch are configured like those of a single path.
+  //
+  Config::MatchContainer nodes = Config::LookupMatches (std::vector<std::string> (1, paths[2]))[0];
+  nodes.Set ("A", IntegerValue (3));
+  IntegerValue iv;
+  nodes.Get (5)->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 3, "Object Attribute \"A\" not set as expected");
+
+  Names::Clear ();
+}
+
 // ===========================================================================
 // The Test Suite that glues all of the Test Cases together.
 // ===========================================================================
@@ -737,6 +814,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase, TestCase::QUICK);
   AddTestCase (new ObjectVectorConfigTestCase, TestCase::QUICK);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase, TestCase::QUICK);
+  AddTestCase (new BatchLookupMatchesConfigTestCase, TestCase::QUICK);
 }
 
 static ConfigTestSuite configTestSuite;
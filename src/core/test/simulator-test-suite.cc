@@ -23,6 +23,12 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/dary-heap-scheduler.h"
+#include "ns3/timing-wheel-scheduler.h"
+#include "ns3/recording-scheduler.h"
+#include "ns3/string.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -459,6 +465,156 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SchedulerRemoveTestCase : public TestCase
+{
+public:
+  SchedulerRemoveTestCase (ObjectFactory schedulerFactory);
+private:
+  virtual void DoRun (void);
+  ObjectFactory m_schedulerFactory;
+};
+
+SchedulerRemoveTestCase::SchedulerRemoveTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that removed events are not returned with " + schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+void
+SchedulerRemoveTestCase::DoRun (void)
+{
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  std::vector<Scheduler::Event> events;
+  // the events are never invoked, so a fake implementation pointer is enough
+  static uint64_t impls[1000];
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      Scheduler::Event ev;
+      ev.impl = reinterpret_cast<EventImpl *> (&impls[i]);
+      ev.key.m_ts = (i * 7919) % 613;
+      ev.key.m_uid = i + 4;
+      ev.key.m_context = 0;
+      scheduler->Insert (ev);
+      events.push_back (ev);
+    }
+  // remove two events out of three, in insertion order
+  uint32_t removed = 0;
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      if (i % 3 != 0)
+        {
+          scheduler->Remove (events[i]);
+          removed++;
+        }
+    }
+  uint32_t count = 0;
+  Scheduler::EventKey last = { 0, 0, 0 };
+  while (!scheduler->IsEmpty ())
+    {
+      Scheduler::Event next = scheduler->PeekNext ();
+      Scheduler::Event ev = scheduler->RemoveNext ();
+      NS_TEST_EXPECT_MSG_EQ (next.key.m_uid, ev.key.m_uid, "PeekNext and RemoveNext differ");
+      NS_TEST_EXPECT_MSG_EQ ((ev.key.m_uid - 4) % 3, 0, "Removed event returned");
+      NS_TEST_EXPECT_MSG_EQ ((ev.key < last), false, "Events out of order");
+      last = ev.key;
+      count++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (count, 1000 - removed, "Wrong number of events");
+}
+
+class SimulatorEventPoolTestCase : public TestCase
+{
+public:
+  SimulatorEventPoolTestCase ();
+private:
+  virtual void DoRun (void);
+  void Next (uint32_t left, uint64_t dummy);
+  uint32_t m_count;
+};
+
+SimulatorEventPoolTestCase::SimulatorEventPoolTestCase ()
+  : TestCase ("Check that released events are reused")
+{
+}
+
+void
+SimulatorEventPoolTestCase::Next (uint32_t left, uint64_t dummy)
+{
+  m_count++;
+  if (left > 0)
+    {
+      Simulator::Schedule (MicroSeconds (1), &SimulatorEventPoolTestCase::Next, this, left - 1, dummy);
+    }
+}
+
+void
+SimulatorEventPoolTestCase::DoRun (void)
+{
+  m_count = 0;
+  Simulator::Schedule (MicroSeconds (1), &SimulatorEventPoolTestCase::Next, this, 99, 0);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_count, 100, "All events should have run");
+
+  Ptr<SimulatorImpl> impl = Simulator::GetImplementation ();
+  if (impl->GetInstanceTypeId () == DefaultSimulatorImpl::GetTypeId ())
+    {
+      UintegerValue allocations, pooled;
+      impl->GetAttribute ("EventAllocations", allocations);
+      impl->GetAttribute ("PooledEventAllocations", pooled);
+      NS_TEST_EXPECT_MSG_GT_OR_EQ (allocations.Get (), 100, "Events not counted");
+      // an event is released right after scheduling the next one of the
+      // chain, so all but the first two should come from the free list
+      NS_TEST_EXPECT_MSG_GT_OR_EQ (pooled.Get (), 98, "Released events not reused");
+    }
+  Simulator::Destroy ();
+}
+
+class RecordingSchedulerTestCase : public TestCase
+{
+public:
+  RecordingSchedulerTestCase ();
+private:
+  virtual void DoRun (void);
+  void Event (void) {}
+};
+
+RecordingSchedulerTestCase::RecordingSchedulerTestCase ()
+  : TestCase ("Check that the scheduler operations are recorded")
+{
+}
+
+void
+RecordingSchedulerTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("simulator-test.rec");
+  ObjectFactory factory ("ns3::RecordingScheduler");
+  factory.Set ("FileName", StringValue (filename));
+  Simulator::SetScheduler (factory);
+  Simulator::Schedule (MicroSeconds (10), &RecordingSchedulerTestCase::Event, this);
+  EventId removed = Simulator::Schedule (MicroSeconds (20), &RecordingSchedulerTestCase::Event, this);
+  Simulator::ScheduleWithContext (7, MicroSeconds (30), &RecordingSchedulerTestCase::Event, this);
+  Simulator::Remove (removed);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  uint64_t us = MicroSeconds (1).GetTimeStep ();
+  std::vector<RecordingScheduler::Record> records;
+  bool ok = RecordingScheduler::Read (filename, records);
+  NS_TEST_ASSERT_MSG_EQ (ok, true, "Cannot read the record");
+  NS_TEST_ASSERT_MSG_EQ (records.size (), 6, "Wrong number of records");
+  NS_TEST_EXPECT_MSG_EQ (records[0].op, RecordingScheduler::INSERT, "Wrong operation");
+  NS_TEST_EXPECT_MSG_EQ (records[0].key.m_ts, 10 * us, "Wrong timestamp");
+  NS_TEST_EXPECT_MSG_EQ (records[2].op, RecordingScheduler::INSERT, "Wrong operation");
+  NS_TEST_EXPECT_MSG_EQ (records[2].key.m_context, 7, "Wrong context");
+  NS_TEST_EXPECT_MSG_EQ (records[3].op, RecordingScheduler::REMOVE, "Wrong operation");
+  NS_TEST_EXPECT_MSG_EQ (records[3].key.m_uid, records[1].key.m_uid, "Wrong removed event");
+  NS_TEST_EXPECT_MSG_EQ (records[3].key.m_ts, 20 * us, "Wrong timestamp");
+  NS_TEST_EXPECT_MSG_EQ (records[4].op, RecordingScheduler::REMOVE_NEXT, "Wrong operation");
+  NS_TEST_EXPECT_MSG_EQ (records[4].key.m_ts, 10 * us, "Wrong timestamp");
+  NS_TEST_EXPECT_MSG_EQ (records[5].op, RecordingScheduler::REMOVE_NEXT, "Wrong operation");
+  NS_TEST_EXPECT_MSG_EQ (records[5].key.m_ts, 30 * us, "Wrong timestamp");
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -475,5 +631,28 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.Set ("Arity", UintegerValue (2));
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory = ObjectFactory ();
+    factory.SetTypeId (TimingWheelScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.Set ("Buckets", UintegerValue (4));
+    factory.Set ("BucketWidth", TimeValue (NanoSeconds (3)));
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SchedulerRemoveTestCase (ObjectFactory ("ns3::ListScheduler")), TestCase::QUICK);
+    AddTestCase (new SchedulerRemoveTestCase (ObjectFactory ("ns3::MapScheduler")), TestCase::QUICK);
+    AddTestCase (new SchedulerRemoveTestCase (ObjectFactory ("ns3::HeapScheduler")), TestCase::QUICK);
+    AddTestCase (new SchedulerRemoveTestCase (ObjectFactory ("ns3::CalendarScheduler")), TestCase::QUICK);
+    AddTestCase (new SchedulerRemoveTestCase (ObjectFactory ("ns3::DaryHeapScheduler")), TestCase::QUICK);
+    AddTestCase (new SchedulerRemoveTestCase (ObjectFactory ("ns3::TimingWheelScheduler")), TestCase::QUICK);
+    factory = ObjectFactory ();
+    factory.SetTypeId (TimingWheelScheduler::GetTypeId ());
+    factory.Set ("Buckets", UintegerValue (16));
+    factory.Set ("BucketWidth", TimeValue (NanoSeconds (5)));
+    AddTestCase (new SchedulerRemoveTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorEventPoolTestCase (), TestCase::QUICK);
+    AddTestCase (new RecordingSchedulerTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
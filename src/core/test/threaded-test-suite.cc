@@ -26,6 +26,8 @@
 #include "ns3/config.h"
 #include "ns3/string.h"
 #include "ns3/system-thread.h"
+#include "ns3/nstime.h"
+#include "ns3/uinteger.h"
 
 #include <ctime>
 #include <list>
@@ -178,6 +180,10 @@ ThreadedSimulatorEventsTestCase::DoSetup (void)
     {
       Config::SetGlobal ("SimulatorImplementationType", StringValue (m_simulatorType));
     }
+  if (m_simulatorType == "ns3::MultithreadedSimulatorImpl")
+    {
+      Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (MicroSeconds (1)));
+    }
   
   m_error = "";
   
@@ -199,6 +205,7 @@ ThreadedSimulatorEventsTestCase::DoTeardown (void)
 {
   m_threadlist.clear();
  
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (Seconds (0)));
   Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
 }
 void 
@@ -225,6 +232,147 @@ ThreadedSimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_a, m_d, "Bad scheduling");
 }
 
+class MultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorTestCase (uint32_t threads);
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+  /**
+   * Run the events of the test with a simulator implementation.
+   * \param simulatorType the simulator implementation
+   * \param stopNow whether an event of context 0 calls Simulator::Stop ()
+   */
+  void RunRing (std::string simulatorType, bool stopNow = false);
+  void Ring (uint32_t hops);
+  void Local (uint32_t context);
+  static void StopNow (void);
+
+  static const uint32_t CONTEXTS = 8;
+  uint32_t m_threads;
+  uint32_t m_count[CONTEXTS];
+  int64_t m_sum[CONTEXTS];
+  uint32_t m_errors[CONTEXTS];
+  Time m_end;
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase (uint32_t threads)
+  : TestCase ("Check that events across partitions run as with the default simulator"),
+    m_threads (threads)
+{
+}
+
+void
+MultithreadedSimulatorTestCase::Ring (uint32_t hops)
+{
+  uint32_t context = Simulator::GetContext ();
+  if (context >= CONTEXTS)
+    {
+      return;
+    }
+  m_count[context]++;
+  m_sum[context] += Simulator::Now ().GetNanoSeconds ();
+  if (hops > 0)
+    {
+      Simulator::ScheduleWithContext ((context + 1) % CONTEXTS, MicroSeconds (10),
+                                      &MultithreadedSimulatorTestCase::Ring, this, hops - 1);
+    }
+  Simulator::Schedule (MicroSeconds (3), &MultithreadedSimulatorTestCase::Local, this, context);
+}
+
+void
+MultithreadedSimulatorTestCase::Local (uint32_t context)
+{
+  if (Simulator::GetContext () != context)
+    {
+      m_errors[context]++;
+    }
+  m_count[context]++;
+  m_sum[context] += Simulator::Now ().GetNanoSeconds ();
+}
+
+void
+MultithreadedSimulatorTestCase::StopNow (void)
+{
+  Simulator::Stop ();
+}
+
+void
+MultithreadedSimulatorTestCase::RunRing (std::string simulatorType, bool stopNow)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (simulatorType));
+  for (uint32_t i = 0; i < CONTEXTS; i++)
+    {
+      m_count[i] = 0;
+      m_sum[i] = 0;
+      m_errors[i] = 0;
+      Simulator::ScheduleWithContext (i, MicroSeconds (i), &MultithreadedSimulatorTestCase::Ring, this, 100);
+    }
+  if (stopNow)
+    {
+      Simulator::ScheduleWithContext (0, NanoSeconds (250500), &MultithreadedSimulatorTestCase::StopNow);
+    }
+  Simulator::Stop (NanoSeconds (500500));
+  Simulator::Run ();
+  m_end = Simulator::Now ();
+  Simulator::Destroy ();
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun (void)
+{
+  RunRing ("ns3::DefaultSimulatorImpl");
+  uint32_t count[CONTEXTS];
+  int64_t sum[CONTEXTS];
+  for (uint32_t i = 0; i < CONTEXTS; i++)
+    {
+      count[i] = m_count[i];
+      sum[i] = m_sum[i];
+    }
+  Time end = m_end;
+  NS_TEST_ASSERT_MSG_GT (count[0], 50, "Too few events");
+
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Threads", UintegerValue (m_threads));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (MicroSeconds (10)));
+  RunRing ("ns3::MultithreadedSimulatorImpl");
+
+  for (uint32_t i = 0; i < CONTEXTS; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_errors[i], 0, "Event run with a wrong context");
+      NS_TEST_EXPECT_MSG_EQ (m_count[i], count[i], "Wrong number of events for context " << i);
+      NS_TEST_EXPECT_MSG_EQ (m_sum[i], sum[i], "Events run at wrong times for context " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_end, end, "Wrong stop time");
+
+  // Simulator::Stop () ends the run after the window of the event which
+  // called it, in every partition: the runs are identical.
+  RunRing ("ns3::MultithreadedSimulatorImpl", true);
+  NS_TEST_EXPECT_MSG_LT (m_count[0], count[0], "Stop () ignored");
+  for (uint32_t i = 0; i < CONTEXTS; i++)
+    {
+      count[i] = m_count[i];
+      sum[i] = m_sum[i];
+    }
+  for (uint32_t run = 0; run < 5; run++)
+    {
+      RunRing ("ns3::MultithreadedSimulatorImpl", true);
+      for (uint32_t i = 0; i < CONTEXTS; i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (m_count[i], count[i], "Stop () at another event for context " << i);
+          NS_TEST_EXPECT_MSG_EQ (m_sum[i], sum[i], "Stop () at another time for context " << i);
+        }
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::DoTeardown (void)
+{
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Threads", UintegerValue (0));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (Seconds (0)));
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+}
+
 class ThreadedSimulatorTestSuite : public TestSuite
 {
 public:
@@ -235,6 +383,7 @@ public:
 #ifdef HAVE_RT
       "ns3::RealtimeSimulatorImpl",
 #endif
+      "ns3::MultithreadedSimulatorImpl",
       "ns3::DefaultSimulatorImpl"
     };
     std::string schedulerTypes[] = {
@@ -262,5 +411,8 @@ public:
               }
           }
       }
+    AddTestCase (new MultithreadedSimulatorTestCase (1), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorTestCase (3), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorTestCase (8), TestCase::QUICK);
   }
 } g_threadedSimulatorTestSuite;
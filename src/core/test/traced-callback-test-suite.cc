@@ -108,6 +108,76 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class ReentrantTracedCallbackTestCase : public TestCase
+{
+public:
+  ReentrantTracedCallbackTestCase ();
+  virtual ~ReentrantTracedCallbackTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+  void CbOne (uint32_t a);
+  void CbTwo (uint32_t a);
+
+  TracedCallback<uint32_t> m_trace;
+  uint32_t m_one;
+  uint32_t m_two;
+};
+
+ReentrantTracedCallbackTestCase::ReentrantTracedCallbackTestCase ()
+  : TestCase ("Check IsEmpty and connections from a TracedCallback callback")
+{
+}
+
+void
+ReentrantTracedCallbackTestCase::CbOne (uint32_t a)
+{
+  m_one += a;
+  // disconnect itself, and connect the other callback
+  m_trace.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbOne, this));
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbTwo, this));
+}
+
+void
+ReentrantTracedCallbackTestCase::CbTwo (uint32_t a)
+{
+  m_two += a;
+}
+
+void
+ReentrantTracedCallbackTestCase::DoRun (void)
+{
+  m_one = 0;
+  m_two = 0;
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "New TracedCallback not empty");
+  m_trace (1);
+
+  m_trace.ConnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbOne, this));
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), false, "Connected TracedCallback empty");
+  TracedCallback<uint32_t> copy = m_trace;
+
+  //
+  // The callbacks connected during a call are called from the next call
+  //
+  m_trace (1);
+  NS_TEST_ASSERT_MSG_EQ (m_one, 1, "Callback CbOne not called once");
+  NS_TEST_ASSERT_MSG_EQ (m_two, 0, "Callback CbTwo called during the call connecting it");
+  NS_TEST_ASSERT_MSG_EQ (m_trace.GetN (), 1, "Wrong number of callbacks");
+  m_trace (2);
+  NS_TEST_ASSERT_MSG_EQ (m_one, 1, "Disconnected callback CbOne called");
+  NS_TEST_ASSERT_MSG_EQ (m_two, 2, "Callback CbTwo not called");
+
+  //
+  // A copy keeps the callbacks of the original at the time of the copy
+  //
+  NS_TEST_ASSERT_MSG_EQ (copy.GetN (), 1, "Copy modified");
+  m_trace.DisconnectWithoutContext (MakeCallback (&ReentrantTracedCallbackTestCase::CbTwo, this));
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "Disconnected TracedCallback not empty");
+  m_trace (4);
+  NS_TEST_ASSERT_MSG_EQ (m_two, 2, "Callback CbTwo called after disconnection");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -118,6 +188,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new ReentrantTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
@@ -23,6 +23,7 @@
 #include <ctime>
 
 #include "ns3/type-id.h"
+#include "ns3/integer.h"
 #include "ns3/test.h"
 #include "ns3/log.h"
 
@@ -188,6 +189,92 @@ CollisionTestCase::DoRun (void)
 }
   
   
+//----------------------------
+//
+// Attribute and trace source lookup test
+
+class LookupByNameTestCase : public TestCase
+{
+public:
+  LookupByNameTestCase ();
+  virtual ~LookupByNameTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+LookupByNameTestCase::LookupByNameTestCase ()
+  : TestCase ("Check attribute and trace source lookup by name")
+{
+}
+
+LookupByNameTestCase::~LookupByNameTestCase ()
+{
+}
+
+void
+LookupByNameTestCase::DoRun (void)
+{
+  // every attribute and trace source is found from its type and from its
+  // descendants, unless a closer type has one with the same name.
+  uint32_t nids = TypeId::GetRegisteredN ();
+  for (uint32_t i = 0; i < nids; ++i)
+    {
+      const TypeId tid = TypeId::GetRegistered (i);
+      TypeId level = tid;
+      while (true)
+        {
+          for (uint32_t j = 0; j < level.GetAttributeN (); j++)
+            {
+              struct TypeId::AttributeInformation expected = level.GetAttribute (j);
+              struct TypeId::AttributeInformation info;
+              NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName (expected.name, &info), true,
+                                     "Attribute " << expected.name << " not found from " << tid.GetName ());
+              NS_TEST_ASSERT_MSG_EQ (info.name, expected.name, "Wrong attribute found");
+            }
+          for (uint32_t j = 0; j < level.GetTraceSourceN (); j++)
+            {
+              struct TypeId::TraceSourceInformation expected = level.GetTraceSource (j);
+              NS_TEST_ASSERT_MSG_EQ ((tid.LookupTraceSourceByName (expected.name) != 0), (expected.accessor != 0),
+                                     "Trace source " << expected.name << " not found from " << tid.GetName ());
+            }
+          // the types of the collision test have no parent
+          if (!level.HasParent () || level.GetParent ().GetUid () == 0)
+            {
+              break;
+            }
+          level = level.GetParent ();
+        }
+      struct TypeId::AttributeInformation info;
+      NS_TEST_ASSERT_MSG_EQ (tid.LookupAttributeByName ("NoSuchAttribute", &info), false,
+                             "Unexpected attribute found from " << tid.GetName ());
+      NS_TEST_ASSERT_MSG_EQ ((tid.LookupTraceSourceByName ("NoSuchTraceSource") == 0), true,
+                             "Unexpected trace source found from " << tid.GetName ());
+    }
+
+  // the attributes added to a type after its children are registered
+  // are found from them, and the closest attribute hides the others.
+  TypeId parent = TypeId ("TypeIdLookupParent");
+  parent.SetParent (parent);
+  TypeId child = TypeId ("TypeIdLookupChild");
+  child.SetParent (parent);
+  child.AddAttribute ("Value", "child value", IntegerValue (2),
+                      Ptr<const AttributeAccessor> (0), MakeIntegerChecker<int32_t> ());
+  parent.AddAttribute ("Inherited", "parent attribute", IntegerValue (1),
+                       Ptr<const AttributeAccessor> (0), MakeIntegerChecker<int32_t> ());
+
+  NS_TEST_ASSERT_MSG_EQ (TypeId::LookupByName ("TypeIdLookupChild"), child, "Wrong TypeId");
+  struct TypeId::AttributeInformation info;
+  NS_TEST_ASSERT_MSG_EQ (child.LookupAttributeByName ("Inherited", &info), true,
+                         "Attribute of the parent not found");
+  NS_TEST_ASSERT_MSG_EQ (info.help, "parent attribute", "Wrong attribute found");
+  NS_TEST_ASSERT_MSG_EQ (parent.LookupAttributeByName ("Value", &info), false,
+                         "Attribute of the child found from the parent");
+  NS_TEST_ASSERT_MSG_EQ (child.LookupAttributeByName ("Value", &info), true,
+                         "Attribute of the child not found");
+  NS_TEST_ASSERT_MSG_EQ (info.help, "child value", "Wrong attribute found");
+}
+
+
 //----------------------------
 //
 // Performance test
@@ -298,6 +385,7 @@ TypeIdTestSuite::TypeIdTestSuite ()
   // as chained.
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
+  AddTestCase (new LookupByNameTestCase, QUICK);
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;  
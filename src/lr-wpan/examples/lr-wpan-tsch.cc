@@ -63,6 +63,7 @@ double duty_cycle = 0.1;      //proportion of assigned timeslots with actual pac
 double duration = 20;       //simulation total duration, in seconds
 bool verbose = false;       //enable logging (different from trace)
 bool interference = false;  //enable wifi interference
+bool tracing = true;        //enable pcap, ascii and routing table output
 
 /////////////////////////////////
 // End configuration
@@ -156,6 +157,9 @@ int main (int argc, char** argv)
 {
   CommandLine cmd;
   cmd.AddValue ("verbose", "Print trace information if true", verbose);
+  cmd.AddValue ("nodes", "Number of nodes, not including the coordinator", nrnodes);
+  cmd.AddValue ("duration", "Simulation duration, in seconds", duration);
+  cmd.AddValue ("tracing", "Enable pcap, ascii and routing table output", tracing);
   cmd.Parse (argc, argv);
   GlobalValue::Bind ("ChecksumEnabled", BooleanValue (true));
 
@@ -211,13 +215,19 @@ int main (int argc, char** argv)
   /////////////////////////////////
 
   LrWpanTschHelper lrWpanHelper(channel,nrnodes+1,false,true);
-  Ptr<OutputStreamWrapper> stream = ascii.CreateFileStream ("lr-wpan-tsch.tr");
-  Ptr<OutputStreamWrapper> fstream = ascii.CreateFileStream ("lr-wpan-tsch.fading");
-  lrWpanHelper.PrintFadingBiasValues(fstream);
+  if (tracing)
+    {
+      Ptr<OutputStreamWrapper> fstream = ascii.CreateFileStream ("lr-wpan-tsch.fading");
+      lrWpanHelper.PrintFadingBiasValues(fstream);
+    }
   NetDeviceContainer netdev = lrWpanHelper.Install (lrwpanNodes);
 
-  lrWpanHelper.EnablePcapAll (string ("lr-wpan-tsch"), true);
-  lrWpanHelper.EnableAsciiAll (stream);
+  if (tracing)
+    {
+      Ptr<OutputStreamWrapper> stream = ascii.CreateFileStream ("lr-wpan-tsch.tr");
+      lrWpanHelper.EnablePcapAll (string ("lr-wpan-tsch"), true);
+      lrWpanHelper.EnableAsciiAll (stream);
+    }
 
   lrWpanHelper.AssociateToPan(netdev,123);
   lrWpanHelper.ConfigureSlotframeAllToPan(netdev,0,true,false);//devices,empty slots,bidirectional=true,use broadcast cells=false
@@ -240,12 +250,14 @@ int main (int argc, char** argv)
 	  deviceInterfaces.SetDefaultRoute(i,0);
   }
 
-  for (int i=0;i<=nrnodes;i++) {
+  if (tracing) {
+    for (int i=0;i<=nrnodes;i++) {
 	Ptr<Node> n=lrwpanNodes.Get(i);
   	cout << "=== node " << deviceInterfaces.GetAddress(i,0) 
 	     << " (IEEE " << DynamicCast<LrWpanTschNetDevice>(netdev.Get(i))->GetMac()->GetShortAddress() << ")"
 	     << " ===" << endl;
 	stackHelper.PrintRoutingTable (n);
+    }
   }
 
   //Ping6
@@ -273,7 +285,28 @@ int main (int argc, char** argv)
   /////////////////////////////////
   // Start and finish the simulation
   /////////////////////////////////
+  SystemWallClockMs clock;
+  clock.Start ();
   Simulator::Run ();
+  int64_t elapsed = clock.End ();
+
+  // the count of event allocations, which bounds the number of events
+  // scheduled, is only available with the default simulator
+  UintegerValue events;
+  if (Simulator::GetImplementation ()->GetAttributeFailSafe ("EventAllocations", events))
+    {
+      TypeIdValue scheduler;
+      GlobalValue::GetValueByName ("SchedulerType", scheduler);
+      cout << "Scheduler: " << scheduler.Get ().GetName ()
+           << ", nodes: " << nrnodes
+           << ", event allocations: " << events.Get ()
+           << ", wall clock: " << elapsed << " ms";
+      if (elapsed > 0)
+        {
+          cout << ", allocations/s: " << events.Get () * 1000 / elapsed;
+        }
+      cout << endl;
+    }
   Simulator::Destroy ();
 }
 
@@ -0,0 +1,245 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lr-wpan-binary-trace.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+#include <ns3/fatal-impl.h>
+#include <ns3/packet.h>
+#include <ns3/lr-wpan-mac-header.h>
+
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LrWpanBinaryTrace");
+
+NS_OBJECT_ENSURE_REGISTERED (LrWpanTraceWriter);
+
+namespace {
+
+const uint32_t MAGIC = 0x4c575442;      //!< "LWTB", in the byte order of the writer
+const uint16_t VERSION = 1;             //!< Version of the file format
+const uint32_t FILE_HEADER_SIZE = 16;   //!< Size of the file header
+const uint16_t RECORD_SIZE = 32;        //!< Size of a record
+
+/// The file header.
+struct FileHeader
+{
+  uint32_t magic;       //!< MAGIC
+  uint16_t version;     //!< VERSION
+  uint16_t recordSize;  //!< RECORD_SIZE
+  uint8_t reserved[8];  //!< zero
+};
+
+/**
+ * \param address a short address
+ * \returns the address, most significant byte first
+ */
+inline uint16_t
+ShortAddressToInt (Mac16Address address)
+{
+  uint8_t buffer[2];
+  address.CopyTo (buffer);
+  return (buffer[0] << 8) | buffer[1];
+}
+
+} // anonymous namespace
+
+TypeId
+LrWpanTraceWriter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LrWpanTraceWriter")
+    .SetParent<BufferedFileWriter> ()
+    .AddConstructor<LrWpanTraceWriter> ()
+  ;
+  return tid;
+}
+
+LrWpanTraceWriter::LrWpanTraceWriter ()
+  : m_buffer (&m_file)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (sizeof (LrWpanTraceRecord) == RECORD_SIZE);
+  NS_ASSERT (sizeof (FileHeader) == FILE_HEADER_SIZE);
+  FatalImpl::RegisterStream (&m_file);
+}
+
+LrWpanTraceWriter::~LrWpanTraceWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  FatalImpl::UnregisterStream (&m_file);
+  Close ();
+}
+
+bool
+LrWpanTraceWriter::Fail (void) const
+{
+  NS_LOG_FUNCTION (this);
+  m_buffer.Sync ();
+  return m_file.fail ();
+}
+
+void
+LrWpanTraceWriter::Open (std::string const &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+  m_file.open (filename.c_str (), std::ios::out | std::ios::trunc | std::ios::binary);
+
+  FileHeader header;
+  std::memset (&header, 0, sizeof (header));
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.recordSize = RECORD_SIZE;
+  std::memcpy (m_buffer.Reserve (FILE_HEADER_SIZE), &header, FILE_HEADER_SIZE);
+  m_buffer.Commit ();
+}
+
+void
+LrWpanTraceWriter::DoSetBufferSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  m_buffer.SetSize (size);
+}
+
+void
+LrWpanTraceWriter::DoSetAsyncFlush (bool async)
+{
+  NS_LOG_FUNCTION (this << async);
+  m_buffer.SetAsync (async);
+}
+
+void
+LrWpanTraceWriter::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_buffer.Flush ();
+  m_file.close ();
+}
+
+void
+LrWpanTraceWriter::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_buffer.Flush ();
+  m_file.flush ();
+}
+
+void
+LrWpanTraceWriter::Write (LrWpanTraceRecord const &record)
+{
+  std::memcpy (m_buffer.Reserve (RECORD_SIZE), &record, RECORD_SIZE);
+  m_buffer.Commit ();
+}
+
+void
+LrWpanTraceWriter::Write (Time t, uint32_t node, uint32_t device,
+                          enum LrWpanTraceRecord::Event event, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << t << node << device << event << p);
+  LrWpanMacHeader header;
+  p->PeekHeader (header);
+
+  LrWpanTraceRecord record;
+  std::memset (&record, 0, sizeof (record));
+  record.time = t.GetNanoSeconds ();
+  record.uid = p->GetUid ();
+  record.node = node;
+  record.device = device;
+  record.size = p->GetSize ();
+  record.source = LrWpanTraceRecord::NO_SHORT_ADDRESS;
+  if (header.GetSrcAddrMode () == LrWpanMacHeader::SHORTADDR)
+    {
+      record.source = ShortAddressToInt (header.GetShortSrcAddr ());
+    }
+  record.destination = LrWpanTraceRecord::NO_SHORT_ADDRESS;
+  if (header.GetDstAddrMode () == LrWpanMacHeader::SHORTADDR)
+    {
+      record.destination = ShortAddressToInt (header.GetShortDstAddr ());
+    }
+  record.sequence = header.GetSeqNum ();
+  record.event = event;
+  Write (record);
+}
+
+LrWpanTraceReader::LrWpanTraceReader ()
+  : m_records (0),
+    m_nRecords (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+bool
+LrWpanTraceReader::Open (std::string const &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+  if (!m_file.Open (filename) || m_file.GetSize () < FILE_HEADER_SIZE)
+    {
+      Close ();
+      return false;
+    }
+  FileHeader header;
+  std::memcpy (&header, m_file.GetData (), FILE_HEADER_SIZE);
+  if (header.magic != MAGIC || header.version != VERSION
+      || header.recordSize != RECORD_SIZE)
+    {
+      NS_LOG_LOGIC ("Not a binary trace of this host: magic " << std::hex << header.magic);
+      Close ();
+      return false;
+    }
+  // the header keeps the records aligned as the mapping
+  m_records = reinterpret_cast<LrWpanTraceRecord const *> (m_file.GetData () + FILE_HEADER_SIZE);
+  m_nRecords = (m_file.GetSize () - FILE_HEADER_SIZE) / RECORD_SIZE;
+  return true;
+}
+
+void
+LrWpanTraceReader::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_file.Close ();
+  m_records = 0;
+  m_nRecords = 0;
+}
+
+uint64_t
+LrWpanTraceReader::GetNRecords (void) const
+{
+  return m_nRecords;
+}
+
+LrWpanTraceRecord const &
+LrWpanTraceReader::Get (uint64_t i) const
+{
+  NS_ASSERT_MSG (i < m_nRecords, "LrWpanTraceReader::Get(): record " << i << " out of range");
+  return m_records[i];
+}
+
+LrWpanTraceRecord const *
+LrWpanTraceReader::Begin (void) const
+{
+  return m_records;
+}
+
+LrWpanTraceRecord const *
+LrWpanTraceReader::End (void) const
+{
+  return m_records + m_nRecords;
+}
+
+} // namespace ns3
@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef LR_WPAN_BINARY_TRACE_H
+#define LR_WPAN_BINARY_TRACE_H
+
+#include <fstream>
+#include <string>
+#include <stdint.h>
+#include <ns3/object.h>
+#include <ns3/nstime.h>
+#include <ns3/ptr.h>
+#include <ns3/mapped-file.h>
+#include <ns3/file-write-buffer.h>
+#include <ns3/buffered-file-writer.h>
+
+namespace ns3 {
+
+class Packet;
+
+/**
+ * \ingroup lr-wpan
+ *
+ * \brief A record of a binary trace of 802.15.4 MAC events.
+ *
+ * The records have a fixed size and layout, and are stored in the byte
+ * order of the host, after a 16-byte file header: a mapped trace can be
+ * read as an array of records.
+ */
+struct LrWpanTraceRecord
+{
+  /// The MAC events traced, named after the lines of the ascii traces.
+  enum Event
+  {
+    ENQUEUE = '+',      //!< MacTxEnqueue
+    DEQUEUE = '-',      //!< MacTxDequeue
+    DROP = 'd',         //!< MacTxDrop
+    RECEIVE = 'r',      //!< MacRx
+    TRANSMIT = 't',     //!< MacTx
+    MAX_RETRIES = 'm'   //!< MacMaxRetries
+  };
+
+  /// Short address recorded when the frame has no short address.
+  static const uint16_t NO_SHORT_ADDRESS = 0xfffe;
+
+  int64_t time;         //!< time of the event, in nanoseconds
+  uint64_t uid;         //!< uid of the packet
+  uint32_t node;        //!< id of the node
+  uint32_t device;      //!< index of the device in the node
+  uint16_t size;        //!< size of the frame, in bytes
+  uint16_t source;      //!< short source address, most significant byte first
+  uint16_t destination; //!< short destination address, most significant byte first
+  uint8_t sequence;     //!< sequence number of the frame
+  uint8_t event;        //!< the event, see Event
+};
+
+/**
+ * \ingroup lr-wpan
+ *
+ * \brief Write a binary trace of 802.15.4 MAC events.
+ *
+ * Instead of printing each packet, as the ascii traces do, the writer
+ * stores a fixed-size LrWpanTraceRecord per event, with the addresses
+ * and sequence number of the MAC header. Records are buffered as
+ * described in BufferedFileWriter.
+ *
+ * \see LrWpanTschHelper::EnableBinaryTrace, LrWpanTraceReader
+ */
+class LrWpanTraceWriter : public BufferedFileWriter
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  LrWpanTraceWriter ();
+  ~LrWpanTraceWriter ();
+
+  /**
+   * \return true if the 'fail' bit is set in the underlying stream, false otherwise.
+   */
+  bool Fail (void) const;
+  /**
+   * Create a new trace file, and write its header.
+   *
+   * \param filename the name of the file
+   */
+  void Open (std::string const &filename);
+  /**
+   * Close the underlying file, writing the buffered records.
+   */
+  void Close (void);
+  /**
+   * Write the buffered records to the underlying file.
+   */
+  void Flush (void);
+
+  /**
+   * \param record the record to write
+   */
+  void Write (LrWpanTraceRecord const &record);
+  /**
+   * \brief Write the record of a frame, taking its addresses and
+   * sequence number from its MAC header.
+   *
+   * \param t the time of the event
+   * \param node the id of the node
+   * \param device the index of the device in the node
+   * \param event the event
+   * \param p the frame, starting with its MAC header
+   */
+  void Write (Time t, uint32_t node, uint32_t device,
+              enum LrWpanTraceRecord::Event event, Ptr<const Packet> p);
+
+private:
+  // inherited from BufferedFileWriter
+  virtual void DoSetBufferSize (uint32_t size);
+  virtual void DoSetAsyncFlush (bool async);
+
+  std::ofstream m_file;               //!< file stream
+  FileWriteBuffer m_buffer;           //!< buffer of the records written
+};
+
+/**
+ * \ingroup lr-wpan
+ *
+ * \brief Read a binary trace of 802.15.4 MAC events.
+ *
+ * The trace is mapped in memory, and its records are accessed in place.
+ * Records written by a host of the other byte order are rejected.
+ */
+class LrWpanTraceReader
+{
+public:
+  LrWpanTraceReader ();
+
+  /**
+   * \brief Map a trace in memory, and check its header.
+   *
+   * \param filename the name of the file
+   * \returns false if the file cannot be read, or is not a binary trace
+   *          written in the byte order of the host
+   */
+  bool Open (std::string const &filename);
+  /**
+   * Unmap the trace: its records must no longer be used.
+   */
+  void Close (void);
+
+  /**
+   * \returns the number of complete records in the trace
+   */
+  uint64_t GetNRecords (void) const;
+  /**
+   * \param i the index of a record
+   * \returns the record
+   */
+  LrWpanTraceRecord const &Get (uint64_t i) const;
+  /**
+   * \returns the first record, followed by the GetNRecords - 1 others
+   */
+  LrWpanTraceRecord const *Begin (void) const;
+  /**
+   * \returns the address past the last record
+   */
+  LrWpanTraceRecord const *End (void) const;
+
+private:
+  MappedFile m_file;                  //!< the mapped trace
+  LrWpanTraceRecord const *m_records; //!< the first record
+  uint64_t m_nRecords;                //!< number of complete records
+};
+
+} // namespace ns3
+
+#endif /* LR_WPAN_BINARY_TRACE_H */
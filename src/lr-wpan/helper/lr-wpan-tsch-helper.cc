@@ -468,6 +468,75 @@ LrWpanTschHelper::EnablePcapInternal (std::string prefix, Ptr<NetDevice> nd, boo
     }
 }
 
+static void
+PcapngSniffLrWpan (Ptr<PcapngFileWrapper> file, uint32_t interface, Ptr<const Packet> packet)
+{
+  file->Write (interface, Simulator::Now (), packet);
+}
+
+Ptr<PcapngFileWrapper>
+LrWpanTschHelper::EnablePcapng (std::string filename, NetDeviceContainer devs, bool promiscuous)
+{
+  NS_LOG_FUNCTION (this << filename << promiscuous);
+  PcapHelper pcapHelper;
+  Ptr<PcapngFileWrapper> file = pcapHelper.CreatePcapngFile (filename);
+  std::string source = promiscuous ? "PromiscSniffer" : "Sniffer";
+  for (NetDeviceContainer::Iterator i = devs.Begin (); i != devs.End (); ++i)
+    {
+      Ptr<LrWpanTschNetDevice> device = (*i)->GetObject<LrWpanTschNetDevice> ();
+      if (device == 0)
+        {
+          NS_LOG_INFO ("LrWpanTschHelper::EnablePcapng(): Device " << *i << " not of type ns3::LrWpanTschNetDevice");
+          continue;
+        }
+      std::ostringstream oss;
+      oss << device->GetNode ()->GetId () << "-" << device->GetIfIndex ();
+      uint32_t interface = file->AddInterface (PcapHelper::DLT_IEEE802_15_4, oss.str ());
+      device->GetOMac ()->TraceConnectWithoutContext (source, MakeBoundCallback (&PcapngSniffLrWpan, file, interface));
+      device->GetNMac ()->TraceConnectWithoutContext (source, MakeBoundCallback (&PcapngSniffLrWpan, file, interface));
+    }
+  return file;
+}
+
+static void
+BinaryTraceLrWpan (Ptr<LrWpanTraceWriter> file, Ptr<NetDevice> device,
+                   LrWpanTraceRecord::Event event, Ptr<const Packet> packet)
+{
+  file->Write (Simulator::Now (), device->GetNode ()->GetId (), device->GetIfIndex (), event, packet);
+}
+
+Ptr<LrWpanTraceWriter>
+LrWpanTschHelper::EnableBinaryTrace (std::string filename, NetDeviceContainer devs)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Ptr<LrWpanTraceWriter> file = CreateObject<LrWpanTraceWriter> ();
+  file->Open (filename);
+  if (file->Fail ())
+    {
+      NS_FATAL_ERROR ("LrWpanTschHelper::EnableBinaryTrace(): Unable to Open " << filename);
+    }
+  for (NetDeviceContainer::Iterator i = devs.Begin (); i != devs.End (); ++i)
+    {
+      Ptr<LrWpanTschNetDevice> device = (*i)->GetObject<LrWpanTschNetDevice> ();
+      if (device == 0)
+        {
+          NS_LOG_INFO ("LrWpanTschHelper::EnableBinaryTrace(): Device " << *i << " not of type ns3::LrWpanTschNetDevice");
+          continue;
+        }
+      Ptr<Object> macs[2] = { device->GetOMac (), device->GetNMac () };
+      for (uint32_t j = 0; j < 2; j++)
+        {
+          macs[j]->TraceConnectWithoutContext ("MacTxEnqueue", MakeBoundCallback (&BinaryTraceLrWpan, file, *i, LrWpanTraceRecord::ENQUEUE));
+          macs[j]->TraceConnectWithoutContext ("MacTxDequeue", MakeBoundCallback (&BinaryTraceLrWpan, file, *i, LrWpanTraceRecord::DEQUEUE));
+          macs[j]->TraceConnectWithoutContext ("MacTxDrop", MakeBoundCallback (&BinaryTraceLrWpan, file, *i, LrWpanTraceRecord::DROP));
+          macs[j]->TraceConnectWithoutContext ("MacRx", MakeBoundCallback (&BinaryTraceLrWpan, file, *i, LrWpanTraceRecord::RECEIVE));
+          macs[j]->TraceConnectWithoutContext ("MacTx", MakeBoundCallback (&BinaryTraceLrWpan, file, *i, LrWpanTraceRecord::TRANSMIT));
+          macs[j]->TraceConnectWithoutContext ("MacMaxRetries", MakeBoundCallback (&BinaryTraceLrWpan, file, *i, LrWpanTraceRecord::MAX_RETRIES));
+        }
+    }
+  return file;
+}
+
 void
 LrWpanTschHelper::EnableAsciiInternal (
   Ptr<OutputStreamWrapper> stream,
@@ -35,6 +35,7 @@
 #include <ns3/trace-helper.h>
 #include "ns3/energy-module.h"
 #include <ns3/lr-wpan-array.h>
+#include <ns3/lr-wpan-binary-trace.h>
 #include <ns3/random-variable-stream.h>
 
 namespace ns3 {
@@ -226,6 +227,32 @@ public:
    */
   void EnableEnergyAllPhy(Ptr<OutputStreamWrapper> stream, EnergySourceContainer sources);
 
+  /**
+   * @brief EnablePcapng: capture the packets of several devices in a single pcapng file
+   *
+   * Each device is described by an interface of the file, instead of
+   * having a pcap file of its own.
+   *
+   * @param filename name of the pcapng file
+   * @param devs the devices captured
+   * @param promiscuous capture all the packets received, not only those sent to the devices
+   * @returns the pcapng file, to set its BufferSize or AsyncFlush attributes, or flush it
+   */
+  Ptr<PcapngFileWrapper> EnablePcapng (std::string filename, NetDeviceContainer devs, bool promiscuous = false);
+
+  /**
+   * @brief EnableBinaryTrace: record the MAC events of several devices in a binary trace
+   *
+   * The events of the ascii traces are recorded as fixed-size
+   * LrWpanTraceRecord structures instead of printed packets, to be read
+   * back with LrWpanTraceReader.
+   *
+   * @param filename name of the trace file
+   * @param devs the devices traced
+   * @returns the trace writer, to set its BufferSize or AsyncFlush attributes, or flush it
+   */
+  Ptr<LrWpanTraceWriter> EnableBinaryTrace (std::string filename, NetDeviceContainer devs);
+
   /**
    * @brief GenerateTraffic: Generate CBR traffic for given devices
    * @param dev
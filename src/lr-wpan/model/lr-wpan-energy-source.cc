@@ -62,6 +62,13 @@ LrWpanEnergySource::GetTypeId (void)
                     MakeBooleanAccessor (&LrWpanEnergySource::SetEnergyUnlimited,
                                          &LrWpanEnergySource::GetEnergyUnlimited),
                     MakeBooleanChecker ())
+    .AddAttribute ("LazyEnergyUpdate",
+                   "Compute the remaining energy on demand and schedule a single "
+                   "predicted depletion event, instead of updating it periodically.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LrWpanEnergySource::SetLazyEnergyUpdate,
+                                        &LrWpanEnergySource::GetLazyEnergyUpdate),
+                   MakeBooleanChecker ())
     .AddTraceSource ("RemainingEnergy",
                      "Remaining energy at LrWpanEnergySource.",
                      MakeTraceSourceAccessor (&LrWpanEnergySource::m_remainingEnergyJ))
@@ -74,6 +81,8 @@ LrWpanEnergySource::LrWpanEnergySource ()
 {
   NS_LOG_FUNCTION (this);
   m_lastUpdateTime = Seconds (0.0);
+  m_lazyUpdate = false;
+  m_totalCurrentA = 0;
 }
 
 LrWpanEnergySource::~LrWpanEnergySource ()
@@ -133,6 +142,11 @@ LrWpanEnergySource::GetRemainingEnergy (void)
   NS_LOG_DEBUG ("Get RemainingEnergy");
   // update energy source to get the latest remaining energy.
   //UpdateEnergySource ();
+  if (m_lazyUpdate)
+    {
+      // cheap: no event is scheduled unless the total current changed
+      UpdateEnergySource ();
+    }
   return m_remainingEnergyJ;
 }
 
@@ -157,6 +171,12 @@ LrWpanEnergySource::UpdateEnergySource (void)
       return;
     }
 
+  if (m_lazyUpdate)
+    {
+      LazyUpdateEnergySource ();
+      return;
+    }
+
   m_energyUpdateEvent.Cancel ();
 
   CalculateRemainingEnergy ();
@@ -182,6 +202,13 @@ void
 LrWpanEnergySource::DoInitialize (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_lazyUpdate)
+    {
+      m_lastUpdateTime = Simulator::Now ();
+      m_totalCurrentA = CalculateTotalCurrent ();
+      ScheduleEnergyDepletion ();
+      return;
+    }
   UpdateEnergySource ();  // start periodic update
 }
 
@@ -235,4 +262,79 @@ LrWpanEnergySource::GetEnergyUnlimited (void) const
     return m_unlimited;
 }
 
+void
+LrWpanEnergySource::SetLazyEnergyUpdate (bool lazy)
+{
+  NS_LOG_FUNCTION (this << lazy);
+  m_lazyUpdate = lazy;
+}
+
+bool
+LrWpanEnergySource::GetLazyEnergyUpdate (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_lazyUpdate;
+}
+
+void
+LrWpanEnergySource::LazyUpdateEnergySource (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_remainingEnergyJ <= 0)
+    {
+      return; // already drained
+    }
+
+  Time duration = Simulator::Now () - m_lastUpdateTime;
+  NS_ASSERT (duration.GetSeconds () >= 0);
+  if (!m_unlimited && !duration.IsZero ())
+    {
+      m_remainingEnergyJ -= m_totalCurrentA * m_supplyVoltageV * duration.GetSeconds ();
+      NS_LOG_DEBUG ("LrWpanEnergySource:Remaining energy = " << m_remainingEnergyJ);
+    }
+  m_lastUpdateTime = Simulator::Now ();
+
+  if (m_remainingEnergyJ <= 0)
+    {
+      m_depletionEvent.Cancel ();
+      HandleEnergyDrainedEvent ();
+      return;
+    }
+
+  double totalCurrentA = CalculateTotalCurrent ();
+  if (totalCurrentA != m_totalCurrentA)
+    {
+      m_totalCurrentA = totalCurrentA;
+      ScheduleEnergyDepletion ();
+    }
+}
+
+void
+LrWpanEnergySource::ScheduleEnergyDepletion (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_depletionEvent.Cancel ();
+
+  if (m_unlimited || m_totalCurrentA <= 0)
+    {
+      return;
+    }
+
+  // time to depletion = remaining energy / (total current * voltage)
+  Time delay = Seconds (m_remainingEnergyJ / (m_totalCurrentA * m_supplyVoltageV));
+  NS_LOG_DEBUG ("LrWpanEnergySource:Energy depletion predicted in " << delay.GetSeconds () << "s");
+  m_depletionEvent = Simulator::Schedule (delay,
+                                          &LrWpanEnergySource::HandlePredictedDepletion,
+                                          this);
+}
+
+void
+LrWpanEnergySource::HandlePredictedDepletion (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_lastUpdateTime = Simulator::Now ();
+  HandleEnergyDrainedEvent ();
+}
+
 } // namespace ns3
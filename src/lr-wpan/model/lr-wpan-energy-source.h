@@ -34,6 +34,14 @@ namespace ns3 {
  * LrWpanEnergySource decreases/increases remaining energy stored in itself in
  * linearly.
  *
+ * By default the remaining energy is updated every PeriodicEnergyUpdateInterval
+ * and whenever a device energy model notifies a state change. When the
+ * LazyEnergyUpdate attribute is set, no periodic event is used: the total
+ * current is piecewise constant between two notifications, so the remaining
+ * energy is integrated on demand, and the depletion time is predicted and
+ * scheduled as a single event, which is rescheduled only when the total
+ * current changes. In this mode the device energy models must notify the
+ * source every time their current draw changes.
  */
 class LrWpanEnergySource : public EnergySource
 {
@@ -113,6 +121,17 @@ public:
    */
   bool GetEnergyUnlimited (void) const;
 
+  /**
+   * \param lazy Use the event-driven update instead of the periodic one.
+   *
+   * Must be set before the simulation starts.
+   */
+  void SetLazyEnergyUpdate (bool lazy);
+
+  /**
+   * \returns True if the event-driven update is used.
+   */
+  bool GetLazyEnergyUpdate (void) const;
 
 private:
   /// Defined in ns3::Object
@@ -138,6 +157,25 @@ private:
    */
   void CalculateRemainingEnergy (void);
 
+  /**
+   * Lazy mode update. The energy consumed since the last update is computed
+   * with the total current recorded at the last update. If the total current
+   * changed, the depletion event is rescheduled.
+   */
+  void LazyUpdateEnergySource (void);
+
+  /**
+   * Schedules the depletion event, given the remaining energy and the
+   * current total current. No event is scheduled if the energy is unlimited
+   * or if no current is drawn.
+   */
+  void ScheduleEnergyDepletion (void);
+
+  /**
+   * Handles the predicted depletion event in lazy mode.
+   */
+  void HandlePredictedDepletion (void);
+
 private:
   double m_initialEnergyJ;                // initial energy, in Joules
   double m_supplyVoltageV;                // supply voltage, in Volts
@@ -146,6 +184,9 @@ private:
   Time m_lastUpdateTime;                  // last update time
   Time m_energyUpdateInterval;            // energy update interval
   bool m_unlimited;                         // source energy unlimited or not
+  bool m_lazyUpdate;                      // event-driven update instead of periodic one
+  double m_totalCurrentA;                 // total current since last update (lazy mode), in Amperes
+  EventId m_depletionEvent;               // predicted depletion event (lazy mode)
 };
 
 } // namespace ns3
@@ -42,36 +42,43 @@ LrWpanInterferenceHelper::~LrWpanInterferenceHelper (void)
 }
 
 bool
-LrWpanInterferenceHelper::AddSignal (Ptr<const SpectrumValue> signal)
+LrWpanInterferenceHelper::AddSignal (Ptr<const SpectrumValue> signal, double gain)
 {
-  NS_LOG_FUNCTION (this << signal);
+  NS_LOG_FUNCTION (this << signal << gain);
 
   bool result = false;
 
   if (signal->GetSpectrumModel () == m_spectrumModel)
     {
-      result = m_signals.insert (signal).second;
-      if (result && !m_dirty)
+      m_signals.insert (std::make_pair (signal, gain));
+      result = true;
+      if (!m_dirty)
         {
-          *m_signal += *signal;
+          m_signal->AddScaled (*signal, gain);
         }
     }
   return result;
 }
 
 bool
-LrWpanInterferenceHelper::RemoveSignal (Ptr<const SpectrumValue> signal)
+LrWpanInterferenceHelper::RemoveSignal (Ptr<const SpectrumValue> signal, double gain)
 {
-  NS_LOG_FUNCTION (this << signal);
+  NS_LOG_FUNCTION (this << signal << gain);
 
   bool result = false;
 
   if (signal->GetSpectrumModel () == m_spectrumModel)
     {
-      result = (m_signals.erase (signal) == 1);
-      if (result)
+      std::pair<Signals::iterator, Signals::iterator> range = m_signals.equal_range (signal);
+      for (Signals::iterator it = range.first; it != range.second; ++it)
         {
-          m_dirty = true;
+          if (it->second == gain)
+            {
+              m_signals.erase (it);
+              m_dirty = true;
+              result = true;
+              break;
+            }
         }
     }
   return result;
@@ -94,11 +101,11 @@ LrWpanInterferenceHelper::GetSignalPsd (void) const
   if (m_dirty)
     {
       // Sum up the current interference PSD.
-      std::set<Ptr<const SpectrumValue> >::const_iterator it;
+      Signals::const_iterator it;
       m_signal = Create<SpectrumValue> (m_spectrumModel);
       for (it = m_signals.begin (); it != m_signals.end (); ++it)
         {
-          *m_signal += *(*it);
+          m_signal->AddScaled (*it->first, it->second);
         }
       m_dirty = false;
     }
@@ -23,7 +23,7 @@
 
 #include <ns3/simple-ref-count.h>
 #include <ns3/ptr.h>
-#include <set>
+#include <map>
 
 namespace ns3 {
 
@@ -48,24 +48,30 @@ public:
   ~LrWpanInterferenceHelper (void);
 
   /**
-   * Add the given signal to the set of accumulated signals. Never add the same
-   * signal more than once. The SpectrumModels of the signal and the one used
-   * for instantiation of the helper have to be the same.
+   * Add the given signal, multiplied by a gain, to the set of accumulated
+   * signals. The signal is not copied: as the PSD of the received signals,
+   * it is shared and must not be modified. The SpectrumModels of the signal
+   * and the one used for instantiation of the helper have to be the same.
    *
    * \param signal the signal to be added
+   * \param gain the gain applied to the signal, see
+   * SpectrumSignalParameters::psdGain
    * \return false, if the signal was not added because the SpectrumModel of the
    * signal does not match the one of the helper, true otherwise.
    */
-  bool AddSignal (Ptr<const SpectrumValue> signal);
+  bool AddSignal (Ptr<const SpectrumValue> signal, double gain = 1.0);
 
   /**
-   * Remove the given signal to the set of accumulated signals.
+   * Remove the given signal from the set of accumulated signals. A signal
+   * added several times, e.g. the successive frames of a transmitter, is
+   * removed once.
    *
    * \param signal the signal to be removed
+   * \param gain the gain the signal was added with
    * \return false, if the signal was not removed (because it was not added
    * before), true otherwise.
    */
-  bool RemoveSignal (Ptr<const SpectrumValue> signal);
+  bool RemoveSignal (Ptr<const SpectrumValue> signal, double gain = 1.0);
 
   /**
    * Remove all currently accumulated signals.
@@ -101,10 +107,13 @@ private:
    */
   Ptr<const SpectrumModel> m_spectrumModel;
 
+  /// Container of the accumulated signals, with their gains.
+  typedef std::multimap<Ptr<const SpectrumValue>, double> Signals;
+
   /**
-   * The set of accumulated signals.
+   * The accumulated signals, with their gains.
    */
-  std::set<Ptr<const SpectrumValue> > m_signals;
+  Signals m_signals;
 
   /**
    * The precomputed sum of all accumulated signals.
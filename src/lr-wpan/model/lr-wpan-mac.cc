@@ -294,7 +294,7 @@ LrWpanMac::McpsDataRequest (McpsDataRequestParams params, Ptr<Packet> p)
   if (b0 == TX_OPTION_ACK)
     {
       // Set AckReq bit only if the destination is not the broadcast address.
-      if (!(macHdr.GetDstAddrMode () == SHORT_ADDR && macHdr.GetShortDstAddr () == "ff:ff"))
+      if (!(macHdr.GetDstAddrMode () == SHORT_ADDR && macHdr.GetShortDstAddr ().IsBroadcast ()))
         {
           macHdr.SetAckReq ();
         }
@@ -453,7 +453,13 @@ LrWpanMac::PdDataIndication (uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
   // if beacon frame then srcPanId = m_macPanId
   // if only srcAddr field in Data or Command frame,accept frame if srcPanId=m_macPanId
 
-  Ptr<Packet> originalPkt = p->Copy (); // because we will strip headers
+  // the trace sinks get a copy, because we will strip headers
+  Ptr<Packet> originalPkt;
+  if (!m_promiscSnifferTrace.IsEmpty () || !m_macPromiscRxTrace.IsEmpty ()
+      || !m_macRxDropTrace.IsEmpty () || !m_macRxTrace.IsEmpty ())
+    {
+      originalPkt = p->Copy ();
+    }
 
   m_promiscSnifferTrace (originalPkt);
 
@@ -531,7 +537,7 @@ LrWpanMac::PdDataIndication (uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
               && (receivedMacHdr.GetDstAddrMode () == 2))
             {
               acceptFrame = receivedMacHdr.GetShortDstAddr () == m_shortAddress
-                || receivedMacHdr.GetShortDstAddr () == Mac16Address ("ff:ff");        // check for broadcast addrs
+                || receivedMacHdr.GetShortDstAddr ().IsBroadcast ();        // check for broadcast addrs
             }
 
           if (acceptFrame
@@ -571,7 +577,7 @@ LrWpanMac::PdDataIndication (uint32_t psduLength, Ptr<Packet> p, uint8_t lqi)
               // If the received frame is a frame with the ACK request bit set, we immediately send back an ACK.
               // If we are currently waiting for a pending ACK, we assume the ACK was lost and trigger a retransmission after sending the ACK.
               if ((receivedMacHdr.IsData () || receivedMacHdr.IsCommand ()) && receivedMacHdr.IsAckReq ()
-                  && !(receivedMacHdr.GetDstAddrMode () == SHORT_ADDR && receivedMacHdr.GetShortDstAddr () == "ff:ff"))
+                  && !(receivedMacHdr.GetDstAddrMode () == SHORT_ADDR && receivedMacHdr.GetShortDstAddr ().IsBroadcast ()))
                 {
                   // If this is a data or mac command frame, which is not a broadcast,
                   // with ack req set, generate and send an ack frame.
@@ -688,7 +694,7 @@ LrWpanMac::RemoveFirstTxQElement ()
   Ptr<Packet> pkt = p->Copy ();
   LrWpanMacHeader hdr;
   pkt->RemoveHeader (hdr);
-  if (hdr.GetShortDstAddr () != Mac16Address ("ff:ff"))
+  if (!hdr.GetShortDstAddr ().IsBroadcast ())
     {
       m_sentPktTrace (p, m_retransmission + 1, m_numCsmacaRetry);
     }
@@ -298,7 +298,7 @@ Address
 LrWpanNetDevice::GetBroadcast (void) const
 {
   NS_LOG_FUNCTION (this);
-  return Mac16Address ("ff:ff");
+  return Mac16Address::GetBroadcast ();
 }
 
 bool
@@ -345,7 +345,7 @@ LrWpanNetDevice::GetMulticast (Ipv6Address addr) const
   //  newaddr.CopyFrom(buf2);
   //  return newaddr;
 
-  return Mac16Address ("ff:ff");
+  return Mac16Address::GetBroadcast ();
 }
 
 bool
@@ -282,7 +282,7 @@ LrWpanPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
   Ptr<Packet> p;
   if (lrWpanRxParams != 0)
     {
-      p = (lrWpanRxParams->packetBurst->GetPackets ()).front ();
+      p = *lrWpanRxParams->packetBurst->Begin ();
       NS_ASSERT (p != 0);
     }
 
@@ -316,26 +316,32 @@ LrWpanPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
       // Add any incoming packet to the current interference before checking the
       // SINR.
       m_receivedPower = 10 * log10(LrWpanSpectrumValueHelper::TotalAvgPower (lrWpanRxParams->psd,m_phyPIBAttributes.phyCurrentChannel)
-                        * m_phyPIBAttributes.phyLinkFadingBias) + 30;
+                        * lrWpanRxParams->psdGain * m_phyPIBAttributes.phyLinkFadingBias) + 30;
 
       NS_LOG_DEBUG (this << " receiving packet with power: " << m_receivedPower << "dBm," 
          << "fading bias: " << m_phyPIBAttributes.phyLinkFadingBias);
 
-      m_signal->AddSignal (lrWpanRxParams->psd);
+      m_signal->AddSignal (lrWpanRxParams->psd, lrWpanRxParams->psdGain);
       Ptr<SpectrumValue> interferenceAndNoise = m_signal->GetSignalPsd ();
-      *interferenceAndNoise -= *lrWpanRxParams->psd;
+      interferenceAndNoise->AddScaled (*lrWpanRxParams->psd, -lrWpanRxParams->psdGain);
       *interferenceAndNoise += *m_noise;
 
       //double sinr = LrWpanSpectrumValueHelper::TotalAvgPower (lrWpanRxParams->psd,m_phyPIBAttributes.phyCurrentChannel)
       // / LrWpanSpectrumValueHelper::TotalAvgPower (interferenceAndNoise,m_phyPIBAttributes.phyCurrentChannel);
       double LrWpanSignalPower = LrWpanSpectrumValueHelper::TotalAvgPower (lrWpanRxParams->psd,m_phyPIBAttributes.phyCurrentChannel)
-                                 *m_phyPIBAttributes.phyLinkFadingBias;
+                                 *lrWpanRxParams->psdGain*m_phyPIBAttributes.phyLinkFadingBias;
 
       m_phyLinkInformation(10*log10(LrWpanSignalPower)+30);
 
       if (LrWpanSignalPower >= m_rxSensitivity)
         {
           ChangeTrxState (IEEE_802_15_4_PHY_BUSY_RX);
+          // The frame is shared with the other receivers of the signal: copy
+          // it before tagging it and passing it up.
+          p = p->Copy ();
+          Ptr<PacketBurst> burst = Create<PacketBurst> ();
+          burst->AddPacket (p);
+          lrWpanRxParams->packetBurst = burst;
           m_currentRxPacket = std::make_pair (lrWpanRxParams, false);
           m_phyRxBeginTrace (p);
           m_currentPacketRxStart = Simulator::Now();
@@ -376,7 +382,7 @@ LrWpanPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
       // Add the incoming signal to the current interference after we have
       // checked for successfull reception of the current packet for the time
       // before the additional interference.
-      m_signal->AddSignal (lrWpanRxParams->psd);
+      m_signal->AddSignal (lrWpanRxParams->psd, lrWpanRxParams->psdGain);
     }
   else if (lrWpanRxParams == 0)
     {
@@ -387,7 +393,7 @@ LrWpanPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
           NS_LOG_DEBUG("Wifi Signal duration: " << (spectrumRxParams->duration).GetSeconds());
         }
 
-      m_signal->AddSignal (spectrumRxParams->psd);
+      m_signal->AddSignal (spectrumRxParams->psd, spectrumRxParams->psdGain);
     }
   else
     {
@@ -396,7 +402,7 @@ LrWpanPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
       m_phyRxDropTrace (p);
 
       // Add the signal power to the interference, anyway.
-      m_signal->AddSignal (lrWpanRxParams->psd);
+      m_signal->AddSignal (lrWpanRxParams->psd, lrWpanRxParams->psdGain);
     }
 
   // Update peak power if CCA is in progress.
@@ -426,6 +432,12 @@ LrWpanPhy::StartRx (Ptr<SpectrumSignalParameters> spectrumRxParams)
 
 }
 
+bool
+LrWpanPhy::SupportsPsdGain (void) const
+{
+  return true;
+}
+
 void
 LrWpanPhy::CheckInterference (LrWpanPPDU packetType, Ptr<LrWpanSpectrumSignalParameters> spectrumRxParams)
 {
@@ -440,14 +452,14 @@ LrWpanPhy::CheckInterference (LrWpanPPDU packetType, Ptr<LrWpanSpectrumSignalPar
       Ptr<LrWpanSpectrumSignalParameters> currentRxParams = m_currentRxPacket.first;
       if (currentRxParams && !m_currentRxPacket.second)
       {
-          Ptr<Packet> currentPacket = currentRxParams->packetBurst->GetPackets ().front ();
+          Ptr<Packet> currentPacket = *currentRxParams->packetBurst->Begin ();
           if (m_errorModel != 0)
             {
               Ptr<SpectrumValue> interferenceAndNoise = m_signal->GetSignalPsd ();
-              *interferenceAndNoise -= *currentRxParams->psd;
+              interferenceAndNoise->AddScaled (*currentRxParams->psd, -currentRxParams->psdGain);
               *interferenceAndNoise += *m_noise;
               double sinr = LrWpanSpectrumValueHelper::TotalAvgPower (currentRxParams->psd,m_phyPIBAttributes.phyCurrentChannel)
-                  * m_phyPIBAttributes.phyLinkFadingBias
+                  * currentRxParams->psdGain * m_phyPIBAttributes.phyLinkFadingBias
                   / LrWpanSpectrumValueHelper::TotalAvgPower (interferenceAndNoise,m_phyPIBAttributes.phyCurrentChannel);
 
                   // How many bits did we receive since the last calculation?
@@ -465,7 +477,7 @@ LrWpanPhy::CheckInterference (LrWpanPPDU packetType, Ptr<LrWpanSpectrumSignalPar
                 currentPacket->ReplacePacketTag (tag);
 
                 NS_LOG_DEBUG (this << " Signal power: "
-                                << 10 * log10(LrWpanSpectrumValueHelper::TotalAvgPower (currentRxParams->psd,m_phyPIBAttributes.phyCurrentChannel)) + 30
+                                << 10 * log10(LrWpanSpectrumValueHelper::TotalAvgPower (currentRxParams->psd,m_phyPIBAttributes.phyCurrentChannel) * currentRxParams->psdGain) + 30
                                 << "dBm");
                 NS_LOG_DEBUG (this << " Interference power: "
                                 << 10 * log10(LrWpanSpectrumValueHelper::TotalAvgPower (interferenceAndNoise,m_phyPIBAttributes.phyCurrentChannel)) + 30
@@ -495,7 +507,7 @@ LrWpanPhy::CheckInterference (LrWpanPPDU packetType, Ptr<LrWpanSpectrumSignalPar
                     {
                        uint32_t payloadLengthSet = ceil(m_randomdatalength->GetValue());
                        NS_LOG_DEBUG (this << " Radom value for datalength is "<< payloadLengthSet);
-                       Ptr<Packet> packetCorrect = m_currentRxPacket.first->packetBurst->GetPackets().front();
+                       Ptr<Packet> packetCorrect = *m_currentRxPacket.first->packetBurst->Begin ();
                        uint32_t payloadLengthCorrect = packetCorrect->GetSize();
 
                        NS_LOG_DEBUG (this << " Correct Packet Size: " << payloadLengthCorrect << " with duration: " << m_currentRxPacket.first->duration);
@@ -570,7 +582,7 @@ LrWpanPhy::EndRx (Ptr<LrWpanSpectrumSignalParameters> spectrumRxParams)
     }
 
   // Update the interference.
-    m_signal->RemoveSignal (spectrumRxParams->psd);
+    m_signal->RemoveSignal (spectrumRxParams->psd, spectrumRxParams->psdGain);
 
   Ptr<LrWpanSpectrumSignalParameters> params = DynamicCast<LrWpanSpectrumSignalParameters> (spectrumRxParams);
 
@@ -584,7 +596,7 @@ LrWpanPhy::EndRx (Ptr<LrWpanSpectrumSignalParameters> spectrumRxParams)
   Ptr<LrWpanSpectrumSignalParameters> currentRxParams = m_currentRxPacket.first;
   if (currentRxParams == params)
     {
-      Ptr<Packet> currentPacket = currentRxParams->packetBurst->GetPackets ().front ();
+      Ptr<Packet> currentPacket = *currentRxParams->packetBurst->Begin ();
       NS_ASSERT (currentPacket != 0);
 
       // If there is no error model attached to the PHY, we always report the maximum LQI value.
@@ -298,6 +298,14 @@ public:
     */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params);
 
+  /**
+   * The PHY shares the PSD of the received signals, and applies their gain
+   * to the power it computes.
+   *
+   * @return true
+   */
+  virtual bool SupportsPsdGain (void) const;
+
   /**
    *  IEEE 802.15.4-2006 section 6.2.1.1
    *  PD-DATA.request
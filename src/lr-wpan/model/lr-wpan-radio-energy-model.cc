@@ -432,6 +432,8 @@ LrWpanRadioEnergyModel::SetLrWpanRadioState (const LrWpanPhyEnumeration state)
     NS_FATAL_ERROR ("LrWpanRadioEnergyModel:Undefined radio state: " << m_currentState);
   }
 
+  // with a lazy energy source, this also lets the source account for the
+  // current of the new state
   m_remainingBatteryEnergy = m_source -> GetRemainingEnergy();
 
   m_EnergyStateLogger (preStateName, curStateName, m_sourceEnergyUnlimited, m_energyToDecrease, m_remainingBatteryEnergy, m_totalEnergyConsumption);
@@ -35,7 +35,8 @@ LrWpanSpectrumSignalParameters::LrWpanSpectrumSignalParameters (const LrWpanSpec
   : SpectrumSignalParameters (p)
 {
   NS_LOG_FUNCTION (this << &p);
-  packetBurst = p.packetBurst->Copy ();
+  // the receivers share the frame, and copy it before modifying it
+  packetBurst = p.packetBurst;
 }
 
 Ptr<SpectrumSignalParameters>
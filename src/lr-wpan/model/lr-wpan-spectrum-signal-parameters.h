@@ -50,7 +50,10 @@ struct LrWpanSpectrumSignalParameters : public SpectrumSignalParameters
   LrWpanSpectrumSignalParameters (const LrWpanSpectrumSignalParameters& p);
 
   /**
-   * The packet burst being transmitted with this signal
+   * The packet burst being transmitted with this signal.
+   *
+   * The copies of the parameters share the burst and its packets: a
+   * receiver replaces the burst before modifying them.
    */
   Ptr<PacketBurst> packetBurst;
 };
@@ -530,7 +530,14 @@ LrWpanTschMac::PdDataIndication (uint32_t psduLength, Ptr<Packet> p, uint8_t lqi
   // if beacon frame then srcPanId = m_macPanId
   // if only srcAddr field in Data or Command frame,accept frame if srcPanId=m_macPanId
 
-  Ptr<Packet> originalPkt = p->Copy (); // because we will strip headers
+  uint32_t originalSize = p->GetSize ();
+  // the trace sinks get a copy, because we will strip headers
+  Ptr<Packet> originalPkt;
+  if (!m_promiscSnifferTrace.IsEmpty () || !m_macPromiscRxTrace.IsEmpty ()
+      || !m_macRxDropTrace.IsEmpty () || !m_macRxTrace.IsEmpty ())
+    {
+      originalPkt = p->Copy ();
+    }
 
   m_promiscSnifferTrace (originalPkt);
 
@@ -620,7 +627,7 @@ LrWpanTschMac::PdDataIndication (uint32_t psduLength, Ptr<Packet> p, uint8_t lqi
               && (receivedMacHdr.GetDstAddrMode () == 2))
             {
               acceptFrame = receivedMacHdr.GetShortDstAddr () == m_shortAddress
-                || receivedMacHdr.GetShortDstAddr () == Mac16Address ("ff:ff");      // check for broadcast addrs
+                || receivedMacHdr.GetShortDstAddr ().IsBroadcast ();      // check for broadcast addrs
             }
 
           if (acceptFrame
@@ -694,7 +701,7 @@ LrWpanTschMac::PdDataIndication (uint32_t psduLength, Ptr<Packet> p, uint8_t lqi
                   // If it is a data frame, push it up the stack.
                   NS_LOG_DEBUG ("Packet successfully received from " << params.m_srcAddr);
                   m_mcpsDataIndicationCallback (params, p);
-                  m_latestPacketSize = originalPkt->GetSize();
+                  m_latestPacketSize = originalSize;
                   //TODO: check the src MAC address
                   if (receivedMacHdr.IsAckReq ())
                     {
@@ -800,7 +807,7 @@ LrWpanTschMac::RemoveTxQueueElement ()
   Ptr<Packet> pkt = p->Copy ();
   LrWpanMacHeader hdr;
   pkt->RemoveHeader (hdr);
-  if (hdr.GetShortDstAddr () != Mac16Address ("ff:ff"))
+  if (!hdr.GetShortDstAddr ().IsBroadcast ())
     {
       if (txQElement->txRequestNB == m_macMaxFrameRetries)
         {
@@ -66,12 +66,20 @@ LrWpanTschNetDevice::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&LrWpanTschNetDevice::m_useAcks),
                    MakeBooleanChecker ())
+    .AddAttribute ("PacketMetadata",
+                   "Maintain the metadata of the packets sent through this device, "
+                   "so that their MAC header and trailer can be printed, even if "
+                   "Packet::EnablePrinting was not called.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LrWpanTschNetDevice::m_packetMetadata),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 LrWpanTschNetDevice::LrWpanTschNetDevice ()
-  : m_isTsch(-1),m_configComplete (false)
+  : m_isTsch(-1),m_configComplete (false),
+    m_packetMetadata (false)
 {
   NS_LOG_FUNCTION (this);
   m_mac = CreateObject<LrWpanTschMac> ();
@@ -336,7 +344,7 @@ Address
 LrWpanTschNetDevice::GetBroadcast (void) const
 {
   NS_LOG_FUNCTION (this);
-  return Mac16Address ("ff:ff");
+  return Mac16Address::GetBroadcast ();
 }
 
 bool
@@ -383,7 +391,7 @@ LrWpanTschNetDevice::GetMulticast (Ipv6Address addr) const
   //  newaddr.CopyFrom(buf2);
   //  return newaddr;
 
-  return Mac16Address ("ff:ff");
+  return Mac16Address::GetBroadcast ();
 }
 
 bool
@@ -416,23 +424,29 @@ LrWpanTschNetDevice::Send (Ptr<Packet> packet, const Address& dest, uint16_t pro
       return false;
     }
 
+  if (m_packetMetadata)
+    {
+      packet->EnableMetadata ();
+    }
+
+  Mac16Address dstAddr = Mac16Address::ConvertFrom (dest);
   assert(m_isTsch>=0);
   if ( m_isTsch) {
 	  TschMcpsDataRequestParams m_mcpsDataRequestParams;
 	  LrWpanFrameControlOptions frmcontrol;
 	  m_mcpsDataRequestParams.m_frameControlOptions = frmcontrol;
-	  m_mcpsDataRequestParams.m_dstAddr = Mac16Address::ConvertFrom (dest);
+	  m_mcpsDataRequestParams.m_dstAddr = dstAddr;
 	  m_mcpsDataRequestParams.m_dstAddrMode = SHORT_ADDR;
 	  m_mcpsDataRequestParams.m_srcAddrMode = NO_PANID_ADDR;
 
-	  m_mcpsDataRequestParams.m_ACK_TX = (Mac16Address::ConvertFrom (dest) == Mac16Address("ff:ff")) ? false : m_useAcks;
+	  m_mcpsDataRequestParams.m_ACK_TX = dstAddr.IsBroadcast () ? false : m_useAcks;
 	  m_mcpsDataRequestParams.m_msduHandle = 0;
 
 	  m_mcpsDataRequestParams.m_dstPanId = m_mac->GetPanId ();
 	  m_mac->McpsDataRequest (m_mcpsDataRequestParams, packet);
   } else {
 	  McpsDataRequestParams m_mcpsDataRequestParams;
-	  m_mcpsDataRequestParams.m_dstAddr = Mac16Address::ConvertFrom (dest);
+	  m_mcpsDataRequestParams.m_dstAddr = dstAddr;
 	  m_mcpsDataRequestParams.m_dstAddrMode = SHORT_ADDR;
 	  m_mcpsDataRequestParams.m_dstPanId = m_omac->GetPanId ();
 	  m_mcpsDataRequestParams.m_srcAddrMode = SHORT_ADDR;
@@ -461,12 +475,18 @@ LrWpanTschNetDevice::Send (Ptr<Packet> packet, const Address& dest, bool use_ack
       return false;
     }
 
+  if (m_packetMetadata)
+    {
+      packet->EnableMetadata ();
+    }
+
+  Mac16Address dstAddr = Mac16Address::ConvertFrom (dest);
   assert(m_isTsch>=0);
   if ( m_isTsch) {
 	  TschMcpsDataRequestParams m_mcpsDataRequestParams;
 	  LrWpanFrameControlOptions frmcontrol;
 	  m_mcpsDataRequestParams.m_frameControlOptions = frmcontrol;
-	  m_mcpsDataRequestParams.m_dstAddr = Mac16Address::ConvertFrom (dest);
+	  m_mcpsDataRequestParams.m_dstAddr = dstAddr;
 	  m_mcpsDataRequestParams.m_dstAddrMode = SHORT_ADDR;
 	  m_mcpsDataRequestParams.m_srcAddrMode = NO_PANID_ADDR;
 	  m_mcpsDataRequestParams.m_ACK_TX = use_ack;
@@ -476,7 +496,7 @@ LrWpanTschNetDevice::Send (Ptr<Packet> packet, const Address& dest, bool use_ack
 	  m_mac->McpsDataRequest (m_mcpsDataRequestParams, packet);
   } else {
 	  McpsDataRequestParams m_mcpsDataRequestParams;
-	  m_mcpsDataRequestParams.m_dstAddr = Mac16Address::ConvertFrom (dest);
+	  m_mcpsDataRequestParams.m_dstAddr = dstAddr;
 	  m_mcpsDataRequestParams.m_dstAddrMode = SHORT_ADDR;
 	  m_mcpsDataRequestParams.m_dstPanId = m_omac->GetPanId ();
 	  m_mcpsDataRequestParams.m_srcAddrMode = SHORT_ADDR;
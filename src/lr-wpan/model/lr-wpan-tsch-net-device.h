@@ -250,6 +250,12 @@ private:
    */
   bool m_useAcks;
 
+  /**
+   * Maintain the metadata of the packets sent using the Send() API, from
+   * the MAC header on.
+   */
+  bool m_packetMetadata;
+
   /**
    * Is the link/device currently up and running?
    */
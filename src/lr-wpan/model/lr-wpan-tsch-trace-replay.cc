@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "lr-wpan-tsch-trace-replay.h"
+#include "lr-wpan-tsch-net-device.h"
+#include "lr-wpan-mac-header.h"
+#include "lr-wpan-mac-trailer.h"
+#include <ns3/abort.h>
+#include <ns3/log.h>
+#include <ns3/node.h>
+#include <ns3/packet.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/trace-source-accessor.h>
+
+NS_LOG_COMPONENT_DEFINE ("LrWpanTschTraceReplay");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (LrWpanTschTraceReplay);
+
+namespace {
+
+/// Data link type of 802.15.4 frames with a FCS, see PcapHelper
+const uint32_t DLT_IEEE802_15_4 = 195;
+/// Data link type of 802.15.4 frames without FCS
+const uint32_t DLT_IEEE802_15_4_NOFCS = 230;
+
+/**
+ * \param data the first bytes of a frame
+ * \returns true if the frame is a data frame
+ *
+ * The frame type is in the three low bits of the frame control field.
+ */
+inline bool
+IsDataFrame (uint8_t const *data)
+{
+  return (data[0] & 0x07) == LrWpanMacHeader::LRWPAN_MAC_DATA;
+}
+
+} // anonymous namespace
+
+TypeId
+LrWpanTschTraceReplay::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LrWpanTschTraceReplay")
+    .SetParent<Application> ()
+    .AddConstructor<LrWpanTschTraceReplay> ()
+    .AddAttribute ("Filename",
+                   "The pcap capture of 802.15.4 frames to replay.",
+                   StringValue (""),
+                   MakeStringAccessor (&LrWpanTschTraceReplay::m_filename),
+                   MakeStringChecker ())
+    .AddAttribute ("Source",
+                   "Only replay the frames sent by this short address; "
+                   "ff:ff replays all the data frames of the capture. "
+                   "Frames without source address are replayed unless "
+                   "they are sent to this address.",
+                   Mac16AddressValue (Mac16Address::GetBroadcast ()),
+                   MakeMac16AddressAccessor (&LrWpanTschTraceReplay::m_source),
+                   MakeMac16AddressChecker ())
+    .AddTraceSource ("Tx",
+                     "A frame of the capture is passed to the device, "
+                     "without its MAC header and trailer.",
+                     MakeTraceSourceAccessor (&LrWpanTschTraceReplay::m_txTrace))
+  ;
+  return tid;
+}
+
+LrWpanTschTraceReplay::LrWpanTschTraceReplay ()
+  : m_fcs (true),
+    m_replayed (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LrWpanTschTraceReplay::~LrWpanTschTraceReplay ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+LrWpanTschTraceReplay::SetNetDevice (Ptr<LrWpanTschNetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  m_device = device;
+}
+
+uint32_t
+LrWpanTschTraceReplay::GetReplayed (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_replayed;
+}
+
+void
+LrWpanTschTraceReplay::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_event.Cancel ();
+  m_file.Close ();
+  m_device = 0;
+  Application::DoDispose ();
+}
+
+void
+LrWpanTschTraceReplay::StartApplication (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_device == 0)
+    {
+      for (uint32_t i = 0; i < GetNode ()->GetNDevices () && m_device == 0; i++)
+        {
+          m_device = DynamicCast<LrWpanTschNetDevice> (GetNode ()->GetDevice (i));
+        }
+      NS_ABORT_MSG_IF (m_device == 0, "No LrWpanTschNetDevice on node " << GetNode ()->GetId ());
+    }
+
+  m_file.Open (m_filename);
+  NS_ABORT_MSG_IF (m_file.Fail (), "Cannot read the capture " << m_filename);
+  uint32_t dataLinkType = m_file.GetDataLinkType ();
+  NS_ABORT_MSG_UNLESS (dataLinkType == DLT_IEEE802_15_4 || dataLinkType == DLT_IEEE802_15_4_NOFCS,
+                       "The capture " << m_filename << " does not contain 802.15.4 frames");
+  m_fcs = dataLinkType == DLT_IEEE802_15_4;
+
+  m_next = m_file.Begin ();
+  if (m_next != m_file.End ())
+    {
+      m_origin = GetTimestamp (*m_next);
+    }
+  m_start = Simulator::Now ();
+  ScheduleNext ();
+}
+
+void
+LrWpanTschTraceReplay::StopApplication (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_event.Cancel ();
+  m_file.Close ();
+}
+
+Time
+LrWpanTschTraceReplay::GetTimestamp (PcapFileMapping::Record const &record) const
+{
+  Time sub = m_file.IsNanoSecMode () ? NanoSeconds (record.GetTsUsec ()) : MicroSeconds (record.GetTsUsec ());
+  return Seconds (record.GetTsSec ()) + sub;
+}
+
+void
+LrWpanTschTraceReplay::ScheduleNext (void)
+{
+  // skip the frames the MAC generates itself, without waiting for them.
+  while (m_next != m_file.End () && !(m_next->GetInclLen () >= 3 && IsDataFrame (m_next->GetData ())))
+    {
+      ++m_next;
+    }
+  if (m_next == m_file.End ())
+    {
+      NS_LOG_LOGIC ("End of the capture, " << m_replayed << " frames replayed");
+      return;
+    }
+  Time at = m_start + GetTimestamp (*m_next) - m_origin;
+  m_event = Simulator::Schedule (at - Simulator::Now (), &LrWpanTschTraceReplay::Replay, this);
+}
+
+void
+LrWpanTschTraceReplay::Replay (void)
+{
+  NS_LOG_FUNCTION (this);
+  PcapFileMapping::Record const &record = *m_next;
+  if (record.GetInclLen () < record.GetOrigLen ())
+    {
+      NS_LOG_LOGIC ("Skip a frame truncated by the capture");
+    }
+  else
+    {
+      Ptr<Packet> p = Create<Packet> (record.GetData (), record.GetInclLen ());
+      if (m_fcs)
+        {
+          LrWpanMacTrailer trailer;
+          p->RemoveTrailer (trailer);
+        }
+      LrWpanMacHeader header;
+      p->RemoveHeader (header);
+      Mac16Address dest = Mac16Address::GetBroadcast ();
+      if (header.GetDstAddrMode () == LrWpanMacHeader::SHORTADDR)
+        {
+          dest = header.GetShortDstAddr ();
+        }
+      bool replay = m_source.IsBroadcast ();
+      if (header.GetSrcAddrMode () == LrWpanMacHeader::SHORTADDR)
+        {
+          replay = replay || header.GetShortSrcAddr () == m_source;
+        }
+      else if (header.GetSrcAddrMode () == LrWpanMacHeader::NOADDR)
+        {
+          // TSCH data frames carry no source address.
+          replay = replay || !(dest == m_source);
+        }
+      if (replay)
+        {
+          NS_LOG_LOGIC ("Replay a " << p->GetSize () << "-byte frame to " << dest);
+          m_txTrace (p, dest);
+          m_device->Send (p, dest, header.IsAckReq (), 0);
+          m_replayed++;
+        }
+    }
+  ++m_next;
+  ScheduleNext ();
+}
+
+} // namespace ns3
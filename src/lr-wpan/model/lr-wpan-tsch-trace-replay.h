@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef LR_WPAN_TSCH_TRACE_REPLAY_H
+#define LR_WPAN_TSCH_TRACE_REPLAY_H
+
+#include <ns3/application.h>
+#include <ns3/event-id.h>
+#include <ns3/mac16-address.h>
+#include <ns3/nstime.h>
+#include <ns3/pcap-file-mapping.h>
+#include <ns3/traced-callback.h>
+
+namespace ns3 {
+
+class LrWpanTschNetDevice;
+class Packet;
+
+/**
+ * \ingroup lr-wpan
+ *
+ * \brief Replay the data frames of an 802.15.4 pcap capture.
+ *
+ * The data frames of the capture, such as those written by
+ * LrWpanTschHelper::EnablePcap, are passed to LrWpanTschNetDevice::Send
+ * with the timing of the capture: the first record of the file is
+ * replayed when the application starts, and the next ones after the
+ * same intervals as in the capture. The MAC header and trailer are
+ * removed, and the frame is sent to its short destination address (or
+ * broadcast) with the acknowledgment request of its header; the MAC of
+ * the device adds its own header. Acknowledgments, beacons and command
+ * frames are skipped, as the MAC generates them itself. The Source
+ * attribute selects the frames of one device in a capture of several;
+ * TSCH data frames, which have no source address, are attributed to it
+ * unless they are addressed to it.
+ *
+ * The capture is mapped in memory, and its records are read one at a
+ * time, as they are replayed.
+ */
+class LrWpanTschTraceReplay : public Application
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  LrWpanTschTraceReplay ();
+  virtual ~LrWpanTschTraceReplay ();
+
+  /**
+   * \param device the device the frames are sent by; by default, the
+   *        first LrWpanTschNetDevice of the node
+   */
+  void SetNetDevice (Ptr<LrWpanTschNetDevice> device);
+  /**
+   * \returns the number of frames replayed
+   */
+  uint32_t GetReplayed (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  virtual void StartApplication (void);
+  virtual void StopApplication (void);
+
+  /**
+   * \param record a record of the capture
+   * \returns the timestamp of the record
+   */
+  Time GetTimestamp (PcapFileMapping::Record const &record) const;
+  /// Schedule the replay of the current record, or of the next data frame.
+  void ScheduleNext (void);
+  /// Send the current record, and schedule the next one.
+  void Replay (void);
+
+  std::string m_filename;            //!< the capture
+  Mac16Address m_source;             //!< the source of the frames replayed; broadcast for all
+  Ptr<LrWpanTschNetDevice> m_device; //!< the device the frames are sent by
+  PcapFileMapping m_file;            //!< the mapped capture
+  PcapFileMapping::Iterator m_next;  //!< the next record to replay
+  bool m_fcs;                        //!< true if the frames of the capture end with a FCS
+  Time m_origin;                     //!< timestamp of the first record
+  Time m_start;                      //!< time when the replay started
+  EventId m_event;                   //!< the next replay event
+  uint32_t m_replayed;               //!< number of frames replayed
+
+  /// Trace source for the frames replayed, as passed to the device.
+  TracedCallback<Ptr<const Packet>, const Mac16Address &> m_txTrace;
+};
+
+} // namespace ns3
+
+#endif /* LR_WPAN_TSCH_TRACE_REPLAY_H */
@@ -0,0 +1,140 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <fstream>
+#include <ns3/test.h>
+#include <ns3/packet.h>
+#include <ns3/uinteger.h>
+#include <ns3/lr-wpan-mac-header.h>
+#include <ns3/lr-wpan-mac-trailer.h>
+#include <ns3/lr-wpan-binary-trace.h>
+#include <ns3/mac16-address.h>
+#include <ns3/log.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("lr-wpan-binary-trace-test");
+
+class LrWpanBinaryTraceTestCase : public TestCase
+{
+public:
+  LrWpanBinaryTraceTestCase ();
+  virtual ~LrWpanBinaryTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LrWpanBinaryTraceTestCase::LrWpanBinaryTraceTestCase ()
+  : TestCase ("Test the records of the 802.15.4 binary trace")
+{
+}
+
+LrWpanBinaryTraceTestCase::~LrWpanBinaryTraceTestCase ()
+{
+}
+
+void
+LrWpanBinaryTraceTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("lr-wpan-binary-trace.bin");
+
+  LrWpanMacHeader macHdr (LrWpanMacHeader::LRWPAN_MAC_DATA, 42);
+  macHdr.SetSrcAddrMode (LrWpanMacHeader::SHORTADDR);
+  macHdr.SetDstAddrMode (LrWpanMacHeader::SHORTADDR);
+  macHdr.SetSrcAddrFields (123, Mac16Address ("00:01"));
+  macHdr.SetDstAddrFields (123, Mac16Address ("ab:cd"));
+  Ptr<Packet> p = Create<Packet> (20);
+  p->AddHeader (macHdr);
+  p->AddTrailer (LrWpanMacTrailer ());
+
+  LrWpanMacHeader tschHdr (LrWpanMacHeader::LRWPAN_MAC_DATA, 7);
+  tschHdr.SetSrcAddrMode (LrWpanMacHeader::NOADDR);
+  tschHdr.SetDstAddrMode (LrWpanMacHeader::SHORTADDR);
+  tschHdr.SetDstAddrFields (123, Mac16Address ("ff:ff"));
+  Ptr<Packet> q = Create<Packet> (10);
+  q->AddHeader (tschHdr);
+
+  // a small buffer, written several times, and set after Open as on
+  // the writers created by LrWpanTschHelper::EnableBinaryTrace
+  Ptr<LrWpanTraceWriter> writer = CreateObject<LrWpanTraceWriter> ();
+  writer->Open (filename);
+  NS_TEST_ASSERT_MSG_EQ (writer->Fail (), false, "Unable to open " << filename);
+  writer->SetAttribute ("BufferSize", UintegerValue (64));
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      writer->Write (MicroSeconds (i), i % 3, 1, LrWpanTraceRecord::TRANSMIT, p);
+    }
+  writer->Write (Seconds (2), 5, 0, LrWpanTraceRecord::RECEIVE, q);
+  writer->Close ();
+
+  LrWpanTraceReader reader;
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (filename), true, "Unable to read " << filename);
+  NS_TEST_ASSERT_MSG_EQ (reader.GetNRecords (), 101, "Wrong number of records");
+  NS_TEST_ASSERT_MSG_EQ ((reader.End () - reader.Begin ()), 101, "Begin and End do not span the records");
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      LrWpanTraceRecord const &record = reader.Get (i);
+      NS_TEST_ASSERT_MSG_EQ (record.time, MicroSeconds (i).GetNanoSeconds (), "Wrong time of record " << i);
+      NS_TEST_ASSERT_MSG_EQ (record.uid, p->GetUid (), "Wrong uid of record " << i);
+      NS_TEST_ASSERT_MSG_EQ (record.node, i % 3, "Wrong node of record " << i);
+      NS_TEST_ASSERT_MSG_EQ (record.device, 1, "Wrong device of record " << i);
+      NS_TEST_ASSERT_MSG_EQ (record.size, p->GetSize (), "Wrong size of record " << i);
+      NS_TEST_ASSERT_MSG_EQ (record.source, 0x0001, "Wrong source of record " << i);
+      NS_TEST_ASSERT_MSG_EQ (record.destination, 0xabcd, "Wrong destination of record " << i);
+      NS_TEST_ASSERT_MSG_EQ ((uint32_t)record.sequence, 42, "Wrong sequence number of record " << i);
+      NS_TEST_ASSERT_MSG_EQ (record.event, LrWpanTraceRecord::TRANSMIT, "Wrong event of record " << i);
+    }
+  LrWpanTraceRecord const &last = reader.Get (100);
+  NS_TEST_ASSERT_MSG_EQ (last.time, 2000000000, "Wrong time of the last record");
+  NS_TEST_ASSERT_MSG_EQ (last.node, 5, "Wrong node of the last record");
+  NS_TEST_ASSERT_MSG_EQ (last.source, LrWpanTraceRecord::NO_SHORT_ADDRESS, "A record without source has a source");
+  NS_TEST_ASSERT_MSG_EQ (last.destination, 0xffff, "Wrong broadcast destination");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t)last.sequence, 7, "Wrong sequence number of the last record");
+  NS_TEST_ASSERT_MSG_EQ (last.event, LrWpanTraceRecord::RECEIVE, "Wrong event of the last record");
+  reader.Close ();
+
+  // a truncated record is not read
+  std::ofstream truncated (filename.c_str (), std::ios::out | std::ios::app | std::ios::binary);
+  truncated.write ("abc", 3);
+  truncated.close ();
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (filename), true, "Unable to read " << filename);
+  NS_TEST_ASSERT_MSG_EQ (reader.GetNRecords (), 101, "Truncated record read");
+  reader.Close ();
+
+  // neither is a file of another format, or a missing file
+  std::ofstream other (filename.c_str (), std::ios::out | std::ios::trunc | std::ios::binary);
+  other << "not a binary trace of 802.15.4 events";
+  other.close ();
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (filename), false, "File of another format read");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetNRecords (), 0, "Records read from a file of another format");
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (filename + ".missing"), false, "Missing file read");
+  remove (filename.c_str ());
+}
+
+// ==============================================================================
+class LrWpanBinaryTraceTestSuite : public TestSuite
+{
+public:
+  LrWpanBinaryTraceTestSuite ();
+};
+
+LrWpanBinaryTraceTestSuite::LrWpanBinaryTraceTestSuite ()
+  : TestSuite ("lr-wpan-binary-trace", UNIT)
+{
+  AddTestCase (new LrWpanBinaryTraceTestCase, TestCase::QUICK);
+}
+
+static LrWpanBinaryTraceTestSuite lrWpanBinaryTraceTestSuite;
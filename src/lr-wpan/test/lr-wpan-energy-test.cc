@@ -0,0 +1,119 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/log.h>
+#include <ns3/lr-wpan-energy-source.h>
+#include <ns3/lr-wpan-radio-energy-model.h>
+
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("lr-wpan-energy-test");
+
+/*
+ * The radio stays in TRX_OFF for 1 s, in TX_ON for 0.5 s and then in RX_ON
+ * until the 30 mJ battery is drained, i.e., at about 14.49896 s.
+ */
+class LrWpanEnergyDepletionTestCase : public TestCase
+{
+public:
+  LrWpanEnergyDepletionTestCase (bool lazy);
+  virtual ~LrWpanEnergyDepletionTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void EnergyDepleted (void);
+
+  bool m_lazy;
+  Time m_depletionTime;
+};
+
+LrWpanEnergyDepletionTestCase::LrWpanEnergyDepletionTestCase (bool lazy)
+  : TestCase (lazy ? "Test the predicted energy depletion of LrWpanEnergySource"
+              : "Test the periodic energy depletion of LrWpanEnergySource"),
+    m_lazy (lazy)
+{
+}
+
+LrWpanEnergyDepletionTestCase::~LrWpanEnergyDepletionTestCase ()
+{
+}
+
+void
+LrWpanEnergyDepletionTestCase::EnergyDepleted (void)
+{
+  m_depletionTime = Simulator::Now ();
+}
+
+void
+LrWpanEnergyDepletionTestCase::DoRun (void)
+{
+  Ptr<LrWpanEnergySource> source = CreateObject<LrWpanEnergySource> ();
+  source->SetEnergyUnlimited (false);
+  source->SetInitialEnergy (0.03);
+  source->SetSupplyVoltage (3.0);
+  source->SetEnergyUpdateInterval (Seconds (1.0));
+  source->SetLazyEnergyUpdate (m_lazy);
+
+  Ptr<LrWpanRadioEnergyModel> model = CreateObject<LrWpanRadioEnergyModel> ();
+  model->SetEnergySource (source);
+  model->SetEnergyDepletionCallback (MakeCallback (&LrWpanEnergyDepletionTestCase::EnergyDepleted, this));
+  source->AppendDeviceEnergyModel (model);
+  source->Initialize ();
+
+  Simulator::Schedule (Seconds (1.0), &LrWpanRadioEnergyModel::ChangeLrWpanState, model,
+                       Seconds (1.0), IEEE_802_15_4_PHY_TRX_OFF, IEEE_802_15_4_PHY_TX_ON);
+  Simulator::Schedule (Seconds (1.5), &LrWpanRadioEnergyModel::ChangeLrWpanState, model,
+                       Seconds (1.5), IEEE_802_15_4_PHY_TX_ON, IEEE_802_15_4_PHY_RX_ON);
+  Simulator::Stop (Seconds (20));
+  Simulator::Run ();
+
+  double offJ = 1.0 * 0.00000052 * 3.0;
+  double txJ = 0.5 * 0.007 * 3.0;
+  double expected = 1.5 + (0.03 - offJ - txJ) / (0.0005 * 3.0);
+
+  if (m_lazy)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_depletionTime.GetSeconds (), expected, 1e-6,
+                                 "Energy depletion not predicted at the right time");
+    }
+  else
+    {
+      // detected at the first periodic update after the depletion
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_depletionTime.GetSeconds (), 14.5, 1e-9,
+                                 "Energy depletion not detected at the right periodic update");
+    }
+  NS_TEST_EXPECT_MSG_EQ (source->GetRemainingEnergy (), 0, "Energy source not drained");
+
+  Simulator::Destroy ();
+}
+
+// ==============================================================================
+class LrWpanEnergyTestSuite : public TestSuite
+{
+public:
+  LrWpanEnergyTestSuite ();
+};
+
+LrWpanEnergyTestSuite::LrWpanEnergyTestSuite ()
+  : TestSuite ("lr-wpan-energy", UNIT)
+{
+  AddTestCase (new LrWpanEnergyDepletionTestCase (false), TestCase::QUICK);
+  AddTestCase (new LrWpanEnergyDepletionTestCase (true), TestCase::QUICK);
+}
+
+static LrWpanEnergyTestSuite lrWpanEnergyTestSuite;
@@ -0,0 +1,110 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <cmath>
+#include <ns3/test.h>
+#include <ns3/lr-wpan-interference-helper.h>
+#include <ns3/lr-wpan-spectrum-value-helper.h>
+#include <ns3/lr-wpan-phy.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/log.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("lr-wpan-interference-helper-test");
+
+class LrWpanInterferenceHelperTestCase : public TestCase
+{
+public:
+  LrWpanInterferenceHelperTestCase ();
+  virtual ~LrWpanInterferenceHelperTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param helper the interference helper
+   * \param psd the PSD of the signals added
+   * \param gain the expected sum of the gains of the signals
+   * \returns true if the helper accumulates psd times gain
+   */
+  bool CheckSignal (Ptr<LrWpanInterferenceHelper> helper, Ptr<const SpectrumValue> psd, double gain);
+};
+
+LrWpanInterferenceHelperTestCase::LrWpanInterferenceHelperTestCase ()
+  : TestCase ("Test the signals of the same PSD accumulated by LrWpanInterferenceHelper")
+{
+}
+
+LrWpanInterferenceHelperTestCase::~LrWpanInterferenceHelperTestCase ()
+{
+}
+
+bool
+LrWpanInterferenceHelperTestCase::CheckSignal (Ptr<LrWpanInterferenceHelper> helper, Ptr<const SpectrumValue> psd, double gain)
+{
+  Ptr<SpectrumValue> signal = helper->GetSignalPsd ();
+  for (uint32_t i = 0; i < psd->GetSpectrumModel ()->GetNumBands (); i++)
+    {
+      double expected = (*psd)[i] * gain;
+      if (std::abs ((*signal)[i] - expected) > std::abs (expected) * 1e-9 + 1e-30)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+LrWpanInterferenceHelperTestCase::DoRun (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (CreateObject<LrWpanPhy> ()->SupportsPsdGain (), true, "LrWpanPhy does not support psdGain");
+
+  LrWpanSpectrumValueHelper psdHelper;
+  Ptr<const SpectrumValue> psd = psdHelper.CreateTxPowerSpectralDensity (0, 11);
+  Ptr<LrWpanInterferenceHelper> helper = Create<LrWpanInterferenceHelper> (psd->GetSpectrumModel ());
+
+  // successive frames of a transmitter share its PSD, and are received
+  // with the same gain
+  double gain = 1e-6;
+  double other = 1e-8;
+  NS_TEST_ASSERT_MSG_EQ (helper->AddSignal (psd, gain), true, "Signal not added");
+  NS_TEST_ASSERT_MSG_EQ (helper->AddSignal (psd, gain), true, "Signal not added");
+  NS_TEST_ASSERT_MSG_EQ (helper->AddSignal (psd, other), true, "Signal not added");
+  NS_TEST_EXPECT_MSG_EQ (CheckSignal (helper, psd, 2 * gain + other), true, "Wrong sum of the signals");
+
+  // removing one of two identical signals keeps the other
+  NS_TEST_ASSERT_MSG_EQ (helper->RemoveSignal (psd, gain), true, "Signal not removed");
+  NS_TEST_EXPECT_MSG_EQ (CheckSignal (helper, psd, gain + other), true, "Both identical signals removed");
+  NS_TEST_ASSERT_MSG_EQ (helper->RemoveSignal (psd, gain), true, "Second signal not removed");
+  NS_TEST_EXPECT_MSG_EQ (CheckSignal (helper, psd, other), true, "Wrong signal removed");
+  NS_TEST_EXPECT_MSG_EQ (helper->RemoveSignal (psd, gain), false, "Signal removed more times than added");
+  NS_TEST_ASSERT_MSG_EQ (helper->RemoveSignal (psd, other), true, "Signal not removed");
+  NS_TEST_EXPECT_MSG_EQ (CheckSignal (helper, psd, 0), true, "Signal left");
+}
+
+// ==============================================================================
+class LrWpanInterferenceHelperTestSuite : public TestSuite
+{
+public:
+  LrWpanInterferenceHelperTestSuite ();
+};
+
+LrWpanInterferenceHelperTestSuite::LrWpanInterferenceHelperTestSuite ()
+  : TestSuite ("lr-wpan-interference-helper", UNIT)
+{
+  AddTestCase (new LrWpanInterferenceHelperTestCase, TestCase::QUICK);
+}
+
+static LrWpanInterferenceHelperTestSuite lrWpanInterferenceHelperTestSuite;
@@ -23,6 +23,12 @@
 #include <ns3/lr-wpan-mac-trailer.h>
 #include <ns3/mac16-address.h>
 #include <ns3/mac64-address.h>
+#include <ns3/lr-wpan-tsch-net-device.h>
+#include <ns3/lr-wpan-mac.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/node.h>
+#include <ns3/boolean.h>
+#include <ns3/simulator.h>
 #include <ns3/log.h>
 
 
@@ -104,6 +110,88 @@ LrWpanPacketTestCase::DoRun (void)
 
 }
 
+// ==============================================================================
+class LrWpanPacketMetadataTestCase : public TestCase
+{
+public:
+  LrWpanPacketMetadataTestCase ();
+  virtual ~LrWpanPacketMetadataTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Record the packet enqueued by a MAC.
+   * \param p the packet
+   */
+  void TxEnqueue (Ptr<const Packet> p);
+
+  Ptr<const Packet> m_enqueued; //!< the last packet enqueued
+};
+
+LrWpanPacketMetadataTestCase::LrWpanPacketMetadataTestCase ()
+  : TestCase ("Test the PacketMetadata attribute of LrWpanTschNetDevice")
+{
+}
+
+LrWpanPacketMetadataTestCase::~LrWpanPacketMetadataTestCase ()
+{
+}
+
+void
+LrWpanPacketMetadataTestCase::TxEnqueue (Ptr<const Packet> p)
+{
+  m_enqueued = p;
+}
+
+void
+LrWpanPacketMetadataTestCase::DoRun (void)
+{
+  Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel> ();
+  Ptr<Node> n0 = CreateObject<Node> ();
+  Ptr<Node> n1 = CreateObject<Node> ();
+  Ptr<LrWpanTschNetDevice> dev0 = CreateObject<LrWpanTschNetDevice> ();
+  Ptr<LrWpanTschNetDevice> dev1 = CreateObject<LrWpanTschNetDevice> ();
+  dev0->SetChannel (channel);
+  dev1->SetChannel (channel);
+  n0->AddDevice (dev0);
+  n1->AddDevice (dev1);
+  dev0->SetAddress (Mac16Address ("00:01"));
+  dev1->SetAddress (Mac16Address ("00:02"));
+  dev0->SetAttribute ("PacketMetadata", BooleanValue (true));
+  dev0->GetOMac ()->TraceConnectWithoutContext ("MacTxEnqueue", MakeCallback (&LrWpanPacketMetadataTestCase::TxEnqueue, this));
+  dev1->GetOMac ()->TraceConnectWithoutContext ("MacTxEnqueue", MakeCallback (&LrWpanPacketMetadataTestCase::TxEnqueue, this));
+
+  // the device opting in records the MAC header and trailer of its packets
+  Ptr<Packet> p = Create<Packet> (20);
+  dev0->Send (p, Mac16Address ("ff:ff"), 0);
+  NS_TEST_ASSERT_MSG_NE (m_enqueued, 0, "No packet enqueued");
+  NS_TEST_ASSERT_MSG_EQ (m_enqueued->IsMetadataEnabled (), true, "No metadata maintained");
+  PacketMetadata::ItemIterator i = m_enqueued->BeginItem ();
+  NS_TEST_ASSERT_MSG_EQ (i.HasNext (), true, "No metadata item");
+  PacketMetadata::Item item = i.Next ();
+  NS_TEST_ASSERT_MSG_EQ (item.type, PacketMetadata::Item::HEADER, "First item is not a header");
+  NS_TEST_ASSERT_MSG_EQ (item.tid, LrWpanMacHeader::GetTypeId (), "First item is not the MAC header");
+  item = i.Next ();
+  NS_TEST_ASSERT_MSG_EQ (item.type, PacketMetadata::Item::PAYLOAD, "Second item is not the payload");
+  NS_TEST_ASSERT_MSG_EQ (item.currentSize, 20, "Wrong payload size");
+  item = i.Next ();
+  NS_TEST_ASSERT_MSG_EQ (item.type, PacketMetadata::Item::TRAILER, "Third item is not a trailer");
+  NS_TEST_ASSERT_MSG_EQ (item.tid, LrWpanMacTrailer::GetTypeId (), "Third item is not the MAC trailer");
+  NS_TEST_ASSERT_MSG_EQ (i.HasNext (), false, "Unexpected metadata item");
+
+  // the other device does not, unless printing was enabled globally
+  m_enqueued = 0;
+  Ptr<Packet> q = Create<Packet> (20);
+  bool printing = q->IsMetadataEnabled ();
+  dev1->Send (q, Mac16Address ("ff:ff"), 0);
+  NS_TEST_ASSERT_MSG_NE (m_enqueued, 0, "No packet enqueued");
+  NS_TEST_ASSERT_MSG_EQ (m_enqueued->IsMetadataEnabled (), printing, "Metadata maintained without opting in");
+
+  Simulator::Run ();
+  m_enqueued = 0;
+  Simulator::Destroy ();
+}
+
 // ==============================================================================
 class LrWpanPacketTestSuite : public TestSuite
 {
@@ -115,6 +203,7 @@ LrWpanPacketTestSuite::LrWpanPacketTestSuite ()
   : TestSuite ("lr-wpan-packet", UNIT)
 {
   AddTestCase (new LrWpanPacketTestCase, TestCase::QUICK);
+  AddTestCase (new LrWpanPacketMetadataTestCase, TestCase::QUICK);
 }
 
 static LrWpanPacketTestSuite lrWpanPacketTestSuite;
@@ -0,0 +1,228 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <cstdio>
+#include <vector>
+#include <ns3/test.h>
+#include <ns3/packet.h>
+#include <ns3/pcap-file.h>
+#include <ns3/node.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/lr-wpan-mac-header.h>
+#include <ns3/lr-wpan-mac-trailer.h>
+#include <ns3/lr-wpan-tsch-net-device.h>
+#include <ns3/lr-wpan-tsch-trace-replay.h>
+#include <ns3/mac16-address.h>
+#include <ns3/log.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("lr-wpan-tsch-trace-replay-test");
+
+class LrWpanTschTraceReplayTestCase : public TestCase
+{
+public:
+  LrWpanTschTraceReplayTestCase ();
+  virtual ~LrWpanTschTraceReplayTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Write the capture replayed.
+   * \param filename the name of the capture
+   * \param dataLinkType 195 to write the frames with a FCS, 230 without
+   */
+  void WriteCapture (std::string filename, uint32_t dataLinkType);
+  /**
+   * Write a frame to the capture.
+   * \param file the capture
+   * \param usec the timestamp of the frame, in microseconds after 10 s
+   * \param header the MAC header of the frame
+   * \param size the size of the payload of the frame
+   * \param fcs true to add a MAC trailer
+   */
+  void WriteFrame (PcapFile &file, uint32_t usec, LrWpanMacHeader const &header,
+                   uint32_t size, bool fcs);
+  /**
+   * Replay a capture, recording the frames replayed.
+   * \param filename the name of the capture
+   * \param source the Source attribute of the replay
+   */
+  void Replay (std::string filename, Mac16Address source);
+  /**
+   * Record a frame replayed.
+   * \param p the frame, without its MAC header and trailer
+   * \param dest the destination of the frame
+   */
+  void Tx (Ptr<const Packet> p, const Mac16Address &dest);
+
+  std::vector<Time> m_times;            //!< the times the frames were replayed
+  std::vector<uint32_t> m_sizes;        //!< the sizes of the frames replayed
+  std::vector<Mac16Address> m_dests;    //!< the destinations of the frames replayed
+};
+
+LrWpanTschTraceReplayTestCase::LrWpanTschTraceReplayTestCase ()
+  : TestCase ("Test the replay of the data frames of an 802.15.4 capture")
+{
+}
+
+LrWpanTschTraceReplayTestCase::~LrWpanTschTraceReplayTestCase ()
+{
+}
+
+void
+LrWpanTschTraceReplayTestCase::WriteFrame (PcapFile &file, uint32_t usec, LrWpanMacHeader const &header,
+                                           uint32_t size, bool fcs)
+{
+  Ptr<Packet> p = Create<Packet> (size);
+  p->AddHeader (header);
+  if (fcs)
+    {
+      p->AddTrailer (LrWpanMacTrailer ());
+    }
+  file.Write (10, usec, p);
+}
+
+void
+LrWpanTschTraceReplayTestCase::WriteCapture (std::string filename, uint32_t dataLinkType)
+{
+  bool fcs = dataLinkType == 195;
+  PcapFile file;
+  file.Open (filename, std::ios::out);
+  file.Init (dataLinkType);
+
+  // the first record, which is not replayed, is the origin of the timing
+  LrWpanMacHeader ack (LrWpanMacHeader::LRWPAN_MAC_ACKNOWLEDGMENT, 1);
+  WriteFrame (file, 0, ack, 0, fcs);
+
+  LrWpanMacHeader data (LrWpanMacHeader::LRWPAN_MAC_DATA, 2);
+  data.SetSrcAddrMode (LrWpanMacHeader::SHORTADDR);
+  data.SetDstAddrMode (LrWpanMacHeader::SHORTADDR);
+  data.SetSrcAddrFields (1, Mac16Address ("00:01"));
+  data.SetDstAddrFields (1, Mac16Address ("00:02"));
+  WriteFrame (file, 1000, data, 5, fcs);
+
+  LrWpanMacHeader beacon (LrWpanMacHeader::LRWPAN_MAC_BEACON, 3);
+  beacon.SetSrcAddrMode (LrWpanMacHeader::SHORTADDR);
+  beacon.SetDstAddrMode (LrWpanMacHeader::NOADDR);
+  beacon.SetSrcAddrFields (1, Mac16Address ("00:01"));
+  WriteFrame (file, 2000, beacon, 4, fcs);
+
+  data.SetSrcAddrFields (1, Mac16Address ("00:03"));
+  data.SetDstAddrFields (1, Mac16Address ("00:01"));
+  WriteFrame (file, 3000, data, 6, fcs);
+
+  // TSCH data frames, without source address
+  LrWpanMacHeader tsch (LrWpanMacHeader::LRWPAN_MAC_DATA, 4);
+  tsch.SetSrcAddrMode (LrWpanMacHeader::NOADDR);
+  tsch.SetDstAddrMode (LrWpanMacHeader::SHORTADDR);
+  tsch.SetDstAddrFields (1, Mac16Address ("00:02"));
+  WriteFrame (file, 5000, tsch, 7, fcs);
+  tsch.SetDstAddrFields (1, Mac16Address ("00:01"));
+  WriteFrame (file, 8000, tsch, 8, fcs);
+
+  file.Close ();
+}
+
+void
+LrWpanTschTraceReplayTestCase::Tx (Ptr<const Packet> p, const Mac16Address &dest)
+{
+  m_times.push_back (Simulator::Now ());
+  m_sizes.push_back (p->GetSize ());
+  m_dests.push_back (dest);
+}
+
+void
+LrWpanTschTraceReplayTestCase::Replay (std::string filename, Mac16Address source)
+{
+  m_times.clear ();
+  m_sizes.clear ();
+  m_dests.clear ();
+
+  Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel> ();
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<LrWpanTschNetDevice> dev = CreateObject<LrWpanTschNetDevice> ();
+  dev->SetChannel (channel);
+  node->AddDevice (dev);
+  dev->SetAddress (Mac16Address ("00:01"));
+
+  Ptr<LrWpanTschTraceReplay> replay = CreateObject<LrWpanTschTraceReplay> ();
+  replay->SetAttribute ("Filename", StringValue (filename));
+  replay->SetAttribute ("Source", Mac16AddressValue (source));
+  replay->TraceConnectWithoutContext ("Tx", MakeCallback (&LrWpanTschTraceReplayTestCase::Tx, this));
+  node->AddApplication (replay);
+  replay->SetStartTime (Seconds (1));
+
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (replay->GetReplayed (), m_times.size (), "Replayed frames not traced");
+  Simulator::Destroy ();
+}
+
+void
+LrWpanTschTraceReplayTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("lr-wpan-tsch-trace-replay.pcap");
+  uint32_t dataLinkTypes[] = { 195, 230 };
+
+  // all the data frames, without their trailer if the capture has a FCS,
+  // at the same intervals from the first record of the capture
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      WriteCapture (filename, dataLinkTypes[i]);
+      Replay (filename, Mac16Address::GetBroadcast ());
+      NS_TEST_ASSERT_MSG_EQ (m_times.size (), 4, "Wrong number of frames replayed with DLT " << dataLinkTypes[i]);
+      uint32_t ms[] = { 1, 3, 5, 8 };
+      uint32_t sizes[] = { 5, 6, 7, 8 };
+      Mac16Address dests[] = { Mac16Address ("00:02"), Mac16Address ("00:01"),
+                               Mac16Address ("00:02"), Mac16Address ("00:01") };
+      for (uint32_t j = 0; j < 4; j++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (m_times[j], Seconds (1) + MilliSeconds (ms[j]), "Wrong time of frame " << j);
+          NS_TEST_EXPECT_MSG_EQ (m_sizes[j], sizes[j], "Wrong size of frame " << j << " with DLT " << dataLinkTypes[i]);
+          NS_TEST_EXPECT_MSG_EQ (m_dests[j], dests[j], "Wrong destination of frame " << j);
+        }
+    }
+
+  // the frames of 00:01: the frames without source address are
+  // attributed to it, unless they are sent to it
+  WriteCapture (filename, 195);
+  Replay (filename, Mac16Address ("00:01"));
+  NS_TEST_ASSERT_MSG_EQ (m_times.size (), 2, "Wrong number of frames replayed from 00:01");
+  NS_TEST_EXPECT_MSG_EQ (m_times[0], Seconds (1) + MilliSeconds (1), "Wrong time of the first frame");
+  NS_TEST_EXPECT_MSG_EQ (m_sizes[0], 5, "Wrong first frame");
+  NS_TEST_EXPECT_MSG_EQ (m_times[1], Seconds (1) + MilliSeconds (5), "Wrong time of the second frame");
+  NS_TEST_EXPECT_MSG_EQ (m_sizes[1], 7, "Wrong second frame");
+  NS_TEST_EXPECT_MSG_EQ (m_dests[1], Mac16Address ("00:02"), "Wrong destination of the second frame");
+
+  remove (filename.c_str ());
+}
+
+// ==============================================================================
+class LrWpanTschTraceReplayTestSuite : public TestSuite
+{
+public:
+  LrWpanTschTraceReplayTestSuite ();
+};
+
+LrWpanTschTraceReplayTestSuite::LrWpanTschTraceReplayTestSuite ()
+  : TestSuite ("lr-wpan-tsch-trace-replay", UNIT)
+{
+  AddTestCase (new LrWpanTschTraceReplayTestCase, TestCase::QUICK);
+}
+
+static LrWpanTschTraceReplayTestSuite lrWpanTschTraceReplayTestSuite;
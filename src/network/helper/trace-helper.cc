@@ -76,6 +76,18 @@ PcapHelper::CreateFile (
   return file;
 }
 
+Ptr<PcapngFileWrapper>
+PcapHelper::CreatePcapngFile (std::string filename)
+{
+  NS_LOG_FUNCTION (filename);
+
+  Ptr<PcapngFileWrapper> file = CreateObject<PcapngFileWrapper> ();
+  file->Open (filename);
+  NS_ABORT_MSG_IF (file->Fail (), "Unable to Open " << filename);
+
+  return file;
+}
+
 std::string
 PcapHelper::GetFilenameFromDevice (std::string prefix, Ptr<NetDevice> device, bool useObjectNames)
 {
@@ -24,6 +24,7 @@
 #include "ns3/node-container.h"
 #include "ns3/simulator.h"
 #include "ns3/pcap-file-wrapper.h"
+#include "ns3/pcapng-file-wrapper.h"
 #include "ns3/output-stream-wrapper.h"
 
 namespace ns3 {
@@ -101,6 +102,15 @@ public:
    */
   Ptr<PcapFileWrapper> CreateFile (std::string filename, std::ios::openmode filemode,
                                    uint32_t dataLinkType,  uint32_t snapLen = std::numeric_limits<uint32_t>::max (), int32_t tzCorrection = 0);
+  /**
+   * @brief Create a pcapng file, in which several devices can be captured.
+   *
+   * Each device must be described with PcapngFileWrapper::AddInterface.
+   *
+   * @param filename file name
+   * @returns a smart pointer to the pcapng file
+   */
+  Ptr<PcapngFileWrapper> CreatePcapngFile (std::string filename);
   /**
    * @brief Hook a trace source to the default trace sink
    * 
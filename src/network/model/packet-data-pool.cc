@@ -0,0 +1,204 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "packet-data-pool.h"
+#include "ns3/log.h"
+#include "ns3/core-config.h"
+
+#include <new>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PacketDataPool");
+
+namespace {
+
+/// Size of the smallest size class, in bytes
+const uint32_t DATA_POOL_MIN_SIZE = 32;
+/// Number of size classes, up to 8 KiB; larger blocks use the heap
+const uint32_t DATA_POOL_CLASSES = 33;
+/// Maximum number of blocks kept in each free list
+const uint32_t DATA_POOL_MAX_FREE = 1024;
+
+struct DataPoolBlock
+{
+  DataPoolBlock *next;
+};
+
+/// Per-thread data pool. Must be a POD to be thread-local.
+struct DataPool
+{
+  DataPoolBlock *free[PacketDataPool::USERS][DATA_POOL_CLASSES];
+  uint32_t length[PacketDataPool::USERS][DATA_POOL_CLASSES];
+  struct PacketDataPool::Statistics stats[PacketDataPool::USERS];
+  bool registered;
+};
+
+__thread DataPool g_dataPool;
+
+/*
+ * Set when the static destructors of this compilation unit have run:
+ * blocks released later go straight back to the heap.
+ */
+bool g_dataPoolDestroyed = false;
+
+/**
+ * \param size the requested size, in bytes
+ * \param capacity set to the size of the blocks of the size class
+ * \returns the size class, which is DATA_POOL_CLASSES if size is too large
+ *
+ * Each power of two is divided in four classes: 32, 40, 48, 56, 64, 80...
+ */
+inline uint32_t
+DataPoolClass (uint32_t size, uint32_t *capacity)
+{
+  if (size <= DATA_POOL_MIN_SIZE)
+    {
+      *capacity = DATA_POOL_MIN_SIZE;
+      return 0;
+    }
+  uint32_t bits = 31 - __builtin_clz (size - 1);
+  uint32_t shift = bits - 2;
+  uint32_t quarter = (size - 1) >> shift;
+  uint32_t sizeClass = (bits - 5) * 4 + (quarter - 4) + 1;
+  if (sizeClass >= DATA_POOL_CLASSES)
+    {
+      *capacity = size;
+      return DATA_POOL_CLASSES;
+    }
+  *capacity = (quarter + 1) << shift;
+  return sizeClass;
+}
+
+#ifdef HAVE_PTHREAD_H
+pthread_key_t g_dataPoolKey;
+pthread_once_t g_dataPoolKeyOnce = PTHREAD_ONCE_INIT;
+
+void
+DataPoolThreadExit (void *)
+{
+  PacketDataPool::Release ();
+}
+
+void
+DataPoolCreateKey (void)
+{
+  pthread_key_create (&g_dataPoolKey, &DataPoolThreadExit);
+}
+#endif /* HAVE_PTHREAD_H */
+
+/// Make sure the free lists of the calling thread are released when it exits.
+void
+DataPoolRegister (DataPool &pool)
+{
+  pool.registered = true;
+#ifdef HAVE_PTHREAD_H
+  pthread_once (&g_dataPoolKeyOnce, &DataPoolCreateKey);
+  pthread_setspecific (g_dataPoolKey, &pool);
+#endif
+}
+
+/// Release the free lists of the main thread at the end of the program.
+struct DataPoolDestructor
+{
+  ~DataPoolDestructor ()
+  {
+    PacketDataPool::Release ();
+    g_dataPoolDestroyed = true;
+  }
+} g_dataPoolDestructor;
+
+} // anonymous namespace
+
+void *
+PacketDataPool::Allocate (enum User user, uint32_t *size)
+{
+  DataPool &pool = g_dataPool;
+  uint32_t sizeClass = DataPoolClass (*size, size);
+  if (sizeClass < DATA_POOL_CLASSES)
+    {
+      DataPoolBlock *block = pool.free[user][sizeClass];
+      if (block != 0)
+        {
+          pool.free[user][sizeClass] = block->next;
+          pool.length[user][sizeClass]--;
+          pool.stats[user].hits++;
+          pool.stats[user].bytesRetained -= *size;
+          return block;
+        }
+    }
+  pool.stats[user].misses++;
+  return ::operator new (*size);
+}
+
+void
+PacketDataPool::Deallocate (enum User user, void *block, uint32_t size)
+{
+  DataPool &pool = g_dataPool;
+  uint32_t capacity;
+  uint32_t sizeClass = DataPoolClass (size, &capacity);
+  if (sizeClass == DATA_POOL_CLASSES
+      || pool.length[user][sizeClass] >= DATA_POOL_MAX_FREE
+      || g_dataPoolDestroyed)
+    {
+      ::operator delete (block);
+      return;
+    }
+  if (!pool.registered)
+    {
+      DataPoolRegister (pool);
+    }
+  DataPoolBlock *b = static_cast<DataPoolBlock *> (block);
+  b->next = pool.free[user][sizeClass];
+  pool.free[user][sizeClass] = b;
+  pool.length[user][sizeClass]++;
+  pool.stats[user].bytesRetained += capacity;
+}
+
+struct PacketDataPool::Statistics
+PacketDataPool::GetStatistics (enum User user)
+{
+  NS_LOG_FUNCTION (user);
+  return g_dataPool.stats[user];
+}
+
+void
+PacketDataPool::Release (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  DataPool &pool = g_dataPool;
+  for (uint32_t user = 0; user < USERS; user++)
+    {
+      for (uint32_t i = 0; i < DATA_POOL_CLASSES; i++)
+        {
+          while (pool.free[user][i] != 0)
+            {
+              DataPoolBlock *block = pool.free[user][i];
+              pool.free[user][i] = block->next;
+              ::operator delete (block);
+            }
+          pool.length[user][i] = 0;
+        }
+      pool.stats[user].hits = 0;
+      pool.stats[user].misses = 0;
+      pool.stats[user].bytesRetained = 0;
+    }
+}
+
+} // namespace ns3
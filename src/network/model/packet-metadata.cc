@@ -23,6 +23,7 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 #include "packet-metadata.h"
+#include "packet-data-pool.h"
 #include "buffer.h"
 #include "header.h"
 #include "trailer.h"
@@ -34,19 +35,7 @@ NS_LOG_COMPONENT_DEFINE ("PacketMetadata");
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
-
-PacketMetadata::DataFreeList::~DataFreeList ()
-{
-  NS_LOG_FUNCTION (this);
-  for (iterator i = begin (); i != end (); i++)
-    {
-      PacketMetadata::Deallocate (*i);
-    }
-  PacketMetadata::m_enable = false;
-}
 
 void 
 PacketMetadata::Enable (void)
@@ -70,18 +59,63 @@ PacketMetadata::EnableChecking (void)
   m_enableChecking = true;
 }
 
+void
+PacketMetadata::EnableRecording (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  if (m_record)
+    {
+      return;
+    }
+  NS_ASSERT (m_head == 0xffff);
+  m_record = true;
+  if (size > 0)
+    {
+      DoAddHeader (0, size);
+    }
+}
+
+void
+PacketMetadata::DisableRecording (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_data != 0)
+    {
+      m_data->m_count--;
+      if (m_data->m_count == 0)
+        {
+          PacketMetadata::Recycle (m_data);
+        }
+      m_data = 0;
+    }
+  m_head = 0xffff;
+  m_tail = 0xffff;
+  m_used = 0;
+  m_record = false;
+}
+
+bool
+PacketMetadata::IsRecording (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_record;
+}
+
 void
 PacketMetadata::ReserveCopy (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
   struct PacketMetadata::Data *newData = PacketMetadata::Create (m_used + size);
-  memcpy (newData->m_data, m_data->m_data, m_used);
-  newData->m_dirtyEnd = m_used;
-  m_data->m_count--;
-  if (m_data->m_count == 0) 
+  if (m_data != 0)
     {
-      PacketMetadata::Recycle (m_data);
+      memcpy (newData->m_data, m_data->m_data, m_used);
+      m_data->m_count--;
+      if (m_data->m_count == 0) 
+        {
+          PacketMetadata::Recycle (m_data);
+        }
     }
+  newData->m_dirtyEnd = m_used;
   m_data = newData;
   if (m_head != 0xffff)
     {
@@ -99,8 +133,8 @@ void
 PacketMetadata::Reserve (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
-  NS_ASSERT (m_data != 0);
-  if (m_data->m_size >= m_used + size &&
+  if (m_data != 0 &&
+      m_data->m_size >= m_used + size &&
       (m_head == 0xffff ||
        m_data->m_count == 1 ||
        m_data->m_dirtyEnd == m_used))
@@ -133,6 +167,10 @@ bool
 PacketMetadata::IsStateOk (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_data == 0)
+    {
+      return m_head == 0xffff && m_tail == 0xffff && m_used == 0;
+    }
   bool ok = m_used <= m_data->m_size;
   ok &= IsPointerOk (m_head);
   ok &= IsPointerOk (m_tail);
@@ -375,12 +413,12 @@ uint16_t
 PacketMetadata::AddSmall (const struct PacketMetadata::SmallItem *item)
 {
   NS_LOG_FUNCTION (this << item->next << item->prev << item->typeUid << item->size << item->chunkUid);
-  NS_ASSERT (m_data != 0);
   NS_ASSERT (m_used != item->prev && m_used != item->next);
   uint32_t typeUidSize = GetUleb128Size (item->typeUid);
   uint32_t sizeSize = GetUleb128Size (item->size);
   uint32_t n =  2 + 2 + typeUidSize + sizeSize + 2;
-  if (m_used + n > m_data->m_size ||
+  if (m_data == 0 ||
+      m_used + n > m_data->m_size ||
       (m_head != 0xffff &&
        m_data->m_count != 1 &&
        m_used != m_data->m_dirtyEnd))
@@ -408,7 +446,6 @@ PacketMetadata::AddBig (uint32_t next, uint32_t prev,
   NS_LOG_FUNCTION (this << next << prev <<
                    item->next << item->prev << item->typeUid << item->size << item->chunkUid <<
                    extraItem->fragmentStart << extraItem->fragmentEnd << extraItem->packetUid);
-  NS_ASSERT (m_data != 0);
   uint32_t typeUid = ((item->typeUid & 0x1) == 0x1) ? item->typeUid : item->typeUid+1;
   NS_ASSERT (m_used != prev && m_used != next);
 
@@ -418,7 +455,8 @@ PacketMetadata::AddBig (uint32_t next, uint32_t prev,
   uint32_t fragEndSize = GetUleb128Size (extraItem->fragmentEnd);
   uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
-  if (m_used + n > m_data->m_size ||
+  if (m_data == 0 ||
+      m_used + n > m_data->m_size ||
       (m_head != 0xffff &&
        m_data->m_count != 1 &&
        m_used != m_data->m_dirtyEnd))
@@ -506,6 +544,7 @@ PacketMetadata::ReplaceTail (PacketMetadata::SmallItem *item,
 
   // create a copy of the packet without its tail.
   PacketMetadata h (m_packetUid, 0);
+  h.m_record = true;
   uint16_t current = m_head;
   while (current != 0xffff && current != m_tail)
     {
@@ -571,48 +610,15 @@ struct PacketMetadata::Data *
 PacketMetadata::Create (uint32_t size)
 {
   NS_LOG_FUNCTION (size);
-  NS_LOG_LOGIC ("create size="<<size<<", max="<<m_maxSize);
-  if (size > m_maxSize)
-    {
-      m_maxSize = size;
-    }
-  while (!m_freeList.empty ()) 
-    {
-      struct PacketMetadata::Data *data = m_freeList.back ();
-      m_freeList.pop_back ();
-      if (data->m_size >= size) 
-        {
-          NS_LOG_LOGIC ("create found size="<<data->m_size);
-          data->m_count = 1;
-          return data;
-        }
-      PacketMetadata::Deallocate (data);
-      NS_LOG_LOGIC ("create dealloc size="<<data->m_size);
-    }
-  NS_LOG_LOGIC ("create alloc size="<<m_maxSize);
-  return PacketMetadata::Allocate (m_maxSize);
+  return PacketMetadata::Allocate (size);
 }
 
 void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  if (!m_enable)
-    {
-      PacketMetadata::Deallocate (data);
-      return;
-    } 
-  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<m_freeList.size ());
   NS_ASSERT (data->m_count == 0);
-  if (m_freeList.size () > 1000 ||
-      data->m_size < m_maxSize) 
-    {
-      PacketMetadata::Deallocate (data);
-    } 
-  else 
-    {
-      m_freeList.push_back (data);
-    }
+  PacketMetadata::Deallocate (data);
 }
 
 struct PacketMetadata::Data *
@@ -625,9 +631,10 @@ PacketMetadata::Allocate (uint32_t n)
       n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
   size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-  uint8_t *buf = new uint8_t [size];
+  // the whole size class is given to the metadata
+  uint8_t *buf = static_cast<uint8_t *> (PacketDataPool::Allocate (PacketDataPool::PACKET_METADATA, &size));
   struct PacketMetadata::Data *data = (struct PacketMetadata::Data *)buf;
-  data->m_size = n;
+  data->m_size = size - sizeof (struct Data) + PACKET_METADATA_DATA_M_DATA_SIZE;
   data->m_count = 1;
   data->m_dirtyEnd = 0;
   return data;
@@ -636,8 +643,8 @@ void
 PacketMetadata::Deallocate (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  uint8_t *buf = (uint8_t *)data;
-  delete [] buf;
+  PacketDataPool::Deallocate (PacketDataPool::PACKET_METADATA, data,
+                              data->m_size + sizeof (struct Data) - PACKET_METADATA_DATA_M_DATA_SIZE);
 }
 
 
@@ -664,9 +671,8 @@ void
 PacketMetadata::DoAddHeader (uint32_t uid, uint32_t size)
 {
   NS_LOG_FUNCTION (this << uid << size);
-  if (!m_enable)
+  if (SkipRecording ())
     {
-      m_metadataSkipped = true;
       return;
     }
 
@@ -686,9 +692,8 @@ PacketMetadata::RemoveHeader (const Header &header, uint32_t size)
   uint32_t uid = header.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << &header << size);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (SkipRecording ())
     {
-      m_metadataSkipped = true;
       return;
     }
   struct PacketMetadata::SmallItem item;
@@ -734,9 +739,8 @@ PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
   uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << &trailer << size);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable)
+  if (SkipRecording ())
     {
-      m_metadataSkipped = true;
       return;
     }
   struct PacketMetadata::SmallItem item;
@@ -756,9 +760,8 @@ PacketMetadata::RemoveTrailer (const Trailer &trailer, uint32_t size)
   uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << &trailer << size);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (SkipRecording ())
     {
-      m_metadataSkipped = true;
       return;
     }
   struct PacketMetadata::SmallItem item;
@@ -803,9 +806,15 @@ PacketMetadata::AddAtEnd (PacketMetadata const&o)
 {
   NS_LOG_FUNCTION (this << &o);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (SkipRecording ())
     {
-      m_metadataSkipped = true;
+      return;
+    }
+  if (!o.m_record)
+    {
+      // The content appended is unknown: the metadata of this
+      // packet would be incomplete, drop it.
+      DisableRecording ();
       return;
     }
   if (m_tail == 0xffff)
@@ -880,9 +889,8 @@ void
 PacketMetadata::AddPaddingAtEnd (uint32_t end)
 {
   NS_LOG_FUNCTION (this << end);
-  if (!m_enable)
+  if (SkipRecording ())
     {
-      m_metadataSkipped = true;
       return;
     }
 }
@@ -891,12 +899,10 @@ PacketMetadata::RemoveAtStart (uint32_t start)
 {
   NS_LOG_FUNCTION (this << start);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (SkipRecording ())
     {
-      m_metadataSkipped = true;
       return;
     }
-  NS_ASSERT (m_data != 0);
   uint32_t leftToRemove = start;
   uint16_t current = m_head;
   while (current != 0xffff && leftToRemove > 0)
@@ -923,6 +929,7 @@ PacketMetadata::RemoveAtStart (uint32_t start)
         {
           // fragment the list item.
           PacketMetadata fragment (m_packetUid, 0);
+          fragment.m_record = true;
           extraItem.fragmentStart += leftToRemove;
           leftToRemove = 0;
           uint16_t written = fragment.AddBig (0xffff, fragment.m_tail,
@@ -954,12 +961,10 @@ PacketMetadata::RemoveAtEnd (uint32_t end)
 {
   NS_LOG_FUNCTION (this << end);
   NS_ASSERT (IsStateOk ());
-  if (!m_enable) 
+  if (SkipRecording ())
     {
-      m_metadataSkipped = true;
       return;
     }
-  NS_ASSERT (m_data != 0);
 
   uint32_t leftToRemove = end;
   uint16_t current = m_tail;
@@ -987,6 +992,7 @@ PacketMetadata::RemoveAtEnd (uint32_t end)
         {
           // fragment the list item.
           PacketMetadata fragment (m_packetUid, 0);
+          fragment.m_record = true;
           NS_ASSERT (extraItem.fragmentEnd > leftToRemove);
           extraItem.fragmentEnd -= leftToRemove;
           leftToRemove = 0;
@@ -1143,10 +1149,10 @@ PacketMetadata::GetSerializedSize (void) const
   // add 8 bytes for the packet uid
   totalSize += 8;
 
-  // if packet-metadata not enabled, total size
+  // if packet-metadata not recorded, total size
   // is simply 4-bytes for itself plus 8-bytes 
   // for packet uid
-  if (!m_enable)
+  if (!m_record)
     {
       return totalSize;
     }
@@ -1292,6 +1298,11 @@ PacketMetadata::Deserialize (const uint8_t* buffer, uint32_t size)
 
   struct PacketMetadata::SmallItem item = {0};
   struct PacketMetadata::ExtraItem extraItem = {0};
+  if (desSize > 0)
+    {
+      // the sender recorded the metadata of this packet.
+      m_record = true;
+    }
   while (desSize > 0)
     {
       uint32_t uidStringSize = 0;
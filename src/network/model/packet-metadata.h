@@ -161,6 +161,27 @@ private:
    */
   static void EnableChecking (void);
 
+  /**
+   * \brief Start recording the metadata of this packet
+   * \param size the current size of the packet
+   *
+   * When Enable has been called, the metadata of every packet is
+   * recorded; otherwise, only that of the packets on which this
+   * method is called. The headers and trailers added to the packet
+   * before this call are unknown: its current content is recorded as
+   * payload.
+   */
+  void EnableRecording (uint32_t size);
+  /**
+   * \brief Stop recording the metadata of this packet, and drop the
+   * metadata recorded so far
+   */
+  void DisableRecording (void);
+  /**
+   * \returns true if the metadata of this packet is recorded
+   */
+  bool IsRecording (void) const;
+
   /**
    * \brief Constructor
    * \param uid packet uid
@@ -492,16 +513,6 @@ private:
     uint64_t packetUid;
   };
 
-  /**
-   * \brief Class to hold all the metadata
-   */
-  class DataFreeList : public std::vector<struct Data *>
-  {
-public:
-    ~DataFreeList ();
-  };
-
-  friend DataFreeList::~DataFreeList ();
   friend class ItemIterator;
 
   PacketMetadata ();
@@ -657,7 +668,14 @@ public:
    */
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList; //!< the metadata data storage
+  /**
+   * \returns true if the metadata of this packet must not be recorded
+   *
+   * Record in m_metadataSkipped that metadata was skipped because
+   * it is not enabled globally.
+   */
+  inline bool SkipRecording (void) const;
+
   static bool m_enable; //!< Enable the packet metadata
   static bool m_enableChecking; //!< Enable the packet metadata checking
 
@@ -668,10 +686,9 @@ public:
    */
   static bool m_metadataSkipped;
 
-  static uint32_t m_maxSize; //!< maximum metadata size
   static uint16_t m_chunkUid; //!< Chunk Uid
 
-  struct Data *m_data; //!< Metadata storage
+  struct Data *m_data; //!< Metadata storage, allocated with the first item
   /*
      head -(next)-> tail
        ^             |
@@ -681,6 +698,7 @@ public:
   uint16_t m_tail; //!< list tail
   uint16_t m_used; //!< used portion
   uint64_t m_packetUid; //!< packet Uid
+  bool m_record; //!< true if the metadata of this packet is recorded
 };
 
 } // namespace ns3
@@ -688,13 +706,13 @@ public:
 namespace ns3 {
 
 PacketMetadata::PacketMetadata (uint64_t uid, uint32_t size)
-  : m_data (PacketMetadata::Create (10)),
+  : m_data (0),
     m_head (0xffff),
     m_tail (0xffff),
     m_used (0),
-    m_packetUid (uid)
+    m_packetUid (uid),
+    m_record (m_enable)
 {
-  memset (m_data->m_data, 0xff, 4);
   if (size > 0)
     {
       DoAddHeader (0, size);
@@ -705,11 +723,14 @@ PacketMetadata::PacketMetadata (PacketMetadata const &o)
     m_head (o.m_head),
     m_tail (o.m_tail),
     m_used (o.m_used),
-    m_packetUid (o.m_packetUid)
+    m_packetUid (o.m_packetUid),
+    m_record (o.m_record)
 {
-  NS_ASSERT (m_data != 0);
-  NS_ASSERT (m_data->m_count < std::numeric_limits<uint32_t>::max());
-  m_data->m_count++;
+  if (m_data != 0)
+    {
+      NS_ASSERT (m_data->m_count < std::numeric_limits<uint32_t>::max());
+      m_data->m_count++;
+    }
 }
 PacketMetadata &
 PacketMetadata::operator = (PacketMetadata const& o)
@@ -717,30 +738,50 @@ PacketMetadata::operator = (PacketMetadata const& o)
   if (m_data != o.m_data) 
     {
       // not self assignment
-      NS_ASSERT (m_data != 0);
-      m_data->m_count--;
-      if (m_data->m_count == 0) 
+      if (m_data != 0)
         {
-          PacketMetadata::Recycle (m_data);
+          m_data->m_count--;
+          if (m_data->m_count == 0) 
+            {
+              PacketMetadata::Recycle (m_data);
+            }
         }
       m_data = o.m_data;
-      NS_ASSERT (m_data != 0);
-      m_data->m_count++;
+      if (m_data != 0)
+        {
+          m_data->m_count++;
+        }
     }
   m_head = o.m_head;
   m_tail = o.m_tail;
   m_used = o.m_used;
   m_packetUid = o.m_packetUid;
+  m_record = o.m_record;
   return *this;
 }
 PacketMetadata::~PacketMetadata ()
 {
-  NS_ASSERT (m_data != 0);
-  m_data->m_count--;
-  if (m_data->m_count == 0) 
+  if (m_data != 0)
+    {
+      m_data->m_count--;
+      if (m_data->m_count == 0) 
+        {
+          PacketMetadata::Recycle (m_data);
+        }
+    }
+}
+bool
+PacketMetadata::SkipRecording (void) const
+{
+  if (m_record)
+    {
+      return false;
+    }
+  if (!m_enable)
     {
-      PacketMetadata::Recycle (m_data);
+      m_metadataSkipped = true;
     }
+  return true;
 }
 
 } // namespace ns3
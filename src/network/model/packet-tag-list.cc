@@ -20,269 +20,158 @@
 
 /**
 \file   packet-tag-list.cc
-\brief  Implements a linked list of Packet tags, including copy-on-write semantics.
+\brief  Implements a small array of Packet tags, including copy-on-write semantics.
 */
 
 #include "packet-tag-list.h"
+#include "packet-data-pool.h"
 #include "tag-buffer.h"
 #include "tag.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include <algorithm>
 #include <cstring>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
-bool
-PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
+struct PacketTagList::Spill *
+PacketTagList::AllocateSpill (uint32_t n)
 {
-  TypeId tid = tag.GetInstanceTypeId ();
-  NS_LOG_FUNCTION (this << tid);
-  NS_LOG_INFO     ("looking for " << tid);
+  NS_LOG_FUNCTION (n);
+  const uint32_t tagSize = sizeof (uint16_t) + sizeof (struct TagData);
+  uint32_t size = sizeof (struct Spill) + n * tagSize;
+  // the whole size class is given to the spill
+  struct Spill *spill = static_cast<struct Spill *>
+    (PacketDataPool::Allocate (PacketDataPool::PACKET_TAG_LIST, &size));
+  spill->count = 1;
+  spill->capacity = (size - sizeof (struct Spill)) / tagSize;
+  spill->size = size;
+  return spill;
+}
 
-  // trivial case when list is empty
-  if (m_next == 0)
+void
+PacketTagList::ReleaseSpill (struct Spill *spill)
+{
+  NS_LOG_FUNCTION (spill);
+  spill->count--;
+  if (spill->count == 0)
     {
-      return false;
+      PacketDataPool::Deallocate (PacketDataPool::PACKET_TAG_LIST, spill, spill->size);
     }
+}
 
-  bool found = false;
-
-  struct TagData ** prevNext = &m_next; // previous node's next pointer
-  struct TagData  * cur      =  m_next; // cursor to current node
-  struct TagData  * it = 0;             // utility
-
-  // Search from the head of the list until we find tid or a merge
-  while (cur != 0)
+int32_t
+PacketTagList::Find (uint16_t uid) const
+{
+  const uint16_t *index = m_spill != 0 ? GetSpillIndex (m_spill) : m_index;
+  for (uint32_t i = 0; i < m_n; i++)
     {
-      if (cur->count > 1)
-        {
-          // found merge
-          NS_LOG_INFO ("found initial merge before tid");
-          break;
-        }
-      else if (cur->tid == tid)
-        {
-          NS_LOG_INFO ("found tid before initial merge, calling writer");
-          found = (this->*Writer)(tag, true, cur, prevNext);
-          break;
-        }
-      else
+      if (index[i] == uid)
         {
-          // no merge or tid found yet, move on
-          prevNext = &cur->next;
-          cur      =  cur->next;
+          return i;
         }
-    }  // while !found && !cow
-
-  // did we find it or run out of tags?
-  if (cur == 0 || found)
-    {
-      NS_LOG_INFO ("returning after header with found: " << found);
-      return found;
     }
+  return -1;
+}
 
-  // From here on out, we have to copy the list
-  // until we find tid, then link past it
-
-  // Before we do all that work, let's make sure tid really exists
-  for (it = cur; it != 0; it = it->next)
+void
+PacketTagList::Reserve (uint32_t n)
+{
+  NS_LOG_FUNCTION (this << n);
+  if (m_spill == 0 ? n <= INLINE_TAGS
+      : m_spill->count == 1 && n <= m_spill->capacity)
     {
-      if (it->tid == tid)
-        {
-          break;
-        }
+      return;
     }
-  if (it == 0)
+  NS_LOG_INFO ("copying " << m_n << " tags to a new spill");
+  struct Spill *spill = AllocateSpill (std::max (n, 2 * m_n));
+  const uint16_t *index = m_spill != 0 ? GetSpillIndex (m_spill) : m_index;
+  std::memcpy (GetSpillIndex (spill), index, m_n * sizeof (uint16_t));
+  std::copy (GetTags (), GetTags () + m_n, GetSpillTags (spill));
+  if (m_spill != 0)
     {
-      // got to end of list without finding tid
-      NS_LOG_INFO ("tid not found after first merge");
-      return found;
+      ReleaseSpill (m_spill);
     }
-
-  // At this point cur is a merge, but untested for tid
-  NS_ASSERT (cur != 0);
-  NS_ASSERT (cur->count > 1);
-
-  /*
-     Walk the remainder of the list, copying, until we find tid
-     As we put a copy of the cur node onto our list,
-     we move the merge point down the list.
-
-     Starting position                  End position
-       T1 is a merge                     T1.count decremented
-                                         T2 is a merge
-                                         T1' is a copy of T1
-
-          other                             other
-               \                                 \
-      Prev  ->  T1  ->  T2  -> ...                T1  ->  T2  -> ...
-           /   /                                         /|
-      pNext cur                         Prev  ->  T1' --/ |
-                                                     /    |
-                                                pNext   cur
-
-     When we reach tid, we link past it, decrement count, and we're done.
-  */
-
-  // Should normally check for null cur pointer,
-  // but since we know tid exists, we'll skip this test
-  while ( /* cur && */ cur->tid != tid)
-    {
-      NS_ASSERT (cur != 0);
-      NS_ASSERT (cur->count > 1);
-      cur->count--;                       // unmerge cur
-      struct TagData * copy = new struct TagData ();
-      copy->tid = cur->tid;
-      copy->count = 1;
-      memcpy (copy->data, cur->data, TagData::MAX_SIZE);
-      copy->next = cur->next;             // merge into tail
-      copy->next->count++;                // mark new merge
-      *prevNext = copy;                   // point prior list at copy
-      prevNext = &copy->next;             // advance
-      cur      =  copy->next;
-    }
-  // Sanity check:
-  NS_ASSERT (cur != 0);                 // cur should be non-zero
-  NS_ASSERT (cur->tid == tid);          // cur->tid should be tid
-  NS_ASSERT (cur->count > 1);           // cur should be a merge
-
-  // link around tid, removing it from our list
-  found = (this->*Writer)(tag, false, cur, prevNext);
-  return found;
-
+  m_spill = spill;
 }
 
 bool
 PacketTagList::Remove (Tag & tag)
 {
-  return COWTraverse (tag, &PacketTagList::RemoveWriter);
-}
-
-// COWWriter implementing Remove
-bool
-PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
-                             struct PacketTagList::TagData  * cur,
-                             struct PacketTagList::TagData ** prevNext)
-{
-  NS_LOG_FUNCTION_NOARGS ();
-
-  // found tid
-  bool found = true;
-  tag.Deserialize (TagBuffer (cur->data,
-                              cur->data + TagData::MAX_SIZE));
-  *prevNext = cur->next;            // link around cur
-
-  if (preMerge)
+  TypeId tid = tag.GetInstanceTypeId ();
+  NS_LOG_FUNCTION (this << tid);
+  int32_t i = Find (tid.GetUid ());
+  if (i < 0)
     {
-      // found tid before first merge, so delete cur
-      delete cur;
+      return false;
     }
-  else
+  Reserve (m_n);
+  uint16_t *index = m_spill != 0 ? GetSpillIndex (m_spill) : m_index;
+  struct TagData *tags = m_spill != 0 ? GetSpillTags (m_spill) : m_tags;
+  tag.Deserialize (TagBuffer (tags[i].data, tags[i].data + TagData::MAX_SIZE));
+  m_n--;
+  std::memmove (&index[i], &index[i + 1], (m_n - i) * sizeof (uint16_t));
+  std::copy (&tags[i + 1], &tags[m_n + 1], &tags[i]);
+  if (m_n == 0)
     {
-      // cur is always a merge at this point
-      // unmerge cur, since we linked around it already
-      cur->count--;
-      if (cur->next != 0)
-        {
-          // there's a next, so make it a merge
-          cur->next->count++;
-        }
+      // back to inline storage
+      RemoveAll ();
     }
-  return found;
+  return true;
 }
 
 bool
 PacketTagList::Replace (Tag & tag)
 {
-  bool found = COWTraverse (tag, &PacketTagList::ReplaceWriter);
-  if (!found)
+  TypeId tid = tag.GetInstanceTypeId ();
+  NS_LOG_FUNCTION (this << tid);
+  int32_t i = Find (tid.GetUid ());
+  if (i < 0)
     {
       Add (tag);
+      return false;
     }
-  return found;
-}
-
-// COWWriter implementing Replace
-bool
-PacketTagList::ReplaceWriter (Tag & tag, bool preMerge,
-                              struct PacketTagList::TagData  * cur,
-                              struct PacketTagList::TagData ** prevNext)
-{
-  NS_LOG_FUNCTION_NOARGS ();
-
-  // found tid
-  bool found = true;
-  if (preMerge)
-    {
-      // found tid before first merge, so just rewrite
-      tag.Serialize (TagBuffer (cur->data,
-                                cur->data + tag.GetSerializedSize ()));
-    }
-  else
-    {
-      // cur is always a merge at this point
-      // need to copy, replace, and link past cur
-      cur->count--;                     // unmerge cur
-      struct TagData * copy = new struct TagData ();
-      copy->tid = tag.GetInstanceTypeId ();
-      copy->count = 1;
-      tag.Serialize (TagBuffer (copy->data,
-                                copy->data + tag.GetSerializedSize ()));
-      copy->next = cur->next;           // merge into tail
-      if (copy->next != 0)
-        {
-          copy->next->count++;          // mark new merge
-        }
-      *prevNext = copy;                 // point prior list at copy
-    }
-  return found;
+  Reserve (m_n);
+  struct TagData *tags = m_spill != 0 ? GetSpillTags (m_spill) : m_tags;
+  tag.Serialize (TagBuffer (tags[i].data, tags[i].data + tag.GetSerializedSize ()));
+  return true;
 }
 
 void 
 PacketTagList::Add (const Tag &tag) const
 {
-  NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
+  TypeId tid = tag.GetInstanceTypeId ();
+  NS_LOG_FUNCTION (this << tid);
   // ensure this id was not yet added
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
-    {
-      NS_ASSERT (cur->tid != tag.GetInstanceTypeId ());
-    }
-  struct TagData * head = new struct TagData ();
-  head->count = 1;
-  head->next = 0;
-  head->tid = tag.GetInstanceTypeId ();
-  head->next = m_next;
+  NS_ASSERT (Find (tid.GetUid ()) < 0);
   NS_ASSERT (tag.GetSerializedSize () <= TagData::MAX_SIZE);
-  tag.Serialize (TagBuffer (head->data, head->data + tag.GetSerializedSize ()));
-
-  const_cast<PacketTagList *> (this)->m_next = head;
+  PacketTagList *self = const_cast<PacketTagList *> (this);
+  self->Reserve (m_n + 1);
+  uint16_t *index = m_spill != 0 ? GetSpillIndex (m_spill) : self->m_index;
+  struct TagData *data = m_spill != 0 ? &GetSpillTags (m_spill)[m_n] : &self->m_tags[m_n];
+  index[m_n] = tid.GetUid ();
+  data->tid = tid;
+  tag.Serialize (TagBuffer (data->data, data->data + tag.GetSerializedSize ()));
+  self->m_n++;
 }
 
 bool
 PacketTagList::Peek (Tag &tag) const
 {
-  NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
   TypeId tid = tag.GetInstanceTypeId ();
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
+  NS_LOG_FUNCTION (this << tid);
+  int32_t i = Find (tid.GetUid ());
+  if (i < 0)
     {
-      if (cur->tid == tid) 
-        {
-          /* found tag */
-          tag.Deserialize (TagBuffer (cur->data, cur->data + TagData::MAX_SIZE));
-          return true;
-        }
+      /* no tag found */
+      return false;
     }
-  /* no tag found */
-  return false;
-}
-
-const struct PacketTagList::TagData *
-PacketTagList::Head (void) const
-{
-  return m_next;
+  const struct TagData *data = &GetTags ()[i];
+  tag.Deserialize (TagBuffer (const_cast<uint8_t *> (data->data),
+                              const_cast<uint8_t *> (data->data) + TagData::MAX_SIZE));
+  return true;
 }
 
 } /* namespace ns3 */
-
@@ -22,12 +22,14 @@
 
 /**
 \file   packet-tag-list.h
-\brief  Defines a linked list of Packet tags, including copy-on-write semantics.
+\brief  Defines a small array of Packet tags, including copy-on-write semantics.
 */
 
 #include <stdint.h>
+#include <cstddef>
 #include <ostream>
 #include "ns3/type-id.h"
+#include "ns3/deprecated.h"
 
 namespace ns3 {
 
@@ -43,96 +45,34 @@ class Tag;
  *
  * \internal
  *
- * The implementation of this class is a bit tricky.  Refer to this
- * diagram in the discussion that follows.
+ * Tags are stored in serialized form in an array of TagData, in the
+ * order in which they were added, next to an index holding the TypeId
+ * uid of each tag. #Peek, #Replace and #Remove scan the index, which
+ * for the usual one or two tags is a couple of comparisons.
  *
- * \dot
- *    digraph {
- *        rankdir = "LR";
- *        clusterrank = local;
- *        node [ shape = record, fontname="FreeSans", fontsize="10" ];
- *        oth  [ label="<l> Other branch | <n> next | <c> ..." ];
- *        PTL1 [ label="<l> PacketTagList A | <n> m_next" , shape=Mrecord];
- *        PTL2 [ label="<l> PacketTagList B | <n> m_next" , shape=Mrecord];
- *        oth:n  -> T7:l ;
- *        PTL2:n -> T6:l ;
- *        PTL1:n -> T5:l ;
- *        T1   [ label="<l> T1  | <n> next | <c> count = 1" ];
- *        T2   [ label="<l> T2  | <n> next | <c> count = 1" ];
- *        T3   [ label="<l> T3  | <n> next | <c> count = 2" ];
- *        T4   [ label="<l> T4  | <n> next | <c> count = 1" ];
- *        T5   [ label="<l> T5  | <n> next | <c> count = 2" ];
- *        T6   [ label="<l> T6  | <n> next | <c> count = 1" ];
- *        T7   [ label="<l> T7  | <n> next | <c> count = 1" ];
- *        NULL [ label="0", shape = ellipse ];
- *        subgraph cluster_list {
- *          penwidth = 0;
- *          T6:n -> T5:l ;
- *          T5:n -> T4:l ;
- *          T4:n -> T3:l ;
- *          T7:n -> T3:l ;
- *          T3:n -> T2:l ;
- *          T2:n -> T1:l ;
- *          T1:n -> NULL ;
- *        };
- *      };
- * \enddot
+ * Up to INLINE_TAGS tags are stored inline, in the PacketTagList itself:
+ * copying the list copies them, and no memory is allocated. When more
+ * tags are added, the tags move to a Spill block allocated from the
+ * PacketDataPool, which copies of the list share, counting references:
  *
- *   - Tags are stored in serialized form in a tree of TagData
- *     structures. (<tt>T1-T7</tt> in the diagram)
+ *   - the copy constructor and assignment share the Spill of the
+ *     original list, incrementing its \c count.
  *
- *   - Each TagData points (\c next pointers in the diagram)
- *     toward the root of the tree, which is a null pointer.
+ *   - #Add, #Remove and #Replace first copy a Spill which is shared
+ *     with other lists (copy-on-write), then modify it in place.
  *
- *   - \c count is the number of incoming pointers to this
- *     TagData.  Branch points, where branches merge or join, have
- *     <tt>count \> 1</tt> (\c T3, \c T5); successive links along
- *     a branch have <tt>count = 1</tt> (\c T1, \c T2, \c T4, \c T6, \c T7).
- *
- *   - Each PacketTagList points to a specific TagData,
- *     which is the most recent Tag added to the packet. (<tt>T5-T7</tt>)
- *
- *   - Conceptually, therefore, each Packet has a PacketTagList which
- *     points to a singly-linked list of TagData.
- *
- * \par <b> Copy-on-write </b> is implemented as follows:
- *
- *   - #Add prepends the new tag to the list (growing that branch of the tree,
- *     as \c T6). This is a constant time operation, and does not affect
- *     any other #PacketTagList's, hence this is a \c const function.
- *
- *   - Copy constructor (PacketTagList(const PacketTagList & o))
- *     and assignment (#operator=(const PacketTagList & o)
- *     simply join the tree at the same place as the original
- *     PacketTagList \c o, incrementing the \c count.
- *     For assignment, the old branch is deleted, up to
- *     the first branch point, which has its \c count decremented.
- *     (PacketTagList \c B started as a copy of PacketTagList \c A,
- *     before \c T6 was added to \c B).
- *
- *   - #Remove and #Replace are a little tricky, depending on where the
- *     target tag is found relative to the first branch point:
- *     - \e Target before <em> the first branch point: </em> \n
- *       The target is just dealt with in place (linked around and deleted,
- *       in the case of #Remove; rewritten in the case of #Replace).
- *     - \e Target at or after <em> the first branch point: </em> \n
- *       The portion of the list between the first branch and the target is
- *       shared. This portion is copied before the #Remove or #Replace is
- *       performed.
+ *   - when the last tag is removed, the list goes back to inline
+ *     storage.
  *
  * \par <b> Memory Management: </b>
  * \n
  * Packet tags must serialize to a finite maximum size, see TagData
- *
- * This documentation entitles the original author to a free beer.
  */
 class PacketTagList 
 {
 public:
   /**
-   * Tree node for sharing serialized tags.
-   *
-   * See PacketTagList for a discussion of the data structure.
+   * A serialized tag.
    *
    * See TagData::TagData_e for a discussion of the size limit on
    * tag serialization.
@@ -146,15 +86,9 @@ public:
      * in this constant.
      *
      * \internal
-     * Ideally, TagData would be 32 bytes in size, so they require
-     * no padding on 64-bit architectures.  (The architecture
-     * affects the size because of the \c #next pointer.)
-     * This would leave 18 bytes for \c #data.  However,
-     * ns3:Ipv6PacketInfoTag needs 19 bytes!  The current
+     * ns3:Ipv6PacketInfoTag needs 19 bytes.  The current
      * implementation allows 20 bytes, which gives TagData
-     * a size of 30 bytes on 32-byte machines (which gets
-     * padded with 2 bytes), and 34 bytes on 64-bit machines, which
-     * gets padded to 40 bytes.
+     * a size of 22 bytes.
      */
     enum TagData_e
     {
@@ -162,9 +96,7 @@ public:
   };
 
     uint8_t data[MAX_SIZE];   /**< Serialization buffer */
-    struct TagData * next;   /**< Pointer to next in list */
     TypeId tid;               /**< Type of the tag serialized into #data */
-    uint32_t count;           /**< Number of incoming links */
   };  /* struct TagData */
 
   /**
@@ -176,8 +108,7 @@ public:
    *
    * \param [in] o The PacketTagList to copy.
    *
-   * This makes a light-weight copy by #RemoveAll, then
-   * pointing to the same \ref TagData as \pname{o}.
+   * This copies the inline tags of \pname{o}, or shares its Spill.
    */
   inline PacketTagList (PacketTagList const &o);
   /**
@@ -186,19 +117,19 @@ public:
    * \param [in] o The PacketTagList to copy.
    * \returns the copied object
    *
-   * This makes a light-weight copy by #RemoveAll, then
-   * pointing to the same \ref TagData as \pname{o}.
+   * This makes a light-weight copy by #RemoveAll, then copying
+   * the inline tags of \pname{o}, or sharing its Spill.
    */
   inline PacketTagList &operator = (PacketTagList const &o);
   /**
    * Destructor
    *
-   * #RemoveAll's the tags up to the first merge.
+   * #RemoveAll's the tags.
    */
   inline ~PacketTagList ();
 
   /**
-   * Add a tag to the head of this branch.
+   * Add a tag to the list.
    *
    * \param [in] tag The tag to add
    */
@@ -230,67 +161,80 @@ public:
    */
   bool Peek (Tag &tag) const;
   /**
-   * Remove all tags from this list (up to the first merge).
+   * Remove all tags from this list.
    */
   inline void RemoveAll (void);
   /**
-   * \returns pointer to head of tag list
+   * \returns the number of tags in the list
+   */
+  inline uint32_t GetN (void) const;
+  /**
+   * \returns the GetN tags of the list, in the order they were added
+   */
+  inline const struct PacketTagList::TagData *GetTags (void) const;
+  /**
+   * \returns the first of the GetN tags of the list, or 0 if the list
+   *          is empty.  The tags are contiguous, and no longer linked.
+   * \deprecated use GetN and GetTags
    */
-  const struct PacketTagList::TagData *Head (void) const;
+  inline const struct PacketTagList::TagData *Head (void) const NS_DEPRECATED;
 
 private:
+  /// Number of tags stored in the PacketTagList itself
+  enum { INLINE_TAGS = 2 };
+
   /**
-   * Typedef of method function pointer for copy-on-write operations
+   * Tags stored out of line, shared by copies of a list.
    *
-   * \param [in] tag The tag type to operate on.
-   * \param [in] preMerge True if \pname{tag} was found before the first merge,
-   *             false otherwise.
-   * \param [in] cur Pointer to the tag.
-   * \param [in] prevNext Pointer to the struct TagData.next pointer
-   *          pointing to \pname{cur}.
-   * \returns True if operation successful, false otherwise
+   * The header is followed by the index, \c capacity uids, and by
+   * \c capacity TagData.
    */
-  typedef bool (PacketTagList::*COWWriter)
-    (Tag       & tag, bool         preMerge,
-    struct TagData * cur, struct TagData ** prevNext);
+  struct Spill
+  {
+    uint32_t count;    //!< Number of lists sharing this Spill
+    uint32_t capacity; //!< Number of tags which fit in this Spill
+    uint32_t size;     //!< Size of the block, in bytes
+  };
+
   /**
-   * Traverse the list implementing copy-on-write, using \pname{Writer}.
-   *
-   * \param [in] tag The tag type to operate on.
-   * \param [in] Writer The copy-on-write function to use.
-   * \returns True if \pname{tag} found, false otherwise.
+   * \param [in] spill A Spill.
+   * \returns the index of \pname{spill}
    */
-  bool COWTraverse   (Tag & tag, PacketTagList::COWWriter Writer);
+  static inline uint16_t *GetSpillIndex (const struct Spill *spill);
   /**
-   * Copy-on-write implementing Remove.
-   *
-   * \param [in] tag The target tag type to remove.
-   * \param [in] preMerge True if \pname{tag} was found before the first merge,
-   *             false otherwise.
-   * \param [in] cur Pointer to the tag.
-   * \param [in] prevNext Pointer to the struct TagData.next pointer
-   *          pointing to \pname{cur}.
-   * \returns True, since tag will definitely be removed.
+   * \param [in] spill A Spill.
+   * \returns the tags of \pname{spill}
    */
-  bool RemoveWriter  (Tag       & tag, bool         preMerge,
-                      struct TagData * cur, struct TagData ** prevNext);
+  static inline struct TagData *GetSpillTags (const struct Spill *spill);
   /**
-   * Copy-on-write implementing Replace
+   * \param [in] n The number of tags needed.
+   * \returns a new Spill, with room for at least \pname{n} tags
+   */
+  static struct Spill *AllocateSpill (uint32_t n);
+  /**
+   * Drop a reference to a Spill, and free it if it was the last one.
    *
-   * \param [in] tag The target tag type to replace
-   * \param [in] preMerge True if \pname{tag} was found before the first merge,
-   *          false otherwise.
-   * \param [in] cur Pointer to the tag
-   * \param [in] prevNext Pointer to the struct TagData.next pointer
-   *          pointing to \pname{cur}.
-   * \returns True, since tag value will definitely be replaced.
+   * \param [in] spill The Spill to release.
    */
-  bool ReplaceWriter (Tag & tag, bool preMerge, struct TagData * cur, struct TagData ** prevNext);
+  static void ReleaseSpill (struct Spill *spill);
 
   /**
-   * Pointer to first \ref TagData on the list
+   * \param [in] uid The TypeId uid of a tag.
+   * \returns the position of the tag in the list, or -1 if not found
+   */
+  int32_t Find (uint16_t uid) const;
+  /**
+   * Make sure the tags can be modified in place, and there is room
+   * for \pname{n} tags, by copying the tags to a new Spill if needed.
+   *
+   * \param [in] n The number of tags needed.
    */
-  struct TagData *m_next;
+  void Reserve (uint32_t n);
+
+  uint32_t m_n;                        //!< Number of tags
+  struct Spill *m_spill;               //!< Tags stored out of line, if any
+  uint16_t m_index[INLINE_TAGS];       //!< Uids of the inline tags
+  struct TagData m_tags[INLINE_TAGS];  //!< Inline tags
 };
 
 } // namespace ns3
@@ -302,16 +246,24 @@ private:
 namespace ns3 {
 
 PacketTagList::PacketTagList ()
-  : m_next ()
+  : m_n (0),
+    m_spill (0)
 {
 }
 
 PacketTagList::PacketTagList (PacketTagList const &o)
-  : m_next (o.m_next)
+  : m_n (o.m_n),
+    m_spill (o.m_spill)
 {
-  if (m_next != 0)
+  if (m_spill != 0)
+    {
+      m_spill->count++;
+      return;
+    }
+  for (uint32_t i = 0; i < m_n; i++)
     {
-      m_next->count++;
+      m_index[i] = o.m_index[i];
+      m_tags[i] = o.m_tags[i];
     }
 }
 
@@ -319,15 +271,22 @@ PacketTagList &
 PacketTagList::operator = (PacketTagList const &o)
 {
   // self assignment
-  if (m_next == o.m_next) 
+  if (this == &o) 
     {
       return *this;
     }
   RemoveAll ();
-  m_next = o.m_next;
-  if (m_next != 0) 
+  m_n = o.m_n;
+  m_spill = o.m_spill;
+  if (m_spill != 0) 
+    {
+      m_spill->count++;
+      return *this;
+    }
+  for (uint32_t i = 0; i < m_n; i++)
     {
-      m_next->count++;
+      m_index[i] = o.m_index[i];
+      m_tags[i] = o.m_tags[i];
     }
   return *this;
 }
@@ -340,25 +299,42 @@ PacketTagList::~PacketTagList ()
 void
 PacketTagList::RemoveAll (void)
 {
-  struct TagData *prev = 0;
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+  if (m_spill != 0)
     {
-      cur->count--;
-      if (cur->count > 0) 
-        {
-          break;
-        }
-      if (prev != 0) 
-        {
-	  delete prev;
-        }
-      prev = cur;
+      ReleaseSpill (m_spill);
+      m_spill = 0;
     }
-  if (prev != 0) 
-    {
-      delete prev;
-    }
-  m_next = 0;
+  m_n = 0;
+}
+
+uint32_t
+PacketTagList::GetN (void) const
+{
+  return m_n;
+}
+
+const struct PacketTagList::TagData *
+PacketTagList::GetTags (void) const
+{
+  return m_spill != 0 ? GetSpillTags (m_spill) : m_tags;
+}
+
+const struct PacketTagList::TagData *
+PacketTagList::Head (void) const
+{
+  return m_n != 0 ? GetTags () : 0;
+}
+
+uint16_t *
+PacketTagList::GetSpillIndex (const struct Spill *spill)
+{
+  return reinterpret_cast<uint16_t *> (const_cast<struct Spill *> (spill) + 1);
+}
+
+struct PacketTagList::TagData *
+PacketTagList::GetSpillTags (const struct Spill *spill)
+{
+  return reinterpret_cast<struct TagData *> (GetSpillIndex (spill) + spill->capacity);
 }
 
 } // namespace ns3
@@ -81,8 +81,9 @@ ByteTagIterator::ByteTagIterator (ByteTagList::Iterator i)
 }
 
 
-PacketTagIterator::PacketTagIterator (const struct PacketTagList::TagData *head)
-  : m_current (head)
+PacketTagIterator::PacketTagIterator (const struct PacketTagList::TagData *tags, uint32_t n)
+  : m_tags (tags),
+    m_current (n)
 {
 }
 bool
@@ -94,9 +95,8 @@ PacketTagIterator::Item
 PacketTagIterator::Next (void)
 {
   NS_ASSERT (HasNext ());
-  const struct PacketTagList::TagData *prev = m_current;
-  m_current = m_current->next;
-  return PacketTagIterator::Item (prev);
+  m_current--;
+  return PacketTagIterator::Item (&m_tags[m_current]);
 }
 
 PacketTagIterator::Item::Item (const struct PacketTagList::TagData *data)
@@ -562,6 +562,27 @@ Packet::EnableChecking (void)
   PacketMetadata::EnableChecking ();
 }
 
+void
+Packet::EnableMetadata (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_metadata.EnableRecording (GetSize ());
+}
+
+void
+Packet::DisableMetadata (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_metadata.DisableRecording ();
+}
+
+bool
+Packet::IsMetadataEnabled (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_metadata.IsRecording ();
+}
+
 uint32_t Packet::GetSerializedSize (void) const
 {
   uint32_t size = 0;
@@ -898,7 +919,7 @@ Packet::PrintPacketTags (std::ostream &os) const
 PacketTagIterator 
 Packet::GetPacketTagIterator (void) const
 {
-  return PacketTagIterator (m_packetTagList.Head ());
+  return PacketTagIterator (m_packetTagList.GetTags (), m_packetTagList.GetN ());
 }
 
 std::ostream& operator<< (std::ostream& os, const Packet &packet)
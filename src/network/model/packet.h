@@ -165,10 +165,12 @@ private:
   friend class Packet;
   /**
    * Constructor
-   * \param head head of the items
+   * \param tags the tags, in the order they were added
+   * \param n the number of tags
    */
-  PacketTagIterator (const struct PacketTagList::TagData *head);
-  const struct PacketTagList::TagData *m_current;  //!< actual position over the set of tags in a packet
+  PacketTagIterator (const struct PacketTagList::TagData *tags, uint32_t n);
+  const struct PacketTagList::TagData *m_tags;  //!< the set of tags in a packet
+  uint32_t m_current;  //!< number of tags left, the most recent first
 };
 
 /**
@@ -191,7 +193,11 @@ private:
  * output from Packet::Print. If you wish to only enable
  * checking of metadata, and do not need any printing capability, you can
  * call Packet::EnableChecking: its runtime cost is lower than
- * Packet::EnablePrinting.
+ * Packet::EnablePrinting. Metadata can also be maintained for some
+ * packets only, such as those of a traced flow: call
+ * Packet::EnableMetadata on them when they are created. Conversely,
+ * Packet::DisableMetadata drops the metadata of a packet which will
+ * never be printed.
  *
  * - The set of tags contain simulation-specific information which cannot
  * be stored in the packet byte buffer because the protocol headers or trailers
@@ -504,6 +510,29 @@ public:
    */
   static void EnableChecking (void);
 
+  /**
+   * \brief Maintain the metadata of this packet, even if
+   * EnablePrinting was not called.
+   *
+   * The metadata is maintained from this call on, and propagated to
+   * the copies and fragments of this packet: call it where the packet
+   * is created, before any header is added. The current content of
+   * the packet is described as payload.
+   */
+  void EnableMetadata (void);
+  /**
+   * \brief Stop maintaining the metadata of this packet, and drop it.
+   *
+   * Appending a packet without metadata to a packet with metadata
+   * also drops the metadata of the latter, which would otherwise be
+   * incomplete.
+   */
+  void DisableMetadata (void);
+  /**
+   * \returns true if the metadata of this packet is maintained
+   */
+  bool IsMetadataEnabled (void) const;
+
   /**
    * \brief Returns number of bytes required for packet
    * serialization.
@@ -322,6 +322,151 @@ BufferTest::DoRun (void)
     }
   free (cBuf);
 }
+//-----------------------------------------------------------------------------
+class BufferZeroAreaTest : public TestCase {
+private:
+  bool CheckBytes (const Buffer &b, uint32_t headerSize, uint32_t zeroSize,
+                   uint32_t leadingZeroSize = 0);
+public:
+  virtual void DoRun (void);
+  BufferZeroAreaTest ();
+};
+
+BufferZeroAreaTest::BufferZeroAreaTest ()
+  : TestCase ("Buffer zero area through copies, fragments and concatenations")
+{
+}
+
+// the buffer holds headerSize bytes 0x1, 0x2, ... then zeroSize zeros.
+bool
+BufferZeroAreaTest::CheckBytes (const Buffer &b, uint32_t headerSize, uint32_t zeroSize,
+                                uint32_t leadingZeroSize)
+{
+  if (b.GetSize () != leadingZeroSize + headerSize + zeroSize)
+    {
+      return false;
+    }
+  std::vector<uint8_t> bytes (b.GetSize ());
+  b.CopyData (&bytes[0], bytes.size ());
+  for (uint32_t i = 0; i < bytes.size (); i++)
+    {
+      bool inHeader = i >= leadingZeroSize && i < leadingZeroSize + headerSize;
+      if (bytes[i] != (inHeader ? i - leadingZeroSize + 1 : 0))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+BufferZeroAreaTest::DoRun (void)
+{
+  const uint32_t header = 10;
+  const uint32_t payload = 10000;
+
+  Buffer first (payload);
+  first.AddAtStart (header);
+  Buffer::Iterator i = first.Begin ();
+  for (uint32_t j = 0; j < header; j++)
+    {
+      i.WriteU8 (j + 1);
+    }
+  uint32_t realSize = first.GetSerializedSize ();
+  NS_TEST_ASSERT_MSG_LT (realSize, 100, "Zero area serialized as bytes");
+
+  // fragments, shared with the original buffer, concatenated back: the
+  // zero areas are adjacent and are merged.
+  Buffer frag0 = first.CreateFragment (0, header + payload / 2);
+  Buffer frag1 = first.CreateFragment (header + payload / 2, payload / 2);
+  frag0.AddAtEnd (frag1);
+  NS_TEST_ASSERT_MSG_EQ (frag0.GetSerializedSize (), realSize, "Zero area materialized");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (frag0, header, payload), true, "Wrong bytes");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (first, header, payload), true, "Original buffer modified");
+
+  // a buffer concatenated to a copy of itself
+  Buffer copy = frag1;
+  frag1.AddAtEnd (copy);
+  NS_TEST_ASSERT_MSG_LT (frag1.GetSerializedSize (), 100, "Zero area materialized");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (frag1, 0, payload), true, "Wrong bytes");
+
+  // a zero area at the end of a buffer followed by a larger one at the
+  // start of the other: they are adjacent and merged.
+  Buffer small (100);
+  small.AddAtStart (header);
+  i = small.Begin ();
+  for (uint32_t j = 0; j < header; j++)
+    {
+      i.WriteU8 (j + 1);
+    }
+  Buffer large = Buffer (payload);
+  small.AddAtEnd (large);
+  NS_TEST_ASSERT_MSG_LT (small.GetSerializedSize (), 100, "Zero area materialized");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (small, header, payload + 100), true, "Wrong bytes");
+
+  // zero areas which are not adjacent, since bytes follow the zero area
+  // of the first buffer: only the larger one is kept, and the first
+  // buffer is written in front of it.
+  Buffer before (100);
+  before.AddAtEnd (header);
+  i = before.End ();
+  i.Prev (header);
+  for (uint32_t j = 0; j < header; j++)
+    {
+      i.WriteU8 (j + 1);
+    }
+  Buffer beforeCopy = before;
+  before.AddAtEnd (Buffer (payload));
+  NS_TEST_ASSERT_MSG_LT (before.GetSerializedSize (), 100 + header + 100, "Larger zero area materialized");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (before, header, payload, 100), true, "Wrong bytes");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (beforeCopy, header, 0, 100), true, "Original buffer modified");
+
+  // the same, with a smaller zero area in the other buffer: it is
+  // written after the first one.
+  Buffer after (payload);
+  after.AddAtStart (header);
+  i = after.Begin ();
+  for (uint32_t j = 0; j < header; j++)
+    {
+      i.WriteU8 (j + 1);
+    }
+  after.AddAtEnd (header);
+  i = after.End ();
+  i.Prev (header);
+  for (uint32_t j = 0; j < header; j++)
+    {
+      i.WriteU8 (j + 1);
+    }
+  Buffer smaller (100);
+  smaller.AddAtStart (header);
+  i = smaller.Begin ();
+  for (uint32_t j = 0; j < header; j++)
+    {
+      i.WriteU8 (j + 1);
+    }
+  after.AddAtEnd (smaller);
+  NS_TEST_ASSERT_MSG_LT (after.GetSerializedSize (), 100 + header + 100 + header + 100, "Larger zero area materialized");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (after.CreateFragment (0, header + payload), header, payload), true, "Wrong bytes");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (after.CreateFragment (header + payload, header), header, 0), true, "Wrong bytes");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (after.CreateFragment (header + payload + header, header + 100), header, 100), true, "Wrong bytes");
+
+  // a buffer which shares its data with the appended one, whose zero
+  // area is larger
+  Buffer shared (payload);
+  shared.AddAtStart (header);
+  i = shared.Begin ();
+  for (uint32_t j = 0; j < header; j++)
+    {
+      i.WriteU8 (j + 1);
+    }
+  Buffer prefix = shared.CreateFragment (0, header);
+  prefix.AddAtEnd (shared);
+  NS_TEST_ASSERT_MSG_LT (prefix.GetSerializedSize (), 100, "Larger zero area materialized");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (prefix.CreateFragment (0, header), header, 0), true, "Wrong bytes");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (prefix.CreateFragment (header, header + payload), header, payload), true, "Wrong bytes");
+  NS_TEST_ASSERT_MSG_EQ (CheckBytes (shared, header, payload), true, "Original buffer modified");
+}
+
 //-----------------------------------------------------------------------------
 class BufferTestSuite : public TestSuite
 {
@@ -333,6 +478,7 @@ BufferTestSuite::BufferTestSuite ()
   : TestSuite ("buffer", UNIT)
 {
   AddTestCase (new BufferTest, TestCase::QUICK);
+  AddTestCase (new BufferZeroAreaTest, TestCase::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite;
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include "ns3/test.h"
+#include "ns3/address.h"
+#include "ns3/mac16-address.h"
+#include "ns3/mac64-address.h"
+
+using namespace ns3;
+
+class Mac16AddressTestCase : public TestCase
+{
+public:
+  Mac16AddressTestCase ();
+  virtual ~Mac16AddressTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+Mac16AddressTestCase::Mac16AddressTestCase ()
+  : TestCase ("Mac16Address conversions and comparisons")
+{
+}
+
+Mac16AddressTestCase::~Mac16AddressTestCase ()
+{
+}
+
+void
+Mac16AddressTestCase::DoRun (void)
+{
+  Mac16Address address ("ab:01");
+  NS_TEST_ASSERT_MSG_EQ (address.ConvertToInt (), 0xab01, "Failed string conversion");
+  NS_TEST_ASSERT_MSG_EQ (Mac16Address (0xab01), address, "Failed integer conversion");
+
+  uint8_t buffer[2];
+  address.CopyTo (buffer);
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t)buffer[0], 0xab, "Bytes not in network order");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t)buffer[1], 0x01, "Bytes not in network order");
+  Mac16Address copy;
+  copy.CopyFrom (buffer);
+  NS_TEST_ASSERT_MSG_EQ (copy, address, "Failed buffer conversion");
+  NS_TEST_ASSERT_MSG_EQ (Mac16Address::ConvertFrom (Address (address)), address, "Failed Address conversion");
+
+  std::ostringstream oss;
+  oss << address;
+  NS_TEST_ASSERT_MSG_EQ (oss.str (), "ab:01", "Failed printing");
+  std::istringstream iss ("01:ab");
+  iss >> copy;
+  NS_TEST_ASSERT_MSG_EQ (copy.ConvertToInt (), 0x01ab, "Failed parsing");
+
+  // the first byte is the most significant, as with memcmp
+  NS_TEST_ASSERT_MSG_EQ ((Mac16Address ("00:ff") < Mac16Address ("01:00")), true, "Wrong order");
+  NS_TEST_ASSERT_MSG_EQ ((Mac16Address ("01:00") < Mac16Address ("00:ff")), false, "Wrong order");
+  NS_TEST_ASSERT_MSG_EQ ((address != copy), true, "Different addresses are equal");
+
+  NS_TEST_ASSERT_MSG_EQ (Mac16Address::GetBroadcast (), Mac16Address ("ff:ff"), "Wrong broadcast address");
+  NS_TEST_ASSERT_MSG_EQ (Mac16Address ("ff:ff").IsBroadcast (), true, "Broadcast address not detected");
+  NS_TEST_ASSERT_MSG_EQ (address.IsBroadcast (), false, "Unicast address is broadcast");
+  NS_TEST_ASSERT_MSG_EQ (Mac16AddressHash () (address), Mac16AddressHash () (Mac16Address ("ab:01")),
+                         "Equal addresses have different hashes");
+}
+
+class Mac64AddressTestCase : public TestCase
+{
+public:
+  Mac64AddressTestCase ();
+  virtual ~Mac64AddressTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+Mac64AddressTestCase::Mac64AddressTestCase ()
+  : TestCase ("Mac64Address conversions and comparisons")
+{
+}
+
+Mac64AddressTestCase::~Mac64AddressTestCase ()
+{
+}
+
+void
+Mac64AddressTestCase::DoRun (void)
+{
+  Mac64Address address ("01:23:45:67:89:ab:cd:ef");
+  NS_TEST_ASSERT_MSG_EQ (address.ConvertToInt (), 0x0123456789abcdefULL, "Failed string conversion");
+  NS_TEST_ASSERT_MSG_EQ (Mac64Address (0x0123456789abcdefULL), address, "Failed integer conversion");
+
+  uint8_t buffer[8];
+  address.CopyTo (buffer);
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t)buffer[0], 0x01, "Bytes not in network order");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t)buffer[7], 0xef, "Bytes not in network order");
+  Mac64Address copy;
+  copy.CopyFrom (buffer);
+  NS_TEST_ASSERT_MSG_EQ (copy, address, "Failed buffer conversion");
+  NS_TEST_ASSERT_MSG_EQ (Mac64Address::ConvertFrom (Address (address)), address, "Failed Address conversion");
+
+  std::ostringstream oss;
+  oss << address;
+  NS_TEST_ASSERT_MSG_EQ (oss.str (), "01:23:45:67:89:ab:cd:ef", "Failed printing");
+
+  NS_TEST_ASSERT_MSG_EQ ((Mac64Address ("00:ff:ff:ff:ff:ff:ff:ff") < Mac64Address ("01:00:00:00:00:00:00:00")), true, "Wrong order");
+  NS_TEST_ASSERT_MSG_EQ ((Mac64Address ("01:00:00:00:00:00:00:00") < Mac64Address ("00:ff:ff:ff:ff:ff:ff:ff")), false, "Wrong order");
+  NS_TEST_ASSERT_MSG_EQ (Mac64AddressHash () (address), Mac64AddressHash () (Mac64Address ("01:23:45:67:89:ab:cd:ef")),
+                         "Equal addresses have different hashes");
+}
+
+class MacAddressTestSuite : public TestSuite
+{
+public:
+  MacAddressTestSuite ();
+};
+
+MacAddressTestSuite::MacAddressTestSuite ()
+  : TestSuite ("mac-address", UNIT)
+{
+  AddTestCase (new Mac16AddressTestCase, TestCase::QUICK);
+  AddTestCase (new Mac64AddressTestCase, TestCase::QUICK);
+}
+
+static MacAddressTestSuite macAddressTestSuite;
@@ -821,6 +821,38 @@ PacketMetadataTest::DoRun (void)
                                  p3->GetSize ());
   delete [] buf;
   NS_TEST_EXPECT_MSG_EQ (msg, std::string ("hello world"), "Could not find original data in received packet");
+
+  // metadata dropped for some packets only.
+  p = Create<Packet> (10);
+  ADD_HEADER (p, 1);
+  p->DisableMetadata ();
+  NS_TEST_EXPECT_MSG_EQ (p->IsMetadataEnabled (), false, "Metadata still maintained");
+  CHECK_HISTORY (p, 0);
+  ADD_HEADER (p, 2);
+  ADD_TRAILER (p, 3);
+  CHECK_HISTORY (p, 0);
+  p1 = p->Copy ();
+  NS_TEST_EXPECT_MSG_EQ (p1->IsMetadataEnabled (), false, "Metadata maintained by a copy");
+  REM_HEADER (p1, 2);
+  CHECK_HISTORY (p1, 0);
+
+  // appending a packet without metadata drops the metadata.
+  p2 = Create<Packet> (10);
+  ADD_HEADER (p2, 4);
+  CHECK_HISTORY (p2, 2, 4, 10);
+  p2->AddAtEnd (p);
+  NS_TEST_EXPECT_MSG_EQ (p2->IsMetadataEnabled (), false, "Incomplete metadata maintained");
+  CHECK_HISTORY (p2, 0);
+  p->AddAtEnd (Create<Packet> (5));
+  CHECK_HISTORY (p, 0);
+
+  // the current content is described as payload.
+  p->EnableMetadata ();
+  NS_TEST_EXPECT_MSG_EQ (p->IsMetadataEnabled (), true, "Metadata not maintained");
+  CHECK_HISTORY (p, 1, 21);
+  ADD_HEADER (p, 5);
+  p3 = p->CreateFragment (0, 10);
+  CHECK_HISTORY (p3, 2, 5, 5);
 }
 //-----------------------------------------------------------------------------
 class PacketMetadataTestSuite : public TestSuite
@@ -19,8 +19,13 @@
  */
 #include "ns3/packet.h"
 #include "ns3/packet-tag-list.h"
+#include "ns3/packet-data-pool.h"
 #include "ns3/test.h"
 #include "ns3/unused.h"
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#endif
 #include <limits>     // std:numeric_limits
 #include <string>
 #include <cstdarg>
@@ -674,6 +679,35 @@ PacketTagListTest::DoRun (void)
     ReplaceCheck (6);
     ReplaceCheck (7);
   }
+
+  { // Inline tags
+    std::cout << GetName () << "check inline tags and spilling" << std::endl;
+    ATestTag<1> a (1);
+    ATestTag<2> b (1);
+    PacketTagList ptl;
+    ptl.Add (a);
+    ptl.Add (b);
+    PacketTagList copy = ptl;
+    b.m_data = 2;
+    copy.Replace (b);
+    b.m_data = 1;
+    CheckRef (ptl, b, "inline replace orig");
+    b.m_data = 2;
+    CheckRef (copy, b, "inline replace copy");
+    copy.Add (t3);            // spills
+    CheckRef (copy, t3, "spill add");
+    CheckRef (ptl, t3, "spill add orig", true);
+    NS_TEST_EXPECT_MSG_EQ (copy.GetN (), 3, "spill add");
+    copy.Remove (a);
+    copy.Remove (b);
+    copy.Remove (t3);
+    NS_TEST_EXPECT_MSG_EQ (copy.GetN (), 0, "remove all");
+    copy.Add (a);
+    CheckRef (copy, a, "add after remove");
+    b.m_data = 1;
+    CheckRef (ptl, a, "inline orig");
+    CheckRef (ptl, b, "inline orig");
+  }
   
   { // Timing
     std::cout << GetName () << "add+remove timing" << std::endl;
@@ -716,6 +750,95 @@ PacketTagListTest::DoRun (void)
     
 }
 
+//-----------------------------------------------------------------------------
+class PacketDataPoolTest : public TestCase
+{
+public:
+  PacketDataPoolTest ();
+private:
+  void DoRun (void);
+  /**
+   * Create and destroy packets of alternating sizes.
+   * \param n the number of packets of each size
+   */
+  static void CreatePackets (uint32_t n);
+  /// Run CreatePackets in another thread and record its statistics.
+  void ThreadRun (void);
+  struct PacketDataPool::Statistics m_threadStats; //!< buffer statistics of the thread
+};
+
+PacketDataPoolTest::PacketDataPoolTest ()
+  : TestCase ("PacketDataPool size classes and per-thread free lists")
+{
+}
+
+void
+PacketDataPoolTest::CreatePackets (uint32_t n)
+{
+  uint8_t bytes[1280] = { 0 };
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // an 802.15.4 frame and an IPv6 packet, with tags and metadata
+      Ptr<Packet> small = Create<Packet> (bytes, 127);
+      small->EnableMetadata ();
+      small->AddHeader (ATestHeader<10> ());
+      small->AddPacketTag (ATestTag<4> ());
+      small->AddByteTag (ATestTag<8> ());
+      Ptr<Packet> large = Create<Packet> (bytes, 1280);
+      large->EnableMetadata ();
+      large->AddHeader (ATestHeader<40> ());
+      large->AddPacketTag (ATestTag<4> ());
+      large->AddPacketTag (ATestTag<5> ());
+      large->AddPacketTag (ATestTag<6> ());
+      large->AddByteTag (ATestTag<8> ());
+    }
+}
+
+void
+PacketDataPoolTest::ThreadRun (void)
+{
+  PacketDataPool::Release ();
+  CreatePackets (100);
+  m_threadStats = PacketDataPool::GetStatistics (PacketDataPool::BUFFER);
+}
+
+void
+PacketDataPoolTest::DoRun (void)
+{
+  PacketDataPool::Release ();
+  CreatePackets (1);
+  struct PacketDataPool::Statistics first = PacketDataPool::GetStatistics (PacketDataPool::BUFFER);
+  NS_TEST_EXPECT_MSG_GT (first.misses, 0, "No buffer allocated");
+  NS_TEST_EXPECT_MSG_GT (first.bytesRetained, 1280, "Buffers not retained");
+
+  // both sizes are reused from then on
+  CreatePackets (100);
+  struct PacketDataPool::Statistics stats = PacketDataPool::GetStatistics (PacketDataPool::BUFFER);
+  NS_TEST_EXPECT_MSG_EQ (stats.misses, first.misses, "Buffer not reused");
+  NS_TEST_EXPECT_MSG_GT (stats.hits, 100 * first.misses, "Buffer not reused");
+  NS_TEST_EXPECT_MSG_EQ (stats.bytesRetained, first.bytesRetained, "Free lists grew");
+  for (uint32_t user = PacketDataPool::PACKET_METADATA; user < PacketDataPool::USERS; user++)
+    {
+      stats = PacketDataPool::GetStatistics (static_cast<enum PacketDataPool::User> (user));
+      NS_TEST_EXPECT_MSG_GT (stats.hits, 0, "Data of user " << user << " not reused");
+    }
+
+#ifdef HAVE_PTHREAD_H
+  // another thread has its own free lists
+  stats = PacketDataPool::GetStatistics (PacketDataPool::BUFFER);
+  Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&PacketDataPoolTest::ThreadRun, this));
+  thread->Start ();
+  thread->Join ();
+  NS_TEST_EXPECT_MSG_EQ (m_threadStats.misses, first.misses, "Free lists shared with the thread");
+  NS_TEST_EXPECT_MSG_EQ (PacketDataPool::GetStatistics (PacketDataPool::BUFFER).hits, stats.hits,
+                         "Free lists shared with the thread");
+#endif
+
+  PacketDataPool::Release ();
+  stats = PacketDataPool::GetStatistics (PacketDataPool::BUFFER);
+  NS_TEST_EXPECT_MSG_EQ (stats.bytesRetained, 0, "Free lists not released");
+}
+
 //-----------------------------------------------------------------------------
 class PacketTestSuite : public TestSuite
 {
@@ -728,6 +851,7 @@ PacketTestSuite::PacketTestSuite ()
 {
   AddTestCase (new PacketTest, TestCase::QUICK);
   AddTestCase (new PacketTagListTest, TestCase::QUICK);
+  AddTestCase (new PacketDataPoolTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite;
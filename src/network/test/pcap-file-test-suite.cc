@@ -21,10 +21,17 @@
 #include <cstdlib>
 #include <sstream>
 #include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
 
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/pcap-file.h"
+#include "ns3/pcap-file-mapping.h"
+#include "ns3/pcapng-file-wrapper.h"
+#include "ns3/packet.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -1120,6 +1127,251 @@ DiffTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+// ===========================================================================
+// Test case to make sure that PcapFileMapping walks the records of a file as
+// PcapFile reads them, in both byte orders, and stops before a truncated
+// record.
+// ===========================================================================
+class MappedReadTestCase : public TestCase
+{
+public:
+  MappedReadTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param filename the file to check against PcapFile::Read
+   * \param records the expected number of records
+   */
+  void CheckRecords (std::string filename, uint32_t records);
+};
+
+MappedReadTestCase::MappedReadTestCase ()
+  : TestCase ("Check that PcapFileMapping reads the records of pcap files")
+{
+}
+
+void
+MappedReadTestCase::CheckRecords (std::string filename, uint32_t records)
+{
+  PcapFile f;
+  f.Open (filename, std::ios::in);
+  NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Open (" << filename << ") returns error");
+  PcapFileMapping m;
+  m.Open (filename);
+  NS_TEST_ASSERT_MSG_EQ (m.Fail (), false, "Mapping " << filename << " returns error");
+  NS_TEST_EXPECT_MSG_EQ (m.GetMagic (), f.GetMagic (), "Magic number differs");
+  NS_TEST_EXPECT_MSG_EQ (m.GetSnapLen (), f.GetSnapLen (), "Snap length differs");
+  NS_TEST_EXPECT_MSG_EQ (m.GetDataLinkType (), f.GetDataLinkType (), "Data link type differs");
+  NS_TEST_EXPECT_MSG_EQ (m.GetSwapMode (), f.GetSwapMode (), "Swap mode differs");
+
+  uint8_t data[2048];
+  uint32_t tsSec, tsUsec, inclLen, origLen, readLen;
+  uint32_t n = 0;
+  for (PcapFileMapping::Iterator i = m.Begin (); i != m.End (); ++i, ++n)
+    {
+      f.Read (data, sizeof (data), tsSec, tsUsec, inclLen, origLen, readLen);
+      NS_TEST_ASSERT_MSG_EQ (f.Fail (), false, "Mapping has more records than " << filename);
+      NS_TEST_EXPECT_MSG_EQ (i->GetTsSec (), tsSec, "Seconds differ in record " << n);
+      NS_TEST_EXPECT_MSG_EQ (i->GetTsUsec (), tsUsec, "Microseconds differ in record " << n);
+      NS_TEST_EXPECT_MSG_EQ (i->GetInclLen (), inclLen, "Included length differs in record " << n);
+      NS_TEST_EXPECT_MSG_EQ (i->GetOrigLen (), origLen, "Original length differs in record " << n);
+      NS_TEST_EXPECT_MSG_EQ (std::memcmp (i->GetData (), data, readLen), 0, "Data differ in record " << n);
+    }
+  NS_TEST_EXPECT_MSG_EQ (n, records, "Wrong number of records in " << filename);
+}
+
+void
+MappedReadTestCase::DoRun (void)
+{
+  std::string known = CreateDataDirFilename ("known.pcap");
+  CheckRecords (known, N_KNOWN_PACKETS);
+
+  //
+  // Write the known packets in the opposite byte order.
+  //
+  std::string swapped = CreateTempDirFilename ("swapped.pcap");
+  PcapFile f;
+  f.Open (swapped, std::ios::out);
+  f.Init (1, N_PACKET_BYTES, PcapFile::ZONE_DEFAULT, true);
+  for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+    {
+      PacketEntry const & p = knownPackets[i];
+      f.Write (p.tsSec, p.tsUsec, (uint8_t const *)p.data, p.origLen);
+    }
+  f.Close ();
+  CheckRecords (swapped, N_KNOWN_PACKETS);
+
+  //
+  // Cut the last record of the known file.
+  //
+  std::ifstream in (known.c_str (), std::ios::binary);
+  std::vector<char> content ((std::istreambuf_iterator<char> (in)), std::istreambuf_iterator<char> ());
+  std::string truncated = CreateTempDirFilename ("truncated.pcap");
+  std::ofstream out (truncated.c_str (), std::ios::binary);
+  out.write (&content[0], content.size () - 10);
+  out.close ();
+  CheckRecords (truncated, N_KNOWN_PACKETS - 1);
+  uint32_t sec (0), usec (0);
+  bool diff = PcapFile::Diff (known, truncated, sec, usec);
+  NS_TEST_EXPECT_MSG_EQ (diff, true, "PcapDiff(file, truncated file) must be true");
+  NS_TEST_EXPECT_MSG_EQ (sec,  2, "Files are different from 2.3915 seconds");
+  NS_TEST_EXPECT_MSG_EQ (usec, 3915, "Files are different from 2.3915 seconds");
+
+  PcapFileMapping m;
+  m.Open (CreateTempDirFilename ("missing.pcap"));
+  NS_TEST_EXPECT_MSG_EQ (m.Fail (), true, "Mapping a missing file must fail");
+
+  remove (swapped.c_str ());
+  remove (truncated.c_str ());
+}
+
+// ===========================================================================
+// Test case to make sure that buffered records, written by the caller or by
+// the I/O thread, result in the same file as records written through.
+// ===========================================================================
+class BufferedWriteTestCase : public TestCase
+{
+public:
+  BufferedWriteTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param filename the file to write
+   * \param bufferSize the size of the buffer
+   * \param async write from the I/O thread
+   */
+  void WriteFile (std::string filename, uint32_t bufferSize, bool async);
+};
+
+BufferedWriteTestCase::BufferedWriteTestCase ()
+  : TestCase ("Check that buffered PcapFile records are written in order")
+{
+}
+
+void
+BufferedWriteTestCase::WriteFile (std::string filename, uint32_t bufferSize, bool async)
+{
+  PcapFile f;
+  f.Open (filename, std::ios::out);
+  f.SetBufferSize (bufferSize);
+  f.SetAsyncFlush (async);
+  f.Init (1, N_PACKET_BYTES);
+  uint8_t data[N_PACKET_BYTES];
+  for (uint32_t i = 0; i < 1000; ++i)
+    {
+      PacketEntry const & p = knownPackets[i % N_KNOWN_PACKETS];
+      for (uint32_t j = 0; j < N_PACKET_BYTES; ++j)
+        {
+          data[j] = p.data[j] + i;
+        }
+      f.Write (p.tsSec + i, p.tsUsec, data, p.origLen);
+    }
+  NS_TEST_EXPECT_MSG_EQ (f.Fail (), false, "Write must not fail");
+  f.Close ();
+}
+
+void
+BufferedWriteTestCase::DoRun (void)
+{
+  std::string reference = CreateTempDirFilename ("write-through.pcap");
+  WriteFile (reference, 0, false);
+  uint32_t sec (0), usec (0);
+  bool async[] = { false, true, true };
+  uint32_t sizes[] = { 100, 100, 1 << 16 };
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      std::string filename = CreateTempDirFilename ("buffered.pcap");
+      WriteFile (filename, sizes[i], async[i]);
+      NS_TEST_EXPECT_MSG_EQ (CheckFileLength (filename, 24 + 1000 * (16 + N_PACKET_BYTES)), true,
+                             "Records missing with a " << sizes[i] << "-byte buffer");
+      bool diff = PcapFile::Diff (reference, filename, sec, usec);
+      NS_TEST_EXPECT_MSG_EQ (diff, false, "Records differ with a " << sizes[i] << "-byte buffer");
+      remove (filename.c_str ());
+    }
+  remove (reference.c_str ());
+}
+
+// ===========================================================================
+// Test case to make sure that the blocks of a pcapng file are consistent.
+// ===========================================================================
+class PcapngWriteTestCase : public TestCase
+{
+public:
+  PcapngWriteTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+PcapngWriteTestCase::PcapngWriteTestCase ()
+  : TestCase ("Check that PcapngFileWrapper writes consistent blocks")
+{
+}
+
+void
+PcapngWriteTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("merged.pcapng");
+  Ptr<PcapngFileWrapper> file = CreateObject<PcapngFileWrapper> ();
+  file->Open (filename);
+  NS_TEST_ASSERT_MSG_EQ (file->Fail (), false, "Open (" << filename << ") returns error");
+  // a small buffer, set after Open as on the files created by the helpers
+  file->SetAttribute ("BufferSize", UintegerValue (64));
+  UintegerValue bufferSize;
+  file->GetAttribute ("BufferSize", bufferSize);
+  NS_TEST_EXPECT_MSG_EQ (bufferSize.Get (), 64, "BufferSize not set");
+  NS_TEST_EXPECT_MSG_EQ (file->AddInterface (195, "0-0"), 0, "Unexpected interface id");
+  NS_TEST_EXPECT_MSG_EQ (file->AddInterface (195, "node-1", 10), 1, "Unexpected interface id");
+  for (uint32_t i = 0; i < 10; ++i)
+    {
+      file->Write (i % 2, NanoSeconds (0x100000000ULL + i), Create<Packet> (i + 5));
+    }
+  file->Close ();
+
+  std::ifstream in (filename.c_str (), std::ios::binary);
+  std::vector<uint8_t> data ((std::istreambuf_iterator<char> (in)), std::istreambuf_iterator<char> ());
+  uint32_t offset = 0;
+  uint32_t blocks[7] = { 0 };
+  uint32_t packets = 0;
+  while (offset + 12 <= data.size ())
+    {
+      uint32_t type, length, trailer;
+      std::memcpy (&type, &data[offset], 4);
+      std::memcpy (&length, &data[offset + 4], 4);
+      NS_TEST_ASSERT_MSG_EQ ((length % 4 == 0 && offset + length <= data.size ()), true,
+                             "Invalid block length " << length);
+      std::memcpy (&trailer, &data[offset + length - 4], 4);
+      NS_TEST_ASSERT_MSG_EQ (trailer, length, "Block lengths differ");
+      if (type == 6)
+        {
+          uint32_t interface, high, low, inclLen, origLen;
+          std::memcpy (&interface, &data[offset + 8], 4);
+          std::memcpy (&high, &data[offset + 12], 4);
+          std::memcpy (&low, &data[offset + 16], 4);
+          std::memcpy (&inclLen, &data[offset + 20], 4);
+          std::memcpy (&origLen, &data[offset + 24], 4);
+          NS_TEST_EXPECT_MSG_EQ (interface, packets % 2, "Wrong interface");
+          NS_TEST_EXPECT_MSG_EQ (high, 1, "Wrong timestamp");
+          NS_TEST_EXPECT_MSG_EQ (low, packets, "Wrong timestamp");
+          NS_TEST_EXPECT_MSG_EQ (origLen, packets + 5, "Wrong length");
+          NS_TEST_EXPECT_MSG_EQ (inclLen, (interface == 1 ? std::min (origLen, 10U) : origLen), "Wrong snap length");
+          packets++;
+        }
+      else if (type < 7)
+        {
+          blocks[type]++;
+        }
+      offset += length;
+    }
+  NS_TEST_EXPECT_MSG_EQ (offset, data.size (), "Trailing bytes");
+  NS_TEST_EXPECT_MSG_EQ ((data.size () > 0 && data[0] == 0x0a && data[3] == 0x0a), true, "No section header block");
+  NS_TEST_EXPECT_MSG_EQ (blocks[1], 2, "Wrong number of interface description blocks");
+  NS_TEST_EXPECT_MSG_EQ (packets, 10, "Wrong number of enhanced packet blocks");
+  remove (filename.c_str ());
+}
+
 class PcapFileTestSuite : public TestSuite
 {
 public:
@@ -1137,6 +1389,9 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new MappedReadTestCase, TestCase::QUICK);
+  AddTestCase (new BufferedWriteTestCase, TestCase::QUICK);
+  AddTestCase (new PcapngWriteTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite;
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "buffered-file-writer.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BufferedFileWriter");
+
+NS_OBJECT_ENSURE_REGISTERED (BufferedFileWriter);
+
+TypeId
+BufferedFileWriter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::BufferedFileWriter")
+    .SetParent<Object> ()
+    .AddAttribute ("BufferSize",
+                   "Size of the buffer of the records written, in bytes. "
+                   "0, the default, writes each record through, so that the "
+                   "file can be read while the simulation runs; a buffer is "
+                   "only written when full, flushed or closed",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&BufferedFileWriter::SetBufferSize,
+                                         &BufferedFileWriter::GetBufferSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("AsyncFlush",
+                   "Write the full buffers from a background I/O thread",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&BufferedFileWriter::SetAsyncFlush,
+                                        &BufferedFileWriter::GetAsyncFlush),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+
+BufferedFileWriter::BufferedFileWriter ()
+  : m_bufferSize (0),
+    m_asyncFlush (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+BufferedFileWriter::~BufferedFileWriter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+BufferedFileWriter::SetBufferSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  m_bufferSize = size;
+  DoSetBufferSize (size);
+}
+
+uint32_t
+BufferedFileWriter::GetBufferSize (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_bufferSize;
+}
+
+void
+BufferedFileWriter::SetAsyncFlush (bool async)
+{
+  NS_LOG_FUNCTION (this << async);
+  m_asyncFlush = async;
+  DoSetAsyncFlush (async);
+}
+
+bool
+BufferedFileWriter::GetAsyncFlush (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_asyncFlush;
+}
+
+} // namespace ns3
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BUFFERED_FILE_WRITER_H
+#define BUFFERED_FILE_WRITER_H
+
+#include <stdint.h>
+#include "ns3/object.h"
+
+namespace ns3 {
+
+/**
+ * \brief Base class of the trace files which buffer the records written.
+ *
+ * Holds the BufferSize and AsyncFlush attributes shared by the trace
+ * files, and forwards them to the buffer of the subclass. Both can be
+ * set at any time, even after the file is opened: the buffered records
+ * are written first.
+ *
+ * By default, each record is written through, as the pcap files always
+ * were, so that a trace can be read while the simulation runs. With a
+ * buffer, call the Flush or Close method of the file first.
+ */
+class BufferedFileWriter : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  BufferedFileWriter ();
+  virtual ~BufferedFileWriter ();
+
+protected:
+  /**
+   * Write the buffered records, and resize the buffer.
+   *
+   * \param size the size of the buffer, in bytes; 0 writes each record
+   *        through
+   */
+  virtual void DoSetBufferSize (uint32_t size) = 0;
+  /**
+   * Write the buffered records, and set how the full buffers are written.
+   *
+   * \param async true to write the full buffers from the I/O thread
+   */
+  virtual void DoSetAsyncFlush (bool async) = 0;
+
+private:
+  /**
+   * \param size the size of the buffer of the records written, in bytes
+   */
+  void SetBufferSize (uint32_t size);
+  /**
+   * \returns the size of the buffer of the records written, in bytes
+   */
+  uint32_t GetBufferSize (void) const;
+  /**
+   * \param async true to write the full buffers from the I/O thread
+   */
+  void SetAsyncFlush (bool async);
+  /**
+   * \returns true if the full buffers are written from the I/O thread
+   */
+  bool GetAsyncFlush (void) const;
+
+  uint32_t m_bufferSize; //!< size of the buffer of the records written
+  bool m_asyncFlush;     //!< true if the buffers are written by the I/O thread
+};
+
+} // namespace ns3
+
+#endif /* BUFFERED_FILE_WRITER_H */
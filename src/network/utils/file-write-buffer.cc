@@ -0,0 +1,268 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "file-write-buffer.h"
+#include "ns3/log.h"
+#include "ns3/core-config.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FileWriteBuffer");
+
+#ifdef HAVE_PTHREAD_H
+namespace {
+
+/// A block of records to be written by the I/O thread.
+struct WriteJob
+{
+  std::ostream *stream; //!< the stream to write to
+  uint8_t *data;        //!< the records, released once written
+  uint32_t size;        //!< the size of the records
+  uint32_t *pending;    //!< counter of the owner, decremented once written
+};
+
+pthread_mutex_t g_ioMutex = PTHREAD_MUTEX_INITIALIZER; //!< protects the variables below
+pthread_cond_t g_ioWork = PTHREAD_COND_INITIALIZER;    //!< signaled when a job is queued
+pthread_cond_t g_ioDone = PTHREAD_COND_INITIALIZER;    //!< broadcast when a job is done
+pthread_t g_ioThread;                                   //!< the I/O thread
+bool g_ioRunning = false;                               //!< true once the thread is started
+bool g_ioStopping = false;                              //!< true once the program exits
+std::deque<WriteJob> g_ioJobs;                          //!< queued jobs
+
+void *
+IoThreadRun (void *)
+{
+  pthread_mutex_lock (&g_ioMutex);
+  while (true)
+    {
+      while (g_ioJobs.empty () && !g_ioStopping)
+        {
+          pthread_cond_wait (&g_ioWork, &g_ioMutex);
+        }
+      if (g_ioJobs.empty ())
+        {
+          break;
+        }
+      WriteJob job = g_ioJobs.front ();
+      g_ioJobs.pop_front ();
+      pthread_mutex_unlock (&g_ioMutex);
+      job.stream->write ((const char *)job.data, job.size);
+      delete [] job.data;
+      pthread_mutex_lock (&g_ioMutex);
+      (*job.pending)--;
+      pthread_cond_broadcast (&g_ioDone);
+    }
+  pthread_mutex_unlock (&g_ioMutex);
+  return 0;
+}
+
+/**
+ * Stop the I/O thread at the end of the program, once the queued jobs
+ * are written. Defined after g_ioJobs, hence destroyed before it.
+ */
+struct IoThreadStopper
+{
+  ~IoThreadStopper ()
+  {
+    pthread_mutex_lock (&g_ioMutex);
+    g_ioStopping = true;
+    bool running = g_ioRunning;
+    pthread_cond_signal (&g_ioWork);
+    pthread_mutex_unlock (&g_ioMutex);
+    if (running)
+      {
+        pthread_join (g_ioThread, 0);
+      }
+  }
+} g_ioThreadStopper;
+
+/**
+ * \param job the job to queue
+ * \returns false if the job cannot be queued and must be done by the caller
+ */
+bool
+IoThreadQueue (const WriteJob &job)
+{
+  pthread_mutex_lock (&g_ioMutex);
+  if (g_ioStopping)
+    {
+      pthread_mutex_unlock (&g_ioMutex);
+      return false;
+    }
+  if (!g_ioRunning)
+    {
+      if (pthread_create (&g_ioThread, 0, &IoThreadRun, 0) != 0)
+        {
+          pthread_mutex_unlock (&g_ioMutex);
+          return false;
+        }
+      g_ioRunning = true;
+    }
+  g_ioJobs.push_back (job);
+  (*job.pending)++;
+  pthread_cond_signal (&g_ioWork);
+  pthread_mutex_unlock (&g_ioMutex);
+  return true;
+}
+
+} // anonymous namespace
+#endif /* HAVE_PTHREAD_H */
+
+FileWriteBuffer::FileWriteBuffer (std::ostream *stream)
+  : m_stream (stream),
+    m_data (0),
+    m_used (0),
+    m_capacity (0),
+    m_size (0),
+    m_async (false),
+    m_pending (0)
+{
+  NS_LOG_FUNCTION (this << stream);
+}
+
+FileWriteBuffer::~FileWriteBuffer ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  delete [] m_data;
+}
+
+void
+FileWriteBuffer::SetSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  Flush ();
+  m_size = size;
+}
+
+uint32_t
+FileWriteBuffer::GetSize (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_size;
+}
+
+bool
+FileWriteBuffer::IsEnabled (void) const
+{
+  return m_size > 0;
+}
+
+void
+FileWriteBuffer::SetAsync (bool async)
+{
+  NS_LOG_FUNCTION (this << async);
+#ifdef HAVE_PTHREAD_H
+  Flush ();
+  m_async = async;
+#endif
+}
+
+uint8_t *
+FileWriteBuffer::Reserve (uint32_t size)
+{
+  if (m_used + size > m_capacity)
+    {
+      // the first record of a buffer may be larger than the buffer.
+      uint32_t capacity = std::max (m_size, m_used + size);
+      uint8_t *data = new uint8_t[capacity];
+      if (m_used > 0)
+        {
+          std::memcpy (data, m_data, m_used);
+        }
+      delete [] m_data;
+      m_data = data;
+      m_capacity = capacity;
+    }
+  uint8_t *start = m_data + m_used;
+  m_used += size;
+  return start;
+}
+
+void
+FileWriteBuffer::Commit (void)
+{
+  if (m_used >= m_size)
+    {
+      Write ();
+    }
+}
+
+void
+FileWriteBuffer::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  Write ();
+  Sync ();
+}
+
+void
+FileWriteBuffer::Sync (void) const
+{
+#ifdef HAVE_PTHREAD_H
+  if (!m_async)
+    {
+      return;
+    }
+  pthread_mutex_lock (&g_ioMutex);
+  while (m_pending > 0)
+    {
+      pthread_cond_wait (&g_ioDone, &g_ioMutex);
+    }
+  pthread_mutex_unlock (&g_ioMutex);
+#endif
+}
+
+void
+FileWriteBuffer::Write (void)
+{
+  NS_LOG_FUNCTION (this << m_used);
+  if (m_used == 0)
+    {
+      return;
+    }
+#ifdef HAVE_PTHREAD_H
+  if (m_async)
+    {
+      WriteJob job;
+      job.stream = m_stream;
+      job.data = m_data;
+      job.size = m_used;
+      job.pending = &m_pending;
+      if (IoThreadQueue (job))
+        {
+          // the I/O thread owns the buffer now.
+          m_data = 0;
+          m_used = 0;
+          m_capacity = 0;
+          return;
+        }
+      // the program is exiting: write the buffer after the pending ones.
+      Sync ();
+    }
+#endif
+  m_stream->write ((const char *)m_data, m_used);
+  m_used = 0;
+}
+
+} // namespace ns3
@@ -58,14 +58,15 @@ AsciiToLowCase (char c)
 
 
 Mac16Address::Mac16Address ()
+  : m_address (0)
 {
   NS_LOG_FUNCTION (this);
-  memset (m_address, 0, 2);
 }
 
 Mac16Address::Mac16Address (const char *str)
 {
   NS_LOG_FUNCTION (this << str);
+  uint8_t buffer[2];
   int i = 0;
   while (*str != 0 && i < 2)
     {
@@ -84,7 +85,7 @@ Mac16Address::Mac16Address (const char *str)
             }
           str++;
         }
-      m_address[i] = byte;
+      buffer[i] = byte;
       i++;
       if (*str == 0)
         {
@@ -93,19 +94,21 @@ Mac16Address::Mac16Address (const char *str)
       str++;
     }
   NS_ASSERT (i == 2);
+  CopyFrom (buffer);
 }
 
 void
 Mac16Address::CopyFrom (const uint8_t buffer[2])
 {
   NS_LOG_FUNCTION (this << &buffer);
-  memcpy (m_address, buffer, 2);
+  m_address = (buffer[0] << 8) | buffer[1];
 }
 void
 Mac16Address::CopyTo (uint8_t buffer[2]) const
 {
   NS_LOG_FUNCTION (this << &buffer);
-  memcpy (buffer, m_address, 2);
+  buffer[0] = (m_address >> 8) & 0xff;
+  buffer[1] = (m_address >> 0) & 0xff;
 }
 
 bool
@@ -125,15 +128,19 @@ Mac16Address::ConvertFrom (const Address &address)
 {
   NS_LOG_FUNCTION (address);
   NS_ASSERT (address.CheckCompatible (GetType (), 2));
+  uint8_t buffer[2];
+  address.CopyTo (buffer);
   Mac16Address retval;
-  address.CopyTo (retval.m_address);
+  retval.CopyFrom (buffer);
   return retval;
 }
 Address
 Mac16Address::ConvertTo (void) const
 {
   NS_LOG_FUNCTION (this);
-  return Address (GetType (), m_address, 2);
+  uint8_t buffer[2];
+  CopyTo (buffer);
+  return Address (GetType (), buffer, 2);
 }
 
 Mac16Address
@@ -143,8 +150,7 @@ Mac16Address::Allocate (void)
   static uint64_t id = 0;
   id++;
   Mac16Address address;
-  address.m_address[0] = (id >> 8) & 0xff;
-  address.m_address[1] = (id >> 0) & 0xff;
+  address.m_address = id & 0xffff;
   return address;
 }
 
@@ -179,6 +185,9 @@ std::istream& operator>> (std::istream& is, Mac16Address & address)
   std::string v;
   is >> v;
 
+  uint8_t buffer[2];
+  address.CopyTo (buffer);
+
   std::string::size_type col = 0;
   for (uint8_t i = 0; i < 2; ++i)
     {
@@ -188,16 +197,17 @@ std::istream& operator>> (std::istream& is, Mac16Address & address)
       if (next == std::string::npos)
         {
           tmp = v.substr (col, v.size ()-col);
-          address.m_address[i] = strtoul (tmp.c_str(), 0, 16);
+          buffer[i] = strtoul (tmp.c_str(), 0, 16);
           break;
         }
       else
         {
           tmp = v.substr (col, next-col);
-          address.m_address[i] = strtoul (tmp.c_str(), 0, 16);
+          buffer[i] = strtoul (tmp.c_str(), 0, 16);
           col = next + 1;
         }
     }
+  address.CopyFrom (buffer);
   return is;
 }
 
@@ -45,6 +45,11 @@ public:
    *
   */
   Mac16Address (const char *str);
+  /**
+   * \param addr the address as an integer, whose most significant byte
+   *        is the first byte of the address in network order
+   */
+  explicit Mac16Address (uint16_t addr);
 
   /**
    * \param buffer address in network order
@@ -58,6 +63,18 @@ public:
    * Copy the internal address to the input buffer.
    */
   void CopyTo (uint8_t buffer[2]) const;
+  /**
+   * \returns the address as an integer, whose most significant byte is
+   *          the first byte of the address in network order
+   *
+   * Addresses compare as their integers, without going through the
+   * polymorphic Address.
+   */
+  uint16_t ConvertToInt (void) const;
+  /**
+   * \returns true if this is the broadcast address ff:ff
+   */
+  bool IsBroadcast (void) const;
   /**
    * \returns a new Address instance
    *
@@ -83,6 +100,10 @@ public:
    * \returns newly allocated mac16Address
    */
   static Mac16Address Allocate (void);
+  /**
+   * \returns the broadcast address ff:ff
+   */
+  static Mac16Address GetBroadcast (void);
 
 private:
   /**
@@ -143,7 +164,7 @@ private:
    */
   friend std::istream& operator>> (std::istream& is, Mac16Address & address);
 
-  uint8_t m_address[2]; //!< address value
+  uint16_t m_address; //!< address value, first byte most significant
 };
 
 /**
@@ -155,17 +176,59 @@ ATTRIBUTE_HELPER_HEADER (Mac16Address); //!< Macro to make help make class an ns
 
 inline bool operator == (const Mac16Address &a, const Mac16Address &b)
 {
-  return memcmp (a.m_address, b.m_address, 2) == 0;
+  return a.m_address == b.m_address;
 }
 inline bool operator != (const Mac16Address &a, const Mac16Address &b)
 {
-  return memcmp (a.m_address, b.m_address, 2) != 0;
+  return a.m_address != b.m_address;
 }
 inline bool operator < (const Mac16Address &a, const Mac16Address &b)
 {
-  return memcmp (a.m_address, b.m_address, 2) < 0;
+  return a.m_address < b.m_address;
+}
+
+inline
+Mac16Address::Mac16Address (uint16_t addr)
+  : m_address (addr)
+{
+}
+
+inline uint16_t
+Mac16Address::ConvertToInt (void) const
+{
+  return m_address;
 }
 
+inline bool
+Mac16Address::IsBroadcast (void) const
+{
+  return m_address == 0xffff;
+}
+
+inline Mac16Address
+Mac16Address::GetBroadcast (void)
+{
+  return Mac16Address (0xffff);
+}
+
+/**
+ * \class Mac16AddressHash
+ * \brief Class providing an hash for Mac16Address, to key hash maps
+ */
+class Mac16AddressHash
+{
+public:
+  /**
+   * Returns the hash of the address
+   * \param x the address
+   * \return the hash
+   */
+  size_t operator() (Mac16Address const &x) const
+  {
+    return x.ConvertToInt ();
+  }
+};
+
 std::ostream& operator<< (std::ostream& os, const Mac16Address & address);
 std::istream& operator>> (std::istream& is, Mac16Address & address);
 
@@ -58,13 +58,14 @@ AsciiToLowCase (char c)
 
 
 Mac64Address::Mac64Address ()
+  : m_address (0)
 {
   NS_LOG_FUNCTION (this);
-  std::memset (m_address, 0, 8);
 }
 Mac64Address::Mac64Address (const char *str)
 {
   NS_LOG_FUNCTION (this << str);
+  uint8_t buffer[8];
   int i = 0;
   while (*str != 0 && i < 8) 
     {
@@ -83,7 +84,7 @@ Mac64Address::Mac64Address (const char *str)
             }
           str++;
         }
-      m_address[i] = byte;
+      buffer[i] = byte;
       i++;
       if (*str == 0) 
         {
@@ -92,18 +93,26 @@ Mac64Address::Mac64Address (const char *str)
       str++;
     }
   NS_ASSERT (i == 8);
+  CopyFrom (buffer);
 }
 void 
 Mac64Address::CopyFrom (const uint8_t buffer[8])
 {
   NS_LOG_FUNCTION (this << &buffer);
-  std::memcpy (m_address, buffer, 8);
+  m_address = 0;
+  for (uint8_t i = 0; i < 8; i++)
+    {
+      m_address = (m_address << 8) | buffer[i];
+    }
 }
 void 
 Mac64Address::CopyTo (uint8_t buffer[8]) const
 {
   NS_LOG_FUNCTION (this << &buffer);
-  std::memcpy (buffer, m_address, 8);
+  for (uint8_t i = 0; i < 8; i++)
+    {
+      buffer[i] = (m_address >> (56 - 8 * i)) & 0xff;
+    }
 }
 
 bool 
@@ -121,8 +130,10 @@ Mac64Address::ConvertFrom (const Address &address)
 {
   NS_LOG_FUNCTION (address);
   NS_ASSERT (address.CheckCompatible (GetType (), 8));
+  uint8_t buffer[8];
+  address.CopyTo (buffer);
   Mac64Address retval;
-  address.CopyTo (retval.m_address);
+  retval.CopyFrom (buffer);
   return retval;
 }
 
@@ -130,7 +141,9 @@ Address
 Mac64Address::ConvertTo (void) const
 {
   NS_LOG_FUNCTION (this);
-  return Address (GetType (), m_address, 8);
+  uint8_t buffer[8];
+  CopyTo (buffer);
+  return Address (GetType (), buffer, 8);
 }
 
 Mac64Address 
@@ -140,14 +153,7 @@ Mac64Address::Allocate (void)
   static uint64_t id = 0;
   id++;
   Mac64Address address;
-  address.m_address[0] = (id >> 56) & 0xff;
-  address.m_address[1] = (id >> 48) & 0xff;
-  address.m_address[2] = (id >> 40) & 0xff;
-  address.m_address[3] = (id >> 32) & 0xff;
-  address.m_address[4] = (id >> 24) & 0xff;
-  address.m_address[5] = (id >> 16) & 0xff;
-  address.m_address[6] = (id >> 8) & 0xff;
-  address.m_address[7] = (id >> 0) & 0xff;
+  address.m_address = id;
   return address;
 }
 uint8_t 
@@ -181,6 +187,9 @@ std::istream& operator>> (std::istream& is, Mac64Address & address)
   std::string v;
   is >> v;
 
+  uint8_t buffer[8];
+  address.CopyTo (buffer);
+
   std::string::size_type col = 0;
   for (uint8_t i = 0; i < 8; ++i)
     {
@@ -190,16 +199,17 @@ std::istream& operator>> (std::istream& is, Mac64Address & address)
       if (next == std::string::npos)
         {
           tmp = v.substr (col, v.size ()-col);
-          address.m_address[i] = strtoul (tmp.c_str(), 0, 16);
+          buffer[i] = strtoul (tmp.c_str(), 0, 16);
           break;
         }
       else
         {
           tmp = v.substr (col, next-col);
-          address.m_address[i] = strtoul (tmp.c_str(), 0, 16);
+          buffer[i] = strtoul (tmp.c_str(), 0, 16);
           col = next + 1;
         }
     }
+  address.CopyFrom (buffer);
   return is;
 }
 
@@ -48,6 +48,11 @@ public:
    * The format of the string is "xx:xx:xx:xx:xx:xx"
    */
   Mac64Address (const char *str);
+  /**
+   * \param addr the address as an integer, whose most significant byte
+   *        is the first byte of the address in network order
+   */
+  explicit Mac64Address (uint64_t addr);
 
   /**
    * \param buffer address in network order
@@ -61,6 +66,14 @@ public:
    * Copy the internal address to the input buffer.
    */
   void CopyTo (uint8_t buffer[8]) const;
+  /**
+   * \returns the address as an integer, whose most significant byte is
+   *          the first byte of the address in network order
+   *
+   * Addresses compare as their integers, without going through the
+   * polymorphic Address.
+   */
+  uint64_t ConvertToInt (void) const;
   /**
    * \returns a new Address instance
    *
@@ -145,7 +158,7 @@ private:
    */
   friend std::istream& operator>> (std::istream& is, Mac64Address & address);
 
-  uint8_t m_address[8]; //!< address value
+  uint64_t m_address; //!< address value, first byte most significant
 };
 
 /**
@@ -157,17 +170,48 @@ ATTRIBUTE_HELPER_HEADER (Mac64Address); //!< Macro to make help make class an ns
 
 inline bool operator == (const Mac64Address &a, const Mac64Address &b)
 {
-  return memcmp (a.m_address, b.m_address, 8) == 0;
+  return a.m_address == b.m_address;
 }
 inline bool operator != (const Mac64Address &a, const Mac64Address &b)
 {
-  return memcmp (a.m_address, b.m_address, 8) != 0;
+  return a.m_address != b.m_address;
 }
 inline bool operator < (const Mac64Address &a, const Mac64Address &b)
 {
-  return memcmp (a.m_address, b.m_address, 8) < 0;
+  return a.m_address < b.m_address;
 }
 
+inline
+Mac64Address::Mac64Address (uint64_t addr)
+  : m_address (addr)
+{
+}
+
+inline uint64_t
+Mac64Address::ConvertToInt (void) const
+{
+  return m_address;
+}
+
+/**
+ * \class Mac64AddressHash
+ * \brief Class providing an hash for Mac64Address, to key hash maps
+ */
+class Mac64AddressHash
+{
+public:
+  /**
+   * Returns the hash of the address
+   * \param x the address
+   * \return the hash
+   */
+  size_t operator() (Mac64Address const &x) const
+  {
+    uint64_t v = x.ConvertToInt ();
+    return static_cast<size_t> (v ^ (v >> 32));
+  }
+};
+
 std::ostream& operator<< (std::ostream& os, const Mac64Address & address);
 std::istream& operator>> (std::istream& is, Mac64Address & address);
 
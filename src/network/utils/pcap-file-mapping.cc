@@ -0,0 +1,309 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pcap-file-mapping.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <cstring>
+
+//
+// This file is used as part of the ns-3 test framework, so please refrain from
+// adding any ns-3 specific constructs such as Packet to this file.
+//
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PcapFileMapping");
+
+namespace {
+
+const uint32_t MAGIC = 0xa1b2c3d4;            //!< standard pcap magic number
+const uint32_t SWAPPED_MAGIC = 0xd4c3b2a1;    //!< standard, byte-swapped
+const uint32_t NS_MAGIC = 0xa1b23cd4;         //!< nanosecond resolution magic number
+const uint32_t NS_SWAPPED_MAGIC = 0xd43cb2a1; //!< nanosecond resolution, byte-swapped
+
+const uint16_t VERSION_MAJOR = 2;             //!< supported major version
+const uint16_t VERSION_MINOR = 4;             //!< supported minor version
+
+const uint32_t FILE_HEADER_SIZE = 24;         //!< size of the file header
+const uint32_t RECORD_HEADER_SIZE = 16;       //!< size of a record header
+
+/**
+ * \param data the address of the field, possibly unaligned
+ * \param swapMode true if the field must be byte-swapped
+ * \returns the field
+ */
+inline uint32_t
+Load32 (uint8_t const *data, bool swapMode)
+{
+  uint32_t v;
+  std::memcpy (&v, data, sizeof (v));
+  if (swapMode)
+    {
+      v = __builtin_bswap32 (v);
+    }
+  return v;
+}
+
+} // anonymous namespace
+
+uint32_t
+PcapFileMapping::Record::GetField (uint32_t offset) const
+{
+  return Load32 (m_start + offset, m_swapMode);
+}
+
+uint32_t
+PcapFileMapping::Record::GetTsSec (void) const
+{
+  return GetField (0);
+}
+
+uint32_t
+PcapFileMapping::Record::GetTsUsec (void) const
+{
+  return GetField (4);
+}
+
+uint32_t
+PcapFileMapping::Record::GetInclLen (void) const
+{
+  return GetField (8);
+}
+
+uint32_t
+PcapFileMapping::Record::GetOrigLen (void) const
+{
+  return GetField (12);
+}
+
+uint8_t const *
+PcapFileMapping::Record::GetData (void) const
+{
+  return m_start + RECORD_HEADER_SIZE;
+}
+
+PcapFileMapping::Iterator::Iterator ()
+  : m_end (0)
+{
+  m_record.m_start = 0;
+  m_record.m_swapMode = false;
+}
+
+PcapFileMapping::Iterator::Iterator (uint8_t const *start, uint8_t const *end, bool swapMode)
+  : m_end (end)
+{
+  m_record.m_start = start;
+  m_record.m_swapMode = swapMode;
+  Check ();
+}
+
+void
+PcapFileMapping::Iterator::Check (void)
+{
+  uint64_t left = m_end - m_record.m_start;
+  if (left < RECORD_HEADER_SIZE
+      || left - RECORD_HEADER_SIZE < m_record.GetInclLen ())
+    {
+      m_record.m_start = m_end;
+    }
+}
+
+PcapFileMapping::Record const &
+PcapFileMapping::Iterator::operator* (void) const
+{
+  NS_ASSERT (m_record.m_start != m_end);
+  return m_record;
+}
+
+PcapFileMapping::Record const *
+PcapFileMapping::Iterator::operator-> (void) const
+{
+  NS_ASSERT (m_record.m_start != m_end);
+  return &m_record;
+}
+
+PcapFileMapping::Iterator &
+PcapFileMapping::Iterator::operator++ (void)
+{
+  NS_ASSERT (m_record.m_start != m_end);
+  m_record.m_start += RECORD_HEADER_SIZE + m_record.GetInclLen ();
+  Check ();
+  return *this;
+}
+
+bool
+PcapFileMapping::Iterator::operator== (Iterator const &o) const
+{
+  return m_record.m_start == o.m_record.m_start;
+}
+
+bool
+PcapFileMapping::Iterator::operator!= (Iterator const &o) const
+{
+  return m_record.m_start != o.m_record.m_start;
+}
+
+PcapFileMapping::PcapFileMapping ()
+  : m_data (0),
+    m_size (0),
+    m_fail (true),
+    m_swapMode (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PcapFileMapping::~PcapFileMapping ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+void
+PcapFileMapping::Open (std::string const &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+  m_fail = !m_file.Open (filename) || m_file.GetSize () < FILE_HEADER_SIZE;
+  m_data = m_file.GetData ();
+  m_size = m_file.GetSize ();
+  if (m_fail)
+    {
+      Close ();
+      m_fail = true;
+      return;
+    }
+
+  uint32_t magic;
+  std::memcpy (&magic, m_data, sizeof (magic));
+  m_swapMode = magic == SWAPPED_MAGIC || magic == NS_SWAPPED_MAGIC;
+  magic = GetMagic ();
+  if ((magic != MAGIC && magic != NS_MAGIC)
+      || GetVersionMajor () != VERSION_MAJOR || GetVersionMinor () != VERSION_MINOR
+      || GetTimeZoneOffset () < -12 || GetTimeZoneOffset () > 12)
+    {
+      Close ();
+      m_fail = true;
+    }
+}
+
+void
+PcapFileMapping::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_file.Close ();
+  m_data = 0;
+  m_size = 0;
+  m_fail = true;
+}
+
+bool
+PcapFileMapping::Fail (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_fail;
+}
+
+PcapFileMapping::Iterator
+PcapFileMapping::Begin (void) const
+{
+  NS_ASSERT (!m_fail);
+  return Iterator (m_data + FILE_HEADER_SIZE, m_data + m_size, m_swapMode);
+}
+
+PcapFileMapping::Iterator
+PcapFileMapping::End (void) const
+{
+  NS_ASSERT (!m_fail);
+  return Iterator (m_data + m_size, m_data + m_size, m_swapMode);
+}
+
+uint32_t
+PcapFileMapping::Read32 (uint32_t offset) const
+{
+  NS_ASSERT (m_data != 0);
+  return Load32 (m_data + offset, m_swapMode);
+}
+
+uint16_t
+PcapFileMapping::Read16 (uint32_t offset) const
+{
+  NS_ASSERT (m_data != 0);
+  uint16_t v;
+  std::memcpy (&v, m_data + offset, sizeof (v));
+  if (m_swapMode)
+    {
+      v = __builtin_bswap16 (v);
+    }
+  return v;
+}
+
+uint32_t
+PcapFileMapping::GetMagic (void) const
+{
+  return Read32 (0);
+}
+
+uint16_t
+PcapFileMapping::GetVersionMajor (void) const
+{
+  return Read16 (4);
+}
+
+uint16_t
+PcapFileMapping::GetVersionMinor (void) const
+{
+  return Read16 (6);
+}
+
+int32_t
+PcapFileMapping::GetTimeZoneOffset (void) const
+{
+  return Read32 (8);
+}
+
+uint32_t
+PcapFileMapping::GetSigFigs (void) const
+{
+  return Read32 (12);
+}
+
+uint32_t
+PcapFileMapping::GetSnapLen (void) const
+{
+  return Read32 (16);
+}
+
+uint32_t
+PcapFileMapping::GetDataLinkType (void) const
+{
+  return Read32 (20);
+}
+
+bool
+PcapFileMapping::GetSwapMode (void) const
+{
+  return m_swapMode;
+}
+
+bool
+PcapFileMapping::IsNanoSecMode (void) const
+{
+  return GetMagic () == NS_MAGIC;
+}
+
+} // namespace ns3
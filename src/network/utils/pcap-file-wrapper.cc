@@ -32,7 +32,7 @@ TypeId
 PcapFileWrapper::GetTypeId (void)
 {
   static TypeId tid = TypeId ("ns3::PcapFileWrapper")
-    .SetParent<Object> ()
+    .SetParent<BufferedFileWriter> ()
     .AddConstructor<PcapFileWrapper> ()
     .AddAttribute ("CaptureSize",
                    "Maximum length of captured packets (cf. pcap snaplen)",
@@ -82,6 +82,13 @@ PcapFileWrapper::Close (void)
   m_file.Close ();
 }
 
+void
+PcapFileWrapper::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_file.Flush ();
+}
+
 void
 PcapFileWrapper::Open (std::string const &filename, std::ios::openmode mode)
 {
@@ -89,6 +96,20 @@ PcapFileWrapper::Open (std::string const &filename, std::ios::openmode mode)
   m_file.Open (filename, mode);
 }
 
+void
+PcapFileWrapper::DoSetBufferSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  m_file.SetBufferSize (size);
+}
+
+void
+PcapFileWrapper::DoSetAsyncFlush (bool async)
+{
+  NS_LOG_FUNCTION (this << async);
+  m_file.SetAsyncFlush (async);
+}
+
 void
 PcapFileWrapper::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrection)
 {
@@ -27,6 +27,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "pcap-file.h"
+#include "buffered-file-writer.h"
 
 namespace ns3 {
 
@@ -36,7 +37,7 @@ namespace ns3 {
  * encouraged to use this object instead of class ns3::PcapFile in ns-3
  * public APIs.
  */
-class PcapFileWrapper : public Object
+class PcapFileWrapper : public BufferedFileWriter
 {
 public:
   /**
@@ -82,6 +83,13 @@ public:
    */
   void Close (void);
 
+  /**
+   * Write the buffered records to the underlying pcap file.
+   *
+   * \sa BufferedFileWriter
+   */
+  void Flush (void);
+
   /**
    * Initialize the pcap file associated with this wrapper.  This file must have
    * been previously opened with write permissions.
@@ -213,6 +221,10 @@ public:
   uint32_t GetDataLinkType (void);
 
 private:
+  // inherited from BufferedFileWriter
+  virtual void DoSetBufferSize (uint32_t size);
+  virtual void DoSetAsyncFlush (bool async);
+
   PcapFile m_file; //!< Pcap file
   uint32_t m_snapLen; //!< max length of saved packets
 };
@@ -20,6 +20,7 @@
 
 #include <iostream>
 #include <cstring>
+#include <algorithm>
 #include "ns3/assert.h"
 #include "ns3/packet.h"
 #include "ns3/fatal-error.h"
@@ -27,6 +28,7 @@
 #include "ns3/header.h"
 #include "ns3/buffer.h"
 #include "pcap-file.h"
+#include "pcap-file-mapping.h"
 #include "ns3/log.h"
 //
 // This file is used as part of the ns-3 test framework, so please refrain from 
@@ -48,7 +50,8 @@ const uint16_t VERSION_MINOR = 4;             /**< Minor version of supported pc
 
 PcapFile::PcapFile ()
   : m_file (),
-    m_swapMode (false)
+    m_swapMode (false),
+    m_buffer (&m_file)
 {
   NS_LOG_FUNCTION (this);
   FatalImpl::RegisterStream (&m_file);
@@ -66,18 +69,21 @@ bool
 PcapFile::Fail (void) const
 {
   NS_LOG_FUNCTION (this);
+  m_buffer.Sync ();
   return m_file.fail ();
 }
 bool 
 PcapFile::Eof (void) const
 {
   NS_LOG_FUNCTION (this);
+  m_buffer.Sync ();
   return m_file.eof ();
 }
 void 
 PcapFile::Clear (void)
 {
   NS_LOG_FUNCTION (this);
+  m_buffer.Sync ();
   m_file.clear ();
 }
 
@@ -86,9 +92,32 @@ void
 PcapFile::Close (void)
 {
   NS_LOG_FUNCTION (this);
+  m_buffer.Flush ();
   m_file.close ();
 }
 
+void
+PcapFile::SetBufferSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  m_buffer.SetSize (size);
+}
+
+void
+PcapFile::SetAsyncFlush (bool async)
+{
+  NS_LOG_FUNCTION (this << async);
+  m_buffer.SetAsync (async);
+}
+
+void
+PcapFile::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_buffer.Flush ();
+  m_file.flush ();
+}
+
 uint32_t
 PcapFile::GetMagic (void)
 {
@@ -197,6 +226,7 @@ PcapFile::WriteFileHeader (void)
   // If we're initializing the file, we need to write the pcap file header
   // at the start of the file.
   //
+  m_buffer.Flush ();
   m_file.seekp (0, std::ios::beg);
  
   //
@@ -311,6 +341,7 @@ PcapFile::Open (std::string const &filename, std::ios::openmode mode)
 {
   NS_LOG_FUNCTION (this << filename << mode);
   NS_ASSERT ((mode & std::ios::app) == 0);
+  m_buffer.Flush ();
   NS_ASSERT (!m_file.fail ());
   //
   // All pcap files are binary files, so we just do this automatically.
@@ -374,7 +405,7 @@ uint32_t
 PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << totalLen);
-  NS_ASSERT (m_file.good ());
+  NS_ASSERT (m_buffer.IsEnabled () || m_file.good ());
 
   uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
 
@@ -393,19 +424,33 @@ PcapFile::WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
   // Watch out for memory alignment differences between machines, so write
   // them all individually.
   //
-  m_file.write ((const char *)&header.m_tsSec, sizeof(header.m_tsSec));
-  m_file.write ((const char *)&header.m_tsUsec, sizeof(header.m_tsUsec));
-  m_file.write ((const char *)&header.m_inclLen, sizeof(header.m_inclLen));
-  m_file.write ((const char *)&header.m_origLen, sizeof(header.m_origLen));
+  WriteData ((const uint8_t *)&header.m_tsSec, sizeof(header.m_tsSec));
+  WriteData ((const uint8_t *)&header.m_tsUsec, sizeof(header.m_tsUsec));
+  WriteData ((const uint8_t *)&header.m_inclLen, sizeof(header.m_inclLen));
+  WriteData ((const uint8_t *)&header.m_origLen, sizeof(header.m_origLen));
   return inclLen;
 }
 
+void
+PcapFile::WriteData (uint8_t const *data, uint32_t size)
+{
+  if (m_buffer.IsEnabled ())
+    {
+      std::memcpy (m_buffer.Reserve (size), data, size);
+    }
+  else
+    {
+      m_file.write ((const char *)data, size);
+    }
+}
+
 void
 PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, uint32_t totalLen)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << &data << totalLen);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, totalLen);
-  m_file.write ((const char *)data, inclLen);
+  WriteData (data, inclLen);
+  m_buffer.Commit ();
 }
 
 void 
@@ -413,7 +458,15 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << tsSec << tsUsec << p);
   uint32_t inclLen = WritePacketHeader (tsSec, tsUsec, p->GetSize ());
-  p->CopyData (&m_file, inclLen);
+  if (m_buffer.IsEnabled ())
+    {
+      p->CopyData (m_buffer.Reserve (inclLen), inclLen);
+      m_buffer.Commit ();
+    }
+  else
+    {
+      p->CopyData (&m_file, inclLen);
+    }
 }
 
 void 
@@ -428,9 +481,19 @@ PcapFile::Write (uint32_t tsSec, uint32_t tsUsec, Header &header, Ptr<const Pack
   headerBuffer.AddAtStart (headerSize);
   header.Serialize (headerBuffer.Begin ());
   uint32_t toCopy = std::min (headerSize, inclLen);
-  headerBuffer.CopyData (&m_file, toCopy);
-  inclLen -= toCopy;
-  p->CopyData (&m_file, inclLen);
+  if (m_buffer.IsEnabled ())
+    {
+      headerBuffer.CopyData (m_buffer.Reserve (toCopy), toCopy);
+      inclLen -= toCopy;
+      p->CopyData (m_buffer.Reserve (inclLen), inclLen);
+      m_buffer.Commit ();
+    }
+  else
+    {
+      headerBuffer.CopyData (&m_file, toCopy);
+      inclLen -= toCopy;
+      p->CopyData (&m_file, inclLen);
+    }
 }
 
 void
@@ -444,6 +507,7 @@ PcapFile::Read (
   uint32_t &readLen)
 {
   NS_LOG_FUNCTION (this << &data <<maxBytes << tsSec << tsUsec << inclLen << origLen << readLen);
+  m_buffer.Flush ();
   NS_ASSERT (m_file.good ());
 
   PcapRecordHeader header;
@@ -498,75 +562,64 @@ PcapFile::Diff (std::string const & f1, std::string const & f2,
                 uint32_t snapLen)
 {
   NS_LOG_FUNCTION (f1 << f2 << sec << usec << snapLen);
-  PcapFile pcap1, pcap2;
-  pcap1.Open (f1, std::ios::in);
-  pcap2.Open (f2, std::ios::in);
+  PcapFileMapping pcap1, pcap2;
+  pcap1.Open (f1);
+  pcap2.Open (f2);
   bool bad = pcap1.Fail () || pcap2.Fail ();
   if (bad)
     {
       return true;
     }
 
-  uint8_t *data1 = new uint8_t [snapLen] ();
-  uint8_t *data2 = new uint8_t [snapLen] ();
+  //
+  // The records are compared where they are mapped, without copying them.
+  // A record truncated by the end of a file ends it.
+  //
+  PcapFileMapping::Iterator i1 = pcap1.Begin ();
+  PcapFileMapping::Iterator i2 = pcap2.Begin ();
+  PcapFileMapping::Iterator end1 = pcap1.End ();
+  PcapFileMapping::Iterator end2 = pcap2.End ();
   uint32_t tsSec1 = 0;
-  uint32_t tsSec2 = 0;
   uint32_t tsUsec1 = 0;
-  uint32_t tsUsec2 = 0;
-  uint32_t inclLen1 = 0;
-  uint32_t inclLen2 = 0;
-  uint32_t origLen1 = 0;
-  uint32_t origLen2 = 0;
-  uint32_t readLen1 = 0;
-  uint32_t readLen2 = 0;
   bool diff = false;
 
-  while (!pcap1.Eof () && !pcap2.Eof ())
+  for (; i1 != end1 && i2 != end2; ++i1, ++i2)
     {
-      pcap1.Read (data1, snapLen, tsSec1, tsUsec1, inclLen1, origLen1, readLen1);
-      pcap2.Read (data2, snapLen, tsSec2, tsUsec2, inclLen2, origLen2, readLen2);
-
-      bool same = pcap1.Fail () == pcap2.Fail ();
-      if (!same)
-        {
-          diff = true;
-          break;
-        }
-      if (pcap1.Eof ())
-        {
-          break;
-        }
+      tsSec1 = i1->GetTsSec ();
+      tsUsec1 = i1->GetTsUsec ();
 
-      if (tsSec1 != tsSec2 || tsUsec1 != tsUsec2)
+      if (tsSec1 != i2->GetTsSec () || tsUsec1 != i2->GetTsUsec ())
         {
           diff = true; // Next packet timestamps do not match
           break;
         }
 
+      uint32_t readLen1 = std::min (snapLen, i1->GetInclLen ());
+      uint32_t readLen2 = std::min (snapLen, i2->GetInclLen ());
       if (readLen1 != readLen2)
         {
           diff = true; // Packet lengths do not match
           break;
         }
 
-      if (std::memcmp (data1, data2, readLen1) != 0)
+      if (std::memcmp (i1->GetData (), i2->GetData (), readLen1) != 0)
         {
           diff = true; // Packet data do not match
           break;
         }
     }
-  sec = tsSec1;
-  usec = tsUsec1;
 
-  bad = pcap1.Fail () || pcap2.Fail ();
-  bool eof = pcap1.Eof () && pcap2.Eof ();
-  if (bad && !eof)
+  if (!diff && (i1 != end1 || i2 != end2))
     {
-      diff = true;
+      diff = true; // One of the files has more packets
+      if (i1 != end1)
+        {
+          tsSec1 = i1->GetTsSec ();
+          tsUsec1 = i1->GetTsUsec ();
+        }
     }
-
-  delete[] data1;
-  delete[] data2;
+  sec = tsSec1;
+  usec = tsUsec1;
 
   return diff;
 }
@@ -25,6 +25,7 @@
 #include <fstream>
 #include <stdint.h>
 #include "ns3/ptr.h"
+#include "file-write-buffer.h"
 
 namespace ns3 {
 
@@ -149,6 +150,30 @@ public:
    */
   void Write (uint32_t tsSec, uint32_t tsUsec, Header &header, Ptr<const Packet> p);
 
+  /**
+   * \brief Buffer the records written to the file
+   *
+   * Records are serialized in a buffer of the given size, which is
+   * written to the file when full, when the file is closed and when
+   * Flush is called. By default, records are written through.
+   *
+   * \param size the size of the buffer, in bytes; 0 disables buffering
+   */
+  void SetBufferSize (uint32_t size);
+  /**
+   * \brief Write the full buffers from a background I/O thread
+   *
+   * This thread is shared by all the files of the program. It is not
+   * used if threads are not supported.
+   *
+   * \param async true to write from the I/O thread
+   */
+  void SetAsyncFlush (bool async);
+  /**
+   * \brief Write the buffered records to the file and wait until they
+   * are written
+   */
+  void Flush (void);
 
   /**
    * \brief Read next packet from file
@@ -264,6 +289,9 @@ public:
   /**
    * \brief Compare two PCAP files packet-by-packet
    * 
+   * The files are mapped in memory by PcapFileMapping, and their records
+   * compared in place.
+   *
    * \return true if files are different, false otherwise
    * 
    * \param  f1         First PCAP file name
@@ -343,6 +371,13 @@ private:
    * \returns the length of the packet to write in the Pcap file
    */
   uint32_t WritePacketHeader (uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen);
+  /**
+   * \brief Write record data to the buffer, or to the file if
+   * records are not buffered
+   * \param data the data
+   * \param size the size of the data
+   */
+  void WriteData (uint8_t const *data, uint32_t size);
 
   /**
    * \brief Read and verify a Pcap file header
@@ -353,6 +388,7 @@ private:
   std::fstream   m_file;        //!< file stream
   PcapFileHeader m_fileHeader;  //!< file header
   bool m_swapMode;              //!< swap mode
+  FileWriteBuffer m_buffer;     //!< buffer of the records written
 };
 
 } // namespace ns3
@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pcapng-file-wrapper.h"
+#include "pcap-file.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-impl.h"
+#include "ns3/packet.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PcapngFileWrapper");
+
+NS_OBJECT_ENSURE_REGISTERED (PcapngFileWrapper);
+
+namespace {
+
+const uint32_t SECTION_HEADER_BLOCK = 0x0a0d0d0a;   //!< Section header block type
+const uint32_t INTERFACE_BLOCK = 0x00000001;        //!< Interface description block type
+const uint32_t ENHANCED_PACKET_BLOCK = 0x00000006;  //!< Enhanced packet block type
+const uint32_t BYTE_ORDER_MAGIC = 0x1a2b3c4d;       //!< Byte order of the section
+const uint16_t OPTION_END = 0;                      //!< opt_endofopt
+const uint16_t OPTION_IF_NAME = 2;                  //!< if_name
+const uint16_t OPTION_IF_TSRESOL = 9;               //!< if_tsresol
+const uint8_t TSRESOL_NS = 9;                       //!< timestamps in 10^-9 s
+
+/// \returns size rounded up to a multiple of 4
+inline uint32_t
+Pad32 (uint32_t size)
+{
+  return (size + 3) & ~3;
+}
+
+} // anonymous namespace
+
+TypeId 
+PcapngFileWrapper::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::PcapngFileWrapper")
+    .SetParent<BufferedFileWriter> ()
+    .AddConstructor<PcapngFileWrapper> ()
+    .AddAttribute ("CaptureSize",
+                   "Default maximum length of captured packets (cf. pcap snaplen)",
+                   UintegerValue (PcapFile::SNAPLEN_DEFAULT),
+                   MakeUintegerAccessor (&PcapngFileWrapper::m_snapLen),
+                   MakeUintegerChecker<uint32_t> (1, PcapFile::SNAPLEN_DEFAULT))
+  ;
+  return tid;
+}
+
+PcapngFileWrapper::PcapngFileWrapper ()
+  : m_buffer (&m_file)
+{
+  NS_LOG_FUNCTION (this);
+  FatalImpl::RegisterStream (&m_file);
+}
+
+PcapngFileWrapper::~PcapngFileWrapper ()
+{
+  NS_LOG_FUNCTION (this);
+  FatalImpl::UnregisterStream (&m_file);
+  Close ();
+}
+
+bool
+PcapngFileWrapper::Fail (void) const
+{
+  NS_LOG_FUNCTION (this);
+  m_buffer.Sync ();
+  return m_file.fail ();
+}
+
+void
+PcapngFileWrapper::Open (std::string const &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  Close ();
+  m_snapLens.clear ();
+  m_file.open (filename.c_str (), std::ios::out | std::ios::trunc | std::ios::binary);
+
+  uint8_t *buffer = m_buffer.Reserve (28);
+  buffer = Append32 (SECTION_HEADER_BLOCK, buffer);
+  buffer = Append32 (28, buffer);
+  buffer = Append32 (BYTE_ORDER_MAGIC, buffer);
+  uint16_t version[2] = { 1, 0 };
+  std::memcpy (buffer, version, 4);
+  buffer += 4;
+  // unspecified section length
+  buffer = Append32 (0xffffffff, buffer);
+  buffer = Append32 (0xffffffff, buffer);
+  Append32 (28, buffer);
+  m_buffer.Commit ();
+}
+
+void
+PcapngFileWrapper::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_buffer.Flush ();
+  m_file.close ();
+}
+
+void
+PcapngFileWrapper::DoSetBufferSize (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  m_buffer.SetSize (size);
+}
+
+void
+PcapngFileWrapper::DoSetAsyncFlush (bool async)
+{
+  NS_LOG_FUNCTION (this << async);
+  m_buffer.SetAsync (async);
+}
+
+void
+PcapngFileWrapper::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_buffer.Flush ();
+  m_file.flush ();
+}
+
+uint32_t
+PcapngFileWrapper::AddInterface (uint32_t dataLinkType, std::string const &name, uint32_t snapLen)
+{
+  NS_LOG_FUNCTION (this << dataLinkType << name << snapLen);
+  if (snapLen == 0)
+    {
+      snapLen = m_snapLen;
+    }
+  uint32_t nameSize = name.size ();
+  // block header, name, resolution and end options, block trailer
+  uint32_t size = 16 + (nameSize > 0 ? 4 + Pad32 (nameSize) : 0) + 8 + 4 + 4;
+  uint8_t *buffer = m_buffer.Reserve (size);
+  std::memset (buffer, 0, size);
+  buffer = Append32 (INTERFACE_BLOCK, buffer);
+  buffer = Append32 (size, buffer);
+  uint16_t linkType[2] = { static_cast<uint16_t> (dataLinkType), 0 };
+  std::memcpy (buffer, linkType, 4);
+  buffer += 4;
+  buffer = Append32 (snapLen, buffer);
+  uint16_t option[2] = { OPTION_IF_NAME, static_cast<uint16_t> (nameSize) };
+  if (nameSize > 0)
+    {
+      std::memcpy (buffer, option, 4);
+      std::memcpy (buffer + 4, name.data (), nameSize);
+      buffer += 4 + Pad32 (nameSize);
+    }
+  option[0] = OPTION_IF_TSRESOL;
+  option[1] = 1;
+  std::memcpy (buffer, option, 4);
+  buffer[4] = TSRESOL_NS;
+  buffer += 8;
+  option[0] = OPTION_END;
+  option[1] = 0;
+  std::memcpy (buffer, option, 4);
+  buffer += 4;
+  Append32 (size, buffer);
+  m_buffer.Commit ();
+
+  m_snapLens.push_back (snapLen);
+  return m_snapLens.size () - 1;
+}
+
+uint32_t
+PcapngFileWrapper::GetNInterfaces (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_snapLens.size ();
+}
+
+void
+PcapngFileWrapper::Write (uint32_t interface, Time t, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << interface << t << p);
+  NS_ASSERT (interface < m_snapLens.size ());
+  uint32_t origLen = p->GetSize ();
+  uint32_t inclLen = std::min (origLen, m_snapLens[interface]);
+  uint32_t size = 28 + Pad32 (inclLen) + 4;
+  uint64_t ts = t.GetNanoSeconds ();
+
+  uint8_t *buffer = m_buffer.Reserve (size);
+  buffer = Append32 (ENHANCED_PACKET_BLOCK, buffer);
+  buffer = Append32 (size, buffer);
+  buffer = Append32 (interface, buffer);
+  buffer = Append32 (ts >> 32, buffer);
+  buffer = Append32 (ts & 0xffffffff, buffer);
+  buffer = Append32 (inclLen, buffer);
+  buffer = Append32 (origLen, buffer);
+  p->CopyData (buffer, inclLen);
+  buffer += inclLen;
+  for (uint32_t i = inclLen; i < Pad32 (inclLen); i++)
+    {
+      *buffer++ = 0;
+    }
+  Append32 (size, buffer);
+  m_buffer.Commit ();
+}
+
+uint8_t *
+PcapngFileWrapper::Append32 (uint32_t value, uint8_t *buffer)
+{
+  std::memcpy (buffer, &value, 4);
+  return buffer + 4;
+}
+
+} // namespace ns3
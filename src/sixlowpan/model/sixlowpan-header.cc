@@ -778,6 +778,7 @@ SixLowPanIphc::SixLowPanIphc ()
 {
   // 011x xxxx xxxx xxxx
   m_baseFormat = 0x6000;
+  m_srcdstContextId = 0;
 }
 
 SixLowPanIphc::SixLowPanIphc (uint8_t dispatch)
@@ -785,6 +786,7 @@ SixLowPanIphc::SixLowPanIphc (uint8_t dispatch)
   // 011x xxxx xxxx xxxx
   m_baseFormat = dispatch;
   m_baseFormat <<= 8;
+  m_srcdstContextId = 0;
 }
 
 TypeId SixLowPanIphc::GetTypeId (void)
@@ -1448,13 +1450,17 @@ Ipv6Address SixLowPanIphc::GetDstAddress () const
 
 void SixLowPanIphc::PostProcessSac ()
 {
-  NS_ABORT_MSG ("Unsupported; Context destination is not implemented");
+  // The context prefix is not known here, SixLowPanNetDevice completes the address.
+  if ( GetSam () == HC_INLINE )
+    {
+      m_srcAddress = Ipv6Address::GetAny ();
+    }
   return;
 }
 
 void SixLowPanIphc::PostProcessDac ()
 {
-  NS_ABORT_MSG ("Unsupported; Context destination is not implemented");
+  // The context prefix is not known here, SixLowPanNetDevice completes the address.
   return;
 }
 
@@ -927,12 +927,12 @@ private:
 
   /**
    * \brief Post-process the Source address stateful compression
-   * \note currently unsupported
+   * \note the context prefix is added by SixLowPanNetDevice
    */
   void PostProcessSac ();
   /**
    * \brief Post-process the Destination address stateful compression
-   * \note currently unsupported
+   * \note the context prefix is added by SixLowPanNetDevice
    */
   void PostProcessDac ();
 
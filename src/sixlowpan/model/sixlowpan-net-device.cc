@@ -19,6 +19,8 @@
  *         Michele Muccio <michelemuccio@virgilio.it>
  */
 
+#include <algorithm>
+
 #include "ns3/node.h"
 #include "ns3/channel.h"
 #include "ns3/packet.h"
@@ -33,7 +35,12 @@
 #include "ns3/mac48-address.h"
 #include "ns3/mac64-address.h"
 #include "ns3/unused.h"
+#include "ns3/hash.h"
 #include "ns3/ipv6-l3-protocol.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6-routing-protocol.h"
+#include "ns3/ndisc-cache.h"
 #include "ns3/ipv6-extension-header.h"
 #include "ns3/udp-header.h"
 #include "ns3/udp-l4-protocol.h"
@@ -64,6 +71,18 @@ TypeId SixLowPanNetDevice::GetTypeId (void)
                    UintegerValue (0),
                    MakeUintegerAccessor (&SixLowPanNetDevice::m_fragmentReassemblyListSize),
                    MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("FragmentReassemblyMemory",
+                   "The maximum number of bytes held in the reassembly buffer. "
+                   "When exceeded, the least recently used fragment sets are dropped. Zero meaning infinite.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&SixLowPanNetDevice::m_fragmentReassemblyMemory),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("FragmentForwarding",
+                   "Forward the fragments of packets not addressed to this node hop-by-hop, "
+                   "without reassembling them.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SixLowPanNetDevice::m_fragmentForwarding),
+                   MakeBooleanChecker ())
     .AddAttribute ("FragmentExpirationTimeout",
                    "When this timeout expires, the fragments will be cleared from the buffer.",
                    TimeValue (Seconds (60)),
@@ -74,6 +93,11 @@ TypeId SixLowPanNetDevice::GetTypeId (void)
                    UintegerValue (0x0),
                    MakeUintegerAccessor (&SixLowPanNetDevice::m_compressionThreshold),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("IphcCacheSize",
+                   "The number of per-flow IPHC address encodings kept in cache. Zero disables the cache.",
+                   UintegerValue (16),
+                   MakeUintegerAccessor (&SixLowPanNetDevice::m_iphcCacheSize),
+                   MakeUintegerChecker<uint32_t> ())
     .AddAttribute ("ForceEtherType",
                    "Force a specific EtherType in L2 frames.",
                    BooleanValue (false),
@@ -90,6 +114,8 @@ TypeId SixLowPanNetDevice::GetTypeId (void)
                      MakeTraceSourceAccessor (&SixLowPanNetDevice::m_rxTrace))
     .AddTraceSource ("Drop", "Drop - DropReason, packet (including 6LoWPAN header), SixLoWPanNetDevice Ptr, interface index.",
                      MakeTraceSourceAccessor (&SixLowPanNetDevice::m_dropTrace))
+    .AddTraceSource ("Reassembly", "Reassembly - latency since the first fragment, SixLoWPanNetDevice Ptr, interface index.",
+                     MakeTraceSourceAccessor (&SixLowPanNetDevice::m_reassemblyTrace))
   ;
   return tid;
 }
@@ -101,6 +127,10 @@ SixLowPanNetDevice::SixLowPanNetDevice ()
 {
   NS_LOG_FUNCTION (this);
   m_netDevice = 0;
+  m_fragmentStoredBytes = 0;
+  m_reassembledDatagrams = 0;
+  m_evictedDatagrams = 0;
+  m_forwardedFragments = 0;
   m_rng = CreateObject<UniformRandomVariable> ();
 }
 
@@ -134,24 +164,61 @@ int64_t SixLowPanNetDevice::AssignStreams (int64_t stream)
   return 1;
 }
 
-void SixLowPanNetDevice::DoDispose ()
+uint32_t SixLowPanNetDevice::GetReassembledDatagrams (void) const
 {
   NS_LOG_FUNCTION (this);
+  return m_reassembledDatagrams;
+}
 
-  m_netDevice = 0;
-  m_node = 0;
+uint32_t SixLowPanNetDevice::GetEvictedDatagrams (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_evictedDatagrams;
+}
 
-  for (MapFragmentsTimersI_t iter = m_fragmentsTimers.begin (); iter != m_fragmentsTimers.end (); iter++)
+Time SixLowPanNetDevice::GetAverageReassemblyLatency (void) const
+{
+  NS_LOG_FUNCTION (this);
+  if (m_reassembledDatagrams == 0)
     {
-      iter->second.Cancel ();
+      return Seconds (0);
     }
-  m_fragmentsTimers.clear ();
+  return m_reassemblyLatency / m_reassembledDatagrams;
+}
+
+uint32_t SixLowPanNetDevice::GetReassemblyBufferSize (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_fragmentStoredBytes;
+}
+
+uint32_t SixLowPanNetDevice::GetForwardedFragments (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_forwardedFragments;
+}
+
+void SixLowPanNetDevice::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_netDevice = 0;
+  m_node = 0;
 
   for (MapFragmentsI_t iter = m_fragments.begin (); iter != m_fragments.end (); iter++)
     {
+      iter->second->GetTimeoutEvent ().Cancel ();
       iter->second = 0;
     }
   m_fragments.clear ();
+  m_fragmentsLru.clear ();
+  m_fragmentStoredBytes = 0;
+
+  for (MapForwarding_t::iterator iter = m_forwarding.begin (); iter != m_forwarding.end (); iter++)
+    {
+      iter->second.m_timeout.Cancel ();
+    }
+  m_forwarding.clear ();
 
   NetDevice::DoDispose ();
 }
@@ -181,6 +248,15 @@ void SixLowPanNetDevice::ReceiveFromDevice (Ptr<NetDevice> incomingPort,
   NS_LOG_DEBUG ( "Packet length: " << copyPkt->GetSize () );
   NS_LOG_DEBUG ( "Dispatches: " << int(dispatchRawVal) << " - " << int(dispatchVal) );
 
+  if ( m_fragmentForwarding
+       && (dispatchVal == SixLowPanDispatch::LOWPAN_FRAG1 || dispatchVal == SixLowPanDispatch::LOWPAN_FRAGN) )
+    {
+      if ( ForwardFragment (copyPkt, src, dst, protocol, dispatchVal == SixLowPanDispatch::LOWPAN_FRAG1) )
+        {
+          return;
+        }
+    }
+
   if ( dispatchVal == SixLowPanDispatch::LOWPAN_FRAG1 )
     {
       isPktDecompressed = ProcessFragment (copyPkt, src, dst, true);
@@ -825,152 +901,404 @@ SixLowPanNetDevice::CompressLowPanIphc (Ptr<Packet> packet, Address const &src,
 
 
       // Set the HLIM field
-      if (ipHeader.GetHopLimit () == 1)
-        {
-          iphcHeader.SetHlim (SixLowPanIphc::HLIM_COMPR_1);
-        }
-      else if (ipHeader.GetHopLimit () == 0x40)
+      SetIphcHopLimit (iphcHeader, ipHeader.GetHopLimit ());
+
+      SetIphcAddresses (iphcHeader, ipHeader.GetSourceAddress (), ipHeader.GetDestinationAddress (), src, dst);
+
+      NS_LOG_DEBUG ("IPHC Compression - IPHC header size = " << iphcHeader.GetSerializedSize () );
+      NS_LOG_DEBUG ("IPHC Compression - packet size = " << packet->GetSize () );
+
+      packet->AddHeader (iphcHeader);
+
+      NS_LOG_DEBUG ("Packet after IPHC compression: " << *packet);
+
+      return size;
+    }
+
+  return 0;
+}
+
+void
+SixLowPanNetDevice::SetIphcHopLimit (SixLowPanIphc &iphcHeader, uint8_t hopLimit)
+{
+  NS_LOG_FUNCTION (this << int (hopLimit));
+
+  if (hopLimit == 1)
+    {
+      iphcHeader.SetHlim (SixLowPanIphc::HLIM_COMPR_1);
+    }
+  else if (hopLimit == 0x40)
+    {
+      iphcHeader.SetHlim (SixLowPanIphc::HLIM_COMPR_64);
+    }
+  else if (hopLimit == 0xFF)
+    {
+      iphcHeader.SetHlim (SixLowPanIphc::HLIM_COMPR_255);
+    }
+  else
+    {
+      iphcHeader.SetHlim (SixLowPanIphc::HLIM_INLINE);
+      // Set the HopLimit
+      iphcHeader.SetHopLimit (hopLimit);
+    }
+}
+
+void
+SixLowPanNetDevice::SetIphcAddresses (SixLowPanIphc &iphcHeader, Ipv6Address srcAddr, Ipv6Address dstAddr,
+                                      Address const &src, Address const &dst)
+{
+  NS_LOG_FUNCTION (this << srcAddr << dstAddr << src << dst);
+
+  iphcHeader.SetSrcAddress (srcAddr);
+  iphcHeader.SetDstAddress (dstAddr);
+
+  // The encoding only depends on the address pairs, reuse the last one computed for this flow.
+  IphcCacheEntry computed;
+  IphcCacheEntry *encoding = &computed;
+  if (m_iphcCacheSize)
+    {
+      if (m_iphcCache.size () != m_iphcCacheSize)
         {
-          iphcHeader.SetHlim (SixLowPanIphc::HLIM_COMPR_64);
+          m_iphcCache.assign (m_iphcCacheSize, IphcCacheEntry ());
         }
-      else if (ipHeader.GetHopLimit () == 0xFF)
+
+      uint8_t buf[2 * 16 + 2 * (Address::MAX_SIZE + 2)];
+      srcAddr.Serialize (buf);
+      dstAddr.Serialize (buf + 16);
+      uint32_t len = 32;
+      len += src.CopyAllTo (buf + len, Address::MAX_SIZE + 2);
+      len += dst.CopyAllTo (buf + len, Address::MAX_SIZE + 2);
+
+      IphcCacheEntry &slot = m_iphcCache[Hash32 (reinterpret_cast<char *> (buf), len) % m_iphcCacheSize];
+      if (slot.m_valid && slot.m_srcAddr == srcAddr && slot.m_dstAddr == dstAddr
+          && slot.m_src == src && slot.m_dst == dst)
         {
-          iphcHeader.SetHlim (SixLowPanIphc::HLIM_COMPR_255);
+          NS_LOG_LOGIC ("IPHC encoding cache hit");
+          encoding = &slot;
         }
       else
         {
-          iphcHeader.SetHlim (SixLowPanIphc::HLIM_INLINE);
-          // Set the HopLimit
-          iphcHeader.SetHopLimit (ipHeader.GetHopLimit ());
+          ComputeIphcAddressModes (slot, srcAddr, dstAddr, src, dst);
+          encoding = &slot;
         }
+    }
+  else
+    {
+      ComputeIphcAddressModes (computed, srcAddr, dstAddr, src, dst);
+    }
+
+  iphcHeader.SetSac (encoding->m_sac);
+  iphcHeader.SetSam (encoding->m_sam);
+  iphcHeader.SetM (encoding->m_m);
+  iphcHeader.SetDac (encoding->m_dac);
+  iphcHeader.SetDam (encoding->m_dam);
 
-      // \todo Add the check of CID if there is context-based compression
-      // Set the CID field
+  // Context 0 is implied when the CID extension is not present.
+  if (encoding->m_srcContextId || encoding->m_dstContextId)
+    {
+      iphcHeader.SetCid (true);
+      iphcHeader.SetSrcContextId (encoding->m_srcContextId);
+      iphcHeader.SetDstContextId (encoding->m_dstContextId);
+    }
+  else
+    {
       iphcHeader.SetCid (false);
+    }
+}
+
+bool
+SixLowPanNetDevice::LookupCompressionContext (Ipv6Address addr, uint8_t &contextId)
+{
+  NS_LOG_FUNCTION (this << addr);
 
-      // \todo Add the check of SAC if there is context-based compression
-      // Set the SAC field
-      iphcHeader.SetSac (false);
+  uint8_t addressBuf[16];
+  uint8_t prefixBuf[16];
+  addr.GetBytes (addressBuf);
 
-      uint8_t addressBuf[16];
-      uint8_t unicastAddrCheckerBuf[16];
-      Ipv6Address srcAddr = ipHeader.GetSourceAddress ();
-      srcAddr.GetBytes (addressBuf);
+  for (ContextTable_t::const_iterator it = m_contextTable.begin (); it != m_contextTable.end (); it++)
+    {
+      if (!it->second.m_compressionAllowed)
+        {
+          continue;
+        }
+      it->second.m_prefix.GetBytes (prefixBuf);
+      if (memcmp (addressBuf, prefixBuf, 8) == 0)
+        {
+          contextId = it->first;
+          return true;
+        }
+    }
+  return false;
+}
 
-      Ipv6Address checker = Ipv6Address ("fe80:0000:0000:0000:0000:00ff:fe00:1");
-      checker.GetBytes (unicastAddrCheckerBuf);
+void
+SixLowPanNetDevice::ComputeIphcAddressModes (IphcCacheEntry &encoding, Ipv6Address srcAddr, Ipv6Address dstAddr,
+                                             Address const &src, Address const &dst)
+{
+  NS_LOG_FUNCTION (this << srcAddr << dstAddr << src << dst);
 
-      // \todo Add the check of SAC if there is context-based compression
-      // Set the Source Address
-      iphcHeader.SetSrcAddress (srcAddr);
+  encoding.m_valid = true;
+  encoding.m_srcAddr = srcAddr;
+  encoding.m_dstAddr = dstAddr;
+  encoding.m_src = src;
+  encoding.m_dst = dst;
+  encoding.m_sac = false;
+  encoding.m_dac = false;
+  encoding.m_srcContextId = 0;
+  encoding.m_dstContextId = 0;
 
-      Ipv6Address mySrcAddr = MakeLinkLocalAddressFromMac (src);
-      NS_LOG_LOGIC ("Checking source compression: " << mySrcAddr << " - " << srcAddr );
+  uint8_t addressBuf[16];
+  uint8_t unicastAddrCheckerBuf[16];
+  srcAddr.GetBytes (addressBuf);
+
+  Ipv6Address checker = Ipv6Address ("fe80:0000:0000:0000:0000:00ff:fe00:1");
+  checker.GetBytes (unicastAddrCheckerBuf);
+
+  // Set the Source Address
+  Ipv6Address mySrcAddr = MakeLinkLocalAddressFromMac (src);
+  NS_LOG_LOGIC ("Checking source compression: " << mySrcAddr << " - " << srcAddr );
+
+  uint8_t contextId;
+  if ( srcAddr.IsAny () )
+    {
+      encoding.m_sac = true;
+      encoding.m_sam = SixLowPanIphc::HC_INLINE;
+    }
+  else if ( mySrcAddr == srcAddr )
+    {
+      encoding.m_sam = SixLowPanIphc::HC_COMPR_0;
+    }
+  else if (memcmp (addressBuf, unicastAddrCheckerBuf, 14) == 0)
+    {
+      encoding.m_sam = SixLowPanIphc::HC_COMPR_16;
+    }
+  else if ( srcAddr.IsLinkLocal () )
+    {
+      encoding.m_sam = SixLowPanIphc::HC_COMPR_64;
+    }
+  else if ( LookupCompressionContext (srcAddr, contextId) )
+    {
+      encoding.m_sac = true;
+      encoding.m_srcContextId = contextId;
+      if ( MakeContextAddress (contextId, mySrcAddr) == srcAddr )
+        {
+          encoding.m_sam = SixLowPanIphc::HC_COMPR_0;
+        }
+      else if (memcmp (addressBuf + 8, unicastAddrCheckerBuf + 8, 6) == 0)
+        {
+          encoding.m_sam = SixLowPanIphc::HC_COMPR_16;
+        }
+      else
+        {
+          encoding.m_sam = SixLowPanIphc::HC_COMPR_64;
+        }
+    }
+  else
+    {
+      encoding.m_sam = SixLowPanIphc::HC_INLINE;
+    }
+
+  // Set the M field
+  encoding.m_m = dstAddr.IsMulticast ();
 
-      if ( mySrcAddr == srcAddr )
+  dstAddr.GetBytes (addressBuf);
+
+  // Set the Destination Address
+  Ipv6Address myDstAddr = MakeLinkLocalAddressFromMac (dst);
+  NS_LOG_LOGIC ("Checking destination compression: " << myDstAddr << " - " << dstAddr );
+
+  if ( !encoding.m_m )
+  // Unicast address
+    {
+      if ( myDstAddr == dstAddr )
         {
-          iphcHeader.SetSam (SixLowPanIphc::HC_COMPR_0);
+          encoding.m_dam = SixLowPanIphc::HC_COMPR_0;
         }
       else if (memcmp (addressBuf, unicastAddrCheckerBuf, 14) == 0)
         {
-          iphcHeader.SetSam (SixLowPanIphc::HC_COMPR_16);
+          encoding.m_dam = SixLowPanIphc::HC_COMPR_16;
         }
-      else if ( srcAddr.IsLinkLocal () )
+      else if ( dstAddr.IsLinkLocal () )
         {
-          iphcHeader.SetSam (SixLowPanIphc::HC_COMPR_64);
+          encoding.m_dam = SixLowPanIphc::HC_COMPR_64;
+        }
+      else if ( LookupCompressionContext (dstAddr, contextId) )
+        {
+          encoding.m_dac = true;
+          encoding.m_dstContextId = contextId;
+          if ( MakeContextAddress (contextId, myDstAddr) == dstAddr )
+            {
+              encoding.m_dam = SixLowPanIphc::HC_COMPR_0;
+            }
+          else if (memcmp (addressBuf + 8, unicastAddrCheckerBuf + 8, 6) == 0)
+            {
+              encoding.m_dam = SixLowPanIphc::HC_COMPR_16;
+            }
+          else
+            {
+              encoding.m_dam = SixLowPanIphc::HC_COMPR_64;
+            }
         }
       else
         {
-          iphcHeader.SetSam (SixLowPanIphc::HC_INLINE);
+          encoding.m_dam = SixLowPanIphc::HC_INLINE;
         }
+    }
+  else
+    {
+      // Multicast address
+      uint8_t multicastAddrCheckerBuf[16];
+      Ipv6Address multicastCheckAddress = Ipv6Address ("ff02::1");
+      multicastCheckAddress.GetBytes (multicastAddrCheckerBuf);
 
-      // Set the M field
-      if (ipHeader.GetDestinationAddress ().IsMulticast ())
+      // The address takes the form ff02::00XX.
+      if ( memcmp (addressBuf, multicastAddrCheckerBuf, 15) == 0 )
+        {
+          encoding.m_dam = SixLowPanIphc::HC_COMPR_0;
+        }
+      // The address takes the form ffXX::00XX:XXXX.
+      //                            ffXX:0000:0000:0000:0000:0000:00XX:XXXX.
+      else if ( (addressBuf[0] == multicastAddrCheckerBuf[0])
+                && (memcmp (addressBuf + 2, multicastAddrCheckerBuf + 2, 11) == 0) )
         {
-          iphcHeader.SetM (true);
+          encoding.m_dam = SixLowPanIphc::HC_COMPR_16;
+        }
+      // The address takes the form ffXX::00XX:XXXX:XXXX.
+      //                            ffXX:0000:0000:0000:0000:00XX:XXXX:XXXX.
+      else if ( (addressBuf[0] == multicastAddrCheckerBuf[0])
+                && (memcmp (addressBuf + 2, multicastAddrCheckerBuf + 2, 9) == 0) )
+        {
+          encoding.m_dam = SixLowPanIphc::HC_COMPR_64;
         }
       else
         {
-          iphcHeader.SetM (false);
+          encoding.m_dam = SixLowPanIphc::HC_INLINE;
         }
+    }
+}
 
-      // \todo Add the check of DAC if there is context-based compression
-      // Set the DAC field
-      iphcHeader.SetDac (false);
+Ipv6Address
+SixLowPanNetDevice::MakeContextAddress (uint8_t contextId, Ipv6Address iid)
+{
+  NS_LOG_FUNCTION (this << int (contextId) << iid);
 
-      Ipv6Address dstAddr = ipHeader.GetDestinationAddress ();
-      dstAddr.GetBytes (addressBuf);
+  ContextTable_t::const_iterator it = m_contextTable.find (contextId);
+  NS_ABORT_MSG_IF (it == m_contextTable.end (), "Unknown 6LoWPAN context " << int (contextId));
 
-      // \todo Add the check of DAC if there is context-based compression
-      // Set the Destination Address
-      iphcHeader.SetDstAddress (dstAddr);
+  uint8_t addressBuf[16];
+  uint8_t prefixBuf[16];
+  iid.GetBytes (addressBuf);
+  it->second.m_prefix.GetBytes (prefixBuf);
+  memcpy (addressBuf, prefixBuf, 8);
 
-      Ipv6Address myDstAddr = MakeLinkLocalAddressFromMac (dst);
-      NS_LOG_LOGIC ("Checking destination compression: " << myDstAddr << " - " << dstAddr );
+  return Ipv6Address (addressBuf);
+}
+
+Ipv6Address
+SixLowPanNetDevice::DecompressIphcSrcAddress (SixLowPanIphc const &encoding, Address const &src)
+{
+  NS_LOG_FUNCTION (this << src);
 
-      if ( !iphcHeader.GetM () )
-      // Unicast address
+  if ( encoding.GetSac () )
+    {
+      if ( encoding.GetSam () == SixLowPanIphc::HC_INLINE )
         {
-          if ( myDstAddr == dstAddr )
-            {
-              iphcHeader.SetDam (SixLowPanIphc::HC_COMPR_0);
-            }
-          else if (memcmp (addressBuf, unicastAddrCheckerBuf, 14) == 0)
-            {
-              iphcHeader.SetDam (SixLowPanIphc::HC_COMPR_16);
-            }
-          else if ( dstAddr.IsLinkLocal () )
-            {
-              iphcHeader.SetDam (SixLowPanIphc::HC_COMPR_64);
-            }
-          else
-            {
-              iphcHeader.SetDam (SixLowPanIphc::HC_INLINE);
-            }
+          return Ipv6Address::GetAny ();
         }
-      else
+      if ( encoding.GetSam () == SixLowPanIphc::HC_COMPR_0 )
         {
-          // Multicast address
-          uint8_t multicastAddrCheckerBuf[16];
-          Ipv6Address multicastCheckAddress = Ipv6Address ("ff02::1");
-          multicastCheckAddress.GetBytes (multicastAddrCheckerBuf);
+          return MakeContextAddress (encoding.GetSrcContextId (), MakeLinkLocalAddressFromMac (src));
+        }
+      return MakeContextAddress (encoding.GetSrcContextId (), encoding.GetSrcAddress ());
+    }
+  if ( encoding.GetSam () == SixLowPanIphc::HC_COMPR_0 )
+    {
+      return MakeLinkLocalAddressFromMac (src);
+    }
+  return encoding.GetSrcAddress ();
+}
 
-          // The address takes the form ff02::00XX.
-          if ( memcmp (addressBuf, multicastAddrCheckerBuf, 15) == 0 )
-            {
-              iphcHeader.SetDam (SixLowPanIphc::HC_COMPR_0);
-            }
-          // The address takes the form ffXX::00XX:XXXX.
-          //                            ffXX:0000:0000:0000:0000:0000:00XX:XXXX.
-          else if ( (addressBuf[0] == multicastAddrCheckerBuf[0])
-                    && (memcmp (addressBuf + 2, multicastAddrCheckerBuf + 2, 11) == 0) )
-            {
-              iphcHeader.SetDam (SixLowPanIphc::HC_COMPR_16);
-            }
-          // The address takes the form ffXX::00XX:XXXX:XXXX.
-          //                            ffXX:0000:0000:0000:0000:00XX:XXXX:XXXX.
-          else if ( (addressBuf[0] == multicastAddrCheckerBuf[0])
-                    && (memcmp (addressBuf + 2, multicastAddrCheckerBuf + 2, 9) == 0) )
-            {
-              iphcHeader.SetDam (SixLowPanIphc::HC_COMPR_64);
-            }
-          else
-            {
-              iphcHeader.SetDam (SixLowPanIphc::HC_INLINE);
-            }
+Ipv6Address
+SixLowPanNetDevice::DecompressIphcDstAddress (SixLowPanIphc const &encoding, Address const &dst)
+{
+  NS_LOG_FUNCTION (this << dst);
+
+  if ( encoding.GetDac () )
+    {
+      if ((encoding.GetDam () == SixLowPanIphc::HC_INLINE  && !encoding.GetM ())
+          || (encoding.GetDam () == SixLowPanIphc::HC_COMPR_64  && encoding.GetM ())
+          || (encoding.GetDam () == SixLowPanIphc::HC_COMPR_16  && encoding.GetM ())
+          || (encoding.GetDam () == SixLowPanIphc::HC_COMPR_0  && encoding.GetM ()) )
+        {
+          NS_ABORT_MSG ("Reserved code found");
         }
+      if ( encoding.GetM () )
+        {
+          NS_ABORT_MSG ("DAC option for multicast addresses not yet implemented");
+        }
+      if ( encoding.GetDam () == SixLowPanIphc::HC_COMPR_0 )
+        {
+          return MakeContextAddress (encoding.GetDstContextId (), MakeLinkLocalAddressFromMac (dst));
+        }
+      return MakeContextAddress (encoding.GetDstContextId (), encoding.GetDstAddress ());
+    }
+  if ( !encoding.GetM () && encoding.GetDam () == SixLowPanIphc::HC_COMPR_0 )
+    {
+      return MakeLinkLocalAddressFromMac (dst);
+    }
+  return encoding.GetDstAddress ();
+}
 
-      NS_LOG_DEBUG ("IPHC Compression - IPHC header size = " << iphcHeader.GetSerializedSize () );
-      NS_LOG_DEBUG ("IPHC Compression - packet size = " << packet->GetSize () );
+void
+SixLowPanNetDevice::AddContext (uint8_t contextId, Ipv6Address contextPrefix, Ipv6Prefix prefixLength, bool compressionAllowed)
+{
+  NS_LOG_FUNCTION (this << int (contextId) << contextPrefix << prefixLength << compressionAllowed);
 
-      packet->AddHeader (iphcHeader);
+  NS_ABORT_MSG_IF (contextId > 15, "6LoWPAN context ID must be between 0 and 15");
+  NS_ABORT_MSG_IF (prefixLength.GetPrefixLength () > 64, "6LoWPAN contexts longer than 64 bits are not supported");
 
-      NS_LOG_DEBUG ("Packet after IPHC compression: " << *packet);
+  uint8_t addressBuf[16];
+  uint8_t maskBuf[16];
+  contextPrefix.GetBytes (addressBuf);
+  prefixLength.GetBytes (maskBuf);
+  for (uint8_t i = 0; i < 16; i++)
+    {
+      addressBuf[i] &= maskBuf[i];
+    }
 
-      return size;
+  ContextEntry entry;
+  entry.m_prefix = Ipv6Address (addressBuf);
+  entry.m_prefixLength = prefixLength;
+  entry.m_compressionAllowed = compressionAllowed;
+  m_contextTable[contextId] = entry;
+
+  // the cached encodings might be stale.
+  m_iphcCache.clear ();
+}
+
+bool
+SixLowPanNetDevice::GetContext (uint8_t contextId, Ipv6Address &contextPrefix, Ipv6Prefix &prefixLength, bool &compressionAllowed) const
+{
+  NS_LOG_FUNCTION (this << int (contextId));
+
+  ContextTable_t::const_iterator it = m_contextTable.find (contextId);
+  if (it == m_contextTable.end ())
+    {
+      return false;
     }
+  contextPrefix = it->second.m_prefix;
+  prefixLength = it->second.m_prefixLength;
+  compressionAllowed = it->second.m_compressionAllowed;
+  return true;
+}
 
-  return 0;
+void
+SixLowPanNetDevice::RemoveContext (uint8_t contextId)
+{
+  NS_LOG_FUNCTION (this << int (contextId));
+
+  m_contextTable.erase (contextId);
+  m_iphcCache.clear ();
 }
 
 bool
@@ -1010,54 +1338,10 @@ SixLowPanNetDevice::DecompressLowPanIphc (Ptr<Packet> packet, Address const &src
   ipHeader.SetHopLimit (encoding.GetHopLimit ());
 
   // Source address
-  if ( encoding.GetSac () )
-    {
-      if ( encoding.GetSam () == SixLowPanIphc::HC_INLINE )
-        {
-          ipHeader.SetSourceAddress ( Ipv6Address::GetAny () );
-        }
-      else
-        {
-          NS_ABORT_MSG ("SAC option not yet implemented");
-        }
-    }
-  else
-    {
-      if ( encoding.GetSam () == SixLowPanIphc::HC_COMPR_0 )
-        {
-          ipHeader.SetSourceAddress (MakeLinkLocalAddressFromMac (src));
-        }
-      else
-        {
-          ipHeader.SetSourceAddress ( encoding.GetSrcAddress () );
-        }
-    }
+  ipHeader.SetSourceAddress (DecompressIphcSrcAddress (encoding, src));
+
   // Destination address
-  if ( encoding.GetDac () )
-    {
-      if ((encoding.GetDam () == SixLowPanIphc::HC_INLINE  && !encoding.GetM ())
-          || (encoding.GetDam () == SixLowPanIphc::HC_COMPR_64  && encoding.GetM ())
-          || (encoding.GetDam () == SixLowPanIphc::HC_COMPR_16  && encoding.GetM ())
-          || (encoding.GetDam () == SixLowPanIphc::HC_COMPR_0  && encoding.GetM ()) )
-        {
-          NS_ABORT_MSG ("Reserved code found");
-        }
-      else
-        {
-          NS_ABORT_MSG ("DAC option not yet implemented");
-        }
-    }
-  else
-    {
-      if ( !encoding.GetM () && encoding.GetDam () == SixLowPanIphc::HC_COMPR_0 )
-        {
-          ipHeader.SetDestinationAddress (MakeLinkLocalAddressFromMac (dst));
-        }
-      else
-        {
-          ipHeader.SetDestinationAddress ( encoding.GetDstAddress () );
-        }
-    }
+  ipHeader.SetDestinationAddress (DecompressIphcDstAddress (encoding, dst));
 
   // Traffic class and Flow Label
   uint8_t traf = 0x00;
@@ -1791,7 +2075,8 @@ bool SixLowPanNetDevice::ProcessFragment (Ptr<Packet>& packet, Address const &sr
   SixLowPanFragN fragNHeader;
   FragmentKey key;
   uint16_t packetSize;
-  key.first = std::pair<Address, Address> (src, dst);
+  key.m_src = src;
+  key.m_dst = dst;
 
   Ptr<Packet> p = packet->Copy ();
   uint16_t offset = 0;
@@ -1837,14 +2122,16 @@ bool SixLowPanNetDevice::ProcessFragment (Ptr<Packet>& packet, Address const &sr
           break;
         }
 
-      key.second = std::pair<uint16_t, uint16_t> (frag1Header.GetDatagramSize (), frag1Header.GetDatagramTag ());
+      key.m_size = frag1Header.GetDatagramSize ();
+      key.m_tag = frag1Header.GetDatagramTag ();
     }
   else
     {
       p->RemoveHeader (fragNHeader);
       packetSize = fragNHeader.GetDatagramSize ();
       offset = fragNHeader.GetDatagramOffset () << 3;
-      key.second = std::pair<uint16_t, uint16_t> (fragNHeader.GetDatagramSize (), fragNHeader.GetDatagramTag ());
+      key.m_size = fragNHeader.GetDatagramSize ();
+      key.m_tag = fragNHeader.GetDatagramTag ();
     }
 
   Ptr<Fragments> fragments;
@@ -1852,53 +2139,34 @@ bool SixLowPanNetDevice::ProcessFragment (Ptr<Packet>& packet, Address const &sr
   MapFragments_t::iterator it = m_fragments.find (key);
   if (it == m_fragments.end ())
     {
-      // erase the oldest packet.
+      // erase the least recently used packet.
       if ( m_fragmentReassemblyListSize && (m_fragments.size () >= m_fragmentReassemblyListSize) )
         {
-          MapFragmentsTimers_t::iterator iter;
-          MapFragmentsTimers_t::iterator iterFound = m_fragmentsTimers.begin ();
-          for ( iter = m_fragmentsTimers.begin (); iter != m_fragmentsTimers.end (); iter++)
-            {
-              if ( iter->second.GetTs () < iterFound->second.GetTs () )
-                {
-                  iterFound = iter;
-                }
-            }
-          FragmentKey oldestKey = iterFound->first;
-
-          std::list< Ptr<Packet> > storedFragments = m_fragments[oldestKey]->GetFraments ();
-          for (std::list< Ptr<Packet> >::iterator fragIter = storedFragments.begin ();
-               fragIter != storedFragments.end (); fragIter++)
-            {
-              m_dropTrace (DROP_FRAGMENT_BUFFER_FULL, *fragIter, m_node->GetObject<SixLowPanNetDevice> (), GetIfIndex ());
-            }
-
-          m_fragmentsTimers[oldestKey].Cancel ();
-          m_fragmentsTimers.erase (oldestKey);
-          m_fragments[oldestKey] = 0;
-          m_fragments.erase (oldestKey);
-
+          DropOldestFragmentSet ();
         }
       fragments = Create<Fragments> ();
       fragments->SetPacketSize (packetSize);
       m_fragments.insert (std::make_pair (key, fragments));
+      fragments->SetLruIterator (m_fragmentsLru.insert (m_fragmentsLru.end (), key));
       uint32_t ifIndex = GetIfIndex ();
-      m_fragmentsTimers[key] = Simulator::Schedule (m_fragmentExpirationTimeout,
-                                                    &SixLowPanNetDevice::HandleFragmentsTimeout, this,
-                                                    key, ifIndex);
+      fragments->SetTimeoutEvent (Simulator::Schedule (m_fragmentExpirationTimeout,
+                                                       &SixLowPanNetDevice::HandleFragmentsTimeout, this,
+                                                       key, ifIndex));
     }
   else
     {
       fragments = it->second;
+      // move the set at the end of the LRU list
+      m_fragmentsLru.splice (m_fragmentsLru.end (), m_fragmentsLru, fragments->GetLruIterator ());
     }
 
-  fragments->AddFragment (p, offset);
+  m_fragmentStoredBytes += fragments->AddFragment (p, offset);
 
   // add the very first fragment so we can correctly decode the packet once is rebuilt.
   // this is needed because otherwise the UDP header length and checksum can not be calculated.
   if ( isFirst )
     {
-      fragments->AddFirstFragment (packet);
+      m_fragmentStoredBytes += fragments->AddFirstFragment (packet);
     }
 
   if ( fragments->IsEntire () )
@@ -1910,24 +2178,313 @@ bool SixLowPanNetDevice::ProcessFragment (Ptr<Packet>& packet, Address const &sr
       packet->RemoveHeader (frag1Header);
 
       NS_LOG_LOGIC ("Rebuilt packet. Size " << packet->GetSize () << " - " << *packet);
-      fragments = 0;
-      m_fragments.erase (key);
-      if (m_fragmentsTimers[key].IsRunning ())
+
+      Time latency = Simulator::Now () - fragments->GetArrivalTime ();
+      m_reassembledDatagrams++;
+      m_reassemblyLatency += latency;
+      m_reassemblyTrace (latency, m_node->GetObject<SixLowPanNetDevice> (), GetIfIndex ());
+
+      NS_LOG_LOGIC ("Stopping 6LoWPAN WaitFragmentsTimer at " << Simulator::Now ().GetSeconds () << " due to complete packet");
+      fragments->GetTimeoutEvent ().Cancel ();
+      RemoveFragmentSet (key);
+      return true;
+    }
+
+  // enforce the memory budget, sparing the set being rebuilt.
+  while ( m_fragmentReassemblyMemory && (m_fragmentStoredBytes > m_fragmentReassemblyMemory)
+          && !(m_fragmentsLru.front () == key) )
+    {
+      DropOldestFragmentSet ();
+    }
+
+  return false;
+}
+
+bool SixLowPanNetDevice::ForwardFragment (Ptr<Packet> packet, Address const &src, Address const &dst, uint16_t protocol, bool isFirst)
+{
+  NS_LOG_FUNCTION (this << *packet << src << dst << isFirst);
+
+  Ptr<Packet> p = packet->Copy ();
+
+  if ( !isFirst )
+    {
+      SixLowPanFragN fragNHeader;
+      p->RemoveHeader (fragNHeader);
+      FragmentKey key (src, dst, fragNHeader.GetDatagramSize (), fragNHeader.GetDatagramTag ());
+
+      MapForwarding_t::iterator it = m_forwarding.find (key);
+      if (it == m_forwarding.end ())
+        {
+          return false;
+        }
+
+      Address nextHop = it->second.m_nextHop;
+      fragNHeader.SetDatagramTag (it->second.m_tag);
+
+      // the last fragment closes the entry.
+      if ( (uint32_t (fragNHeader.GetDatagramOffset ()) << 3) + p->GetSize () >= fragNHeader.GetDatagramSize () )
         {
-          NS_LOG_LOGIC ("Stopping 6LoWPAN WaitFragmentsTimer at " << Simulator::Now ().GetSeconds () << " due to complete packet");
-          m_fragmentsTimers[key].Cancel ();
+          it->second.m_timeout.Cancel ();
+          m_forwarding.erase (it);
         }
-      m_fragmentsTimers.erase (key);
+
+      p->AddHeader (fragNHeader);
+      NS_LOG_LOGIC ("Forwarding fragment to " << nextHop << ": " << *p);
+      m_forwardedFragments++;
+      m_txTrace (p, m_node->GetObject<SixLowPanNetDevice> (), GetIfIndex ());
+      m_netDevice->Send (p, nextHop, protocol);
+      return true;
+    }
+
+  SixLowPanFrag1 frag1Header;
+  p->RemoveHeader (frag1Header);
+  FragmentKey key (src, dst, frag1Header.GetDatagramSize (), frag1Header.GetDatagramTag ());
+
+  // some fragments have been already buffered, keep on reassembling the packet.
+  if ( m_fragments.find (key) != m_fragments.end () || m_forwarding.find (key) != m_forwarding.end () )
+    {
+      return false;
+    }
+
+  uint8_t dispatchRawVal = 0;
+  p->CopyData (&dispatchRawVal, sizeof(dispatchRawVal));
+  if ( SixLowPanDispatch::GetDispatchType (dispatchRawVal) != SixLowPanDispatch::LOWPAN_IPHC )
+    {
+      return false;
+    }
+
+  SixLowPanIphc encoding;
+  p->RemoveHeader (encoding);
+  if ( encoding.GetM () )
+    {
+      return false;
+    }
+
+  Ipv6Address srcAddr = DecompressIphcSrcAddress (encoding, src);
+  Ipv6Address dstAddr = DecompressIphcDstAddress (encoding, dst);
+
+  // let the IPv6 layer handle the expired packets.
+  Address nextHop;
+  if ( encoding.GetHopLimit () <= 1 || !LookupFragmentNextHop (srcAddr, dstAddr, nextHop) )
+    {
+      return false;
+    }
+
+  // re-encode the IPHC header for the next link.
+  SixLowPanIphc nextEncoding;
+  nextEncoding.SetTf (encoding.GetTf ());
+  nextEncoding.SetEcn (encoding.GetEcn ());
+  nextEncoding.SetDscp (encoding.GetDscp ());
+  nextEncoding.SetFlowLabel (encoding.GetFlowLabel ());
+  nextEncoding.SetNh (encoding.GetNh ());
+  nextEncoding.SetNextHeader (encoding.GetNextHeader ());
+  SetIphcHopLimit (nextEncoding, encoding.GetHopLimit () - 1);
+  SetIphcAddresses (nextEncoding, srcAddr, dstAddr, m_netDevice->GetAddress (), nextHop);
+  p->AddHeader (nextEncoding);
+
+  uint16_t tag = uint16_t (m_rng->GetValue (0, 65535));
+  frag1Header.SetDatagramTag (tag);
+  p->AddHeader (frag1Header);
+
+  if ( p->GetSize () > m_netDevice->GetMtu () )
+    {
+      NS_LOG_LOGIC ("Re-encoded first fragment exceeds the MTU, reassembling the packet");
+      return false;
+    }
+
+  ForwardingEntry entry;
+  entry.m_nextHop = nextHop;
+  entry.m_tag = tag;
+  entry.m_timeout = Simulator::Schedule (m_fragmentExpirationTimeout,
+                                         &SixLowPanNetDevice::HandleForwardingTimeout, this, key);
+  m_forwarding.insert (std::make_pair (key, entry));
+
+  NS_LOG_LOGIC ("Forwarding first fragment to " << nextHop << ": " << *p);
+  m_forwardedFragments++;
+  m_txTrace (p, m_node->GetObject<SixLowPanNetDevice> (), GetIfIndex ());
+  m_netDevice->Send (p, nextHop, protocol);
+  return true;
+}
+
+bool SixLowPanNetDevice::LookupFragmentNextHop (Ipv6Address srcAddr, Ipv6Address dstAddr, Address &nextHop)
+{
+  NS_LOG_FUNCTION (this << srcAddr << dstAddr);
+
+  Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol> ();
+  if ( !ipv6 || dstAddr.IsMulticast () || ipv6->GetInterfaceForAddress (dstAddr) != -1 )
+    {
+      return false;
+    }
+
+  int32_t interface = ipv6->GetInterfaceForDevice (this);
+  if ( interface == -1 || !ipv6->IsForwarding (interface) || !ipv6->GetRoutingProtocol () )
+    {
+      return false;
+    }
+
+  Ipv6Header ipHeader;
+  ipHeader.SetSourceAddress (srcAddr);
+  ipHeader.SetDestinationAddress (dstAddr);
+  Socket::SocketErrno err;
+  Ptr<Ipv6Route> route = ipv6->GetRoutingProtocol ()->RouteOutput (0, ipHeader, 0, err);
+  if ( !route || route->GetOutputDevice () != this )
+    {
+      return false;
+    }
+
+  Ipv6Address gateway = route->GetGateway ();
+  if ( gateway.IsAny () )
+    {
+      gateway = dstAddr;
+    }
+
+  if ( !m_netDevice->NeedsArp () )
+    {
+      nextHop = m_netDevice->GetBroadcast ();
       return true;
     }
 
+  NdiscCache::Entry* entry = ipv6->GetInterface (interface)->GetNdiscCache ()->Lookup (gateway);
+  if ( !entry || entry->IsIncomplete () )
+    {
+      return false;
+    }
+  nextHop = entry->GetMacAddress ();
+  return true;
+}
+
+void SixLowPanNetDevice::HandleForwardingTimeout (FragmentKey key)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_forwarding.erase (key);
+}
+
+void SixLowPanNetDevice::DropOldestFragmentSet ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_fragmentsLru.empty ())
+    {
+      return;
+    }
+
+  FragmentKey oldestKey = m_fragmentsLru.front ();
+  Ptr<Fragments> oldest = m_fragments[oldestKey];
+
+  std::list< Ptr<Packet> > storedFragments = oldest->GetFraments ();
+  for (std::list< Ptr<Packet> >::iterator fragIter = storedFragments.begin ();
+       fragIter != storedFragments.end (); fragIter++)
+    {
+      m_dropTrace (DROP_FRAGMENT_BUFFER_FULL, *fragIter, m_node->GetObject<SixLowPanNetDevice> (), GetIfIndex ());
+    }
+
+  oldest->GetTimeoutEvent ().Cancel ();
+  m_evictedDatagrams++;
+  RemoveFragmentSet (oldestKey);
+}
+
+void SixLowPanNetDevice::RemoveFragmentSet (FragmentKey const &key)
+{
+  NS_LOG_FUNCTION (this);
+
+  MapFragmentsI_t it = m_fragments.find (key);
+  NS_ASSERT (it != m_fragments.end ());
+
+  m_fragmentStoredBytes -= it->second->GetStoredBytes ();
+  m_fragmentsLru.erase (it->second->GetLruIterator ());
+  m_fragments.erase (it);
+}
+
+SixLowPanNetDevice::FragmentKey::FragmentKey ()
+  : m_size (0),
+    m_tag (0)
+{
+}
+
+SixLowPanNetDevice::FragmentKey::FragmentKey (Address const &src, Address const &dst, uint16_t size, uint16_t tag)
+  : m_src (src),
+    m_dst (dst),
+    m_size (size),
+    m_tag (tag)
+{
+}
+
+bool SixLowPanNetDevice::FragmentKey::operator == (FragmentKey const &other) const
+{
+  return m_tag == other.m_tag && m_size == other.m_size
+         && m_src == other.m_src && m_dst == other.m_dst;
+}
+
+/**
+ * \brief Get the integer of an 802.15.4 address.
+ * \param address a polymorphic address
+ * \param value the integer of the address, if it is a Mac16Address or a Mac64Address
+ * \returns true if the address is a Mac16Address or a Mac64Address
+ */
+static bool
+LrWpanAddressToInt (Address const &address, uint64_t &value)
+{
+  if (Mac16Address::IsMatchingType (address))
+    {
+      value = Mac16Address::ConvertFrom (address).ConvertToInt ();
+      return true;
+    }
+  if (Mac64Address::IsMatchingType (address))
+    {
+      value = Mac64Address::ConvertFrom (address).ConvertToInt ();
+      return true;
+    }
   return false;
 }
 
+size_t SixLowPanNetDevice::FragmentKeyHash::operator () (FragmentKey const &key) const
+{
+  // 802.15.4 addresses are hashed as integers, without serializing them.
+  uint64_t src;
+  uint64_t dst;
+  if (LrWpanAddressToInt (key.m_src, src) && LrWpanAddressToInt (key.m_dst, dst))
+    {
+      // combined as boost::hash_combine does
+      uint64_t hash = src;
+      hash ^= dst + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+      hash ^= (((uint32_t)key.m_size << 16) | key.m_tag) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+      return Mac64AddressHash () (Mac64Address (hash));
+    }
+
+  uint8_t buf[2 * (Address::MAX_SIZE + 2) + 4];
+  uint32_t len = 0;
+
+  len += key.m_src.CopyAllTo (buf, Address::MAX_SIZE + 2);
+  len += key.m_dst.CopyAllTo (buf + len, Address::MAX_SIZE + 2);
+  buf[len++] = key.m_size >> 8;
+  buf[len++] = key.m_size & 0xff;
+  buf[len++] = key.m_tag >> 8;
+  buf[len++] = key.m_tag & 0xff;
+
+  return Hash32 (reinterpret_cast<char *> (buf), len);
+}
+
+/**
+ * \brief Orders the stored fragments by offset.
+ * \param fragment a stored fragment
+ * \param offset the offset to compare with
+ * \returns true if the fragment starts before the offset
+ */
+static bool
+FragmentOffsetLess (std::pair<uint16_t, Ptr<Packet> > const &fragment, uint16_t offset)
+{
+  return fragment.first < offset;
+}
+
 SixLowPanNetDevice::Fragments::Fragments ()
 {
   NS_LOG_FUNCTION (this);
   m_packetSize = 0;
+  m_coveredUnits = 0;
+  m_totalUnits = 0;
+  m_storedBytes = 0;
+  m_arrivalTime = Simulator::Now ();
 }
 
 SixLowPanNetDevice::Fragments::~Fragments ()
@@ -1935,96 +2492,95 @@ SixLowPanNetDevice::Fragments::~Fragments ()
   NS_LOG_FUNCTION (this);
 }
 
-void SixLowPanNetDevice::Fragments::AddFragment (Ptr<Packet> fragment, uint16_t fragmentOffset)
+uint32_t SixLowPanNetDevice::Fragments::AddFragment (Ptr<Packet> fragment, uint16_t fragmentOffset)
 {
   NS_LOG_FUNCTION (this << fragmentOffset << *fragment);
 
-  std::list<std::pair<Ptr<Packet>, uint16_t> >::iterator it;
-  bool duplicate = false;
+  std::vector<std::pair<uint16_t, Ptr<Packet> > >::iterator it = m_fragments.end ();
 
-  for (it = m_fragments.begin (); it != m_fragments.end (); it++)
+  // fragments are usually received in order, avoid the search in that case.
+  if (!m_fragments.empty () && m_fragments.back ().first >= fragmentOffset)
     {
-      if (it->second > fragmentOffset)
-        {
-          break;
-        }
-      if (it->second == fragmentOffset)
+      it = std::lower_bound (m_fragments.begin (), m_fragments.end (),
+                             fragmentOffset, FragmentOffsetLess);
+      if (it != m_fragments.end () && it->first == fragmentOffset)
         {
-          duplicate = true;
-          NS_ASSERT_MSG (fragment->GetSize () == it->first->GetSize (), "Duplicate fragment size differs. Aborting.");
-          break;
+          NS_ASSERT_MSG (fragment->GetSize () == it->second->GetSize (), "Duplicate fragment size differs. Aborting.");
+          return 0;
         }
     }
-  if (!duplicate)
-    {
-      m_fragments.insert (it, std::make_pair (fragment, fragmentOffset));
-    }
+
+  m_fragments.insert (it, std::make_pair (fragmentOffset, fragment));
+  MarkCovered (fragmentOffset, fragmentOffset + fragment->GetSize ());
+  m_storedBytes += fragment->GetSize ();
+  return fragment->GetSize ();
 }
 
-void SixLowPanNetDevice::Fragments::AddFirstFragment (Ptr<Packet> fragment)
+uint32_t SixLowPanNetDevice::Fragments::AddFirstFragment (Ptr<Packet> fragment)
 {
   NS_LOG_FUNCTION (this << *fragment);
 
+  uint32_t added = fragment->GetSize ();
+  if (m_firstFragment)
+    {
+      added -= std::min (added, m_firstFragment->GetSize ());
+    }
+  m_storedBytes += added;
   m_firstFragment = fragment;
+  return added;
 }
 
-bool SixLowPanNetDevice::Fragments::IsEntire () const
+void SixLowPanNetDevice::Fragments::MarkCovered (uint32_t start, uint32_t end)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << start << end);
 
-  bool ret = m_fragments.size () > 0;
-  uint16_t lastEndOffset = 0;
+  // only the last fragment may end in the middle of an 8-byte unit.
+  uint32_t firstUnit = (start + 7) >> 3;
+  uint32_t lastUnit = (end >= m_packetSize) ? m_totalUnits : (end >> 3);
 
-  if (ret)
+  for (uint32_t unit = firstUnit; unit < lastUnit; unit++)
     {
-      for (std::list<std::pair<Ptr<Packet>, uint16_t> >::const_iterator it = m_fragments.begin (); it != m_fragments.end (); it++)
+      uint32_t mask = 1u << (unit & 0x1f);
+      if (!(m_coverage[unit >> 5] & mask))
         {
-          // overlapping fragments should not exist
-          NS_LOG_LOGIC ("Checking overlaps " << lastEndOffset << " - " << it->second );
-
-          if (lastEndOffset < it->second)
-            {
-              ret = false;
-              break;
-            }
-          // fragments might overlap in strange ways
-          uint16_t fragmentEnd = it->first->GetSize () + it->second;
-          lastEndOffset = std::max ( lastEndOffset, fragmentEnd );
+          m_coverage[unit >> 5] |= mask;
+          m_coveredUnits++;
         }
     }
+}
 
-  if ( ret && (lastEndOffset == m_packetSize))
-    {
-      return true;
-    }
-  return false;
+bool SixLowPanNetDevice::Fragments::IsEntire () const
+{
+  NS_LOG_FUNCTION (this);
+
+  return m_firstFragment && m_totalUnits && (m_coveredUnits == m_totalUnits);
 }
 
 Ptr<Packet> SixLowPanNetDevice::Fragments::GetPacket () const
 {
   NS_LOG_FUNCTION (this);
 
-  std::list<std::pair<Ptr<Packet>, uint16_t> >::const_iterator it = m_fragments.begin ();
+  std::vector<std::pair<uint16_t, Ptr<Packet> > >::const_iterator it = m_fragments.begin ();
 
   Ptr<Packet> p = Create<Packet> ();
   uint16_t lastEndOffset = 0;
 
   p->AddAtEnd (m_firstFragment);
   it = m_fragments.begin ();
-  lastEndOffset = it->first->GetSize ();
+  lastEndOffset = it->second->GetSize ();
 
   for ( it++; it != m_fragments.end (); it++)
     {
-      if ( lastEndOffset > it->second )
+      if ( lastEndOffset > it->first )
         {
           NS_ABORT_MSG ("Overlapping fragments found, forbidden condition");
         }
       else
         {
-          NS_LOG_LOGIC ("Adding: " << *(it->first) );
-          p->AddAtEnd (it->first);
+          NS_LOG_LOGIC ("Adding: " << *(it->second) );
+          p->AddAtEnd (it->second);
         }
-      lastEndOffset += it->first->GetSize ();
+      lastEndOffset += it->second->GetSize ();
     }
 
   return p;
@@ -2034,19 +2590,52 @@ void SixLowPanNetDevice::Fragments::SetPacketSize (uint32_t packetSize)
 {
   NS_LOG_FUNCTION (this << packetSize);
   m_packetSize = packetSize;
+  m_totalUnits = (packetSize + 7) >> 3;
+  m_coverage.assign ((m_totalUnits + 31) >> 5, 0);
+  m_coveredUnits = 0;
 }
 
 std::list< Ptr<Packet> > SixLowPanNetDevice::Fragments::GetFraments () const
 {
   std::list< Ptr<Packet> > fragments;
-  std::list<std::pair<Ptr<Packet>, uint16_t> >::const_iterator iter;
+  std::vector<std::pair<uint16_t, Ptr<Packet> > >::const_iterator iter;
   for ( iter = m_fragments.begin (); iter != m_fragments.end (); iter ++)
     {
-      fragments.push_back (iter->first);
+      fragments.push_back (iter->second);
     }
   return fragments;
 }
 
+uint32_t SixLowPanNetDevice::Fragments::GetStoredBytes () const
+{
+  return m_storedBytes;
+}
+
+Time SixLowPanNetDevice::Fragments::GetArrivalTime () const
+{
+  return m_arrivalTime;
+}
+
+void SixLowPanNetDevice::Fragments::SetTimeoutEvent (EventId event)
+{
+  m_timeoutEvent = event;
+}
+
+EventId SixLowPanNetDevice::Fragments::GetTimeoutEvent () const
+{
+  return m_timeoutEvent;
+}
+
+void SixLowPanNetDevice::Fragments::SetLruIterator (FragmentsLru_t::iterator iter)
+{
+  m_lruIterator = iter;
+}
+
+SixLowPanNetDevice::FragmentsLru_t::iterator SixLowPanNetDevice::Fragments::GetLruIterator () const
+{
+  return m_lruIterator;
+}
+
 void SixLowPanNetDevice::HandleFragmentsTimeout (FragmentKey key, uint32_t iif)
 {
   NS_LOG_FUNCTION (this);
@@ -2059,10 +2648,7 @@ void SixLowPanNetDevice::HandleFragmentsTimeout (FragmentKey key, uint32_t iif)
       m_dropTrace (DROP_FRAGMENT_TIMEOUT, *fragIter, m_node->GetObject<SixLowPanNetDevice> (), iif);
     }
   // clear the buffers
-  it->second = 0;
-
-  m_fragments.erase (key);
-  m_fragmentsTimers.erase (key);
+  RemoveFragmentSet (key);
 }
 
 Ipv6Address SixLowPanNetDevice::MakeLinkLocalAddressFromMac (Address const &addr)
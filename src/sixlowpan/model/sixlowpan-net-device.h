@@ -25,6 +25,9 @@
 #include <stdint.h>
 #include <string>
 #include <map>
+#include <list>
+#include <vector>
+#include "ns3/sgi-hashmap.h"
 #include "ns3/traced-callback.h"
 #include "ns3/event-id.h"
 #include "ns3/nstime.h"
@@ -47,7 +50,7 @@ class Node;
  * <ul>
  * <li> MESH and LOWPAN_BC0 dispatch types are not supported </li>
  * <li> HC2 encoding is not supported </li>
- * <li> IPHC's SAC and DAC are not supported </li>
+ * <li> IPHC's DAC is not supported for multicast addresses </li>
  *</ul>
  */
 
@@ -145,6 +148,67 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * \brief Get the number of datagrams successfully reassembled.
+   * \return the number of reassembled datagrams
+   */
+  uint32_t GetReassembledDatagrams (void) const;
+
+  /**
+   * \brief Get the number of fragment sets evicted because the
+   * reassembly buffer was full.
+   * \return the number of evicted fragment sets
+   */
+  uint32_t GetEvictedDatagrams (void) const;
+
+  /**
+   * \brief Get the average time elapsed between the reception of the
+   * first fragment of a datagram and its reassembly.
+   * \return the average reassembly latency
+   */
+  Time GetAverageReassemblyLatency (void) const;
+
+  /**
+   * \brief Get the number of bytes currently held in the reassembly buffer.
+   * \return the stored bytes
+   */
+  uint32_t GetReassemblyBufferSize (void) const;
+
+  /**
+   * \brief Get the number of fragments forwarded without reassembly.
+   * \return the number of forwarded fragments
+   */
+  uint32_t GetForwardedFragments (void) const;
+
+  /**
+   * \brief Add, or update, a compression context (RFC 6282).
+   *
+   * Only the first 64 bits of the context are used, i.e., contexts are
+   * expected to be IPv6 network prefixes.
+   *
+   * \param contextId context ID (0 to 15)
+   * \param contextPrefix the context prefix
+   * \param prefixLength the context prefix length (up to 64 bits)
+   * \param compressionAllowed use the context for compression (decompression is always allowed)
+   */
+  void AddContext (uint8_t contextId, Ipv6Address contextPrefix, Ipv6Prefix prefixLength, bool compressionAllowed);
+
+  /**
+   * \brief Get a compression context.
+   * \param [in] contextId context ID
+   * \param [out] contextPrefix the context prefix
+   * \param [out] prefixLength the context prefix length
+   * \param [out] compressionAllowed the context is used for compression
+   * \return true if the context exists
+   */
+  bool GetContext (uint8_t contextId, Ipv6Address &contextPrefix, Ipv6Prefix &prefixLength, bool &compressionAllowed) const;
+
+  /**
+   * \brief Remove a compression context.
+   * \param contextId context ID
+   */
+  void RemoveContext (uint8_t contextId);
+
 protected:
   virtual void DoDispose (void);
 
@@ -274,6 +338,114 @@ private:
    */
   uint32_t CompressLowPanIphc (Ptr<Packet> packet, Address const &src, Address const &dst);
 
+  /**
+   * \brief Set the IPHC HLIM field and the inline Hop Limit, if needed.
+   * \param iphcHeader the IPHC header
+   * \param hopLimit the IPv6 Hop Limit
+   */
+  void SetIphcHopLimit (SixLowPanIphc &iphcHeader, uint8_t hopLimit);
+
+  /**
+   * \brief Set the IPHC address fields, eliding what can be derived from the link-layer addresses.
+   * \param iphcHeader the IPHC header
+   * \param srcAddr the IPv6 source address
+   * \param dstAddr the IPv6 destination address
+   * \param src the MAC source address
+   * \param dst the MAC destination address
+   */
+  void SetIphcAddresses (SixLowPanIphc &iphcHeader, Ipv6Address srcAddr, Ipv6Address dstAddr,
+                         Address const &src, Address const &dst);
+
+  /**
+   * \class IphcCacheEntry
+   * \brief IPHC address encoding computed for a given address pair.
+   */
+  class IphcCacheEntry
+  {
+public:
+    IphcCacheEntry ()
+      : m_valid (false)
+    {
+    }
+
+    bool m_valid;            //!< The entry holds a computed encoding
+    Ipv6Address m_srcAddr;   //!< IPv6 source address
+    Ipv6Address m_dstAddr;   //!< IPv6 destination address
+    Address m_src;           //!< MAC source address
+    Address m_dst;           //!< MAC destination address
+    bool m_sac;              //!< SAC field
+    SixLowPanIphc::HeaderCompression_e m_sam; //!< SAM field
+    bool m_m;                //!< M field
+    bool m_dac;              //!< DAC field
+    SixLowPanIphc::HeaderCompression_e m_dam; //!< DAM field
+    uint8_t m_srcContextId;  //!< Source context ID
+    uint8_t m_dstContextId;  //!< Destination context ID
+  };
+
+  /**
+   * \brief Compute the IPHC address encoding of an address pair.
+   * \param encoding the computed encoding
+   * \param srcAddr the IPv6 source address
+   * \param dstAddr the IPv6 destination address
+   * \param src the MAC source address
+   * \param dst the MAC destination address
+   */
+  void ComputeIphcAddressModes (IphcCacheEntry &encoding, Ipv6Address srcAddr, Ipv6Address dstAddr,
+                                Address const &src, Address const &dst);
+
+  /**
+   * \brief Find a context usable to compress an address.
+   * \param addr the IPv6 address
+   * \param contextId the context ID found
+   * \return true if a context has been found
+   */
+  bool LookupCompressionContext (Ipv6Address addr, uint8_t &contextId);
+
+  /**
+   * \brief Build an address from a context prefix and an interface identifier.
+   * \param contextId the context ID
+   * \param iid an address holding the interface identifier in its last 64 bits
+   * \return the IPv6 address
+   */
+  Ipv6Address MakeContextAddress (uint8_t contextId, Ipv6Address iid);
+
+  /**
+   * \brief Rebuild the source address of an IPHC header.
+   * \param encoding the IPHC header
+   * \param src the MAC source address
+   * \return the IPv6 source address
+   */
+  Ipv6Address DecompressIphcSrcAddress (SixLowPanIphc const &encoding, Address const &src);
+
+  /**
+   * \brief Rebuild the destination address of an IPHC header.
+   * \param encoding the IPHC header
+   * \param dst the MAC destination address
+   * \return the IPv6 destination address
+   */
+  Ipv6Address DecompressIphcDstAddress (SixLowPanIphc const &encoding, Address const &dst);
+
+  /**
+   * \class ContextEntry
+   * \brief A RFC 6282 compression context.
+   */
+  class ContextEntry
+  {
+public:
+    Ipv6Address m_prefix;        //!< Context prefix
+    Ipv6Prefix m_prefixLength;   //!< Context prefix length
+    bool m_compressionAllowed;   //!< Context usable for compression (or only for decompression)
+  };
+
+  /**
+   * Container for context ID -> context
+   */
+  typedef std::map<uint8_t, ContextEntry> ContextTable_t;
+
+  ContextTable_t m_contextTable;            //!< Compression contexts
+  std::vector<IphcCacheEntry> m_iphcCache;  //!< Direct-mapped cache of IPHC address encodings
+  uint32_t m_iphcCacheSize;                 //!< Number of entries in the IPHC encoding cache
+
   /**
    * \brief Checks if the next header can be compressed using NHC.
    * \param headerType the header kind to be compressed
@@ -327,13 +499,63 @@ private:
   void DecompressLowPanUdpNhc (Ptr<Packet> packet, Ipv6Address saddr, Ipv6Address daddr);
 
   /**
-   * Fragment identifier type: src/dst address src/dst port
+   * \brief Fragment identifier: src/dst MAC address, datagram size and tag.
+   */
+  class FragmentKey
+  {
+public:
+    FragmentKey ();
+
+    /**
+     * \brief Constructor.
+     * \param src the source MAC address
+     * \param dst the destination MAC address
+     * \param size the datagram size
+     * \param tag the datagram tag
+     */
+    FragmentKey (Address const &src, Address const &dst, uint16_t size, uint16_t tag);
+
+    Address m_src;   //!< Source MAC address
+    Address m_dst;   //!< Destination MAC address
+    uint16_t m_size; //!< Datagram size
+    uint16_t m_tag;  //!< Datagram tag
+
+    /**
+     * \brief Equality operator.
+     * \param other the key to compare with
+     * \returns true if the keys are equal
+     */
+    bool operator == (FragmentKey const &other) const;
+  };
+
+  /**
+   * \class FragmentKeyHash
+   * \brief Hash function class for fragment keys.
    */
-  typedef std::pair< std::pair<Address, Address>, std::pair<uint16_t, uint16_t> > FragmentKey;
+  class FragmentKeyHash : public std::unary_function<FragmentKey, size_t>
+  {
+public:
+    /**
+     * \brief Unary operator to hash a fragment key.
+     * \param key the key to hash
+     * \returns the hash of the key
+     */
+    size_t operator () (FragmentKey const &key) const;
+  };
+
+  /**
+   * Container for the fragment sets, least recently used first.
+   */
+  typedef std::list<FragmentKey> FragmentsLru_t;
 
   /**
    * \class Fragments
    * \brief A Set of Fragment
+   *
+   * The fragments are kept sorted by offset in a contiguous vector, and the
+   * covered part of the datagram is tracked by a bitmap of 8-byte units
+   * (the FRAGN offset granularity), so that checking whether the datagram
+   * is complete does not require walking the fragments.
    */
   class Fragments : public SimpleRefCount<Fragments>
   {
@@ -352,15 +574,17 @@ public:
      * \brief Add a fragment to the pool.
      * \param fragment the fragment
      * \param fragmentOffset the offset of the fragment
+     * \return the number of bytes added to the pool (zero for duplicates)
      */
-    void AddFragment (Ptr<Packet> fragment, uint16_t fragmentOffset);
+    uint32_t AddFragment (Ptr<Packet> fragment, uint16_t fragmentOffset);
 
     /**
      * \brief Add the first packet fragment. The first fragment is needed to
      * allow the post-defragmentation decompression.
      * \param fragment the fragment
+     * \return the number of bytes added to the pool
      */
-    void AddFirstFragment (Ptr<Packet> fragment);
+    uint32_t AddFirstFragment (Ptr<Packet> fragment);
 
     /**
      * \brief If all fragments have been added.
@@ -385,22 +609,72 @@ public:
      */
     std::list< Ptr<Packet> > GetFraments () const;
 
+    /**
+     * \brief Get the number of bytes held by this fragment set.
+     * \return the stored bytes
+     */
+    uint32_t GetStoredBytes () const;
+
+    /**
+     * \brief Get the time the first fragment of the set has been received.
+     * \return the arrival time
+     */
+    Time GetArrivalTime () const;
+
+    /**
+     * \brief Set the timeout event of the fragment set.
+     * \param event the timeout event
+     */
+    void SetTimeoutEvent (EventId event);
+
+    /**
+     * \brief Get the timeout event of the fragment set.
+     * \return the timeout event
+     */
+    EventId GetTimeoutEvent () const;
+
+    /**
+     * \brief Set the position of the fragment set in the LRU list.
+     * \param iter the LRU list iterator
+     */
+    void SetLruIterator (FragmentsLru_t::iterator iter);
+
+    /**
+     * \brief Get the position of the fragment set in the LRU list.
+     * \return the LRU list iterator
+     */
+    FragmentsLru_t::iterator GetLruIterator () const;
+
 private:
+    /**
+     * \brief Mark the 8-byte units fully covered by [start, end) as received.
+     * \param start the first byte
+     * \param end one past the last byte
+     */
+    void MarkCovered (uint32_t start, uint32_t end);
+
     /**
      * \brief The size of the reconstructed packet (bytes).
      */
     uint32_t m_packetSize;
 
     /**
-     * \brief The current fragments.
+     * \brief The current fragments, sorted by offset.
      */
-    std::list<std::pair<Ptr<Packet>, uint16_t> > m_fragments;
+    std::vector<std::pair<uint16_t, Ptr<Packet> > > m_fragments;
 
     /**
      * \brief The very first fragment
      */
     Ptr<Packet> m_firstFragment;
 
+    std::vector<uint32_t> m_coverage; //!< Bitmap of the received 8-byte units
+    uint32_t m_coveredUnits;          //!< Number of bits set in m_coverage
+    uint32_t m_totalUnits;            //!< Number of 8-byte units in the packet
+    uint32_t m_storedBytes;           //!< Bytes held by the stored fragments
+    Time m_arrivalTime;               //!< Arrival time of the first fragment
+    EventId m_timeoutEvent;           //!< Expiration event
+    FragmentsLru_t::iterator m_lruIterator; //!< Position in the LRU list
   };
 
   /**
@@ -431,29 +705,79 @@ private:
   void HandleFragmentsTimeout ( FragmentKey key, uint32_t iif);
 
   /**
-   * \brief Drops the oldest fragment set
+   * \brief Drops the least recently used fragment set
    */
   void DropOldestFragmentSet ();
 
   /**
-   * Container for fragment key -> fragments
+   * \brief Remove a fragment set from the reassembly buffer.
+   * \param key the fragment set key
    */
-  typedef std::map< FragmentKey, Ptr<Fragments> > MapFragments_t;
+  void RemoveFragmentSet (FragmentKey const &key);
+
   /**
-   * Container Iterator for fragment key -> fragments
+   * \brief Try to forward a fragment toward the next hop without reassembling the packet.
+   *
+   * The first fragment is forwarded only if the IPv6 destination is not local, its route
+   * uses this interface and the next hop link-layer address is known. In that case
+   * a forwarding entry is created, and the following fragments are switched through it.
+   *
+   * \param packet the fragment (including the 6LoWPAN fragmentation header)
+   * \param src the source MAC address
+   * \param dst the destination MAC address
+   * \param protocol the L2 protocol number
+   * \param isFirst true if it is the first fragment, false otherwise
+   * \return true if the fragment has been forwarded
+   */
+  bool ForwardFragment (Ptr<Packet> packet, Address const &src, Address const &dst, uint16_t protocol, bool isFirst);
+
+  /**
+   * \brief Find the link-layer address of the next hop toward an IPv6 destination.
+   * \param srcAddr the IPv6 source address
+   * \param dstAddr the IPv6 destination address
+   * \param nextHop the next hop MAC address
+   * \return true if the next hop is reachable through this interface
+   */
+  bool LookupFragmentNextHop (Ipv6Address srcAddr, Ipv6Address dstAddr, Address &nextHop);
+
+  /**
+   * \brief Process the timeout for a fragment forwarding entry
+   * \param key representing the incoming packet fragments
+   */
+  void HandleForwardingTimeout (FragmentKey key);
+
+  /**
+   * \class ForwardingEntry
+   * \brief Per-hop switching state of a forwarded packet.
+   */
+  class ForwardingEntry
+  {
+public:
+    Address m_nextHop;  //!< Next hop MAC address
+    uint16_t m_tag;     //!< Outgoing datagram tag
+    EventId m_timeout;  //!< Expiration event
+  };
+
+  /**
+   * Container for incoming fragment key -> forwarding entry
    */
-  typedef std::map< FragmentKey, Ptr<Fragments> >::iterator MapFragmentsI_t;
+  typedef sgi::hash_map< FragmentKey, ForwardingEntry, FragmentKeyHash > MapForwarding_t;
+
+  MapForwarding_t m_forwarding; /**< Fragment forwarding entries */
+  bool m_fragmentForwarding;    /**< Forward fragments without reassembling them */
+  uint32_t m_forwardedFragments; /**< Number of fragments forwarded */
+
   /**
-   * Container for fragment key -> exiration event
+   * Container for fragment key -> fragments
    */
-  typedef std::map< FragmentKey, EventId > MapFragmentsTimers_t;
+  typedef sgi::hash_map< FragmentKey, Ptr<Fragments>, FragmentKeyHash > MapFragments_t;
   /**
-   * Container Iterator for fragment key -> exiration event
+   * Container Iterator for fragment key -> fragments
    */
-  typedef std::map< FragmentKey, EventId >::iterator MapFragmentsTimersI_t;
+  typedef sgi::hash_map< FragmentKey, Ptr<Fragments>, FragmentKeyHash >::iterator MapFragmentsI_t;
 
   MapFragments_t       m_fragments; /**< Fragments hold to be rebuilt */
-  MapFragmentsTimers_t m_fragmentsTimers; /**< Timers related to fragment rebuilding */
+  FragmentsLru_t       m_fragmentsLru; /**< Fragment sets, least recently used first */
   Time                 m_fragmentExpirationTimeout; /**< Time limit for fragment rebuilding */
 
   /**
@@ -462,6 +786,27 @@ private:
    */
   uint16_t             m_fragmentReassemblyListSize;
 
+  /**
+   * \brief How many bytes can be held in the reassembly buffer.
+   * Zero means no limit.
+   */
+  uint32_t             m_fragmentReassemblyMemory;
+  uint32_t             m_fragmentStoredBytes; /**< Bytes currently held in the reassembly buffer */
+
+  uint32_t m_reassembledDatagrams; /**< Number of successfully reassembled datagrams */
+  uint32_t m_evictedDatagrams;     /**< Number of fragment sets evicted because the buffer was full */
+  Time     m_reassemblyLatency;    /**< Cumulative reassembly latency */
+
+  /**
+   * \brief Callback to trace the reassembly latency of each rebuilt datagram.
+   *
+   * Data passed:
+   * \li time elapsed since the first received fragment
+   * \li Ptr to SixLowPanNetDevice
+   * \li interface index
+   */
+  TracedCallback<Time, Ptr<SixLowPanNetDevice>, uint32_t> m_reassemblyTrace;
+
   bool m_useIphc; /**< Use IPHC or HC1 */
 
   Ptr<Node> m_node; /**< Smart pointer to the Node */
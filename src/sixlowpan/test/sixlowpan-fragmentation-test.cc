@@ -263,6 +263,7 @@ SixlowpanFragmentationTest::DoRun (void)
   Ptr<Node> serverNode = CreateObject<Node> ();
   AddInternetStack (serverNode);
   Ptr<SimpleNetDevice> serverDev;
+  Ptr<SixLowPanNetDevice> serverSix;
   Ptr<BinaryErrorSixlowModel> serverDevErrorModel = CreateObject<BinaryErrorSixlowModel> ();
   {
     Ptr<Icmpv6L4Protocol> icmpv6l4 = serverNode->GetObject<Icmpv6L4Protocol> ();
@@ -275,7 +276,7 @@ SixlowpanFragmentationTest::DoRun (void)
     serverDevErrorModel->Disable ();
     serverNode->AddDevice (serverDev);
 
-    Ptr<SixLowPanNetDevice> serverSix = CreateObject<SixLowPanNetDevice> ();
+    serverSix = CreateObject<SixLowPanNetDevice> ();
     serverSix->SetAttribute ("ForceEtherType", BooleanValue (true) );
     serverNode->AddDevice (serverSix);
     serverSix->SetNetDevice (serverDev);
@@ -359,6 +360,8 @@ SixlowpanFragmentationTest::DoRun (void)
       NS_TEST_EXPECT_MSG_EQ (memcmp (m_data, recvBuffer, m_receivedPacketServer->GetSize ()),
                              0, "Packet content differs");
     }
+  NS_TEST_EXPECT_MSG_EQ (serverSix->GetReassembledDatagrams (), 5, "Reassembled datagrams count not correct");
+  NS_TEST_EXPECT_MSG_EQ (serverSix->GetReassemblyBufferSize (), 0, "Reassembly buffer not empty");
 
   // Second test: normal channel, no errors, delays each 2 packets.
   // Each other fragment will arrive out-of-order.
@@ -449,8 +452,138 @@ SixlowpanFragmentationTest::DoRun (void)
       // Note that a 6LoWPAN fragment timeout does NOT send any ICMPv6.
     }
 
+  // Fifth test: same as the fourth one, but the reassembly buffer can hold
+  // only one incomplete datagram.
+  // The second datagram must evict the first one.
+  serverSix->SetAttribute ("FragmentReassemblyMemory", UintegerValue (200));
+  SetFill (fillData, 78, 600);
+  serverDevErrorModel->Reset ();
+  m_receivedPacketServer = Create<Packet> ();
+  Simulator::ScheduleWithContext (m_socketClient->GetNode ()->GetId (), Seconds (0),
+                                  &SixlowpanFragmentationTest::SendClient, this);
+  Simulator::ScheduleWithContext (m_socketClient->GetNode ()->GetId (), Seconds (1),
+                                  &SixlowpanFragmentationTest::SendClient, this);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (serverSix->GetEvictedDatagrams (), 1, "Evicted datagrams count not correct");
+  NS_TEST_EXPECT_MSG_EQ (serverSix->GetReassemblyBufferSize (), 0, "Reassembly buffer not empty");
 
 
+
+  Simulator::Destroy ();
+}
+
+//-----------------------------------------------------------------------------
+class SixlowpanFragmentForwardingTest : public TestCase
+{
+  uint32_t m_receivedPackets;
+  uint32_t m_receivedBytes;
+
+public:
+  virtual void DoRun (void);
+  SixlowpanFragmentForwardingTest ();
+
+  Ptr<SixLowPanNetDevice> AddNode (Ptr<ErrorChannelSixlow> channel, Ipv6Address address, uint32_t mtu);
+  void HandleReadServer (Ptr<Socket> socket);
+  void SendClient (Ptr<Socket> socket, uint32_t size);
+};
+
+SixlowpanFragmentForwardingTest::SixlowpanFragmentForwardingTest ()
+  : TestCase ("Verify the 6LoWPAN fragment forwarding")
+{
+  m_receivedPackets = 0;
+  m_receivedBytes = 0;
+}
+
+Ptr<SixLowPanNetDevice>
+SixlowpanFragmentForwardingTest::AddNode (Ptr<ErrorChannelSixlow> channel, Ipv6Address address, uint32_t mtu)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  AddInternetStack (node);
+  node->GetObject<Icmpv6L4Protocol> ()->SetAttribute ("DAD", BooleanValue (false));
+
+  Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+  dev->SetAddress (Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+  dev->SetMtu (mtu);
+  node->AddDevice (dev);
+  dev->SetChannel (channel);
+
+  Ptr<SixLowPanNetDevice> six = CreateObject<SixLowPanNetDevice> ();
+  six->SetAttribute ("ForceEtherType", BooleanValue (true) );
+  six->SetAttribute ("FragmentForwarding", BooleanValue (true) );
+  node->AddDevice (six);
+  six->SetNetDevice (dev);
+
+  Ptr<Ipv6> ipv6 = node->GetObject<Ipv6> ();
+  ipv6->AddInterface (dev);
+  uint32_t netdev_idx = ipv6->AddInterface (six);
+  ipv6->AddAddress (netdev_idx, Ipv6InterfaceAddress (address, Ipv6Prefix (64)));
+  ipv6->SetUp (netdev_idx);
+
+  return six;
+}
+
+void
+SixlowpanFragmentForwardingTest::HandleReadServer (Ptr<Socket> socket)
+{
+  Ptr<Packet> packet;
+  Address from;
+  while ((packet = socket->RecvFrom (from)))
+    {
+      m_receivedPackets++;
+      m_receivedBytes += packet->GetSize ();
+    }
+}
+
+void
+SixlowpanFragmentForwardingTest::SendClient (Ptr<Socket> socket, uint32_t size)
+{
+  socket->Send (Create<Packet> (size));
+}
+
+void
+SixlowpanFragmentForwardingTest::DoRun (void)
+{
+  // Client, router and server share the same link, but the client
+  // reaches the server through the router.
+  Ptr<ErrorChannelSixlow> channel = CreateObject<ErrorChannelSixlow> ();
+  Ptr<SixLowPanNetDevice> clientSix = AddNode (channel, Ipv6Address ("2001:0100::2"), 150);
+  Ptr<SixLowPanNetDevice> routerSix = AddNode (channel, Ipv6Address ("2001:0100::3"), 150);
+  Ptr<SixLowPanNetDevice> serverSix = AddNode (channel, Ipv6Address ("2001:0100::1"), 150);
+
+  Ptr<Node> clientNode = clientSix->GetNode ();
+  Ptr<Ipv6> clientIpv6 = clientNode->GetObject<Ipv6> ();
+  int16_t priority;
+  Ptr<Ipv6StaticRouting> clientRouting = DynamicCast<Ipv6StaticRouting> (
+      DynamicCast<Ipv6ListRouting> (clientIpv6->GetRoutingProtocol ())->GetRoutingProtocol (0, priority));
+  clientRouting->AddHostRouteTo (Ipv6Address ("2001:0100::1"), Ipv6Address ("2001:0100::3"),
+                                 clientIpv6->GetInterfaceForDevice (clientSix));
+
+  Ptr<Ipv6L3Protocol> routerIpv6 = routerSix->GetNode ()->GetObject<Ipv6L3Protocol> ();
+  routerIpv6->SetForwarding (routerIpv6->GetInterfaceForDevice (routerSix), true);
+  routerIpv6->SetAttribute ("SendIcmpv6Redirect", BooleanValue (false));
+
+  Ptr<Socket> serverSocket = Socket::CreateSocket (serverSix->GetNode (), TypeId::LookupByName ("ns3::UdpSocketFactory"));
+  serverSocket->Bind (Inet6SocketAddress (Ipv6Address ("2001:0100::1"), 9));
+  serverSocket->SetRecvCallback (MakeCallback (&SixlowpanFragmentForwardingTest::HandleReadServer, this));
+
+  Ptr<Socket> clientSocket = Socket::CreateSocket (clientNode, TypeId::LookupByName ("ns3::UdpSocketFactory"));
+  clientSocket->Bind (Inet6SocketAddress (Ipv6Address::GetAny (), 9));
+  clientSocket->Connect (Inet6SocketAddress (Ipv6Address ("2001:0100::1"), 9));
+
+  // The first packet is reassembled by the router, as the server link-layer
+  // address is not yet known. The second one is forwarded fragment by fragment.
+  Simulator::ScheduleWithContext (clientNode->GetId (), Seconds (0),
+                                  &SixlowpanFragmentForwardingTest::SendClient, this, clientSocket, 500);
+  Simulator::ScheduleWithContext (clientNode->GetId (), Seconds (1),
+                                  &SixlowpanFragmentForwardingTest::SendClient, this, clientSocket, 500);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_receivedPackets, 2, "Server did not receive all the packets");
+  NS_TEST_EXPECT_MSG_EQ (m_receivedBytes, 1000, "Server received wrong packet sizes");
+  NS_TEST_EXPECT_MSG_EQ (routerSix->GetReassembledDatagrams (), 1, "Router reassembled a forwarded packet");
+  NS_TEST_EXPECT_MSG_GT (routerSix->GetForwardedFragments (), 0, "Router did not forward any fragment");
+  NS_TEST_EXPECT_MSG_EQ (serverSix->GetReassembledDatagrams (), 2, "Server did not reassemble all the packets");
+
   Simulator::Destroy ();
 }
 //-----------------------------------------------------------------------------
@@ -460,5 +593,6 @@ public:
   SixlowpanFragmentationTestSuite () : TestSuite ("sixlowpan-fragmentation", UNIT)
   {
     AddTestCase (new SixlowpanFragmentationTest, TestCase::QUICK);
+    AddTestCase (new SixlowpanFragmentForwardingTest, TestCase::QUICK);
   }
 } g_sixlowpanFragmentationTestSuite;
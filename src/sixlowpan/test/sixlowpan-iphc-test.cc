@@ -71,6 +71,7 @@ AddInternetStack6 (Ptr<Node> node)
 class SixlowpanIphcImplTest : public TestCase
 {
   Ptr<Packet> m_receivedPacket;
+  uint32_t m_txSize;
   void DoSendData (Ptr<Socket> socket, std::string to);
   void SendData (Ptr<Socket> socket, std::string to);
 
@@ -80,6 +81,7 @@ public:
 
   void ReceivePacket (Ptr<Socket> socket, Ptr<Packet> packet, const Address &from);
   void ReceivePkt (Ptr<Socket> socket);
+  void TxTrace (Ptr<const Packet> packet, Ptr<SixLowPanNetDevice> device, uint32_t ifIndex);
 };
 
 SixlowpanIphcImplTest::SixlowpanIphcImplTest ()
@@ -103,6 +105,11 @@ void SixlowpanIphcImplTest::ReceivePkt (Ptr<Socket> socket)
   (void) availableData;
 }
 
+void SixlowpanIphcImplTest::TxTrace (Ptr<const Packet> packet, Ptr<SixLowPanNetDevice> device, uint32_t ifIndex)
+{
+  m_txSize = packet->GetSize ();
+}
+
 void
 SixlowpanIphcImplTest::DoSendData (Ptr<Socket> socket, std::string to)
 {
@@ -132,12 +139,13 @@ SixlowpanIphcImplTest::DoRun (void)
   Ptr<Node> rxNode = CreateObject<Node> ();
   AddInternetStack6 (rxNode);
   Ptr<SimpleNetDevice> rxDev;
+  Ptr<SixLowPanNetDevice> rxSix;
   { // first interface
     rxDev = CreateObject<SimpleNetDevice> ();
     rxDev->SetAddress (Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
     rxNode->AddDevice (rxDev);
 
-    Ptr<SixLowPanNetDevice> rxSix = CreateObject<SixLowPanNetDevice> ();
+    rxSix = CreateObject<SixLowPanNetDevice> ();
     rxSix->SetAttribute ("ForceEtherType", BooleanValue (true) );
     rxNode->AddDevice (rxSix);
     rxSix->SetNetDevice (rxDev);
@@ -154,12 +162,13 @@ SixlowpanIphcImplTest::DoRun (void)
   Ptr<Node> txNode = CreateObject<Node> ();
   AddInternetStack6 (txNode);
   Ptr<SimpleNetDevice> txDev;
+  Ptr<SixLowPanNetDevice> txSix;
   {
     txDev = CreateObject<SimpleNetDevice> ();
     txDev->SetAddress (Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
     txNode->AddDevice (txDev);
 
-    Ptr<SixLowPanNetDevice> txSix = CreateObject<SixLowPanNetDevice> ();
+    txSix = CreateObject<SixLowPanNetDevice> ();
     txSix->SetAttribute ("ForceEtherType", BooleanValue (true) );
     txNode->AddDevice (txSix);
     txSix->SetNetDevice (txDev);
@@ -186,6 +195,7 @@ SixlowpanIphcImplTest::DoRun (void)
   Ptr<SocketFactory> txSocketFactory = txNode->GetObject<UdpSocketFactory> ();
   Ptr<Socket> txSocket = txSocketFactory->CreateSocket ();
   txSocket->SetAllowBroadcast (true);
+  txSix->TraceConnectWithoutContext ("Tx", MakeCallback (&SixlowpanIphcImplTest::TxTrace, this));
   // ------ Now the tests ------------
 
   // Unicast test
@@ -198,6 +208,18 @@ SixlowpanIphcImplTest::DoRun (void)
 
   m_receivedPacket->RemoveAllByteTags ();
 
+  // Context-based unicast test: both addresses are compressed to 64 bits.
+  uint32_t statelessSize = m_txSize;
+  txSix->AddContext (0, Ipv6Address ("2001:0100::"), Ipv6Prefix (64), true);
+  rxSix->AddContext (0, Ipv6Address ("2001:0100::"), Ipv6Prefix (64), true);
+  SendData (txSocket, "2001:0100::1");
+  NS_TEST_EXPECT_MSG_EQ (m_receivedPacket->GetSize (), 180, "trivial");
+  m_receivedPacket->CopyData (rxBuffer, 180);
+  NS_TEST_EXPECT_MSG_EQ (memcmp (rxBuffer, txBuffer, 180), 0, "trivial");
+  NS_TEST_EXPECT_MSG_EQ (m_txSize, statelessSize - 16, "Context-based compression did not shrink the addresses");
+
+  m_receivedPacket->RemoveAllByteTags ();
+
   Simulator::Destroy ();
 
 }
@@ -67,6 +67,7 @@ SpectrumModel::SpectrumModel (std::vector<double> centerFreqs)
           e.fh = ((*(it + 1)) + (*it)) / 2;
         }
       m_bands.push_back (e);
+      m_bandWidths.push_back (e.fh - e.fl);
     }
 }
 
@@ -75,6 +76,10 @@ SpectrumModel::SpectrumModel (Bands bands)
   m_uid = ++m_uidCount;
   NS_LOG_INFO ("creating new SpectrumModel, m_uid=" << m_uid);
   m_bands = bands;
+  for (Bands::const_iterator it = m_bands.begin (); it != m_bands.end (); ++it)
+    {
+      m_bandWidths.push_back (it->fh - it->fl);
+    }
 }
 
 Bands::const_iterator
@@ -89,6 +94,12 @@ SpectrumModel::End () const
   return m_bands.end ();
 }
 
+const std::vector<double>&
+SpectrumModel::GetBandWidths () const
+{
+  return m_bandWidths;
+}
+
 size_t
 SpectrumModel::GetNumBands () const
 {
@@ -106,9 +106,17 @@ public:
   Bands::const_iterator Begin () const;
   Bands::const_iterator End () const;
 
+  /**
+   *
+   * @return the width fh - fl of each band, in the order of the bands
+   */
+  const std::vector<double>& GetBandWidths () const;
+
 private:
   Bands m_bands;         ///< actual definition of frequency bands
                          /// within this SpectrumModel
+  std::vector<double> m_bandWidths; ///< width of each band, contiguous
+                                    /// for the Integral of SpectrumValues
   SpectrumModelUid_t m_uid;        ///< unique id for a given set of frequencies
   static SpectrumModelUid_t m_uidCount;    ///< counter to assign m_uids
 };
@@ -51,5 +51,11 @@ SpectrumPhy::~SpectrumPhy ()
   NS_LOG_FUNCTION (this);
 }
 
+bool
+SpectrumPhy::SupportsPsdGain (void) const
+{
+  return false;
+}
+
 
 } // namespace
@@ -108,6 +108,17 @@ public:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params) = 0;
 
+  /**
+   * \brief Whether the PHY handles SpectrumSignalParameters::psdGain.
+   *
+   * A PHY which supports it receives the PSD of the transmitter, shared with
+   * the other receivers, and the path gain in psdGain; the other PHYs
+   * receive their own copy of the PSD, already scaled.
+   *
+   * @return true if StartRx applies psdGain to the PSD; false by default
+   */
+  virtual bool SupportsPsdGain (void) const;
+
 private:
   SpectrumPhy (SpectrumPhy const &);
   SpectrumPhy& operator= (SpectrumPhy const &);
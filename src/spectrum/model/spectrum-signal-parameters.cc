@@ -31,6 +31,7 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("SpectrumSignalParameters");
 
 SpectrumSignalParameters::SpectrumSignalParameters ()
+  : psdGain (1.0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -43,7 +44,8 @@ SpectrumSignalParameters::~SpectrumSignalParameters ()
 SpectrumSignalParameters::SpectrumSignalParameters (const SpectrumSignalParameters& p)
 {
   NS_LOG_FUNCTION (this << &p);
-  psd = p.psd->Copy ();
+  psd = p.psd;
+  psdGain = p.psdGain;
   duration = p.duration;
   txPhy = p.txPhy;
   txAntenna = p.txAntenna;
@@ -56,6 +58,15 @@ SpectrumSignalParameters::Copy ()
   return Create<SpectrumSignalParameters> (*this);
 }
 
+void
+SpectrumSignalParameters::ApplyPsdGain (void)
+{
+  NS_LOG_FUNCTION (this << psdGain);
+  psd = psd->Copy ();
+  *psd *= psdGain;
+  psdGain = 1.0;
+}
+
 
 
 } // namespace ns3
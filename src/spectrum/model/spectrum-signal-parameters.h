@@ -87,10 +87,25 @@ struct SpectrumSignalParameters : public SimpleRefCount<SpectrumSignalParameters
    * underwater acoustic communications. Other transmission media to
    * be defined.
    *
-   * \note when SpectrumSignalParameters is copied, only the pointer to the PSD will be copied. This is because SpectrumChannel objects normally overwrite the psd anyway, so there is no point in making a copy.
+   * \note when SpectrumSignalParameters is copied, only the pointer to the PSD will be copied. The PSD is shared by the transmitter and the receivers of the signal, and must not be modified: the channel makes a copy only where the received PSD differs from the transmitted one.
    */
   Ptr <SpectrumValue> psd;
 
+  /**
+   * The linear gain of the signal not applied to psd yet: the received
+   * Power Spectral Density is psd times psdGain. The channel sets it to
+   * the path gain of the receivers which support it (see
+   * SpectrumPhy::SupportsPsdGain), so that they share the PSD of the
+   * transmitter; it is 1 for the other receivers.
+   */
+  double psdGain;
+
+  /**
+   * \brief Give this signal its own PSD, scaled by psdGain, and reset
+   * psdGain to 1.
+   */
+  void ApplyPsdGain (void);
+
   /**
    * The duration of the packet transmission. It is
    * assumed that the Power Spectral Density remains constant for the
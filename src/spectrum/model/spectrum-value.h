@@ -408,6 +408,18 @@ public:
    */
   SpectrumValue& operator= (double rhs);
 
+  /**
+   * Add the Right Hand Side, multiplied by a gain, to *this, component
+   * by component. This is *this += rhs * gain, without the temporary
+   * SpectrumValue.
+   *
+   * @param rhs the Right Hand Side
+   * @param gain the gain applied to rhs
+   *
+   * @return a reference to *this
+   */
+  SpectrumValue& AddScaled (const SpectrumValue& rhs, double gain);
+
 
 
   /**
@@ -0,0 +1,256 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <vector>
+#include <ns3/log.h>
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/ptr.h>
+#include <ns3/net-device.h>
+#include <ns3/antenna-model.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/constant-position-mobility-model.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("SpectrumPsdGainTest");
+
+/**
+ * A PHY which records the signals it receives, and may support
+ * SpectrumSignalParameters::psdGain.
+ */
+class PsdGainTestPhy : public SpectrumPhy
+{
+public:
+  /**
+   * \param model the SpectrumModel of the PHY
+   * \param position the position of the PHY
+   * \param supportsPsdGain the value returned by SupportsPsdGain
+   */
+  PsdGainTestPhy (Ptr<const SpectrumModel> model, Vector position, bool supportsPsdGain);
+
+  virtual void SetDevice (Ptr<NetDevice> d);
+  virtual Ptr<NetDevice> GetDevice ();
+  virtual void SetMobility (Ptr<MobilityModel> m);
+  virtual Ptr<MobilityModel> GetMobility ();
+  virtual void SetChannel (Ptr<SpectrumChannel> c);
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const;
+  virtual Ptr<AntennaModel> GetRxAntenna ();
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params);
+  virtual bool SupportsPsdGain (void) const;
+
+  /// the signals received
+  std::vector<Ptr<SpectrumSignalParameters> > m_rx;
+
+private:
+  virtual void DoDispose (void);
+
+  Ptr<const SpectrumModel> m_model;  //!< the SpectrumModel of the PHY
+  Ptr<MobilityModel> m_mobility;     //!< the position of the PHY
+  bool m_supportsPsdGain;            //!< the value returned by SupportsPsdGain
+};
+
+PsdGainTestPhy::PsdGainTestPhy (Ptr<const SpectrumModel> model, Vector position, bool supportsPsdGain)
+  : m_model (model),
+    m_supportsPsdGain (supportsPsdGain)
+{
+  m_mobility = CreateObject<ConstantPositionMobilityModel> ();
+  m_mobility->SetPosition (position);
+}
+
+void
+PsdGainTestPhy::DoDispose (void)
+{
+  m_rx.clear ();
+  m_mobility = 0;
+  SpectrumPhy::DoDispose ();
+}
+
+void
+PsdGainTestPhy::SetDevice (Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+PsdGainTestPhy::GetDevice ()
+{
+  return 0;
+}
+
+void
+PsdGainTestPhy::SetMobility (Ptr<MobilityModel> m)
+{
+  m_mobility = m;
+}
+
+Ptr<MobilityModel>
+PsdGainTestPhy::GetMobility ()
+{
+  return m_mobility;
+}
+
+void
+PsdGainTestPhy::SetChannel (Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+PsdGainTestPhy::GetRxSpectrumModel () const
+{
+  return m_model;
+}
+
+Ptr<AntennaModel>
+PsdGainTestPhy::GetRxAntenna ()
+{
+  return 0;
+}
+
+void
+PsdGainTestPhy::StartRx (Ptr<SpectrumSignalParameters> params)
+{
+  m_rx.push_back (params);
+}
+
+bool
+PsdGainTestPhy::SupportsPsdGain (void) const
+{
+  return m_supportsPsdGain;
+}
+
+
+/**
+ * Check the PSD and the psdGain of the signals received through a
+ * channel, by a PHY which supports psdGain and by a PHY which does not.
+ */
+class SpectrumPsdGainTestCase : public TestCase
+{
+public:
+  /**
+   * \param multiModel true to test MultiModelSpectrumChannel, false
+   *        for SingleModelSpectrumChannel
+   */
+  SpectrumPsdGainTestCase (bool multiModel);
+  virtual ~SpectrumPsdGainTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  bool m_multiModel;  //!< true to test MultiModelSpectrumChannel
+};
+
+SpectrumPsdGainTestCase::SpectrumPsdGainTestCase (bool multiModel)
+  : TestCase (multiModel ? "psdGain through a MultiModelSpectrumChannel" : "psdGain through a SingleModelSpectrumChannel"),
+    m_multiModel (multiModel)
+{
+}
+
+SpectrumPsdGainTestCase::~SpectrumPsdGainTestCase ()
+{
+}
+
+void
+SpectrumPsdGainTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  freqs.push_back (2.405e9);
+  freqs.push_back (2.410e9);
+  freqs.push_back (2.415e9);
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (freqs);
+
+  Ptr<SpectrumChannel> channel;
+  if (m_multiModel)
+    {
+      channel = CreateObject<MultiModelSpectrumChannel> ();
+    }
+  else
+    {
+      channel = CreateObject<SingleModelSpectrumChannel> ();
+    }
+  Ptr<FriisPropagationLossModel> loss = CreateObject<FriisPropagationLossModel> ();
+  channel->AddPropagationLossModel (loss);
+
+  Ptr<PsdGainTestPhy> tx = CreateObject<PsdGainTestPhy> (model, Vector (0, 0, 0), true);
+  Ptr<PsdGainTestPhy> scaled = CreateObject<PsdGainTestPhy> (model, Vector (10, 0, 0), false);
+  Ptr<PsdGainTestPhy> shared = CreateObject<PsdGainTestPhy> (model, Vector (0, 20, 0), true);
+  channel->AddRx (tx);
+  channel->AddRx (scaled);
+  channel->AddRx (shared);
+
+  Ptr<SpectrumValue> psd = Create<SpectrumValue> (model);
+  (*psd)[0] = 1e-9;
+  (*psd)[1] = 2e-9;
+  (*psd)[2] = 4e-9;
+  Ptr<SpectrumSignalParameters> txParams = Create<SpectrumSignalParameters> ();
+  txParams->psd = psd;
+  txParams->duration = MicroSeconds (100);
+  txParams->txPhy = tx;
+  channel->StartTx (txParams);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (tx->m_rx.size (), 0, "The transmitter received its own signal");
+  NS_TEST_ASSERT_MSG_EQ (scaled->m_rx.size (), 1, "Signal not received");
+  NS_TEST_ASSERT_MSG_EQ (shared->m_rx.size (), 1, "Signal not received");
+
+  // the PHY which does not support psdGain gets its own, scaled, PSD
+  double gain = std::pow (10.0, loss->CalcRxPower (0, tx->GetMobility (), scaled->GetMobility ()) / 10.0);
+  Ptr<SpectrumSignalParameters> rx = scaled->m_rx[0];
+  NS_TEST_EXPECT_MSG_NE (rx->psd, psd, "PSD of the transmitter shared with a PHY which does not support psdGain");
+  NS_TEST_EXPECT_MSG_EQ (rx->psdGain, 1.0, "psdGain not applied");
+  for (uint32_t i = 0; i < freqs.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL ((*rx->psd)[i], (*psd)[i] * gain, (*psd)[i] * gain * 1e-9, "Wrong received PSD in band " << i);
+    }
+
+  // the PHY which supports it gets the PSD of the transmitter, and the
+  // path gain in psdGain
+  gain = std::pow (10.0, loss->CalcRxPower (0, tx->GetMobility (), shared->GetMobility ()) / 10.0);
+  rx = shared->m_rx[0];
+  NS_TEST_EXPECT_MSG_EQ (rx->psd, psd, "PSD of the transmitter not shared");
+  NS_TEST_EXPECT_MSG_EQ_TOL (rx->psdGain, gain, gain * 1e-9, "Wrong psdGain");
+
+  // the PSD of the transmitter is not modified
+  NS_TEST_EXPECT_MSG_EQ ((*psd)[0], 1e-9, "PSD of the transmitter modified");
+  NS_TEST_EXPECT_MSG_EQ ((*psd)[1], 2e-9, "PSD of the transmitter modified");
+  NS_TEST_EXPECT_MSG_EQ ((*psd)[2], 4e-9, "PSD of the transmitter modified");
+
+  Simulator::Destroy ();
+  tx->Dispose ();
+  scaled->Dispose ();
+  shared->Dispose ();
+}
+
+
+class SpectrumPsdGainTestSuite : public TestSuite
+{
+public:
+  SpectrumPsdGainTestSuite ();
+};
+
+SpectrumPsdGainTestSuite::SpectrumPsdGainTestSuite ()
+  : TestSuite ("spectrum-psd-gain", UNIT)
+{
+  AddTestCase (new SpectrumPsdGainTestCase (false), TestCase::QUICK);
+  AddTestCase (new SpectrumPsdGainTestCase (true), TestCase::QUICK);
+}
+
+static SpectrumPsdGainTestSuite g_spectrumPsdGainTestSuite;
@@ -82,6 +82,49 @@ SpectrumValueTestCase::DoRun (void)
 
 
 
+/**
+ * Test Sum and Integral, which add the values in another order than a
+ * loop over the bands, against such a loop.
+ */
+class SpectrumValueReductionTestCase : public TestCase
+{
+public:
+  SpectrumValueReductionTestCase (SpectrumValue a, std::string name);
+  virtual ~SpectrumValueReductionTestCase ();
+  virtual void DoRun (void);
+
+private:
+  SpectrumValue m_a;
+};
+
+SpectrumValueReductionTestCase::SpectrumValueReductionTestCase (SpectrumValue a, std::string name)
+  : TestCase (name),
+    m_a (a)
+{
+}
+
+SpectrumValueReductionTestCase::~SpectrumValueReductionTestCase ()
+{
+}
+
+void
+SpectrumValueReductionTestCase::DoRun (void)
+{
+  double sum = 0;
+  double integral = 0;
+  Values::const_iterator vit = m_a.ConstValuesBegin ();
+  Bands::const_iterator bit = m_a.ConstBandsBegin ();
+  while (vit != m_a.ConstValuesEnd ())
+    {
+      sum += *vit;
+      integral += (*vit) * (bit->fh - bit->fl);
+      ++vit;
+      ++bit;
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (Sum (m_a), sum, TOLERANCE, "Sum");
+  NS_TEST_ASSERT_MSG_EQ_TOL (Integral (m_a), integral, TOLERANCE, "Integral");
+}
+
 class SpectrumValueTestSuite : public TestSuite
 {
 public:
@@ -227,6 +270,13 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
 
 
 
+  SpectrumValue tv11 (f);
+  tv11 = v1;
+  tv11.AddScaled (v2, doubleValue);
+  AddTestCase (new SpectrumValueTestCase (tv11, v1 + v2 * doubleValue, "tv11 = v1 + v2 * doubleValue"), TestCase::QUICK);
+
+  AddTestCase (new SpectrumValueReductionTestCase (v1, "Sum and Integral of v1"), TestCase::QUICK);
+
   SpectrumValue v1ls3 (f), v1rs3 (f);
   SpectrumValue tv1ls3 (f), tv1rs3 (f);
 
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Measure the throughput of Simulator::ScheduleWithContext called by
+// threads other than the simulation thread.
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdint.h>
+#include <time.h>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+namespace {
+
+/// \returns a monotonic time, in ns
+uint64_t
+GetNs (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * Producer threads inject events in a running simulation, which
+ * counts them and stops when all of them are received.
+ */
+class Injection
+{
+public:
+  Injection (uint32_t producers, uint32_t events)
+    : m_producers (producers),
+      m_events (events),
+      m_received (0),
+      m_pushNs (0),
+      m_start (0),
+      m_end (0)
+  {}
+  /// Run the simulation.
+  void Run (void)
+  {
+    Simulator::Schedule (Seconds (0), &Injection::Start, this);
+    Simulator::Run ();
+    for (uint32_t i = 0; i < m_threads.size (); i++)
+      {
+        m_threads[i]->Join ();
+      }
+    m_threads.clear ();
+    Simulator::Destroy ();
+  }
+  /// \returns the number of events received per second
+  double GetThroughput (void) const
+  {
+    return m_received * 1e9 / (m_end - m_start);
+  }
+  /// \returns the mean time spent by the producers to inject an event
+  double GetPushNs (void) const
+  {
+    return static_cast<double> (m_pushNs) / (m_producers * m_events);
+  }
+private:
+  void Start (void)
+  {
+    m_start = GetNs ();
+    for (uint32_t i = 0; i < m_producers; i++)
+      {
+        Ptr<SystemThread> thread =
+          Create<SystemThread> (MakeCallback (&Injection::Produce, this));
+        thread->Start ();
+        m_threads.push_back (thread);
+      }
+    Poll ();
+  }
+  void Produce (void)
+  {
+    uint64_t start = GetNs ();
+    for (uint32_t i = 0; i < m_events; i++)
+      {
+        Simulator::ScheduleWithContext (i, Seconds (0), &Injection::Receive, this);
+      }
+    __sync_fetch_and_add (&m_pushNs, GetNs () - start);
+  }
+  void Receive (void)
+  {
+    if (++m_received == m_producers * m_events)
+      {
+        m_end = GetNs ();
+        Simulator::Stop ();
+      }
+  }
+  // keeps the simulation running until all the events are received
+  void Poll (void)
+  {
+    Simulator::Schedule (MicroSeconds (10), &Injection::Poll, this);
+  }
+
+  uint32_t m_producers;
+  uint32_t m_events;
+  uint32_t m_received;
+  uint64_t m_pushNs;
+  uint64_t m_start;
+  uint64_t m_end;
+  std::vector<Ptr<SystemThread> > m_threads;
+};
+
+} // anonymous namespace
+
+
+int main (int argc, char *argv[])
+{
+  std::string only = "";
+  uint32_t maxProducers = 8;
+  uint32_t events = 100000;
+
+  CommandLine cmd;
+  cmd.Usage ("Measure the throughput of events injected with\n"
+             "Simulator::ScheduleWithContext by 1 to --producers threads.");
+  cmd.AddValue ("simulator", "only run this simulator implementation type", only);
+  cmd.AddValue ("producers", "maximum number of producer threads",        maxProducers);
+  cmd.AddValue ("events",    "number of events injected by each thread",  events);
+  cmd.Parse (argc, argv);
+
+  std::vector<std::string> impls;
+  if (only != "")
+    {
+      impls.push_back (only);
+    }
+  else
+    {
+      impls.push_back ("ns3::DefaultSimulatorImpl");
+      TypeId tid;
+      if (TypeId::LookupByNameFailSafe ("ns3::RealtimeSimulatorImpl", &tid))
+        {
+          impls.push_back (tid.GetName ());
+        }
+    }
+
+  std::cout << std::left
+            << std::setw (28) << "Simulator"
+            << std::setw (12) << "Producers"
+            << std::setw (16) << "Events/s"
+            << "Push ns" << std::endl;
+  for (uint32_t s = 0; s < impls.size (); s++)
+    {
+      for (uint32_t producers = 1; producers <= maxProducers; producers *= 2)
+        {
+          GlobalValue::Bind ("SimulatorImplementationType", StringValue (impls[s]));
+          Injection injection (producers, events);
+          injection.Run ();
+          std::cout << std::setw (28) << impls[s]
+                    << std::setw (12) << producers
+                    << std::setw (16) << static_cast<uint64_t> (injection.GetThroughput ())
+                    << injection.GetPushNs () << std::endl;
+        }
+    }
+  return 0;
+}
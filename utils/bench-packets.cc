@@ -20,6 +20,11 @@
 #include "ns3/system-wall-clock-ms.h"
 #include "ns3/packet.h"
 #include "ns3/packet-metadata.h"
+#ifdef NS3_BENCH_PACKETS_LR_WPAN
+#include "ns3/lr-wpan-mac-header.h"
+#include "ns3/lr-wpan-mac-trailer.h"
+#include "ns3/mac16-address.h"
+#endif
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -241,6 +246,67 @@ benchC (uint32_t n)
   }
 }
 
+static void
+benchE (uint32_t n)
+{
+  BenchHeader<25> ipv4;
+  BenchHeader<8> udp;
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (2000);
+    p->DisableMetadata ();
+    p->AddHeader (udp);
+    p->AddHeader (ipv4);
+    Ptr<Packet> o = p->Copy ();
+    o->RemoveHeader (ipv4);
+    o->RemoveHeader (udp);
+  }
+}
+
+#ifdef NS3_BENCH_PACKETS_LR_WPAN
+// A 127-byte 802.15.4 data frame: 9-byte MAC header with short
+// addresses and PAN id compression, 116-byte payload, 2-byte FCS.
+static void
+benchLrWpan (uint32_t n, bool fcs)
+{
+  LrWpanMacHeader header (LrWpanMacHeader::LRWPAN_MAC_DATA, 0);
+  header.SetPanIdComp ();
+  header.SetSrcAddrMode (LrWpanMacHeader::SHORTADDR);
+  header.SetDstAddrMode (LrWpanMacHeader::SHORTADDR);
+  header.SetSrcAddrFields (1, Mac16Address ("00:01"));
+  header.SetDstAddrFields (1, Mac16Address ("00:02"));
+  header.SetNoAckReq ();
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (116);
+    header.SetSeqNum (i);
+    p->AddHeader (header);
+    LrWpanMacTrailer trailer;
+    trailer.EnableFcs (fcs);
+    trailer.SetFcs (p);
+    p->AddTrailer (trailer);
+    Ptr<Packet> o = p->Copy ();
+    LrWpanMacTrailer receivedTrailer;
+    receivedTrailer.EnableFcs (fcs);
+    o->RemoveTrailer (receivedTrailer);
+    receivedTrailer.CheckFcs (o);
+    LrWpanMacHeader receivedHeader;
+    o->RemoveHeader (receivedHeader);
+  }
+}
+
+static void
+benchF (uint32_t n)
+{
+  benchLrWpan (n, false);
+}
+
+static void
+benchG (uint32_t n)
+{
+  benchLrWpan (n, true);
+}
+#endif /* NS3_BENCH_PACKETS_LR_WPAN */
 
 static void
 runBench (void (*bench) (uint32_t), uint32_t n, char const *name)
@@ -289,6 +355,11 @@ int main (int argc, char *argv[])
   runBench (&benchB, n, "Just add headers");
   runBench (&benchC, n, "Remove by func call");
   runBench (&benchD, n, "Intermixed add/remove headers and tags");
+  runBench (&benchE, n, "Copy packet without metadata, remove headers");
+#ifdef NS3_BENCH_PACKETS_LR_WPAN
+  runBench (&benchF, n, "Copy 802.15.4 frame, remove MAC header and trailer");
+  runBench (&benchG, n, "Same, with FCS");
+#endif
 
   return 0;
 }
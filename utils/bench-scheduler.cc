@@ -0,0 +1,375 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Replay the scheduler operations recorded by ns3::RecordingScheduler
+// against every scheduler implementation.
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <new>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "ns3/core-module.h"
+#include "ns3/recording-scheduler.h"
+
+using namespace ns3;
+
+namespace {
+
+// The heap usage is tracked by storing the size of each block before it.
+const size_t g_header = 16;
+size_t g_liveBytes = 0;
+size_t g_peakBytes = 0;
+
+} // anonymous namespace
+
+void *
+operator new (size_t size)
+{
+  void *p = std::malloc (size + g_header);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  *static_cast<size_t *> (p) = size;
+  g_liveBytes += size;
+  if (g_liveBytes > g_peakBytes)
+    {
+      g_peakBytes = g_liveBytes;
+    }
+  return static_cast<char *> (p) + g_header;
+}
+
+void
+operator delete (void *p) throw ()
+{
+  if (p == 0)
+    {
+      return;
+    }
+  void *block = static_cast<char *> (p) - g_header;
+  g_liveBytes -= *static_cast<size_t *> (block);
+  std::free (block);
+}
+
+namespace {
+
+/// \returns a monotonic time, in ns
+uint64_t
+GetNs (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/// Count the cache misses of the calling thread, when the kernel allows it.
+class CacheMissCounter
+{
+public:
+  CacheMissCounter ()
+    : m_fd (-1)
+  {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    std::memset (&attr, 0, sizeof (attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof (attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    m_fd = syscall (__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+  ~CacheMissCounter ()
+  {
+    if (m_fd >= 0)
+      {
+        close (m_fd);
+      }
+  }
+  bool IsAvailable (void) const
+  {
+    return m_fd >= 0;
+  }
+  void Start (void)
+  {
+#ifdef __linux__
+    if (m_fd >= 0)
+      {
+        ioctl (m_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl (m_fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+  }
+  uint64_t Stop (void)
+  {
+    uint64_t count = 0;
+#ifdef __linux__
+    if (m_fd >= 0)
+      {
+        ioctl (m_fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read (m_fd, &count, sizeof (count)) != sizeof (count))
+          {
+            count = 0;
+          }
+      }
+#endif
+    return count;
+  }
+private:
+  int m_fd;
+};
+
+/// The results of one replay.
+struct Result
+{
+  uint64_t insertNs;       //!< total time of the Insert operations
+  uint64_t removeNextNs;   //!< total time of the RemoveNext operations
+  uint64_t removeNs;       //!< total time of the Remove operations
+  uint64_t totalNs;        //!< total time of the replay
+  size_t peakBytes;        //!< peak heap usage of the scheduler
+  uint64_t cacheMisses;    //!< cache misses of the replay
+  uint32_t errors;         //!< events returned out of the recorded order
+};
+
+/**
+ * Replay the records against a scheduler.
+ *
+ * \param type the scheduler type
+ * \param records the records
+ * \param timerNs the overhead of a timer measure, subtracted from each operation
+ * \param counter the cache miss counter
+ * \returns the results
+ */
+Result
+Replay (TypeId type, const std::vector<RecordingScheduler::Record> &records,
+        uint64_t timerNs, CacheMissCounter &counter)
+{
+  // the events are never invoked, so a fake implementation pointer is enough
+  static uint64_t impl;
+  Result result = { 0, 0, 0, 0, 0, 0, 0 };
+  uint64_t ops[RecordingScheduler::REMOVE_NEXT + 1] = { 0 };
+  uint64_t ns[RecordingScheduler::REMOVE_NEXT + 1] = { 0 };
+
+  size_t base = g_liveBytes;
+  g_peakBytes = base;
+  ObjectFactory factory;
+  factory.SetTypeId (type);
+  Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+
+  counter.Start ();
+  uint64_t start = GetNs ();
+  for (std::vector<RecordingScheduler::Record>::const_iterator i = records.begin ();
+       i != records.end (); i++)
+    {
+      Scheduler::Event ev;
+      ev.impl = reinterpret_cast<EventImpl *> (&impl);
+      ev.key = i->key;
+      uint64_t before = GetNs ();
+      switch (i->op)
+        {
+        case RecordingScheduler::INSERT:
+          scheduler->Insert (ev);
+          break;
+        case RecordingScheduler::REMOVE:
+          scheduler->Remove (ev);
+          break;
+        case RecordingScheduler::REMOVE_NEXT:
+          ev = scheduler->RemoveNext ();
+          break;
+        }
+      ns[i->op] += GetNs () - before;
+      ops[i->op]++;
+      if (i->op == RecordingScheduler::REMOVE_NEXT && ev.key.m_ts != i->key.m_ts)
+        {
+          result.errors++;
+        }
+    }
+  result.totalNs = GetNs () - start;
+  result.cacheMisses = counter.Stop ();
+  result.peakBytes = g_peakBytes - base;
+  scheduler = 0;
+
+  uint64_t *totals[RecordingScheduler::REMOVE_NEXT + 1] =
+    { 0, &result.insertNs, &result.removeNs, &result.removeNextNs };
+  for (uint32_t op = RecordingScheduler::INSERT; op <= RecordingScheduler::REMOVE_NEXT; op++)
+    {
+      uint64_t overhead = ops[op] * timerNs;
+      *totals[op] = ns[op] > overhead ? ns[op] - overhead : 0;
+      *totals[op] = ops[op] ? *totals[op] / ops[op] : 0;
+    }
+  return result;
+}
+
+/**
+ * Record a synthetic workload: a population of events, each scheduling
+ * a new event after an exponential delay.
+ */
+class Workload
+{
+public:
+  Workload (uint32_t population, uint32_t total)
+    : m_population (population),
+      m_total (total),
+      m_count (0)
+  {
+    m_rand = CreateObject<ExponentialRandomVariable> ();
+    m_rand->SetAttribute ("Mean", DoubleValue (100));
+  }
+  void Run (void)
+  {
+    for (uint32_t i = 0; i < m_population; i++)
+      {
+        Simulator::Schedule (NanoSeconds (m_rand->GetInteger ()), &Workload::Cb, this);
+      }
+    Simulator::Run ();
+    Simulator::Destroy ();
+  }
+private:
+  void Cb (void)
+  {
+    if (++m_count < m_total)
+      {
+        Simulator::Schedule (NanoSeconds (m_rand->GetInteger ()), &Workload::Cb, this);
+      }
+  }
+  Ptr<ExponentialRandomVariable> m_rand;
+  uint32_t m_population;
+  uint32_t m_total;
+  uint32_t m_count;
+};
+
+} // anonymous namespace
+
+
+int main (int argc, char *argv[])
+{
+  std::string filename = "";
+  std::string only = "";
+  uint32_t pop   =  10000;
+  uint32_t total = 100000;
+  uint32_t runs  =      1;
+
+  CommandLine cmd;
+  cmd.Usage ("Replay recorded scheduler operations against every scheduler.\n"
+             "\n"
+             "Record the operations of a simulation with\n"
+             "  --SchedulerType=ns3::RecordingScheduler\n"
+             "  --ns3::RecordingScheduler::FileName=<file>\n"
+             "then replay them with --file=<file>. Without --file, a\n"
+             "synthetic workload is recorded and replayed.");
+  cmd.AddValue ("file",      "the recorded operations",                 filename);
+  cmd.AddValue ("scheduler", "only replay against this scheduler type",   only);
+  cmd.AddValue ("pop",       "synthetic event population size",         pop);
+  cmd.AddValue ("total",     "synthetic total number of events",        total);
+  cmd.AddValue ("runs",      "number of replays for each scheduler",    runs);
+  cmd.Parse (argc, argv);
+
+  if (filename == "")
+    {
+      filename = "bench-scheduler.rec";
+      std::cout << "Recording a synthetic workload to " << filename << std::endl;
+      ObjectFactory factory ("ns3::RecordingScheduler");
+      factory.Set ("FileName", StringValue (filename));
+      Simulator::SetScheduler (factory);
+      Workload workload (pop, total);
+      workload.Run ();
+    }
+
+  std::vector<RecordingScheduler::Record> records;
+  if (!RecordingScheduler::Read (filename, records))
+    {
+      std::cerr << "Cannot read " << filename << std::endl;
+      return 1;
+    }
+  std::cout << "Replaying " << records.size () << " operations from " << filename << std::endl;
+
+  std::vector<TypeId> schedulers;
+  if (only != "")
+    {
+      schedulers.push_back (TypeId::LookupByName (only));
+    }
+  else
+    {
+      for (uint32_t i = 0; i < TypeId::GetRegisteredN (); i++)
+        {
+          TypeId tid = TypeId::GetRegistered (i);
+          if (tid.IsChildOf (Scheduler::GetTypeId ()) && tid.HasConstructor ()
+              && tid != RecordingScheduler::GetTypeId ())
+            {
+              schedulers.push_back (tid);
+            }
+        }
+    }
+
+  // the cost of a timer measure
+  uint64_t start = GetNs ();
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      GetNs ();
+    }
+  uint64_t timerNs = (GetNs () - start) / 10000;
+
+  CacheMissCounter counter;
+  std::cout << std::left
+            << std::setw (28) << "Scheduler"
+            << std::setw (8) << "Run"
+            << std::setw (12) << "Total ms"
+            << std::setw (12) << "Insert ns"
+            << std::setw (12) << "Next ns"
+            << std::setw (12) << "Remove ns"
+            << std::setw (12) << "Peak KiB"
+            << std::setw (14) << "Cache misses"
+            << "Errors" << std::endl;
+  for (uint32_t s = 0; s < schedulers.size (); s++)
+    {
+      for (uint32_t run = 0; run < runs; run++)
+        {
+          Result result = Replay (schedulers[s], records, timerNs, counter);
+          std::cout << std::setw (28) << schedulers[s].GetName ()
+                    << std::setw (8) << run
+                    << std::setw (12) << result.totalNs / 1000000.0
+                    << std::setw (12) << result.insertNs
+                    << std::setw (12) << result.removeNextNs
+                    << std::setw (12) << result.removeNs
+                    << std::setw (12) << result.peakBytes / 1024;
+          if (counter.IsAvailable ())
+            {
+              std::cout << std::setw (14) << result.cacheMisses;
+            }
+          else
+            {
+              std::cout << std::setw (14) << "n/a";
+            }
+          std::cout << result.errors << std::endl;
+        }
+    }
+  return 0;
+}
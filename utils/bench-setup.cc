@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Measure the setup of a large simulation: the creation of LrWpanTsch
+// device stacks, and the TypeId lookups by name it relies on.
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdint.h>
+#include <time.h>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/lr-wpan-module.h"
+
+using namespace ns3;
+
+namespace {
+
+/// \returns a monotonic time, in ns
+uint64_t
+GetNs (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/// An energy trace sink, as connected by LrWpanTschHelper.
+void
+EnergySink (std::string context, uint32_t slot)
+{
+}
+
+/**
+ * Print a measure.
+ * \param name the name of the measure
+ * \param start the start time of the measure, in ns
+ * \param n the number of operations measured
+ */
+void
+Report (std::string name, uint64_t start, uint32_t n)
+{
+  double ns = static_cast<double> (GetNs () - start) / n;
+  std::cout << std::setw (36) << name << ns << std::endl;
+}
+
+} // anonymous namespace
+
+
+int main (int argc, char *argv[])
+{
+  uint32_t stacks = 10000;
+  uint32_t lookups = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue ("stacks",  "number of LrWpanTschNetDevice stacks created", stacks);
+  cmd.AddValue ("lookups", "number of lookups of each kind",                lookups);
+  cmd.Parse (argc, argv);
+
+  std::cout << std::left << std::setw (36) << "Operation" << "ns" << std::endl;
+
+  uint64_t start = GetNs ();
+  TypeId tid;
+  for (uint32_t i = 0; i < lookups; i++)
+    {
+      tid = TypeId::LookupByName ("ns3::LrWpanTschNetDevice");
+    }
+  Report ("TypeId::LookupByName", start, lookups);
+
+  TypeId::AttributeInformation info;
+  TypeId macTid = TypeId::LookupByName ("ns3::LrWpanTschMac");
+  start = GetNs ();
+  for (uint32_t i = 0; i < lookups; i++)
+    {
+      tid.LookupAttributeByName ("UseAcks", &info);
+    }
+  Report ("TypeId::LookupAttributeByName", start, lookups);
+
+  start = GetNs ();
+  for (uint32_t i = 0; i < lookups; i++)
+    {
+      macTid.LookupTraceSourceByName ("MacTxDataRxAck");
+    }
+  Report ("TypeId::LookupTraceSourceByName", start, lookups);
+
+  start = GetNs ();
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::LrWpanTschNetDevice");
+  factory.Set ("UseAcks", BooleanValue (false));
+  for (uint32_t i = 0; i < stacks; i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      Ptr<LrWpanTschNetDevice> device = factory.Create<LrWpanTschNetDevice> ();
+      node->AddDevice (device);
+      std::ostringstream oss;
+      oss << "/NodeList/" << node->GetId () << "/DeviceList/0/$ns3::LrWpanTschNetDevice/TschMac/";
+      device->GetNMac ()->TraceConnect ("MacTxData", oss.str () + "MacTxData", MakeCallback (&EnergySink));
+      device->GetNMac ()->TraceConnect ("MacRxData", oss.str () + "MacRxData", MakeCallback (&EnergySink));
+    }
+  Report ("LrWpanTschNetDevice stack", start, stacks);
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -45,7 +45,8 @@ public:
   Bench (const uint32_t population, const uint32_t total)
   : m_population (population),
     m_total (total),
-    m_count (0)
+    m_count (0),
+    m_timers (false)
   { };
   
   void SetRandomStream (Ptr<RandomVariableStream> stream)
@@ -62,15 +63,23 @@ public:
   {
     m_total = total;
   }
+
+  void SetTimers (const bool timers)
+  {
+    m_timers = timers;
+  }
     
   void RunBench (void);
 private:
   void Cb (void);
+  void Timeout (void);
   
   Ptr<RandomVariableStream> m_rand;
   uint32_t m_population;
   uint32_t m_total;
   uint32_t m_count;
+  bool m_timers;
+  EventId m_timeout;
 };
 
 void
@@ -80,6 +89,8 @@ Bench::RunBench (void)
   double init, simu;
 
   DEB ("initializing");
+  m_count = 0;
+  m_timeout = EventId ();
 
   time.Start ();
   for (uint32_t i = 0; i < m_population; ++i)
@@ -121,6 +132,20 @@ Bench::Cb (void)
   Time after = NanoSeconds (m_rand->GetValue ());
   Simulator::Schedule (after, &Bench::Cb, this);
   ++m_count;
+
+  if (m_timers)
+    {
+      // restart a timeout, as MAC and transport protocols do:
+      // most timeouts are removed before they expire
+      Simulator::Remove (m_timeout);
+      m_timeout = Simulator::Schedule (after * 10, &Bench::Timeout, this);
+    }
+}
+
+void
+Bench::Timeout (void)
+{
+  DEB ("timeout at " << Simulator::Now ().GetSeconds () << "s");
 }
 
 
@@ -186,6 +211,10 @@ int main (int argc, char *argv[])
   bool schedHeap = false;
   bool schedList = false;
   bool schedMap  = true;
+  bool schedDary = false;
+  bool schedWheel = false;
+  bool schedAll  = false;
+  bool timers    = false;
 
   uint32_t pop   =  100000;
   uint32_t total = 1000000;
@@ -205,6 +234,10 @@ int main (int argc, char *argv[])
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
+  cmd.AddValue ("dary",  "use DaryHeapScheduler",         schedDary);
+  cmd.AddValue ("wheel", "use TimingWheelScheduler",      schedWheel);
+  cmd.AddValue ("all",   "run with every scheduler in turn", schedAll);
+  cmd.AddValue ("timers", "each event also restarts a timeout", timers);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
@@ -215,60 +248,85 @@ int main (int argc, char *argv[])
   g_me = cmd.GetName () + ": ";
   g_fwidth += 6;  // 5 extra chars in '2.000002e+07 ': . e+0 _
 
-  ObjectFactory factory ("ns3::MapScheduler");
-  if (schedCal)  { factory.SetTypeId ("ns3::CalendarScheduler"); }
-  if (schedHeap) { factory.SetTypeId ("ns3::HeapScheduler");     }
-  if (schedList) { factory.SetTypeId ("ns3::ListScheduler");     }  
-  Simulator::SetScheduler (factory);
+  std::vector<std::string> schedulers;
+  if (schedAll)
+    {
+      schedulers.push_back ("ns3::MapScheduler");
+      schedulers.push_back ("ns3::HeapScheduler");
+      schedulers.push_back ("ns3::ListScheduler");
+      schedulers.push_back ("ns3::CalendarScheduler");
+      schedulers.push_back ("ns3::DaryHeapScheduler");
+      schedulers.push_back ("ns3::TimingWheelScheduler");
+    }
+  else
+    {
+      std::string scheduler = "ns3::MapScheduler";
+      if (schedCal)  { scheduler = "ns3::CalendarScheduler"; }
+      if (schedHeap) { scheduler = "ns3::HeapScheduler";     }
+      if (schedList) { scheduler = "ns3::ListScheduler";     }
+      if (schedDary) { scheduler = "ns3::DaryHeapScheduler"; }
+      if (schedWheel) { scheduler = "ns3::TimingWheelScheduler"; }
+      schedulers.push_back (scheduler);
+    }
 
   LOGME (std::setprecision (g_fwidth - 6));
   DEB ("debugging is ON");
 
-  LOGME ("scheduler: " << factory.GetTypeId ().GetName ());
-  LOGME ("population: " << pop);
-  LOGME ("total events: " << total);
-  LOGME ("runs: " << runs);
+  for (uint32_t s = 0; s < schedulers.size (); s++)
+    {
+      ObjectFactory factory (schedulers[s]);
+      Simulator::SetScheduler (factory);
+
+      LOGME ("scheduler: " << factory.GetTypeId ().GetName ());
+      LOGME ("population: " << pop);
+      LOGME ("total events: " << total);
+      LOGME ("runs: " << runs);
+      LOGME ("timers: " << (timers ? "on" : "off"));
   
-  Bench *bench = new Bench (pop, total);
-  bench->SetRandomStream (GetRandomStream (filename));
-
-  // table header
-  LOG ("");
-  LOG (std::left << std::setw (g_fwidth) << "Run #" <<
-       std::left << std::setw (3 * g_fwidth) << "Inititialization:" <<
-       std::left << std::setw (3 * g_fwidth) << "Simulation:");
-  LOG (std::left << std::setw (g_fwidth) << "" <<
-       std::left << std::setw (g_fwidth) << "Time (s)" <<
-       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
-       std::left << std::setw (g_fwidth) << "Per (s/ev)" <<
-       std::left << std::setw (g_fwidth) << "Time (s)" <<
-       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
-       std::left << std::setw (g_fwidth) << "Per (s/ev)" );
-  LOG (std::setfill ('-') <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<       
-       std::right << std::setw (g_fwidth) << " " <<       
-       std::right << std::setw (g_fwidth) << " " <<       
-       std::right << std::setw (g_fwidth) << " " <<       
-       std::right << std::setw (g_fwidth) << " " <<       
-       std::right << std::setw (g_fwidth) << " " <<
-       std::setfill (' ')
-       );
+      Bench *bench = new Bench (pop, total);
+      bench->SetRandomStream (GetRandomStream (filename));
+      bench->SetTimers (timers);
+
+      // table header
+      LOG ("");
+      LOG (std::left << std::setw (g_fwidth) << "Run #" <<
+           std::left << std::setw (3 * g_fwidth) << "Inititialization:" <<
+           std::left << std::setw (3 * g_fwidth) << "Simulation:");
+      LOG (std::left << std::setw (g_fwidth) << "" <<
+           std::left << std::setw (g_fwidth) << "Time (s)" <<
+           std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+           std::left << std::setw (g_fwidth) << "Per (s/ev)" <<
+           std::left << std::setw (g_fwidth) << "Time (s)" <<
+           std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+           std::left << std::setw (g_fwidth) << "Per (s/ev)" );
+      LOG (std::setfill ('-') <<
+           std::right << std::setw (g_fwidth) << " " <<
+           std::right << std::setw (g_fwidth) << " " <<       
+           std::right << std::setw (g_fwidth) << " " <<       
+           std::right << std::setw (g_fwidth) << " " <<       
+           std::right << std::setw (g_fwidth) << " " <<       
+           std::right << std::setw (g_fwidth) << " " <<       
+           std::right << std::setw (g_fwidth) << " " <<
+           std::setfill (' ')
+           );
        
-  // prime
-  DEB ("priming");
-  std::cout << std::left << std::setw (g_fwidth) << "(prime)";
-  bench->RunBench ();
-
-  bench->SetPopulation (pop);
-  bench->SetTotal (total);
-  for (uint32_t i = 0; i < runs; i++)
-    {
-      std::cout << std::setw (g_fwidth) << i;
-      
+      // prime
+      DEB ("priming");
+      std::cout << std::left << std::setw (g_fwidth) << "(prime)";
       bench->RunBench ();
+
+      bench->SetPopulation (pop);
+      bench->SetTotal (total);
+      for (uint32_t i = 0; i < runs; i++)
+        {
+          std::cout << std::setw (g_fwidth) << i;
+      
+          bench->RunBench ();
+        }
+
+      delete bench;
+      LOG ("");
     }
 
-  LOG ("");
   return 0;
 }
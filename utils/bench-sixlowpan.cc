@@ -0,0 +1,313 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include <new>
+#include <stdlib.h>
+
+#include "ns3/core-module.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+#include "ns3/error-model.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/udp-header.h"
+#include "ns3/sixlowpan-net-device.h"
+
+using namespace ns3;
+
+/*
+ * Benchmark of the SixLowPanNetDevice send and receive paths.
+ *
+ * Synthetic IPv6/UDP packets are handed to a SixLowPanNetDevice, which
+ * compresses (HC1 or IPHC + NHC) and, if needed, fragments them. The frames
+ * are captured by a channel-less NetDevice and handed directly to the
+ * receiving SixLowPanNetDevice, which reassembles and decompresses them.
+ *
+ * For each scenario the program reports the time and the number of
+ * heap allocations per packet for the send path alone and for the full
+ * round trip, as well as the number of frames and the 6LoWPAN overhead
+ * (frame bytes minus UDP payload bytes) per packet.
+ */
+
+static uint64_t g_allocations = 0;
+
+void *
+operator new (std::size_t size)
+{
+  g_allocations++;
+  void *p = malloc (size == 0 ? 1 : size);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void *
+operator new[] (std::size_t size)
+{
+  return operator new (size);
+}
+
+void
+operator delete (void *p)
+{
+  free (p);
+}
+
+void
+operator delete[] (void *p)
+{
+  free (p);
+}
+
+/**
+ * A NetDevice without channel, which keeps the frames it is asked to send.
+ */
+class BenchLinkNetDevice : public SimpleNetDevice
+{
+public:
+  virtual bool Send (Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber)
+  {
+    m_frames.push_back (packet);
+    m_protocol = protocolNumber;
+    return true;
+  }
+  virtual bool SendFrom (Ptr<Packet> packet, const Address& source, const Address& dest, uint16_t protocolNumber)
+  {
+    return Send (packet, dest, protocolNumber);
+  }
+
+  std::vector<Ptr<Packet> > m_frames;
+  uint16_t m_protocol;
+};
+
+class Bench
+{
+public:
+  Bench (bool iphc, uint16_t mtu);
+
+  void Run (uint32_t payloadSize, uint32_t n);
+private:
+  void RunBench (uint32_t payloadSize, uint32_t n);
+  Ptr<Packet> MakePacket (uint32_t payloadSize) const;
+  void SendOne (Ptr<Packet> packet);
+  void Deliver (void);
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+
+  bool m_iphc;
+  Ptr<Node> m_rxNode;
+  Ptr<BenchLinkNetDevice> m_txLink;
+  Ptr<BenchLinkNetDevice> m_rxLink;
+  Ptr<SixLowPanNetDevice> m_txSix;
+  Ptr<SixLowPanNetDevice> m_rxSix;
+  uint32_t m_received;
+  uint32_t m_frameCount;
+  uint32_t m_frameBytes;
+};
+
+Bench::Bench (bool iphc, uint16_t mtu)
+  : m_iphc (iphc),
+    m_received (0),
+    m_frameCount (0),
+    m_frameBytes (0)
+{
+  Ptr<Node> txNode = CreateObject<Node> ();
+  m_rxNode = CreateObject<Node> ();
+
+  m_txLink = CreateObject<BenchLinkNetDevice> ();
+  m_txLink->SetAddress (Mac48Address::Allocate ());
+  m_txLink->SetMtu (mtu);
+  txNode->AddDevice (m_txLink);
+
+  m_rxLink = CreateObject<BenchLinkNetDevice> ();
+  m_rxLink->SetAddress (Mac48Address::Allocate ());
+  m_rxLink->SetMtu (mtu);
+  m_rxNode->AddDevice (m_rxLink);
+
+  m_txSix = CreateObject<SixLowPanNetDevice> ();
+  m_txSix->SetAttribute ("Rfc6282", BooleanValue (iphc));
+  m_txSix->SetAttribute ("ForceEtherType", BooleanValue (true));
+  txNode->AddDevice (m_txSix);
+  m_txSix->SetNetDevice (m_txLink);
+
+  m_rxSix = CreateObject<SixLowPanNetDevice> ();
+  m_rxSix->SetAttribute ("Rfc6282", BooleanValue (iphc));
+  m_rxSix->SetAttribute ("ForceEtherType", BooleanValue (true));
+  m_rxNode->AddDevice (m_rxSix);
+  m_rxSix->SetNetDevice (m_rxLink);
+  m_rxSix->SetReceiveCallback (MakeCallback (&Bench::Receive, this));
+}
+
+Ptr<Packet>
+Bench::MakePacket (uint32_t payloadSize) const
+{
+  Ptr<Packet> packet = Create<Packet> (payloadSize);
+
+  UdpHeader udp;
+  udp.SetSourcePort (0xf0b1);
+  udp.SetDestinationPort (5683);
+  packet->AddHeader (udp);
+
+  Ipv6Header ipv6;
+  ipv6.SetSourceAddress (Ipv6Address::MakeAutoconfiguredLinkLocalAddress (Mac48Address::ConvertFrom (m_txLink->GetAddress ())));
+  ipv6.SetDestinationAddress (Ipv6Address::MakeAutoconfiguredLinkLocalAddress (Mac48Address::ConvertFrom (m_rxLink->GetAddress ())));
+  ipv6.SetNextHeader (Ipv6Header::IPV6_UDP);
+  ipv6.SetPayloadLength (packet->GetSize ());
+  ipv6.SetHopLimit (64);
+  packet->AddHeader (ipv6);
+
+  return packet;
+}
+
+void
+Bench::SendOne (Ptr<Packet> packet)
+{
+  m_txSix->Send (packet, m_rxLink->GetAddress (), 0x86DD);
+}
+
+void
+Bench::Deliver (void)
+{
+  for (std::vector<Ptr<Packet> >::iterator it = m_txLink->m_frames.begin (); it != m_txLink->m_frames.end (); it++)
+    {
+      m_rxLink->Receive (*it, m_txLink->m_protocol,
+                         Mac48Address::ConvertFrom (m_rxLink->GetAddress ()),
+                         Mac48Address::ConvertFrom (m_txLink->GetAddress ()));
+    }
+  m_txLink->m_frames.clear ();
+}
+
+bool
+Bench::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  m_received++;
+  return true;
+}
+
+void
+Bench::Run (uint32_t payloadSize, uint32_t n)
+{
+  // The receiving node checks that frames are delivered in its context.
+  Simulator::ScheduleWithContext (m_rxNode->GetId (), Seconds (0),
+                                  &Bench::RunBench, this, payloadSize, n);
+  Simulator::Run ();
+}
+
+void
+Bench::RunBench (uint32_t payloadSize, uint32_t n)
+{
+  Ptr<Packet> packet = MakePacket (payloadSize);
+
+  // Frames and overhead of a single packet
+  SendOne (packet->Copy ());
+  m_frameCount = m_txLink->m_frames.size ();
+  m_frameBytes = 0;
+  for (std::vector<Ptr<Packet> >::iterator it = m_txLink->m_frames.begin (); it != m_txLink->m_frames.end (); it++)
+    {
+      m_frameBytes += (*it)->GetSize ();
+    }
+  m_txLink->m_frames.clear ();
+
+  // Send path only: compression and fragmentation
+  SystemWallClockMs time;
+  uint64_t allocations = g_allocations;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SendOne (packet->Copy ());
+      m_txLink->m_frames.clear ();
+    }
+  double txMs = time.End ();
+  double txAllocations = g_allocations - allocations;
+
+  // Round trip: the above plus reassembly and decompression
+  m_received = 0;
+  allocations = g_allocations;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SendOne (packet->Copy ());
+      Deliver ();
+    }
+  double rtMs = time.End ();
+  double rtAllocations = g_allocations - allocations;
+
+  if (m_received != n)
+    {
+      std::cerr << "Error-- " << m_received << " packets received out of " << n << std::endl;
+      exit (1);
+    }
+
+  std::cout << std::left
+            << std::setw (6) << (m_iphc ? "IPHC" : "HC1")
+            << std::setw (9) << payloadSize
+            << std::setw (8) << m_frameCount
+            << std::setw (10) << m_frameBytes - payloadSize
+            << std::setw (12) << txMs * 1e6 / n
+            << std::setw (12) << txAllocations / n
+            << std::setw (12) << rtMs * 1e6 / n
+            << std::setw (12) << rtAllocations / n
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 100000;
+  uint32_t mtu = 102;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the 6LoWPAN compression, fragmentation, reassembly and decompression paths.\n"
+             "\n"
+             "UDP payloads of increasing size are sent through a SixLowPanNetDevice\n"
+             "using HC1 and IPHC, with the frames delivered directly to a receiving\n"
+             "SixLowPanNetDevice. Overhead is the total frame size minus the UDP payload.");
+  cmd.AddValue ("n",   "number of packets per scenario (default 1E5)", n);
+  cmd.AddValue ("mtu", "link MTU, i.e., the 802.15.4 MAC payload (default 102)", mtu);
+  cmd.Parse (argc, argv);
+
+  uint32_t payloads[] = { 8, 32, 64, 200, 1000 };
+
+  std::cout << "Running bench-sixlowpan with n=" << n << " mtu=" << mtu << std::endl;
+  std::cout << std::left
+            << std::setw (6) << "Mode"
+            << std::setw (9) << "Payload"
+            << std::setw (8) << "Frames"
+            << std::setw (10) << "Overhead"
+            << std::setw (12) << "Tx ns/pkt"
+            << std::setw (12) << "Tx allocs"
+            << std::setw (12) << "RT ns/pkt"
+            << std::setw (12) << "RT allocs"
+            << std::endl;
+
+  for (uint32_t hc = 0; hc < 2; hc++)
+    {
+      Bench bench (hc == 1, mtu);
+      for (uint32_t i = 0; i < sizeof (payloads) / sizeof (payloads[0]); i++)
+        {
+          bench.Run (payloads[i], n);
+        }
+    }
+
+  Simulator::Destroy ();
+  return 0;
+}
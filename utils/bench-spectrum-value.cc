@@ -0,0 +1,312 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/spectrum-value.h"
+
+using namespace ns3;
+
+/*
+ * Benchmark of the SpectrumValue arithmetic.
+ *
+ * For spectrum models of 5 (e.g., a single 802.15.4 channel and its
+ * neighbours), 100 and 1000 bands, each operator is applied repeatedly to
+ * the same SpectrumValues, and compared to the iterator loop the operators
+ * used before their kernels were vectorized.
+ *
+ * The program reports the time per operation and per value, for the
+ * SpectrumValue operator and the reference loop.
+ */
+
+/// The reference loops, as SpectrumValue implemented the operators.
+class Reference
+{
+public:
+  static void Add (Values &a, const Values &b)
+  {
+    Values::iterator it1 = a.begin ();
+    Values::const_iterator it2 = b.begin ();
+    while (it1 != a.end ())
+      {
+        *it1 += *it2;
+        ++it1;
+        ++it2;
+      }
+  }
+  static void Subtract (Values &a, const Values &b)
+  {
+    Values::iterator it1 = a.begin ();
+    Values::const_iterator it2 = b.begin ();
+    while (it1 != a.end ())
+      {
+        *it1 -= *it2;
+        ++it1;
+        ++it2;
+      }
+  }
+  static void Multiply (Values &a, const Values &b)
+  {
+    Values::iterator it1 = a.begin ();
+    Values::const_iterator it2 = b.begin ();
+    while (it1 != a.end ())
+      {
+        *it1 *= *it2;
+        ++it1;
+        ++it2;
+      }
+  }
+  static void Multiply (Values &a, double s)
+  {
+    Values::iterator it1 = a.begin ();
+    while (it1 != a.end ())
+      {
+        *it1 *= s;
+        ++it1;
+      }
+  }
+  static void AddScaled (Values &a, const Values &b, double s)
+  {
+    // a += b * s, with the temporary of the operators
+    Values tmp = b;
+    Multiply (tmp, s);
+    Add (a, tmp);
+  }
+  static double Sum (const Values &a)
+  {
+    double s = 0;
+    Values::const_iterator it1 = a.begin ();
+    while (it1 != a.end ())
+      {
+        s += *it1;
+        ++it1;
+      }
+    return s;
+  }
+  static double Integral (const Values &a, Ptr<const SpectrumModel> model)
+  {
+    double i = 0;
+    Values::const_iterator vit = a.begin ();
+    Bands::const_iterator bit = model->Begin ();
+    while (vit != a.end ())
+      {
+        i += (*vit) * (bit->fh - bit->fl);
+        ++vit;
+        ++bit;
+      }
+    return i;
+  }
+};
+
+class Bench
+{
+public:
+  Bench (uint32_t nBands, uint64_t nValues);
+
+  void Run (void);
+private:
+  void Report (std::string name, double ms, double referenceMs) const;
+
+  Ptr<SpectrumModel> m_model;
+  uint32_t m_nBands;
+  uint32_t m_n;
+  double m_checksum;
+};
+
+Bench::Bench (uint32_t nBands, uint64_t nValues)
+  : m_nBands (nBands),
+    m_checksum (0)
+{
+  std::vector<double> centerFreqs;
+  for (uint32_t i = 0; i < nBands; i++)
+    {
+      centerFreqs.push_back (2.4e9 + i * 1e6);
+    }
+  m_model = Create<SpectrumModel> (centerFreqs);
+  m_n = nValues / nBands;
+  if (m_n == 0)
+    {
+      m_n = 1;
+    }
+}
+
+void
+Bench::Report (std::string name, double ms, double referenceMs) const
+{
+  std::cout << std::left
+            << std::setw (7) << m_nBands
+            << std::setw (11) << name
+            << std::setw (12) << ms * 1e6 / m_n
+            << std::setw (12) << ms * 1e6 / m_n / m_nBands
+            << std::setw (12) << referenceMs * 1e6 / m_n
+            << std::setw (12) << referenceMs * 1e6 / m_n / m_nBands
+            << std::setw (8) << (ms > 0 ? referenceMs / ms : 0)
+            << std::endl;
+}
+
+void
+Bench::Run (void)
+{
+  SpectrumValue a (m_model);
+  SpectrumValue b (m_model);
+  for (uint32_t i = 0; i < m_nBands; i++)
+    {
+      a[i] = 1e-12 * (i + 1);
+      b[i] = 1e-15;
+    }
+  Values ra (a.ConstValuesBegin (), a.ConstValuesEnd ());
+  Values rb (b.ConstValuesBegin (), b.ConstValuesEnd ());
+
+  SystemWallClockMs time;
+  double ms;
+  double referenceMs;
+
+  // The additions and subtractions alternate, not to overflow a.
+  time.Start ();
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      a += b;
+      a -= b;
+    }
+  ms = time.End ();
+  time.Start ();
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      Reference::Add (ra, rb);
+      Reference::Subtract (ra, rb);
+    }
+  referenceMs = time.End ();
+  Report ("+= -=", ms, referenceMs);
+
+  // a *= b * 1e15 keeps a close to its initial values.
+  time.Start ();
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      a *= b;
+      a *= 1e15;
+    }
+  ms = time.End ();
+  time.Start ();
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      Reference::Multiply (ra, rb);
+      Reference::Multiply (ra, 1e15);
+    }
+  referenceMs = time.End ();
+  Report ("*= *=s", ms, referenceMs);
+
+  time.Start ();
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      a.AddScaled (b, (i & 1) ? -0.5 : 0.5);
+    }
+  ms = time.End ();
+  time.Start ();
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      Reference::AddScaled (ra, rb, (i & 1) ? -0.5 : 0.5);
+    }
+  referenceMs = time.End ();
+  Report ("AddScaled", ms, referenceMs);
+
+  double s = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      s += Sum (a);
+    }
+  ms = time.End ();
+  double rs = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      rs += Reference::Sum (ra);
+    }
+  referenceMs = time.End ();
+  Report ("Sum", ms, referenceMs);
+  m_checksum += s + rs;
+
+  s = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      s += Integral (a);
+    }
+  ms = time.End ();
+  rs = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < m_n; i++)
+    {
+      rs += Reference::Integral (ra, m_model);
+    }
+  referenceMs = time.End ();
+  Report ("Integral", ms, referenceMs);
+  m_checksum += s + rs;
+
+  // The operators and the reference loops must agree.
+  for (uint32_t i = 0; i < m_nBands; i++)
+    {
+      if (a[i] != ra[i])
+        {
+          std::cerr << "Error-- value " << i << " is " << a[i] << " instead of " << ra[i] << std::endl;
+          exit (1);
+        }
+    }
+  if (m_checksum == 0)
+    {
+      std::cerr << "Error-- null checksum" << std::endl;
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  uint64_t nValues = 100000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the SpectrumValue arithmetic.\n"
+             "\n"
+             "Each operator is applied to SpectrumValues of 5, 100 and 1000 bands,\n"
+             "and compared to the iterator loop of the previous implementation.\n"
+             "+= -= and *= *=s time two operations per iteration.");
+  cmd.AddValue ("values", "number of values processed per operator and model (default 1E8)", nValues);
+  cmd.Parse (argc, argv);
+
+  uint32_t bands[] = { 5, 100, 1000 };
+
+  std::cout << "Running bench-spectrum-value with values=" << nValues << std::endl;
+  std::cout << std::left
+            << std::setw (7) << "Bands"
+            << std::setw (11) << "Operator"
+            << std::setw (12) << "ns/op"
+            << std::setw (12) << "ns/value"
+            << std::setw (12) << "Ref ns/op"
+            << std::setw (12) << "Ref ns/val"
+            << std::setw (8) << "Speedup"
+            << std::endl;
+
+  for (uint32_t i = 0; i < sizeof (bands) / sizeof (bands[0]); i++)
+    {
+      Bench bench (bands[i], nValues);
+      bench.Run ();
+    }
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Measure the cost of firing a TracedCallback with 0, 1 or N connected
+// sinks, with and without building its argument when nobody listens.
+
+#include <iomanip>
+#include <iostream>
+#include <stdint.h>
+#include <time.h>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+namespace {
+
+/// \returns a monotonic time, in ns
+uint64_t
+GetNs (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/// A trace argument, allocated for each event like a packet copy.
+class Payload : public SimpleRefCount<Payload>
+{
+public:
+  Payload (uint32_t value)
+    : m_value (value)
+  {}
+  uint32_t m_value;
+};
+
+/// The sum of the arguments received by the sinks.
+uint64_t volatile g_sum = 0;
+
+void
+Sink (Ptr<const Payload> payload)
+{
+  g_sum += payload->m_value;
+}
+
+/**
+ * Fire a trace source with a new argument for each event.
+ * \param trace the trace source
+ * \param events the number of events
+ * \param guard whether to test IsEmpty before building the argument
+ * \returns the mean cost of an event, in ns
+ */
+double
+Fire (const TracedCallback<Ptr<const Payload> > &trace, uint32_t events, bool guard)
+{
+  uint64_t start = GetNs ();
+  for (uint32_t i = 0; i < events; i++)
+    {
+      if (guard && trace.IsEmpty ())
+        {
+          continue;
+        }
+      trace (Create<Payload> (i));
+    }
+  return static_cast<double> (GetNs () - start) / events;
+}
+
+} // anonymous namespace
+
+
+int main (int argc, char *argv[])
+{
+  uint32_t events = 10000000;
+  uint32_t maxSinks = 8;
+
+  CommandLine cmd;
+  cmd.AddValue ("events", "number of events fired for each measure", events);
+  cmd.AddValue ("sinks",  "maximum number of connected sinks",        maxSinks);
+  cmd.Parse (argc, argv);
+
+  TracedCallback<Ptr<const Payload> > trace;
+  std::cout << std::left
+            << std::setw (8) << "Sinks"
+            << std::setw (16) << "Unguarded ns"
+            << "Guarded ns" << std::endl;
+  uint32_t sinks = 0;
+  while (true)
+    {
+      double unguarded = Fire (trace, events, false);
+      double guarded = Fire (trace, events, true);
+      std::cout << std::setw (8) << sinks
+                << std::setw (16) << unguarded
+                << guarded << std::endl;
+      uint32_t next = sinks == 0 ? 1 : sinks * 2;
+      if (next > maxSinks)
+        {
+          break;
+        }
+      for (; sinks < next; sinks++)
+        {
+          trace.ConnectWithoutContext (MakeCallback (&Sink));
+        }
+    }
+  return 0;
+}